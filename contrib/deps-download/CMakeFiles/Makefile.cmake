@@ -0,0 +1,81 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "CMakeLists.txt"
+  "cjson-prefix/tmp/cjson-mkdirs.cmake"
+  "libuv-prefix/tmp/libuv-mkdirs.cmake"
+  "lz4-prefix/tmp/lz4-mkdirs.cmake"
+  "taosadapter-prefix/tmp/taosadapter-mkdirs.cmake"
+  "zlib-prefix/tmp/zlib-mkdirs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystem.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeUnixFindMake.cmake"
+  "/usr/share/cmake-3.25/Modules/ExternalProject.cmake"
+  "/usr/share/cmake-3.25/Modules/ExternalProject/RepositoryInfo.txt.in"
+  "/usr/share/cmake-3.25/Modules/ExternalProject/cfgcmd.txt.in"
+  "/usr/share/cmake-3.25/Modules/ExternalProject/gitclone.cmake.in"
+  "/usr/share/cmake-3.25/Modules/ExternalProject/gitupdate.cmake.in"
+  "/usr/share/cmake-3.25/Modules/ExternalProject/mkdirs.cmake.in"
+  "/usr/share/cmake-3.25/Modules/FindGit.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "taosadapter-prefix/tmp/taosadapter-mkdirs.cmake"
+  "taosadapter-prefix/tmp/taosadapter-gitclone.cmake"
+  "taosadapter-prefix/src/taosadapter-stamp/taosadapter-gitinfo.txt"
+  "taosadapter-prefix/tmp/taosadapter-gitupdate.cmake"
+  "taosadapter-prefix/tmp/taosadapter-cfgcmd.txt"
+  "lz4-prefix/tmp/lz4-mkdirs.cmake"
+  "lz4-prefix/tmp/lz4-gitclone.cmake"
+  "lz4-prefix/src/lz4-stamp/lz4-gitinfo.txt"
+  "lz4-prefix/tmp/lz4-gitupdate.cmake"
+  "lz4-prefix/tmp/lz4-cfgcmd.txt"
+  "zlib-prefix/tmp/zlib-mkdirs.cmake"
+  "zlib-prefix/tmp/zlib-gitclone.cmake"
+  "zlib-prefix/src/zlib-stamp/zlib-gitinfo.txt"
+  "zlib-prefix/tmp/zlib-gitupdate.cmake"
+  "zlib-prefix/tmp/zlib-cfgcmd.txt"
+  "cjson-prefix/tmp/cjson-mkdirs.cmake"
+  "cjson-prefix/tmp/cjson-gitclone.cmake"
+  "cjson-prefix/src/cjson-stamp/cjson-gitinfo.txt"
+  "cjson-prefix/tmp/cjson-gitupdate.cmake"
+  "cjson-prefix/tmp/cjson-cfgcmd.txt"
+  "libuv-prefix/tmp/libuv-mkdirs.cmake"
+  "libuv-prefix/tmp/libuv-gitclone.cmake"
+  "libuv-prefix/src/libuv-stamp/libuv-gitinfo.txt"
+  "libuv-prefix/tmp/libuv-gitupdate.cmake"
+  "libuv-prefix/tmp/libuv-cfgcmd.txt"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/taosadapter.dir/DependInfo.cmake"
+  "CMakeFiles/lz4.dir/DependInfo.cmake"
+  "CMakeFiles/zlib.dir/DependInfo.cmake"
+  "CMakeFiles/cjson.dir/DependInfo.cmake"
+  "CMakeFiles/libuv.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/lz4"
+  "CMakeFiles/lz4-complete"
+  "lz4-prefix/src/lz4-stamp/lz4-build"
+  "lz4-prefix/src/lz4-stamp/lz4-configure"
+  "lz4-prefix/src/lz4-stamp/lz4-download"
+  "lz4-prefix/src/lz4-stamp/lz4-install"
+  "lz4-prefix/src/lz4-stamp/lz4-mkdir"
+  "lz4-prefix/src/lz4-stamp/lz4-patch"
+  "lz4-prefix/src/lz4-stamp/lz4-test"
+  "lz4-prefix/src/lz4-stamp/lz4-update"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/lz4.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/zlib"
+  "CMakeFiles/zlib-complete"
+  "zlib-prefix/src/zlib-stamp/zlib-build"
+  "zlib-prefix/src/zlib-stamp/zlib-configure"
+  "zlib-prefix/src/zlib-stamp/zlib-download"
+  "zlib-prefix/src/zlib-stamp/zlib-install"
+  "zlib-prefix/src/zlib-stamp/zlib-mkdir"
+  "zlib-prefix/src/zlib-stamp/zlib-patch"
+  "zlib-prefix/src/zlib-stamp/zlib-test"
+  "zlib-prefix/src/zlib-stamp/zlib-update"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/zlib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+cmake_minimum_required(VERSION 3.5)
+
+file(MAKE_DIRECTORY
+  "/root/repo/contrib/libuv"
+  "/root/repo/contrib/libuv"
+  "/root/repo/contrib/deps-download/libuv-prefix"
+  "/root/repo/contrib/deps-download/libuv-prefix/tmp"
+  "/root/repo/contrib/deps-download/libuv-prefix/src/libuv-stamp"
+  "/root/repo/contrib/deps-download/libuv-prefix/src"
+  "/root/repo/contrib/deps-download/libuv-prefix/src/libuv-stamp"
+)
+
+set(configSubDirs )
+foreach(subDir IN LISTS configSubDirs)
+    file(MAKE_DIRECTORY "/root/repo/contrib/deps-download/libuv-prefix/src/libuv-stamp/${subDir}")
+endforeach()
+if(cfgdir)
+  file(MAKE_DIRECTORY "/root/repo/contrib/deps-download/libuv-prefix/src/libuv-stamp${cfgdir}") # cfgdir has leading slash
+endif()
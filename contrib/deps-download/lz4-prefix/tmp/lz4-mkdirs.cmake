@@ -0,0 +1,22 @@
+# Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+# file Copyright.txt or https://cmake.org/licensing for details.
+
+cmake_minimum_required(VERSION 3.5)
+
+file(MAKE_DIRECTORY
+  "/root/repo/contrib/lz4"
+  "/root/repo/contrib/deps-download/lz4-prefix/src/lz4-build"
+  "/root/repo/contrib/deps-download/lz4-prefix"
+  "/root/repo/contrib/deps-download/lz4-prefix/tmp"
+  "/root/repo/contrib/deps-download/lz4-prefix/src/lz4-stamp"
+  "/root/repo/contrib/deps-download/lz4-prefix/src"
+  "/root/repo/contrib/deps-download/lz4-prefix/src/lz4-stamp"
+)
+
+set(configSubDirs )
+foreach(subDir IN LISTS configSubDirs)
+    file(MAKE_DIRECTORY "/root/repo/contrib/deps-download/lz4-prefix/src/lz4-stamp/${subDir}")
+endforeach()
+if(cfgdir)
+  file(MAKE_DIRECTORY "/root/repo/contrib/deps-download/lz4-prefix/src/lz4-stamp${cfgdir}") # cfgdir has leading slash
+endif()
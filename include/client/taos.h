@@ -28,6 +28,7 @@ typedef void   TAOS_STMT;
 typedef void   TAOS_RES;
 typedef void **TAOS_ROW;
 typedef void   TAOS_SUB;
+typedef void   TAOS_CQ;
 
 // Data type definition
 #define TSDB_DATA_TYPE_NULL       0   // 1 bytes
@@ -175,6 +176,22 @@ DLL_EXPORT char     *taos_stmt_errstr(TAOS_STMT *stmt);
 DLL_EXPORT int       taos_stmt_affected_rows(TAOS_STMT *stmt);
 DLL_EXPORT int       taos_stmt_affected_rows_once(TAOS_STMT *stmt);
 
+typedef struct TAOS_STMT_VG_STAT {
+  int32_t vgId;
+  int32_t inflight;  // submits not finished
+  int64_t submits;   // finished
+  int64_t failed;
+  int64_t rows;  // affected
+  int64_t totalLatencyUs;
+  int64_t maxLatencyUs;
+} TAOS_STMT_VG_STAT;
+
+// maxRows 0 turns the auto batch mode off, taos_stmt_execute then sends the rows and waits as before
+DLL_EXPORT int taos_stmt_set_auto_batch(TAOS_STMT *stmt, int maxRows, int maxDelayMs, int maxInflight);
+DLL_EXPORT int taos_stmt_flush(TAOS_STMT *stmt);
+// returns the number of vgroups written to stats
+DLL_EXPORT int taos_stmt_get_vgroup_stats(TAOS_STMT *stmt, TAOS_STMT_VG_STAT *stats, int maxNum);
+
 DLL_EXPORT TAOS_RES *taos_query(TAOS *taos, const char *sql);
 DLL_EXPORT TAOS_RES *taos_query_with_reqid(TAOS *taos, const char *sql, int64_t reqId);
 
@@ -196,6 +213,26 @@ DLL_EXPORT int         taos_fetch_block(TAOS_RES *res, TAOS_ROW *rows);
 DLL_EXPORT int         taos_fetch_block_s(TAOS_RES *res, int *numOfRows, TAOS_ROW *rows);
 DLL_EXPORT int         taos_fetch_raw_block(TAOS_RES *res, int *numOfRows, void **pData);
 DLL_EXPORT int        *taos_get_column_data_offset(TAOS_RES *res, int columnIndex);
+
+// The buffers of one column in the arrow layout. The fixed length values are stored as in the rows, the var length
+// ones back to back with maxRows + 1 offsets, nchar is converted to the charset of the client. The bit of a row in
+// validity, the lowest bit first, is set when the value is not null.
+typedef struct TAOS_COLUMN_BUF {
+  void    *data;
+  int32_t  capacity;  // bytes of data
+  int32_t *offsets;   // var length types only
+  uint8_t *validity;  // (maxRows + 7) / 8 bytes
+  int32_t  length;     // bytes written into data
+  int32_t  nullCount;  // of the rows written
+} TAOS_COLUMN_BUF;
+
+// returns the rows written into the buffers, 0 when the result is used up, or an error code
+DLL_EXPORT int taos_fetch_columns(TAOS_RES *res, TAOS_COLUMN_BUF *cols, int numOfCols, int maxRows);
+
+// Writes the rest of the result as an arrow IPC stream through fp, which returns 0 when the bytes are written. The
+// binary and nchar columns are dictionary encoded, nchar in the charset of the client.
+typedef int (*__taos_arrow_write_fn_t)(void *param, const void *data, int64_t len);
+DLL_EXPORT int taos_export_arrow(TAOS_RES *res, __taos_arrow_write_fn_t fp, void *param);
 DLL_EXPORT int         taos_validate_sql(TAOS *taos, const char *sql);
 DLL_EXPORT void        taos_reset_current_db(TAOS *taos);
 
@@ -226,6 +263,34 @@ DLL_EXPORT TAOS_RES *taos_schemaless_insert_raw(TAOS *taos, char *lines, int len
 DLL_EXPORT TAOS_RES *taos_schemaless_insert_raw_with_reqid(TAOS *taos, char *lines, int len, int32_t *totalRows,
                                                            int protocol, int precision, int64_t reqid);
 
+/* --------------------------COMPLETION QUEUE INTERFACE------------------------------- */
+
+typedef enum {
+  TAOS_CQ_QUERY = 1,
+  TAOS_CQ_FETCH,
+  TAOS_CQ_STMT_EXECUTE,
+  TAOS_CQ_SCHEMALESS_INSERT,
+} TAOS_CQ_OP;
+
+typedef struct TAOS_CQ_EVENT {
+  TAOS_CQ_OP op;
+  int        code;
+  int        numOfRows;  // rows fetched, or rows affected by the others
+  void      *userData;
+  TAOS_RES  *res;   // released by the app, except for fetch; NULL for a stmt not inserting async
+  TAOS_STMT *stmt;  // stmt execute only
+} TAOS_CQ_EVENT;
+
+DLL_EXPORT TAOS_CQ *taos_cq_create();
+DLL_EXPORT void     taos_cq_destroy(TAOS_CQ *cq);
+DLL_EXPORT int      taos_cq_query(TAOS_CQ *cq, TAOS *taos, const char *sql, void *userData);
+DLL_EXPORT int      taos_cq_fetch(TAOS_CQ *cq, TAOS_RES *res, void *userData);
+DLL_EXPORT int      taos_cq_stmt_execute(TAOS_CQ *cq, TAOS_STMT *stmt, void *userData);
+DLL_EXPORT int      taos_cq_schemaless_insert(TAOS_CQ *cq, TAOS *taos, char *lines[], int numLines, int protocol,
+                                              int precision, void *userData);
+// returns the number of events, 0 when nothing finished within timeout ms, a negative timeout waits until one does
+DLL_EXPORT int      taos_cq_poll(TAOS_CQ *cq, TAOS_CQ_EVENT *events, int maxEvents, int timeout);
+
 /* --------------------------TMQ INTERFACE------------------------------- */
 
 typedef struct tmq_t      tmq_t;
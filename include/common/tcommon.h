@@ -183,6 +183,7 @@ typedef struct SDataBlockInfo {
   uint64_t    groupId;
   int16_t     hasVarCol;
   uint32_t    capacity;
+  bool        noData;  // only the block SMA (if any) and time range are loaded, not kept by copies of the block
   // TODO: optimize and remove following
   int64_t     version;    // used for stream, and need serialization
   int32_t     childId;    // used for stream, do not serialize
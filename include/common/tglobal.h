@@ -62,6 +62,15 @@ extern int32_t tsNumOfSnodeStreamThreads;
 extern int32_t tsNumOfSnodeWriteThreads;
 extern int64_t tsRpcQueueMemoryAllowed;
 
+// db
+extern bool tsNcharUtf8;  // the nchar columns of the databases created while set keep UTF-8
+
+// stream
+extern int32_t tsStreamStateCacheSize;  // memory budget in MB of the write-back state cache for each stream task
+extern int32_t tsStreamDispatchBatchSize;  // KB, small results are coalesced into dispatch msgs up to this size
+extern bool    tsStreamDispatchCompress;
+extern int32_t tsStreamCheckpointInterval;  // second, the state of each stream task is checkpointed at this interval
+
 // monitor
 extern bool     tsEnableMonitor;
 extern int32_t  tsMonitorInterval;
@@ -79,6 +88,7 @@ extern uint16_t tsTelemPort;
 // query buffer management
 extern int32_t tsQueryBufferSize;  // maximum allowed usage buffer size in MB for each data node during query processing
 extern int64_t tsQueryBufferSizeBytes;  // maximum allowed usage buffer size in byte for each data node
+extern int32_t tsQueryMaxParallelism;   // maximum number of threads used by one query task in vnode
 
 // query client
 extern int32_t tsQueryPolicy;
@@ -120,9 +130,10 @@ extern char tsUdfdResFuncs[];
 extern char tsUdfdLdLibPath[];
 
 // schemaless
-extern char tsSmlChildTableName[];
-extern char tsSmlTagName[];
-extern bool tsSmlDataFormat;
+extern char    tsSmlChildTableName[];
+extern char    tsSmlTagName[];
+extern bool    tsSmlDataFormat;
+extern int32_t tsSmlParseThreads;
 
 // wal
 extern int64_t tsWalFsyncDataSizeLimit;
@@ -324,6 +324,7 @@ void    tFreeSSubmitRsp(SSubmitRsp* pRsp);
 
 #define COL_SMA_ON     ((int8_t)0x1)
 #define COL_IDX_ON     ((int8_t)0x2)
+#define COL_NCHAR_UTF8 ((int8_t)0x4)  // a VARCHAR keeping the UTF-8 of an NCHAR of a database created with ncharUtf8
 #define COL_SET_NULL   ((int8_t)0x10)
 #define COL_SET_VAL    ((int8_t)0x20)
 #define COL_IS_SYSINFO ((int8_t)0x40)
@@ -921,6 +922,7 @@ typedef struct {
   int32_t numOfRetensions;
   SArray* pRetensions;
   int8_t  schemaless;
+  int8_t  ncharUtf8;
 } SDbCfgRsp;
 
 int32_t tSerializeSDbCfgRsp(void* buf, int32_t bufLen, const SDbCfgRsp* pRsp);
@@ -2949,6 +2951,8 @@ typedef struct {
   int64_t  timeout;
   // int64_t      currentOffset;
   STqOffsetVal reqOffset;
+  int32_t      batchRows;     // a parked poll is answered once so many rows are collected, 0 for the first block
+  int32_t      batchDelayMs;  // or once the first collected block has waited so long
 } SMqPollReq;
 
 int32_t tSerializeSMqPollReq(void *buf, int32_t bufLen, SMqPollReq *pReq);
@@ -328,6 +328,18 @@ int32_t tdSTSRowNew(SArray *pArray, STSchema *pTSchema, STSRow **ppRow);
 bool    tdSTSRowGetVal(STSRowIter *pIter, col_id_t colId, col_type_t colType, SCellVal *pVal);
 void    tdSRowPrint(STSRow *row, STSchema *pSchema, const char *tag);
 
+// Location of one column in the rows of a schema version, resolved once and reused to decode a batch of rows column by
+// column.
+typedef struct {
+  col_id_t colId;
+  int8_t   type;
+  int16_t  colIdx;  // index in STSchema, -1 if the column does not exist in the schema
+  int32_t  offset;  // offset in the first part of STpRow, the primary TS key excluded
+} STSRowColLoc;
+
+void tdSTSRowColLocInit(STSchema *pSchema, col_id_t colId, STSRowColLoc *pLoc);
+void tdSTSRowGetValByLoc(STSRow *pRow, STSchema *pSchema, const STSRowColLoc *pLoc, SCellVal *pVal);
+
 #ifdef __cplusplus
 }
 #endif
@@ -275,6 +275,11 @@ typedef struct {
   (((t) == TSDB_DATA_TYPE_VARCHAR) || ((t) == TSDB_DATA_TYPE_NCHAR) || ((t) == TSDB_DATA_TYPE_JSON))
 #define IS_STR_DATA_TYPE(t) (((t) == TSDB_DATA_TYPE_VARCHAR) || ((t) == TSDB_DATA_TYPE_NCHAR))
 
+// the scale of the VARCHAR columns flagged COL_NCHAR_UTF8, their string functions and LIKE count the chars of UTF-8,
+// the other VARCHAR count the bytes
+#define TSDB_UTF8_NCHAR_SCALE           1
+#define IS_UTF8_NCHAR_TYPE(_t, _scale) ((_t) == TSDB_DATA_TYPE_VARCHAR && (_scale) == TSDB_UTF8_NCHAR_SCALE)
+
 #define IS_VALID_TINYINT(_t)   ((_t) >= INT8_MIN && (_t) <= INT8_MAX)
 #define IS_VALID_SMALLINT(_t)  ((_t) >= INT16_MIN && (_t) <= INT16_MAX)
 #define IS_VALID_INT(_t)       ((_t) >= INT32_MIN && (_t) <= INT32_MAX)
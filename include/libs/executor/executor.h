@@ -176,6 +176,13 @@ void qProcessRspMsg(void* parent, struct SRpcMsg* pMsg, struct SEpSet* pEpSet);
 
 int32_t qGetExplainExecInfo(qTaskInfo_t tinfo, SArray* pExecInfoList /*,int32_t* resNum, SExplainExecInfo** pRes*/);
 
+/**
+ * Run the work put into the query queue by a query task, e.g. a parallel worker of an operator
+ * @param pMsg the TDMT_SCH_QUERY_WORKER msg
+ * @return
+ */
+int32_t qProcessWorkerMsg(struct SRpcMsg* pMsg);
+
 int32_t qSerializeTaskStatus(qTaskInfo_t tinfo, char** pOutput, int32_t* len);
 
 int32_t qDeserializeTaskStatus(qTaskInfo_t tinfo, const char* pInput, int32_t len);
@@ -41,17 +41,24 @@ typedef int32_t (*FExecFinalize)(struct SqlFunctionCtx *pCtx, SSDataBlock *pBloc
 typedef int32_t (*FScalarExecProcess)(SScalarParam *pInput, int32_t inputNum, SScalarParam *pOutput);
 typedef int32_t (*FExecCombine)(struct SqlFunctionCtx *pDestCtx, struct SqlFunctionCtx *pSourceCtx);
 
+/**
+ * Apply the function on input.numOfRows rows, starting from input.startRowIndex. Each row may belong to a different
+ * result, pResList[i] is the initialized result entry of row (input.startRowIndex + i).
+ */
+typedef int32_t (*FExecBatchProcess)(struct SqlFunctionCtx *pCtx, struct SResultRowEntryInfo **pResList);
+
 typedef struct SScalarFuncExecFuncs {
   FExecGetEnv        getEnv;
   FScalarExecProcess process;
 } SScalarFuncExecFuncs;
 
 typedef struct SFuncExecFuncs {
-  FExecGetEnv   getEnv;
-  FExecInit     init;
-  FExecProcess  process;
-  FExecFinalize finalize;
-  FExecCombine  combine;
+  FExecGetEnv       getEnv;
+  FExecInit         init;
+  FExecProcess      process;
+  FExecFinalize     finalize;
+  FExecCombine      combine;
+  FExecBatchProcess batchProcess;
 } SFuncExecFuncs;
 
 #define MAX_INTERVAL_TIME_WINDOW 10000000  // maximum allowed time windows in final results
@@ -64,6 +64,7 @@ typedef struct SParseContext {
   SArray*          pTableMetaPos;    // sql table pos => catalog data pos
   SArray*          pTableVgroupPos;  // sql table pos => catalog data pos
   int64_t          allocatorId;
+  void*            pInsertCache;  // the resolved schema clauses of the INSERT statements, see qCreateInsertCache
 } SParseContext;
 
 int32_t qParseSql(SParseContext* pCxt, SQuery** pQuery);
@@ -80,6 +81,12 @@ void qDestroyParseContext(SParseContext* pCxt);
 
 void qDestroyQuery(SQuery* pQueryNode);
 
+// The insert cache of a connection, shared by its requests. It is cleared when the meta of a written table may be
+// out of date.
+void* qCreateInsertCache();
+void  qClearInsertCache(void* pCache);
+void  qDestroyInsertCache(void* pCache);
+
 int32_t qExtractResultSchema(const SNode* pRoot, int32_t* numOfCols, SSchema** pSchema);
 int32_t qSetSTableIdForRsma(SNode* pStmt, int64_t uid);
 void    qCleanupKeywordsTable();
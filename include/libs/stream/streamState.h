@@ -35,7 +35,13 @@ typedef struct STdbState {
   TTB*         pFillStateDb;  // todo refactor
   TTB*         pSessionStateDb;
   TTB*         pParNameDb;
+  TTB*         pCheckpointDb;
   TXN          txn;
+  SHashObj*    pStateCache;    // write-back cache of pStateDb, SStateKey -> SStateCacheEntry*
+  SArray*      pDirtyKeys;     // SStateKey of the cached window states not written into pStateDb yet
+  int64_t      cacheSize;      // memory occupied by the cached window states
+  int64_t      checkpointVer;  // wal version of the latest input applied to the state
+  int64_t      committedVer;   // checkpointVer persisted by the last commit, -1 if none
 } STdbState;
 
 // incremental state storage
@@ -51,6 +57,9 @@ int32_t       streamStateCommit(SStreamState* pState);
 int32_t       streamStateAbort(SStreamState* pState);
 void          streamStateDestroy(SStreamState* pState);
 
+void    streamStateSetCheckpointVer(SStreamState* pState, int64_t ver);
+int64_t streamStateGetCommittedVer(SStreamState* pState);
+
 typedef struct {
   TBC*    pCur;
   int64_t number;
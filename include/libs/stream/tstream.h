@@ -156,6 +156,12 @@ typedef struct {
   int8_t      status;
 } SStreamQueue;
 
+// back pressure: a task grants its upstream credits for so many queued input items, a source task defers the submits
+// beyond them to the wal replay, and a task stops exec while as many results as its downstream grants are waiting
+#define STREAM_TASK_QUEUE_CAPACITY 128
+// a task that is granted no credit probes its downstream again after the delay
+#define STREAM_DISPATCH_BACKOFF_MS 100
+
 int32_t streamInit();
 void    streamCleanUp();
 
@@ -339,6 +345,13 @@ typedef struct SStreamTask {
   int64_t checkReqId;
   SArray* checkReqIds;  // shuffle
   int32_t refCnt;
+  int32_t dispatchCredit;  // min credit granted by the downstream tasks in the last finished dispatch round
+  int32_t roundCredit;     // min credit granted by the downstream tasks in the current dispatch round
+  int8_t  execPaused;      // exec stopped since the output queue is full
+  int64_t lastCheckpointTs;
+  int64_t replayStartVer;  // data of version in (replayStartVer, replayEndVer] is replayed from the checkpoint, the
+                           // data up to replayStartVer is done
+  int64_t replayEndVer;
 } SStreamTask;
 
 int32_t tEncodeStreamEpInfo(SEncoder* pEncoder, const SStreamChildEpInfo* pInfo);
@@ -428,6 +441,7 @@ typedef struct {
   int32_t downstreamNodeId;
   int32_t downstreamTaskId;
   int8_t  inputStatus;
+  int32_t credit;  // more dispatch msgs the downstream task can take
 } SStreamDispatchRsp;
 
 typedef struct {
@@ -529,6 +543,14 @@ int32_t streamSchedExec(SStreamTask* pTask);
 
 int32_t streamScanExec(SStreamTask* pTask, int32_t batchSz);
 
+// checkpoint
+int32_t streamTaskDoCheckpoint(SStreamTask* pTask);
+int32_t streamSourceReplayFromCheckpoint(SStreamTask* pTask);
+bool    streamTaskInputFull(SStreamTask* pTask);
+bool    streamTaskReplayPending(SStreamTask* pTask);
+void    streamTaskDeferSubmit(SStreamTask* pTask, int64_t ver);
+bool    streamTaskSubmitCovered(SStreamTask* pTask, int64_t ver);
+
 // recover and fill history
 int32_t streamTaskCheckDownstream(SStreamTask* pTask, int64_t version);
 int32_t streamTaskLaunchRecover(SStreamTask* pTask, int64_t version);
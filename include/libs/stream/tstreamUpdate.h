@@ -19,7 +19,7 @@
 #include "tarray.h"
 #include "tcommon.h"
 #include "tmsg.h"
-#include "tscalablebf.h"
+#include "thash.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -30,19 +30,34 @@ typedef struct SUpdateKey {
   TSKEY   ts;
 } SUpdateKey;
 
+// keys skey, skey + step, ..., skey + step * (num - 1)
+typedef struct SUpdateRun {
+  TSKEY   skey;
+  int64_t step;
+  int32_t num;
+} SUpdateRun;
+
+typedef struct STableUpdateInfo {
+  TSKEY   maxTs;
+  int32_t start;  // runs before start are below the watermark
+  SArray *pRuns;  // SArray<SUpdateRun>, sorted and disjoint
+} STableUpdateInfo;
+
+typedef struct SUpdateStat {
+  int64_t numOfChecked;
+  int64_t numOfUpdated;  // rows whose key has been seen within the watermark
+  int64_t numOfExpired;  // rows below the watermark, recalculated without an exact check
+} SUpdateStat;
+
 typedef struct SUpdateInfo {
-  SArray      *pTsBuckets;
-  uint64_t     numBuckets;
-  SArray      *pTsSBFs;
-  uint64_t     numSBFs;
-  int64_t      interval;
-  int64_t      watermark;
-  TSKEY        minTS;
-  SScalableBf *pCloseWinSBF;
-  SHashObj    *pMap;
-  STimeWindow  scanWindow;
-  uint64_t     scanGroupId;
-  uint64_t     maxVersion;
+  int64_t     interval;
+  int64_t     watermark;
+  SHashObj   *pCloseWinSet;  // SUpdateKey -> NULL, keys of the closed windows seen during the history scan
+  SHashObj   *pMap;          // tbUid -> STableUpdateInfo
+  STimeWindow scanWindow;
+  uint64_t    scanGroupId;
+  uint64_t    maxVersion;
+  SUpdateStat stat;
 } SUpdateInfo;
 
 SUpdateInfo *updateInfoInitP(SInterval *pInterval, int64_t watermark);
@@ -53,8 +68,8 @@ bool         updateInfoIsTableInserted(SUpdateInfo *pInfo, int64_t tbUid);
 void         updateInfoSetScanRange(SUpdateInfo *pInfo, STimeWindow *pWin, uint64_t groupId, uint64_t version);
 bool         updateInfoIgnore(SUpdateInfo *pInfo, STimeWindow *pWin, uint64_t groupId, uint64_t version);
 void         updateInfoDestroy(SUpdateInfo *pInfo);
-void         updateInfoAddCloseWindowSBF(SUpdateInfo *pInfo);
-void         updateInfoDestoryColseWinSBF(SUpdateInfo *pInfo);
+void         updateInfoAddCloseWindowSet(SUpdateInfo *pInfo);
+void         updateInfoDestroyCloseWindowSet(SUpdateInfo *pInfo);
 int32_t      updateInfoSerialize(void *buf, int32_t bufLen, const SUpdateInfo *pInfo);
 int32_t      updateInfoDeserialize(void *buf, int32_t bufLen, SUpdateInfo *pInfo);
 
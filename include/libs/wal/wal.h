@@ -97,6 +97,20 @@ typedef struct {
 } SWalCkHead;
 #pragma pack(pop)
 
+// recently read entries, shared by all readers of the wal so that the readers tailing the log at the same position
+// read and verify each entry only once
+typedef struct {
+  int64_t     ver;
+  SWalCkHead *pEntry;
+} SWalCacheSlot;
+
+typedef struct {
+  TdThreadRwlock lock;
+  int64_t        size;  // total bytes of the cached entries
+  int64_t        gen;   // increased when versions are removed, entries read from file before it are not cached
+  SWalCacheSlot *pSlots;
+} SWalReadCache;
+
 typedef struct SWal {
   // cfg
   SWalCfg cfg;
@@ -117,6 +131,10 @@ typedef struct SWal {
   SHashObj *pRefHash;  // refId -> SWalRef
   // path
   char path[WAL_PATH_LEN];
+  // shared read cache
+  SWalReadCache readCache;
+  // side index of the files created since open, SArray<SWalSegIdx>
+  SArray *pSegIdxs;
   // reusable write head
   SWalCkHead writeHead;
 } SWal;
@@ -147,6 +165,11 @@ typedef struct {
   int8_t         curStopped;
   TdThreadMutex  mutex;
   SWalFilterCond cond;
+  // files without any of the tables are skipped, NULL for all tables
+  SHashObj *pUidFilter;
+  int64_t   segCheckedVer;
+  // generation of the read cache when the current entry is read from file
+  int64_t cacheGen;
   // TODO remove it
   SWalCkHead *pHead;
 } SWalReader;
@@ -192,6 +215,7 @@ void        walCloseReader(SWalReader *pRead);
 int32_t     walReadVer(SWalReader *pRead, int64_t ver);
 int32_t     walReadSeekVer(SWalReader *pRead, int64_t ver);
 int32_t     walNextValidMsg(SWalReader *pRead);
+void        walReaderSetUidFilter(SWalReader *pRead, SHashObj *pUids);
 
 // only for tq usage
 void    walSetReaderCapacity(SWalReader *pRead, int32_t capacity);
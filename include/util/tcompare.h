@@ -42,6 +42,7 @@ extern "C" {
 typedef struct SPatternCompareInfo {
   char matchAll;  // symbol for match all wildcard, default: '%'
   char matchOne;  // symbol for match one wildcard, default: '_'
+  bool utf8;      // match one matches all the bytes of a char of UTF-8, default: one byte
 } SPatternCompareInfo;
 
 int32_t patternMatch(const char *pattern, const char *str, size_t size, const SPatternCompareInfo *pInfo);
@@ -101,6 +102,8 @@ int32_t compareLenPrefixedWStrDesc(const void *pLeft, const void *pRight);
 
 int32_t compareStrPatternMatch(const void *pLeft, const void *pRight);
 int32_t compareStrPatternNotMatch(const void *pLeft, const void *pRight);
+int32_t compareUtf8PatternMatch(const void *pLeft, const void *pRight);
+int32_t compareUtf8PatternNotMatch(const void *pLeft, const void *pRight);
 
 int32_t compareWStrPatternMatch(const void *pLeft, const void *pRight);
 int32_t compareWStrPatternNotMatch(const void *pLeft, const void *pRight);
@@ -150,6 +150,8 @@ typedef struct STscObj {
   SAppInstInfo* pAppInfo;
   SHashObj*     pRequests;
   int8_t        schemalessType;  // todo remove it, this attribute should be move to request
+  void*         smlCache;        // SSmlCache, the meta of the tables written by schemaless insert
+  void*         insertCache;     // the resolved schema clauses of the INSERT statements, see qCreateInsertCache
 } STscObj;
 
 typedef struct SResultColumn {
@@ -247,6 +249,7 @@ typedef struct SRequestObj {
   bool                 validateOnly;  // todo refactor
   bool                 killed;
   bool                 inRetry;
+  bool                 isStmtBind;  // the stmt retries it with the meta refreshed, not the scheduler callback
   uint32_t             prevCode;  // previous error code: todo refactor, add update flag for catalog
   uint32_t             retry;
   int64_t              allocatorRefId;
@@ -262,9 +265,13 @@ void* doAsyncFetchRows(SRequestObj* pRequest, bool setupOneRowPtr, bool convertU
 void* doFetchRows(SRequestObj* pRequest, bool setupOneRowPtr, bool convertUcs4);
 
 void    doSetOneRowPtr(SReqResultInfo* pResultInfo);
+int32_t doFillColumns(SReqResultInfo* pResultInfo, TAOS_COLUMN_BUF* cols, int32_t maxRows);
+int32_t doFillValidity(const char* nullbitmap, int32_t start, int32_t numOfRows, uint8_t* validity);
 void    setResPrecision(SReqResultInfo* pResInfo, int32_t precision);
 int32_t setQueryResultFromRsp(SReqResultInfo* pResultInfo, const SRetrieveTableRsp* pRsp, bool convertUcs4,
                               bool freeAfterUse);
+int32_t setResultDataPtr(SReqResultInfo* pResultInfo, TAOS_FIELD* pFields, int32_t numOfCols, int32_t numOfRows,
+                         bool convertUcs4);
 void    setResSchemaInfo(SReqResultInfo* pResInfo, const SSchema* pSchema, int32_t numOfCols);
 void    doFreeReqResultInfo(SReqResultInfo* pResInfo);
 int32_t transferTableNameList(const char* tbList, int32_t acctId, char* dbName, SArray** pReq);
@@ -393,6 +400,9 @@ void    launchAsyncQuery(SRequestObj* pRequest, SQuery* pQuery, SMetaData* pResu
 int32_t refreshMeta(STscObj* pTscObj, SRequestObj* pRequest);
 int32_t updateQnodeList(SAppInstInfo* pInfo, SArray* pNodeList);
 void    doAsyncQuery(SRequestObj* pRequest, bool forceUpdateMeta);
+void    smlDestroyCache(void* pCache);
+void    smlInsertAsync(TAOS* taos, char* lines[], int numLines, int protocol, int precision, __taos_async_fn_t fp,
+                       void* param);
 int32_t removeMeta(STscObj* pTscObj, SArray* tbList);
 int32_t handleAlterTbExecRes(void* res, struct SCatalog* pCatalog);
 int32_t handleCreateTbExecRes(void* res, SCatalog* pCatalog);
@@ -400,6 +410,14 @@ bool    qnodeRequired(SRequestObj* pRequest);
 void    continueInsertFromCsv(SSqlCallbackWrapper* pWrapper, SRequestObj* pRequest);
 void    destorySqlCallbackWrapper(SSqlCallbackWrapper* pWrapper);
 
+typedef struct SArrowWriter SArrowWriter;
+
+SArrowWriter* arrowWriterCreate(TAOS_FIELD* fields, int32_t numOfCols, int32_t precision, __taos_arrow_write_fn_t fp,
+                                void* param);
+int32_t       arrowWriteBlock(SArrowWriter* pWriter, SReqResultInfo* pResultInfo);
+int32_t       arrowWriterFinish(SArrowWriter* pWriter);
+void          arrowWriterDestroy(SArrowWriter* pWriter);
+
 #ifdef __cplusplus
 }
 #endif
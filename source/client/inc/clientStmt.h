@@ -91,6 +91,29 @@ typedef struct SStmtSQLInfo {
   SHashObj         *pVgHash;
 } SStmtSQLInfo;
 
+// In the auto batch mode an execute only buffers the bound rows, they are sent by the execute which finds maxRows
+// rows buffered or the first of them older than maxDelayMs, or by a flush. The rows are merged into one submit per
+// vgroup and each submit is sent without waiting, up to maxInflight of them per vgroup. An error of a submit sent
+// before is returned by the next execute or flush. If it is caused by a stale meta, the meta of the tables of that
+// submit is refreshed and the stmt is reset as by a sync execute, TSDB_CODE_NEED_RETRY then asks the app to prepare it
+// again and resend the rows not affected.
+typedef struct SStmtAutoBatch {
+  int32_t       maxRows;  // 0 if the mode is off
+  int32_t       maxDelayMs;
+  int32_t       maxInflight;
+  int32_t       numOfRows;  // buffered
+  int64_t       firstTs;    // when the first buffered row was bound
+  int32_t       execCode;   // of the last stmtExecAsync
+  TdThreadMutex mutex;
+  TdThreadCond  cond;
+  // guarded by the mutex, updated by the submit callbacks
+  SHashObj *pVgStats;  // SHash<vgId, TAOS_STMT_VG_STAT>
+  int32_t   numOfInflight;
+  int32_t   numOfAckRows;  // affected by the submits finished since the last execute
+  int32_t   code;          // first error of the submits finished since the last execute
+  SArray   *pStaleTables;  // SArray<SName>, written by the submits failed with a stale meta
+} SStmtAutoBatch;
+
 typedef struct STscStmt {
   STscObj  *taos;
   SCatalog *pCatalog;
@@ -103,6 +126,11 @@ typedef struct STscStmt {
   SStmtBindInfo bInfo;
 
   int64_t reqid;
+
+  __taos_async_fn_t execFp;  // of the running stmtExecAsync
+  void             *execParam;
+
+  SStmtAutoBatch autoBatch;
 } STscStmt;
 
 extern char *gStmtStatusStr[];
@@ -151,6 +179,8 @@ extern char *gStmtStatusStr[];
 TAOS_STMT  *stmtInit(STscObj *taos, int64_t reqid);
 int         stmtClose(TAOS_STMT *stmt);
 int         stmtExec(TAOS_STMT *stmt);
+int         stmtExecAsync(TAOS_STMT *stmt, __taos_async_fn_t fp, void *param);
+int         stmtExecAsyncDone(TAOS_STMT *stmt, TAOS_RES **pRes);
 const char *stmtErrstr(TAOS_STMT *stmt);
 int         stmtAffectedRows(TAOS_STMT *stmt);
 int         stmtAffectedRowsOnce(TAOS_STMT *stmt);
@@ -165,6 +195,9 @@ int         stmtGetParam(TAOS_STMT *stmt, int idx, int *type, int *bytes);
 int         stmtAddBatch(TAOS_STMT *stmt);
 TAOS_RES   *stmtUseResult(TAOS_STMT *stmt);
 int         stmtBindBatch(TAOS_STMT *stmt, TAOS_MULTI_BIND *bind, int32_t colIdx);
+int         stmtSetAutoBatch(TAOS_STMT *stmt, int32_t maxRows, int32_t maxDelayMs, int32_t maxInflight);
+int         stmtFlush(TAOS_STMT *stmt);
+int         stmtGetVgStats(TAOS_STMT *stmt, TAOS_STMT_VG_STAT *stats, int32_t maxNum);
 
 #ifdef __cplusplus
 }
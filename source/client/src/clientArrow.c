@@ -0,0 +1,742 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "clientInt.h"
+#include "clientLog.h"
+
+// The result is written as an arrow IPC stream: the schema, then a record batch for each block, preceded by the
+// dictionary batches of the values new to the dictionaries, then the end of stream marker. The fixed length values
+// of a block are in the arrow layout already and are written from the block itself, only the validity bitmaps, the
+// bool bits and the dictionary indices are built. The binary and nchar columns are dictionary encoded, the values
+// seen are kept until the export is done, the later batches only send the new ones as deltas.
+//
+// The messages are flatbuffers, built here from the back as the flatbuffers library does, little endian only.
+
+#define ARROW_FB_MAX_SLOTS 8
+
+#define ARROW_METADATA_V5       4
+#define ARROW_HEADER_SCHEMA     1
+#define ARROW_HEADER_DICTIONARY 2
+#define ARROW_HEADER_RECORD     3
+
+#define ARROW_TYPE_INT       2
+#define ARROW_TYPE_FLOAT     3
+#define ARROW_TYPE_UTF8      5
+#define ARROW_TYPE_BOOL      6
+#define ARROW_TYPE_TIMESTAMP 10
+
+#define ARROW_PRECISION_SINGLE 1
+#define ARROW_PRECISION_DOUBLE 2
+
+#define ARROW_COL_FIXED 0
+#define ARROW_COL_BOOL  1
+#define ARROW_COL_DICT  2
+
+typedef struct SFbBuilder {
+  char   *buf;
+  int32_t cap;
+  int32_t used;  // the bytes built, at the end of buf
+  int32_t minAlign;
+  int32_t tableStart;
+  int32_t numOfSlots;
+  int32_t slots[ARROW_FB_MAX_SLOTS];  // the end of the fields of the table being built
+  int32_t code;
+} SFbBuilder;
+
+typedef struct SArrowBuffer {
+  int64_t offset;
+  int64_t length;
+} SArrowBuffer;
+
+typedef struct SArrowFieldNode {
+  int64_t length;
+  int64_t nullCount;
+} SArrowFieldNode;
+
+typedef struct SArrowColumn {
+  int8_t    kind;
+  int32_t   nullCount;
+  uint8_t  *validity;
+  char     *values;  // the bool bits or the dictionary indices
+  SHashObj *pDict;   // value -> index
+  int32_t   dictSize;
+  int32_t   emptyIdx;  // the empty string can not be a hash key
+  bool      dictWritten;
+  int32_t  *deltaOffsets;  // the values added to the dictionary by the current block
+  int32_t   deltaNum;
+  int32_t   deltaCap;
+  char     *deltaData;
+  int32_t   deltaLen;
+  int32_t   deltaDataCap;
+} SArrowColumn;
+
+struct SArrowWriter {
+  __taos_arrow_write_fn_t fp;
+  void                   *param;
+  TAOS_FIELD             *fields;
+  int32_t                 numOfCols;
+  int32_t                 precision;
+  SArrowColumn           *pCols;
+  int32_t                 capacity;  // rows of the column buffers
+  char                   *convertBuf;
+  int32_t                 convertCap;
+  SFbBuilder              fb;
+  const void            **pBufData;
+  SArrowBuffer           *pBufs;
+  SArrowFieldNode        *pNodes;
+  int32_t                 numOfBufs;
+  int64_t                 bodyLen;
+};
+
+static const char zeroPad[8] = {0};
+
+static void fbReset(SFbBuilder *pFb) {
+  pFb->used = 0;
+  pFb->minAlign = 1;
+  pFb->code = TSDB_CODE_SUCCESS;
+}
+
+static bool fbEnsure(SFbBuilder *pFb, int32_t len) {
+  if (pFb->code != TSDB_CODE_SUCCESS) {
+    return false;
+  }
+  if (pFb->used + len <= pFb->cap) {
+    return true;
+  }
+
+  int32_t cap = TMAX(pFb->cap * 2, pFb->used + len + 256);
+  char   *buf = taosMemoryMalloc(cap);
+  if (buf == NULL) {
+    pFb->code = TSDB_CODE_OUT_OF_MEMORY;
+    return false;
+  }
+  if (pFb->used > 0) {
+    memcpy(buf + cap - pFb->used, pFb->buf + pFb->cap - pFb->used, pFb->used);
+  }
+  taosMemoryFree(pFb->buf);
+  pFb->buf = buf;
+  pFb->cap = cap;
+  return true;
+}
+
+// zeros are pushed when p is NULL
+static void fbPush(SFbBuilder *pFb, const void *p, int32_t len) {
+  if (!fbEnsure(pFb, len)) {
+    return;
+  }
+  pFb->used += len;
+  if (p != NULL) {
+    memcpy(pFb->buf + pFb->cap - pFb->used, p, len);
+  } else {
+    memset(pFb->buf + pFb->cap - pFb->used, 0, len);
+  }
+}
+
+// pads so that the next additional bytes end aligned to size
+static void fbPrep(SFbBuilder *pFb, int32_t size, int32_t additional) {
+  pFb->minAlign = TMAX(pFb->minAlign, size);
+  fbPush(pFb, NULL, (~(pFb->used + additional) + 1) & (size - 1));
+}
+
+static void fbStartTable(SFbBuilder *pFb, int32_t numOfSlots) {
+  memset(pFb->slots, 0, sizeof(pFb->slots));
+  pFb->numOfSlots = numOfSlots;
+  pFb->tableStart = pFb->used;
+}
+
+static void fbAddField(SFbBuilder *pFb, int32_t slot, const void *p, int32_t size) {
+  fbPrep(pFb, size, 0);
+  fbPush(pFb, p, size);
+  pFb->slots[slot] = pFb->used;
+}
+
+#define FB_ADD(_fb, _slot, _type, _v)                 \
+  do {                                                \
+    _type _val = (_v);                                \
+    fbAddField((_fb), (_slot), &_val, sizeof(_type)); \
+  } while (0)
+
+static void fbAddOffset(SFbBuilder *pFb, int32_t slot, int32_t off) {
+  fbPrep(pFb, sizeof(uint32_t), 0);
+  uint32_t v = pFb->used + sizeof(uint32_t) - off;
+  fbPush(pFb, &v, sizeof(uint32_t));
+  pFb->slots[slot] = pFb->used;
+}
+
+// the vtable is put right before the table, it is not shared
+static int32_t fbEndTable(SFbBuilder *pFb) {
+  fbPrep(pFb, sizeof(int32_t), 0);
+  fbPush(pFb, NULL, sizeof(int32_t));
+  int32_t table = pFb->used;
+
+  int32_t n = pFb->numOfSlots;
+  while (n > 0 && pFb->slots[n - 1] == 0) {
+    n--;
+  }
+  for (int32_t i = n - 1; i >= 0; --i) {
+    uint16_t off = (pFb->slots[i] != 0) ? (uint16_t)(table - pFb->slots[i]) : 0;
+    fbPush(pFb, &off, sizeof(uint16_t));
+  }
+  uint16_t size = (uint16_t)(table - pFb->tableStart);
+  fbPush(pFb, &size, sizeof(uint16_t));
+  size = (uint16_t)((n + 2) * sizeof(uint16_t));
+  fbPush(pFb, &size, sizeof(uint16_t));
+
+  if (pFb->code != TSDB_CODE_SUCCESS) {
+    return 0;
+  }
+  int32_t vtable = pFb->used - table;
+  memcpy(pFb->buf + pFb->cap - table, &vtable, sizeof(int32_t));
+  return table;
+}
+
+static int32_t fbCreateVector(SFbBuilder *pFb, const void *p, int32_t elemSize, int32_t num, int32_t align) {
+  fbPrep(pFb, sizeof(uint32_t), elemSize * num);
+  fbPrep(pFb, align, elemSize * num);
+  fbPush(pFb, p, elemSize * num);
+  uint32_t n = num;
+  fbPush(pFb, &n, sizeof(uint32_t));
+  return pFb->used;
+}
+
+static int32_t fbCreateOffsetVector(SFbBuilder *pFb, const int32_t *offs, int32_t num) {
+  fbPrep(pFb, sizeof(uint32_t), sizeof(uint32_t) * num);
+  for (int32_t i = num - 1; i >= 0; --i) {
+    uint32_t v = pFb->used + sizeof(uint32_t) - offs[i];
+    fbPush(pFb, &v, sizeof(uint32_t));
+  }
+  uint32_t n = num;
+  fbPush(pFb, &n, sizeof(uint32_t));
+  return pFb->used;
+}
+
+static int32_t fbCreateString(SFbBuilder *pFb, const char *str, int32_t len) {
+  fbPrep(pFb, sizeof(uint32_t), len + 1);
+  fbPush(pFb, NULL, 1);
+  fbPush(pFb, str, len);
+  uint32_t n = len;
+  fbPush(pFb, &n, sizeof(uint32_t));
+  return pFb->used;
+}
+
+static int32_t fbFinish(SFbBuilder *pFb, int32_t root) {
+  fbPrep(pFb, pFb->minAlign, sizeof(uint32_t));
+  uint32_t v = pFb->used + sizeof(uint32_t) - root;
+  fbPush(pFb, &v, sizeof(uint32_t));
+  return pFb->code;
+}
+
+static int32_t arrowWrite(SArrowWriter *pWriter, const void *data, int64_t len) {
+  if (len <= 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+  int32_t code = pWriter->fp(pWriter->param, data, len);
+  if (code != TSDB_CODE_SUCCESS) {
+    tscError("failed to write %" PRId64 " bytes of the arrow stream, code:%d", len, code);
+  }
+  return code;
+}
+
+static void arrowResetBody(SArrowWriter *pWriter) {
+  pWriter->numOfBufs = 0;
+  pWriter->bodyLen = 0;
+}
+
+static void arrowAddBuffer(SArrowWriter *pWriter, const void *data, int64_t len) {
+  SArrowBuffer *pBuf = &pWriter->pBufs[pWriter->numOfBufs];
+  pBuf->offset = pWriter->bodyLen;
+  pBuf->length = len;
+  pWriter->pBufData[pWriter->numOfBufs++] = data;
+  pWriter->bodyLen += ALIGN8(len);
+}
+
+// the message header is the last object built, the body is made of the buffers added
+static int32_t arrowWriteMessage(SArrowWriter *pWriter, uint8_t headerType, int32_t header) {
+  SFbBuilder *pFb = &pWriter->fb;
+
+  fbStartTable(pFb, 4);
+  FB_ADD(pFb, 3, int64_t, pWriter->bodyLen);
+  fbAddOffset(pFb, 2, header);
+  FB_ADD(pFb, 0, int16_t, ARROW_METADATA_V5);
+  FB_ADD(pFb, 1, uint8_t, headerType);
+  int32_t code = fbFinish(pFb, fbEndTable(pFb));
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  int32_t prefix[2] = {-1, ALIGN8(pFb->used)};
+  code = arrowWrite(pWriter, prefix, sizeof(prefix));
+  if (code == TSDB_CODE_SUCCESS) {
+    code = arrowWrite(pWriter, pFb->buf + pFb->cap - pFb->used, pFb->used);
+  }
+  if (code == TSDB_CODE_SUCCESS) {
+    code = arrowWrite(pWriter, zeroPad, prefix[1] - pFb->used);
+  }
+
+  for (int32_t i = 0; i < pWriter->numOfBufs && code == TSDB_CODE_SUCCESS; ++i) {
+    int64_t len = pWriter->pBufs[i].length;
+    code = arrowWrite(pWriter, pWriter->pBufData[i], len);
+    if (code == TSDB_CODE_SUCCESS) {
+      code = arrowWrite(pWriter, zeroPad, ALIGN8(len) - len);
+    }
+  }
+  return code;
+}
+
+static int32_t arrowBuildRecordBatch(SArrowWriter *pWriter, int64_t length, int32_t numOfNodes) {
+  SFbBuilder *pFb = &pWriter->fb;
+
+  int32_t buffers = fbCreateVector(pFb, pWriter->pBufs, sizeof(SArrowBuffer), pWriter->numOfBufs, sizeof(int64_t));
+  int32_t nodes = fbCreateVector(pFb, pWriter->pNodes, sizeof(SArrowFieldNode), numOfNodes, sizeof(int64_t));
+  fbStartTable(pFb, 3);
+  FB_ADD(pFb, 0, int64_t, length);
+  fbAddOffset(pFb, 1, nodes);
+  fbAddOffset(pFb, 2, buffers);
+  return fbEndTable(pFb);
+}
+
+static int32_t arrowBuildIntType(SFbBuilder *pFb, int32_t bitWidth, bool isSigned) {
+  fbStartTable(pFb, 2);
+  FB_ADD(pFb, 0, int32_t, bitWidth);
+  FB_ADD(pFb, 1, uint8_t, isSigned);
+  return fbEndTable(pFb);
+}
+
+static int32_t arrowBuildType(SArrowWriter *pWriter, int8_t type, uint8_t *typeType) {
+  SFbBuilder *pFb = &pWriter->fb;
+
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+      *typeType = ARROW_TYPE_BOOL;
+      fbStartTable(pFb, 0);
+      return fbEndTable(pFb);
+    case TSDB_DATA_TYPE_TINYINT:
+    case TSDB_DATA_TYPE_SMALLINT:
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_BIGINT:
+      *typeType = ARROW_TYPE_INT;
+      return arrowBuildIntType(pFb, tDataTypes[type].bytes * 8, true);
+    case TSDB_DATA_TYPE_UTINYINT:
+    case TSDB_DATA_TYPE_USMALLINT:
+    case TSDB_DATA_TYPE_UINT:
+    case TSDB_DATA_TYPE_UBIGINT:
+      *typeType = ARROW_TYPE_INT;
+      return arrowBuildIntType(pFb, tDataTypes[type].bytes * 8, false);
+    case TSDB_DATA_TYPE_FLOAT:
+    case TSDB_DATA_TYPE_DOUBLE:
+      *typeType = ARROW_TYPE_FLOAT;
+      fbStartTable(pFb, 1);
+      FB_ADD(pFb, 0, int16_t, (type == TSDB_DATA_TYPE_FLOAT) ? ARROW_PRECISION_SINGLE : ARROW_PRECISION_DOUBLE);
+      return fbEndTable(pFb);
+    case TSDB_DATA_TYPE_TIMESTAMP: {
+      // the arrow units from milli second on follow the order of the precisions
+      *typeType = ARROW_TYPE_TIMESTAMP;
+      int32_t tz = fbCreateString(pFb, "UTC", 3);
+      fbStartTable(pFb, 2);
+      FB_ADD(pFb, 0, int16_t, pWriter->precision + 1);
+      fbAddOffset(pFb, 1, tz);
+      return fbEndTable(pFb);
+    }
+    default:
+      *typeType = ARROW_TYPE_UTF8;
+      fbStartTable(pFb, 0);
+      return fbEndTable(pFb);
+  }
+}
+
+static int32_t arrowBuildField(SArrowWriter *pWriter, int32_t idx) {
+  SFbBuilder *pFb = &pWriter->fb;
+  TAOS_FIELD *pField = &pWriter->fields[idx];
+
+  int32_t name = fbCreateString(pFb, pField->name, strlen(pField->name));
+  int32_t children = fbCreateOffsetVector(pFb, NULL, 0);
+  int32_t dict = 0;
+  if (pWriter->pCols[idx].kind == ARROW_COL_DICT) {
+    int32_t indexType = arrowBuildIntType(pFb, 32, true);
+    fbStartTable(pFb, 4);
+    FB_ADD(pFb, 0, int64_t, idx);
+    fbAddOffset(pFb, 1, indexType);
+    dict = fbEndTable(pFb);
+  }
+  uint8_t typeType = 0;
+  int32_t type = arrowBuildType(pWriter, pField->type, &typeType);
+
+  fbStartTable(pFb, 7);
+  fbAddOffset(pFb, 0, name);
+  fbAddOffset(pFb, 3, type);
+  if (dict != 0) {
+    fbAddOffset(pFb, 4, dict);
+  }
+  fbAddOffset(pFb, 5, children);
+  FB_ADD(pFb, 1, uint8_t, 1);
+  FB_ADD(pFb, 2, uint8_t, typeType);
+  return fbEndTable(pFb);
+}
+
+static int32_t arrowWriteSchema(SArrowWriter *pWriter) {
+  SFbBuilder *pFb = &pWriter->fb;
+
+  int32_t *pFields = taosMemoryMalloc(pWriter->numOfCols * sizeof(int32_t));
+  if (pFields == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  fbReset(pFb);
+  for (int32_t i = 0; i < pWriter->numOfCols; ++i) {
+    pFields[i] = arrowBuildField(pWriter, i);
+  }
+  int32_t fields = fbCreateOffsetVector(pFb, pFields, pWriter->numOfCols);
+  taosMemoryFree(pFields);
+
+  fbStartTable(pFb, 4);
+  fbAddOffset(pFb, 1, fields);
+  FB_ADD(pFb, 0, int16_t, 0);  // little endian
+  int32_t schema = fbEndTable(pFb);
+
+  arrowResetBody(pWriter);
+  return arrowWriteMessage(pWriter, ARROW_HEADER_SCHEMA, schema);
+}
+
+// the delta of the first batch replaces the empty dictionary
+static int32_t arrowWriteDictionary(SArrowWriter *pWriter, int32_t idx) {
+  SArrowColumn *pCol = &pWriter->pCols[idx];
+  SFbBuilder   *pFb = &pWriter->fb;
+
+  arrowResetBody(pWriter);
+  pWriter->pNodes[0].length = pCol->deltaNum;
+  pWriter->pNodes[0].nullCount = 0;
+  arrowAddBuffer(pWriter, NULL, 0);
+  arrowAddBuffer(pWriter, pCol->deltaOffsets, (pCol->deltaNum + 1) * sizeof(int32_t));
+  arrowAddBuffer(pWriter, pCol->deltaData, pCol->deltaLen);
+
+  fbReset(pFb);
+  int32_t data = arrowBuildRecordBatch(pWriter, pCol->deltaNum, 1);
+  fbStartTable(pFb, 3);
+  FB_ADD(pFb, 0, int64_t, idx);
+  fbAddOffset(pFb, 1, data);
+  FB_ADD(pFb, 2, uint8_t, pCol->dictWritten);
+  int32_t code = arrowWriteMessage(pWriter, ARROW_HEADER_DICTIONARY, fbEndTable(pFb));
+
+  pCol->dictWritten = true;
+  pCol->deltaNum = 0;
+  pCol->deltaLen = 0;
+  return code;
+}
+
+static int32_t arrowAppendDelta(SArrowColumn *pCol, const char *val, int32_t len) {
+  if (pCol->deltaNum + 2 > pCol->deltaCap) {
+    int32_t  cap = TMAX(pCol->deltaCap * 2, 64);
+    int32_t *p = taosMemoryRealloc(pCol->deltaOffsets, cap * sizeof(int32_t));
+    if (p == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    pCol->deltaOffsets = p;
+    pCol->deltaCap = cap;
+  }
+  if (pCol->deltaLen + len > pCol->deltaDataCap) {
+    int32_t cap = TMAX(pCol->deltaDataCap * 2, pCol->deltaLen + len + 1024);
+    char   *p = taosMemoryRealloc(pCol->deltaData, cap);
+    if (p == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    pCol->deltaData = p;
+    pCol->deltaDataCap = cap;
+  }
+
+  memcpy(pCol->deltaData + pCol->deltaLen, val, len);
+  pCol->deltaLen += len;
+  pCol->deltaOffsets[0] = 0;
+  pCol->deltaOffsets[++pCol->deltaNum] = pCol->deltaLen;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t arrowGetDictIndex(SArrowColumn *pCol, const char *val, int32_t len, int32_t *pIndex) {
+  int32_t *pIdx = (len == 0) ? ((pCol->emptyIdx >= 0) ? &pCol->emptyIdx : NULL) : taosHashGet(pCol->pDict, val, len);
+  if (pIdx != NULL) {
+    *pIndex = *pIdx;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t code = arrowAppendDelta(pCol, val, len);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+  if (len == 0) {
+    pCol->emptyIdx = pCol->dictSize;
+  } else if (taosHashPut(pCol->pDict, val, len, &pCol->dictSize, sizeof(int32_t)) != 0) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  *pIndex = pCol->dictSize++;
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t arrowFillDictColumn(SArrowWriter *pWriter, SReqResultInfo *pResultInfo, int32_t idx, int32_t start,
+                                   int32_t numOfRows) {
+  SArrowColumn  *pCol = &pWriter->pCols[idx];
+  SResultColumn *pResCol = &pResultInfo->pCol[idx];
+  int32_t        type = pResultInfo->fields[idx].type;
+  bool           allNull = IS_VAR_NULL_TYPE(type, pResultInfo->fields[idx].bytes);
+  bool           convert = (type == TSDB_DATA_TYPE_NCHAR) && !pResultInfo->convertUcs4;
+  int32_t       *indices = (int32_t *)pCol->values;
+
+  for (int32_t j = 0; j < numOfRows; ++j) {
+    if (allNull || pResCol->offset[start + j] == -1) {
+      indices[j] = 0;
+      pCol->nullCount++;
+      continue;
+    }
+
+    char   *pStart = pResCol->pData + pResCol->offset[start + j];
+    char   *val = varDataVal(pStart);
+    int32_t len = varDataLen(pStart);
+    if (convert) {
+      if (len + 1 > pWriter->convertCap) {
+        char *p = taosMemoryRealloc(pWriter->convertBuf, len + 1);
+        if (p == NULL) {
+          return TSDB_CODE_OUT_OF_MEMORY;
+        }
+        pWriter->convertBuf = p;
+        pWriter->convertCap = len + 1;
+      }
+      len = taosUcs4ToMbs((TdUcs4 *)val, len, pWriter->convertBuf);
+      if (len < 0) {
+        tscError("failed to convert ucs4 to mbs, row:%d, col:%d", start + j, idx);
+        return TSDB_CODE_TSC_INVALID_VALUE;
+      }
+      val = pWriter->convertBuf;
+    }
+
+    int32_t code = arrowGetDictIndex(pCol, val, len, &indices[j]);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+    pCol->validity[j >> NBIT] |= (1u << BitPos(j));
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+static int32_t arrowEnsureCapacity(SArrowWriter *pWriter, int32_t numOfRows) {
+  if (numOfRows <= pWriter->capacity) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  for (int32_t i = 0; i < pWriter->numOfCols; ++i) {
+    SArrowColumn *pCol = &pWriter->pCols[i];
+    uint8_t      *validity = taosMemoryRealloc(pCol->validity, BitmapLen(numOfRows));
+    if (validity == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    pCol->validity = validity;
+
+    if (pCol->kind != ARROW_COL_FIXED) {
+      int32_t size = (pCol->kind == ARROW_COL_BOOL) ? BitmapLen(numOfRows) : numOfRows * sizeof(int32_t);
+      char   *values = taosMemoryRealloc(pCol->values, size);
+      if (values == NULL) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+      pCol->values = values;
+    }
+  }
+
+  pWriter->capacity = numOfRows;
+  return TSDB_CODE_SUCCESS;
+}
+
+SArrowWriter *arrowWriterCreate(TAOS_FIELD *fields, int32_t numOfCols, int32_t precision, __taos_arrow_write_fn_t fp,
+                                void *param) {
+  SArrowWriter *pWriter = taosMemoryCalloc(1, sizeof(SArrowWriter));
+  if (pWriter == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  pWriter->fp = fp;
+  pWriter->param = param;
+  pWriter->fields = fields;
+  pWriter->numOfCols = numOfCols;
+  pWriter->precision = precision;
+  pWriter->pCols = taosMemoryCalloc(numOfCols, sizeof(SArrowColumn));
+  // a record batch has two buffers for each column, a dictionary batch has three
+  pWriter->pBufData = taosMemoryCalloc(numOfCols * 2 + 3, POINTER_BYTES);
+  pWriter->pBufs = taosMemoryCalloc(numOfCols * 2 + 3, sizeof(SArrowBuffer));
+  pWriter->pNodes = taosMemoryCalloc(numOfCols + 1, sizeof(SArrowFieldNode));
+  if (pWriter->pCols == NULL || pWriter->pBufData == NULL || pWriter->pBufs == NULL || pWriter->pNodes == NULL) {
+    arrowWriterDestroy(pWriter);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SArrowColumn *pCol = &pWriter->pCols[i];
+    if (fields[i].type == TSDB_DATA_TYPE_BOOL) {
+      pCol->kind = ARROW_COL_BOOL;
+    } else if (IS_VAR_DATA_TYPE(fields[i].type)) {
+      pCol->kind = ARROW_COL_DICT;
+      pCol->emptyIdx = -1;
+      pCol->pDict = taosHashInit(1024, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
+      if (pCol->pDict == NULL) {
+        arrowWriterDestroy(pWriter);
+        terrno = TSDB_CODE_OUT_OF_MEMORY;
+        return NULL;
+      }
+    } else {
+      pCol->kind = ARROW_COL_FIXED;
+    }
+  }
+
+  terrno = arrowWriteSchema(pWriter);
+  if (terrno != TSDB_CODE_SUCCESS) {
+    arrowWriterDestroy(pWriter);
+    return NULL;
+  }
+  return pWriter;
+}
+
+// writes the rows from the current one of the block
+int32_t arrowWriteBlock(SArrowWriter *pWriter, SReqResultInfo *pResultInfo) {
+  int32_t start = pResultInfo->current;
+  int32_t numOfRows = pResultInfo->numOfRows - start;
+  if (numOfRows <= 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t code = arrowEnsureCapacity(pWriter, numOfRows);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  for (int32_t i = 0; i < pWriter->numOfCols; ++i) {
+    SArrowColumn  *pCol = &pWriter->pCols[i];
+    SResultColumn *pResCol = &pResultInfo->pCol[i];
+
+    if (pCol->kind == ARROW_COL_DICT) {
+      memset(pCol->validity, 0, BitmapLen(numOfRows));
+      pCol->nullCount = 0;
+      code = arrowFillDictColumn(pWriter, pResultInfo, i, start, numOfRows);
+      if (code != TSDB_CODE_SUCCESS) {
+        return code;
+      }
+      if (pCol->deltaNum > 0 || !pCol->dictWritten) {
+        code = arrowWriteDictionary(pWriter, i);
+        if (code != TSDB_CODE_SUCCESS) {
+          return code;
+        }
+      }
+      continue;
+    }
+
+    pCol->nullCount = doFillValidity(pResCol->nullbitmap, start, numOfRows, pCol->validity);
+    if (pCol->kind == ARROW_COL_BOOL) {
+      memset(pCol->values, 0, BitmapLen(numOfRows));
+      for (int32_t j = 0; j < numOfRows; ++j) {
+        if (pResCol->pData[start + j]) {
+          pCol->values[j >> NBIT] |= (1u << BitPos(j));
+        }
+      }
+    }
+  }
+
+  arrowResetBody(pWriter);
+  for (int32_t i = 0; i < pWriter->numOfCols; ++i) {
+    SArrowColumn *pCol = &pWriter->pCols[i];
+    int32_t       bytes = pResultInfo->fields[i].bytes;
+
+    pWriter->pNodes[i].length = numOfRows;
+    pWriter->pNodes[i].nullCount = pCol->nullCount;
+    arrowAddBuffer(pWriter, pCol->validity, BitmapLen(numOfRows));
+    if (pCol->kind == ARROW_COL_FIXED) {
+      arrowAddBuffer(pWriter, pResultInfo->pCol[i].pData + (int64_t)start * bytes, (int64_t)numOfRows * bytes);
+    } else if (pCol->kind == ARROW_COL_BOOL) {
+      arrowAddBuffer(pWriter, pCol->values, BitmapLen(numOfRows));
+    } else {
+      arrowAddBuffer(pWriter, pCol->values, (int64_t)numOfRows * sizeof(int32_t));
+    }
+  }
+
+  fbReset(&pWriter->fb);
+  int32_t header = arrowBuildRecordBatch(pWriter, numOfRows, pWriter->numOfCols);
+  return arrowWriteMessage(pWriter, ARROW_HEADER_RECORD, header);
+}
+
+int32_t arrowWriterFinish(SArrowWriter *pWriter) {
+  int32_t eos[2] = {-1, 0};
+  return arrowWrite(pWriter, eos, sizeof(eos));
+}
+
+void arrowWriterDestroy(SArrowWriter *pWriter) {
+  if (pWriter == NULL) {
+    return;
+  }
+
+  for (int32_t i = 0; pWriter->pCols != NULL && i < pWriter->numOfCols; ++i) {
+    SArrowColumn *pCol = &pWriter->pCols[i];
+    taosMemoryFree(pCol->validity);
+    taosMemoryFree(pCol->values);
+    taosHashCleanup(pCol->pDict);
+    taosMemoryFree(pCol->deltaOffsets);
+    taosMemoryFree(pCol->deltaData);
+  }
+  taosMemoryFree(pWriter->pCols);
+  taosMemoryFree(pWriter->convertBuf);
+  taosMemoryFree(pWriter->fb.buf);
+  taosMemoryFree(pWriter->pBufData);
+  taosMemoryFree(pWriter->pBufs);
+  taosMemoryFree(pWriter->pNodes);
+  taosMemoryFree(pWriter);
+}
+
+int taos_export_arrow(TAOS_RES *res, __taos_arrow_write_fn_t fp, void *param) {
+  if (res == NULL || fp == NULL || !TD_RES_QUERY(res)) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  SRequestObj    *pRequest = (SRequestObj *)res;
+  SReqResultInfo *pResInfo = &pRequest->body.resInfo;
+  if (pRequest->code != TSDB_CODE_SUCCESS) {
+    return pRequest->code;
+  }
+  if (pResInfo->numOfCols <= 0 || pResInfo->fields == NULL) {
+    return TSDB_CODE_INVALID_PARA;
+  }
+
+  SArrowWriter *pWriter = arrowWriterCreate(pResInfo->fields, pResInfo->numOfCols, pResInfo->precision, fp, param);
+  if (pWriter == NULL) {
+    return terrno;
+  }
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  while (true) {
+    doAsyncFetchRows(pRequest, false, false);
+    if (pRequest->code != TSDB_CODE_SUCCESS) {
+      code = pRequest->code;
+      break;
+    }
+    if (pResInfo->numOfRows == 0) {
+      break;
+    }
+
+    code = arrowWriteBlock(pWriter, pResInfo);
+    if (code != TSDB_CODE_SUCCESS) {
+      break;
+    }
+    pResInfo->current = pResInfo->numOfRows;
+  }
+
+  if (code == TSDB_CODE_SUCCESS) {
+    code = arrowWriterFinish(pWriter);
+  }
+  arrowWriterDestroy(pWriter);
+  return code;
+}
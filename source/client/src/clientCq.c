@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "clientInt.h"
+#include "clientLog.h"
+#include "clientStmt.h"
+
+// A completion queue lets a few threads keep many requests in flight. The requests are submitted with the async
+// interfaces, their callbacks only queue the finished operation, and taos_cq_poll hands them to the app. The work
+// left after a request, e.g. the meta refresh of a stmt, is done in taos_cq_poll by the app thread, never in the
+// scheduler callback.
+
+typedef struct SCompletionQueue SCompletionQueue;
+
+typedef struct SCqOp {
+  TAOS_CQ_EVENT     event;
+  SCompletionQueue *pCq;
+} SCqOp;
+
+struct SCompletionQueue {
+  TdThreadMutex mutex;
+  TdThreadCond  cond;
+  SArray       *pDone;           // SArray<SCqOp*>, finished and not polled yet
+  int32_t       numOfInflight;  // submitted and not finished
+};
+
+static SCqOp *cqNewOp(SCompletionQueue *pCq, TAOS_CQ_OP op, void *userData) {
+  SCqOp *pOp = taosMemoryCalloc(1, sizeof(SCqOp));
+  if (pOp == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  pOp->pCq = pCq;
+  pOp->event.op = op;
+  pOp->event.userData = userData;
+
+  taosThreadMutexLock(&pCq->mutex);
+  pCq->numOfInflight++;
+  taosThreadMutexUnlock(&pCq->mutex);
+  return pOp;
+}
+
+static void cqPushOp(SCqOp *pOp) {
+  SCompletionQueue *pCq = pOp->pCq;
+
+  taosThreadMutexLock(&pCq->mutex);
+  if (taosArrayPush(pCq->pDone, &pOp) == NULL) {
+    tscError("failed to queue the finished op:%d, userData:%p", pOp->event.op, pOp->event.userData);
+  }
+  pCq->numOfInflight--;
+  taosThreadCondBroadcast(&pCq->cond);
+  taosThreadMutexUnlock(&pCq->mutex);
+}
+
+static void cqQueryCb(void *param, TAOS_RES *res, int code) {
+  SCqOp *pOp = param;
+  pOp->event.code = code;
+  pOp->event.res = res;
+  cqPushOp(pOp);
+}
+
+static void cqFetchCb(void *param, TAOS_RES *res, int numOfRows) {
+  SCqOp *pOp = param;
+  if (numOfRows < 0) {
+    pOp->event.code = numOfRows;
+  } else {
+    pOp->event.numOfRows = numOfRows;
+  }
+  pOp->event.res = res;
+  cqPushOp(pOp);
+}
+
+// runs in the app thread
+static void cqFinishEvent(TAOS_CQ_EVENT *pEvent) {
+  switch (pEvent->op) {
+    case TAOS_CQ_QUERY:
+    case TAOS_CQ_SCHEMALESS_INSERT:
+      if (pEvent->res != NULL && pEvent->code == TSDB_CODE_SUCCESS) {
+        pEvent->numOfRows = taos_affected_rows(pEvent->res);
+      }
+      break;
+    case TAOS_CQ_STMT_EXECUTE:
+      pEvent->code = stmtExecAsyncDone(pEvent->stmt, &pEvent->res);
+      if (pEvent->code == TSDB_CODE_SUCCESS) {
+        pEvent->numOfRows = taos_stmt_affected_rows_once(pEvent->stmt);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+TAOS_CQ *taos_cq_create() {
+  SCompletionQueue *pCq = taosMemoryCalloc(1, sizeof(SCompletionQueue));
+  if (pCq == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  pCq->pDone = taosArrayInit(64, POINTER_BYTES);
+  if (pCq->pDone == NULL) {
+    taosMemoryFree(pCq);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+  taosThreadMutexInit(&pCq->mutex, NULL);
+  taosThreadCondInit(&pCq->cond, NULL);
+  return pCq;
+}
+
+void taos_cq_destroy(TAOS_CQ *cq) {
+  SCompletionQueue *pCq = cq;
+  if (pCq == NULL) {
+    return;
+  }
+
+  // the callbacks of the requests in flight still use the queue
+  taosThreadMutexLock(&pCq->mutex);
+  while (pCq->numOfInflight > 0) {
+    taosThreadCondWait(&pCq->cond, &pCq->mutex);
+  }
+  taosThreadMutexUnlock(&pCq->mutex);
+
+  // the results never polled are released, the stmts are left to the app
+  for (int32_t i = 0; i < taosArrayGetSize(pCq->pDone); ++i) {
+    SCqOp *pOp = taosArrayGetP(pCq->pDone, i);
+    if (pOp->event.op == TAOS_CQ_STMT_EXECUTE) {
+      stmtExecAsyncDone(pOp->event.stmt, &pOp->event.res);
+    }
+    if (pOp->event.op != TAOS_CQ_FETCH) {
+      taos_free_result(pOp->event.res);
+    }
+    taosMemoryFree(pOp);
+  }
+
+  taosArrayDestroy(pCq->pDone);
+  taosThreadCondDestroy(&pCq->cond);
+  taosThreadMutexDestroy(&pCq->mutex);
+  taosMemoryFree(pCq);
+}
+
+int taos_cq_query(TAOS_CQ *cq, TAOS *taos, const char *sql, void *userData) {
+  if (cq == NULL || taos == NULL || sql == NULL) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  SCqOp *pOp = cqNewOp(cq, TAOS_CQ_QUERY, userData);
+  if (pOp == NULL) {
+    return terrno;
+  }
+  taos_query_a(taos, sql, cqQueryCb, pOp);
+  return TSDB_CODE_SUCCESS;
+}
+
+int taos_cq_fetch(TAOS_CQ *cq, TAOS_RES *res, void *userData) {
+  if (cq == NULL || res == NULL || !TD_RES_QUERY(res)) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  SCqOp *pOp = cqNewOp(cq, TAOS_CQ_FETCH, userData);
+  if (pOp == NULL) {
+    return terrno;
+  }
+  taos_fetch_rows_a(res, cqFetchCb, pOp);
+  return TSDB_CODE_SUCCESS;
+}
+
+int taos_cq_stmt_execute(TAOS_CQ *cq, TAOS_STMT *stmt, void *userData) {
+  if (cq == NULL || stmt == NULL) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  SCqOp *pOp = cqNewOp(cq, TAOS_CQ_STMT_EXECUTE, userData);
+  if (pOp == NULL) {
+    return terrno;
+  }
+  pOp->event.stmt = stmt;
+
+  int32_t code = stmtExecAsync(stmt, cqQueryCb, pOp);
+  if (code != TSDB_CODE_SUCCESS) {
+    // nothing is submitted, the op is not queued
+    taosThreadMutexLock(&pOp->pCq->mutex);
+    pOp->pCq->numOfInflight--;
+    taosThreadCondBroadcast(&pOp->pCq->cond);
+    taosThreadMutexUnlock(&pOp->pCq->mutex);
+    taosMemoryFree(pOp);
+  }
+  return code;
+}
+
+int taos_cq_schemaless_insert(TAOS_CQ *cq, TAOS *taos, char *lines[], int numLines, int protocol, int precision,
+                              void *userData) {
+  if (cq == NULL || taos == NULL) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  SCqOp *pOp = cqNewOp(cq, TAOS_CQ_SCHEMALESS_INSERT, userData);
+  if (pOp == NULL) {
+    return terrno;
+  }
+  smlInsertAsync(taos, lines, numLines, protocol, precision, cqQueryCb, pOp);
+  return TSDB_CODE_SUCCESS;
+}
+
+int taos_cq_poll(TAOS_CQ *cq, TAOS_CQ_EVENT *events, int maxEvents, int timeout) {
+  SCompletionQueue *pCq = cq;
+  if (pCq == NULL || events == NULL || maxEvents <= 0) {
+    terrno = TSDB_CODE_INVALID_PARA;
+    return -1;
+  }
+
+  struct timespec endTs = {0};
+  if (timeout > 0) {
+    taosClockGetTime(CLOCK_REALTIME, &endTs);
+    int64_t nsec = endTs.tv_nsec + (timeout % 1000) * 1000000LL;
+    endTs.tv_sec += timeout / 1000 + nsec / 1000000000LL;
+    endTs.tv_nsec = nsec % 1000000000LL;
+  }
+
+  taosThreadMutexLock(&pCq->mutex);
+  while (taosArrayGetSize(pCq->pDone) == 0 && pCq->numOfInflight > 0 && timeout != 0) {
+    if (timeout < 0) {
+      taosThreadCondWait(&pCq->cond, &pCq->mutex);
+    } else if (taosThreadCondTimedWait(&pCq->cond, &pCq->mutex, &endTs) != 0) {
+      break;
+    }
+  }
+
+  // the events are stored first and finished after the lock is released
+  int32_t num = TMIN(maxEvents, (int32_t)taosArrayGetSize(pCq->pDone));
+  for (int32_t i = 0; i < num; ++i) {
+    SCqOp *pOp = taosArrayGetP(pCq->pDone, i);
+    events[i] = pOp->event;
+    taosMemoryFree(pOp);
+  }
+  taosArrayPopFrontBatch(pCq->pDone, num);
+  taosThreadMutexUnlock(&pCq->mutex);
+
+  for (int32_t i = 0; i < num; ++i) {
+    cqFinishEvent(&events[i]);
+  }
+  return num;
+}
@@ -231,6 +231,8 @@ void destroyTscObj(void *pObj) {
   if (0 == connNum) {
     destroyAppInst(pTscObj->pAppInfo);
   }
+  smlDestroyCache(pTscObj->smlCache);
+  qDestroyInsertCache(pTscObj->insertCache);
   taosThreadMutexDestroy(&pTscObj->mutex);
   taosMemoryFree(pTscObj);
 
@@ -260,6 +262,9 @@ void *createTscObj(const char *user, const char *auth, const char *db, int32_t c
     tstrncpy(pObj->db, db, tListLen(pObj->db));
   }
 
+  // the INSERT statements are parsed without the cache if it is not created
+  pObj->insertCache = qCreateInsertCache();
+
   taosThreadMutexInit(&pObj->mutex, NULL);
   pObj->id = taosAddRef(clientConnRefPool, pObj);
   pObj->schemalessType = 1;
@@ -236,7 +236,8 @@ int32_t parseSql(SRequestObj* pRequest, bool topicQuery, SQuery** pQuery, SStmtC
                        .isSuperUser = (0 == strcmp(pTscObj->user, TSDB_DEFAULT_USER)),
                        .enableSysInfo = pTscObj->sysInfo,
                        .svrVer = pTscObj->sVer,
-                       .nodeOffline = (pTscObj->pAppInfo->onlineDnodes < pTscObj->pAppInfo->totalDnodes)};
+                       .nodeOffline = (pTscObj->pAppInfo->onlineDnodes < pTscObj->pAppInfo->totalDnodes),
+                       .pInsertCache = pTscObj->insertCache};
 
   cxt.mgmtEpSet = getEpSet_s(&pTscObj->pAppInfo->mgmtEp);
   int32_t code = catalogGetHandle(pTscObj->pAppInfo->clusterId, &cxt.pCatalog);
@@ -908,7 +909,8 @@ void schedulerExecCb(SExecResult* pResult, void* param, int32_t code) {
   tscDebug("0x%" PRIx64 " enter scheduler exec cb, code:%s, reqId:0x%" PRIx64, pRequest->self, tstrerror(code),
            pRequest->requestId);
 
-  if (code != TSDB_CODE_SUCCESS && NEED_CLIENT_HANDLE_ERROR(code) && pRequest->sqlstr != NULL) {
+  if (code != TSDB_CODE_SUCCESS && NEED_CLIENT_HANDLE_ERROR(code) && pRequest->sqlstr != NULL &&
+      !pRequest->isStmtBind) {
     tscDebug("0x%" PRIx64 " client retry to handle the error, code:%s, tryCount:%d, reqId:0x%" PRIx64, pRequest->self,
              tstrerror(code), pRequest->retry, pRequest->requestId);
     pRequest->prevCode = code;
@@ -1144,6 +1146,8 @@ int32_t refreshMeta(STscObj* pTscObj, SRequestObj* pRequest) {
     return code;
   }
 
+  qClearInsertCache(pTscObj->insertCache);
+
   SRequestConnInfo conn = {.pTrans = pTscObj->pAppInfo->pTransporter,
                            .requestId = pRequest->requestId,
                            .requestObjRefId = pRequest->self,
@@ -1182,6 +1186,9 @@ int32_t removeMeta(STscObj* pTscObj, SArray* tbList) {
     SName* pTbName = taosArrayGet(tbList, i);
     catalogRemoveTableMeta(pCatalog, pTbName);
   }
+  if (tbNum > 0) {
+    qClearInsertCache(pTscObj->insertCache);
+  }
 
   return TSDB_CODE_SUCCESS;
 }
@@ -1498,6 +1505,135 @@ void doSetOneRowPtr(SReqResultInfo* pResultInfo) {
   }
 }
 
+static FORCE_INLINE uint8_t doReverseBits(uint8_t b) {
+  b = (b & 0xF0) >> 4 | (b & 0x0F) << 4;
+  b = (b & 0xCC) >> 2 | (b & 0x33) << 2;
+  return (b & 0xAA) >> 1 | (b & 0x55) << 1;
+}
+
+// The null bitmap of a block has the bits of the null rows set, the highest bit first. The validity bitmap has the
+// bits of the rows not null set, the lowest bit first.
+int32_t doFillValidity(const char* nullbitmap, int32_t start, int32_t numOfRows, uint8_t* validity) {
+  int32_t nulls = 0;
+  int32_t i = 0;
+
+  if (BitPos(start) == 0) {
+    const uint8_t* pBitmap = (const uint8_t*)nullbitmap + (start >> NBIT);
+    for (; i + 8 <= numOfRows; i += 8) {
+      uint8_t b = pBitmap[i >> NBIT];
+      validity[i >> NBIT] = ~doReverseBits(b);
+      for (; b != 0; b &= b - 1) {
+        nulls++;
+      }
+    }
+  }
+
+  for (; i < numOfRows; ++i) {
+    if (colDataIsNull_f(nullbitmap, start + i)) {
+      validity[i >> NBIT] &= ~(1u << BitPos(i));
+      nulls++;
+    } else {
+      validity[i >> NBIT] |= (1u << BitPos(i));
+    }
+  }
+
+  return nulls;
+}
+
+static int32_t doFillVarColumn(SReqResultInfo* pResultInfo, int32_t idx, int32_t start, int32_t numOfRows,
+                               TAOS_COLUMN_BUF* pBuf) {
+  SResultColumn* pCol = &pResultInfo->pCol[idx];
+  int32_t        type = pResultInfo->fields[idx].type;
+  bool           allNull = IS_VAR_NULL_TYPE(type, pResultInfo->fields[idx].bytes);
+  char*          pDst = pBuf->data;
+  int32_t        len = 0;
+
+  memset(pBuf->validity, 0, BitmapLen(numOfRows));
+  pBuf->nullCount = 0;
+  pBuf->offsets[0] = 0;
+
+  for (int32_t j = 0; j < numOfRows; ++j) {
+    if (allNull || pCol->offset[start + j] == -1) {
+      pBuf->nullCount++;
+    } else {
+      char* pStart = pCol->pData + pCol->offset[start + j];
+      if (type == TSDB_DATA_TYPE_NCHAR && !pResultInfo->convertUcs4) {
+        int32_t n = taosUcs4ToMbs((TdUcs4*)varDataVal(pStart), varDataLen(pStart), pDst + len);
+        if (n < 0) {
+          tscError("failed to convert ucs4 to mbs, row:%d, col:%d", start + j, idx);
+          return TSDB_CODE_TSC_INVALID_VALUE;
+        }
+        len += n;
+      } else {
+        memcpy(pDst + len, varDataVal(pStart), varDataLen(pStart));
+        len += varDataLen(pStart);
+      }
+      pBuf->validity[j >> NBIT] |= (1u << BitPos(j));
+    }
+    pBuf->offsets[j + 1] = len;
+  }
+
+  pBuf->length = len;
+  return TSDB_CODE_SUCCESS;
+}
+
+// Copies the rows from the current one of the block into the buffers of the app, as many as fit into all of them.
+// Neither the row pointers nor the converted nchar columns of the row interfaces are built.
+int32_t doFillColumns(SReqResultInfo* pResultInfo, TAOS_COLUMN_BUF* cols, int32_t maxRows) {
+  int32_t start = pResultInfo->current;
+  int32_t numOfRows = TMIN(maxRows, (int32_t)(pResultInfo->numOfRows - start));
+
+  for (int32_t i = 0; i < pResultInfo->numOfCols && numOfRows > 0; ++i) {
+    SResultColumn* pCol = &pResultInfo->pCol[i];
+    int32_t        type = pResultInfo->fields[i].type;
+    int32_t        bytes = pResultInfo->fields[i].bytes;
+
+    if (!IS_VAR_DATA_TYPE(type)) {
+      numOfRows = TMIN(numOfRows, cols[i].capacity / bytes);
+    } else if (!IS_VAR_NULL_TYPE(type, bytes)) {
+      // the converted nchar is never longer than the ucs4 one
+      int64_t len = 0;
+      for (int32_t j = 0; j < numOfRows; ++j) {
+        if (pCol->offset[start + j] != -1) {
+          len += varDataLen(pCol->pData + pCol->offset[start + j]);
+        }
+        if (len > cols[i].capacity) {
+          numOfRows = j;
+          break;
+        }
+      }
+    }
+  }
+
+  if (numOfRows <= 0) {
+    if (start < pResultInfo->numOfRows) {
+      tscError("the column buffers are too small for one row");
+      return TSDB_CODE_INVALID_PARA;
+    }
+    return 0;
+  }
+
+  for (int32_t i = 0; i < pResultInfo->numOfCols; ++i) {
+    SResultColumn*   pCol = &pResultInfo->pCol[i];
+    TAOS_COLUMN_BUF* pBuf = &cols[i];
+    int32_t          bytes = pResultInfo->fields[i].bytes;
+
+    if (IS_VAR_DATA_TYPE(pResultInfo->fields[i].type)) {
+      int32_t code = doFillVarColumn(pResultInfo, i, start, numOfRows, pBuf);
+      if (code != TSDB_CODE_SUCCESS) {
+        return code;
+      }
+    } else {
+      pBuf->nullCount = doFillValidity(pCol->nullbitmap, start, numOfRows, pBuf->validity);
+      pBuf->length = numOfRows * bytes;
+      memcpy(pBuf->data, pCol->pData + (int64_t)start * bytes, pBuf->length);
+    }
+  }
+
+  pResultInfo->current += numOfRows;
+  return numOfRows;
+}
+
 void* doFetchRows(SRequestObj* pRequest, bool setupOneRowPtr, bool convertUcs4) {
   assert(pRequest != NULL);
 
@@ -571,6 +571,47 @@ int taos_fetch_block_s(TAOS_RES *res, int *numOfRows, TAOS_ROW *rows) {
   }
 }
 
+int taos_fetch_columns(TAOS_RES *res, TAOS_COLUMN_BUF *cols, int numOfCols, int maxRows) {
+  if (res == NULL || cols == NULL || maxRows <= 0 || !TD_RES_QUERY(res)) {
+    tscError("invalid parameter for %s", __FUNCTION__);
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  SRequestObj *pRequest = (SRequestObj *)res;
+  if (pRequest->type == TSDB_SQL_RETRIEVE_EMPTY_RESULT || pRequest->type == TSDB_SQL_INSERT ||
+      pRequest->code != TSDB_CODE_SUCCESS || taos_num_fields(res) == 0) {
+    return pRequest->code;
+  }
+
+  if (numOfCols != taos_num_fields(res)) {
+    tscError("0x%" PRIx64 " %d column buffers for %d columns", pRequest->requestId, numOfCols, taos_num_fields(res));
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    if (cols[i].data == NULL || cols[i].validity == NULL ||
+        (IS_VAR_DATA_TYPE(pRequest->body.resInfo.fields[i].type) && cols[i].offsets == NULL)) {
+      tscError("0x%" PRIx64 " no buffer for column %d", pRequest->requestId, i);
+      terrno = TSDB_CODE_INVALID_PARA;
+      return terrno;
+    }
+  }
+
+  // the next block is fetched only when the current one is used up, its nchar columns are not converted
+  doAsyncFetchRows(pRequest, false, false);
+  if (pRequest->code != TSDB_CODE_SUCCESS) {
+    return pRequest->code;
+  }
+
+  int32_t code = doFillColumns(&pRequest->body.resInfo, cols, maxRows);
+  if (code < 0) {
+    terrno = code;
+  }
+  return code;
+}
+
 int taos_fetch_raw_block(TAOS_RES *res, int *numOfRows, void **pData) {
   if (res == NULL || TD_RES_TMQ_META(res)) {
     return 0;
@@ -859,7 +900,8 @@ int32_t createParseContext(const SRequestObj *pRequest, SParseContext **pCxt) {
                            .async = true,
                            .svrVer = pTscObj->sVer,
                            .nodeOffline = (pTscObj->pAppInfo->onlineDnodes < pTscObj->pAppInfo->totalDnodes),
-                           .allocatorId = pRequest->allocatorRefId};
+                           .allocatorId = pRequest->allocatorRefId,
+                           .pInsertCache = pTscObj->insertCache};
   return TSDB_CODE_SUCCESS;
 }
 
@@ -872,6 +914,11 @@ void doAsyncQuery(SRequestObj *pRequest, bool updateMetaForce) {
     code = pRequest->prevCode;
   }
 
+  // the meta of the templates may be the one the error is from
+  if (updateMetaForce) {
+    qClearInsertCache(pTscObj->insertCache);
+  }
+
   if (TSDB_CODE_SUCCESS == code) {
     pWrapper = taosMemoryCalloc(1, sizeof(SSqlCallbackWrapper));
     if (pWrapper == NULL) {
@@ -1386,6 +1433,36 @@ int taos_stmt_execute(TAOS_STMT *stmt) {
   return stmtExec(stmt);
 }
 
+int taos_stmt_set_auto_batch(TAOS_STMT *stmt, int maxRows, int maxDelayMs, int maxInflight) {
+  if (stmt == NULL || maxRows < 0 || maxDelayMs < 0 || (maxRows > 0 && maxInflight <= 0)) {
+    tscError("invalid parameter for %s", __FUNCTION__);
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  return stmtSetAutoBatch(stmt, maxRows, maxDelayMs, maxInflight);
+}
+
+int taos_stmt_flush(TAOS_STMT *stmt) {
+  if (stmt == NULL) {
+    tscError("NULL parameter for %s", __FUNCTION__);
+    terrno = TSDB_CODE_INVALID_PARA;
+    return terrno;
+  }
+
+  return stmtFlush(stmt);
+}
+
+int taos_stmt_get_vgroup_stats(TAOS_STMT *stmt, TAOS_STMT_VG_STAT *stats, int maxNum) {
+  if (stmt == NULL || stats == NULL || maxNum < 0) {
+    tscError("invalid parameter for %s", __FUNCTION__);
+    terrno = TSDB_CODE_INVALID_PARA;
+    return -1;
+  }
+
+  return stmtGetVgStats(stmt, stats, maxNum);
+}
+
 int taos_stmt_is_insert(TAOS_STMT *stmt, int *insert) {
   if (stmt == NULL || insert == NULL) {
     tscError("NULL parameter for %s", __FUNCTION__);
@@ -55,15 +55,24 @@
 
 #define MOVE_FORWARD_ONE(sql, len) (memmove((void *)((sql)-1), (sql), len))
 
-#define PROCESS_SLASH(key, keyLen)           \
-  for (int i = 1; i < keyLen; ++i) {         \
-    if (IS_SLASH_LETTER(key + i)) {          \
-      MOVE_FORWARD_ONE(key + i, keyLen - i); \
-      i--;                                   \
-      keyLen--;                              \
-    }                                        \
+#define PROCESS_SLASH(key, keyLen)             \
+  if (memchr(key, SLASH, keyLen) != NULL) {    \
+    for (int i = 1; i < keyLen; ++i) {         \
+      if (IS_SLASH_LETTER(key + i)) {          \
+        MOVE_FORWARD_ONE(key + i, keyLen - i); \
+        i--;                                   \
+        keyLen--;                              \
+      }                                        \
+    }                                          \
   }
 
+// a byte the parser stops at, the separators, the quote and the escape
+#define IS_SML_SPECIAL(c) ((c) == COMMA || (c) == SPACE || (c) == EQUAL || (c) == QUOTE || (c) == SLASH)
+
+// SWAR helpers, a word with the high bit set in every byte of v that is zero, exact up to the first zero byte
+#define SML_REPEAT_BYTE(c) (0x0101010101010101ULL * (uint8_t)(c))
+#define SML_ZERO_BYTES(v)  (((v)-0x0101010101010101ULL) & ~(v)&0x8080808080808080ULL)
+
 #define IS_INVALID_COL_LEN(len)   ((len) <= 0 || (len) >= TSDB_COL_NAME_LEN)
 #define IS_INVALID_TABLE_LEN(len) ((len) <= 0 || (len) >= TSDB_TABLE_NAME_LEN)
 
@@ -80,6 +89,10 @@
 
 #define MAX_RETRY_TIMES 5
 #define LINE_BATCH      2000
+
+#define SML_PARSE_MIN_LINES_PER_THREAD 500
+
+#define SML_CACHE_MAX_TABLES 100000
 //=================================================================================================
 typedef TSDB_SML_PROTOCOL_TYPE SMLProtocolType;
 
@@ -133,6 +146,27 @@ typedef struct {
   char   *buf;
 } SSmlMsgBuf;
 
+typedef struct {
+  int32_t sversion;
+  int32_t tversion;
+} SSmlSTableCache;
+
+typedef struct {
+  char        db[TSDB_DB_NAME_LEN];  // the db of vg, the name and uid only depend on the tags
+  char        childTableName[TSDB_TABLE_NAME_LEN];
+  uint64_t    uid;
+  int32_t     vgVersion;  // the name and uid stay, vg is stale once the catalog has another version of the db vgroups
+  SVgroupInfo vg;
+} SSmlCTableCache;
+
+// The meta of the tables written by the schemaless insert of a connection. The collectors send the same measurements
+// and tags batch after batch, so the super table versions checked against the mnode, the child table names and the
+// vgroups are kept to skip the schema refresh, the name hashing and the vgroup lookup of the next batches.
+typedef struct {
+  SHashObj *pSTables;  // <db.stable, SSmlSTableCache>
+  SHashObj *pCTables;  // <measure and tags of a line, SSmlCTableCache>, influx line protocol only
+} SSmlCache;
+
 typedef struct {
   int32_t code;
   int32_t lineNum;
@@ -149,11 +183,13 @@ typedef struct {
 } SSmlCostInfo;
 
 typedef struct {
-  SRequestObj     *request;
-  tsem_t           sem;
-  int32_t          cnt;
-  int32_t          total;
-  TdThreadSpinlock lock;
+  SRequestObj      *request;
+  tsem_t            sem;
+  int32_t           cnt;
+  int32_t           total;
+  TdThreadSpinlock  lock;
+  __taos_async_fn_t fp;  // the insert returns at once if set, fp gets the request after the last batch
+  void             *param;
 } Params;
 
 typedef struct {
@@ -170,6 +206,7 @@ typedef struct {
   void     *exec;
 
   STscObj     *taos;
+  SSmlCache   *cache;
   SCatalog    *pCatalog;
   SRequestObj *pRequest;
   SQuery      *pQuery;
@@ -179,7 +216,21 @@ typedef struct {
   SSmlMsgBuf   msgBuf;
   SHashObj    *dumplicateKey;  // for dumplicate key
   SArray      *colsContainer;  // for cols parse, if dataFormat == false
+  SArray      *subInfos;       // SArray<SSmlHandle*>, handles of the parse threads, merged into this one
+  bool         retried;        // the batch was submitted again after a stale meta error
 } SSmlHandle;
+
+typedef struct {
+  SSmlHandle *info;
+  char      **lines;
+  int32_t    *lens;  // NULL if the lines are null terminated
+  int32_t     start;
+  int32_t     end;
+  int32_t     code;
+  TdThread    thread;
+  bool        running;
+  char        msg[ERROR_MSG_BUF_DEFAULT_SIZE];
+} SSmlParseTask;
 //=================================================================================================
 
 //=================================================================================================
@@ -194,6 +245,135 @@ static int64_t          smlGenId() {
            return id;
 }
 
+// Returns the first special byte in [sql, sqlEnd), or sqlEnd. The plain bytes between the separators are skipped eight
+// at a time, the lowest byte matching any special char is located with a bit scan.
+static FORCE_INLINE const char *smlSkipPlain(const char *sql, const char *sqlEnd) {
+  if (IS_LITTLE_ENDIAN()) {
+    while (sqlEnd - sql >= (int64_t)sizeof(uint64_t)) {
+      uint64_t v;
+      memcpy(&v, sql, sizeof(uint64_t));
+      uint64_t mask = SML_ZERO_BYTES(v ^ SML_REPEAT_BYTE(COMMA)) | SML_ZERO_BYTES(v ^ SML_REPEAT_BYTE(SPACE)) |
+                      SML_ZERO_BYTES(v ^ SML_REPEAT_BYTE(EQUAL)) | SML_ZERO_BYTES(v ^ SML_REPEAT_BYTE(QUOTE)) |
+                      SML_ZERO_BYTES(v ^ SML_REPEAT_BYTE(SLASH));
+      if (mask != 0) {
+        return sql + (BUILDIN_CTZL(mask) >> 3);
+      }
+      sql += sizeof(uint64_t);
+    }
+  }
+
+  while (sql < sqlEnd && !IS_SML_SPECIAL(*sql)) {
+    sql++;
+  }
+  return sql;
+}
+
+static SSmlCache *smlCreateCache() {
+  SSmlCache *pCache = (SSmlCache *)taosMemoryCalloc(1, sizeof(SSmlCache));
+  if (pCache == NULL) {
+    return NULL;
+  }
+  pCache->pSTables = taosHashInit(32, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_ENTRY_LOCK);
+  pCache->pCTables = taosHashInit(1024, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_ENTRY_LOCK);
+  if (pCache->pSTables == NULL || pCache->pCTables == NULL) {
+    smlDestroyCache(pCache);
+    return NULL;
+  }
+  return pCache;
+}
+
+void smlDestroyCache(void *pCache) {
+  if (pCache == NULL) return;
+  taosHashCleanup(((SSmlCache *)pCache)->pSTables);
+  taosHashCleanup(((SSmlCache *)pCache)->pCTables);
+  taosMemoryFree(pCache);
+}
+
+static SSmlCache *smlGetCache(STscObj *pTscObj) {
+  SSmlCache *pCache = (SSmlCache *)atomic_load_ptr(&pTscObj->smlCache);
+  if (pCache != NULL) {
+    return pCache;
+  }
+
+  pCache = smlCreateCache();
+  if (pCache == NULL) {
+    return NULL;
+  }
+  SSmlCache *pOld = (SSmlCache *)atomic_val_compare_exchange_ptr(&pTscObj->smlCache, NULL, pCache);
+  if (pOld != NULL) {
+    smlDestroyCache(pCache);
+    pCache = pOld;
+  }
+  return pCache;
+}
+
+static int32_t smlBuildSTableCacheKey(SSmlHandle *info, const char *sTableName, int32_t sTableNameLen, char *key) {
+  return snprintf(key, TSDB_TABLE_FNAME_LEN, "%s.%.*s", info->pRequest->pDb, sTableNameLen, sTableName);
+}
+
+static int32_t smlGetDbVgVersion(SSmlHandle *info) {
+  SName   dbName = {0};
+  char    dbFName[TSDB_DB_FNAME_LEN] = {0};
+  int32_t vgVersion = -1;
+  int64_t dbId = 0;
+  int32_t tableNum = 0;
+  int64_t stateTs = 0;
+  tNameSetDbName(&dbName, info->taos->acctId, info->pRequest->pDb, strlen(info->pRequest->pDb));
+  tNameGetFullDbName(&dbName, dbFName);
+  if (catalogGetDBVgVersion(info->pCatalog, dbFName, &vgVersion, &dbId, &tableNum, &stateTs) != 0) {
+    return -1;
+  }
+  return vgVersion;
+}
+
+static bool smlGetCTableCache(SSmlHandle *info, const char *key, int32_t keyLen, SSmlCTableCache *pCached) {
+  if (info->cache == NULL) return false;
+  return taosHashGetDup(info->cache->pCTables, key, keyLen, pCached) == 0 && pCached->childTableName[0] != 0;
+}
+
+static void smlPutCTableCache(SSmlHandle *info, const char *key, int32_t keyLen, SSmlTableInfo *tableData,
+                              SVgroupInfo *pVg) {
+  if (info->cache == NULL) return;
+  SSmlCTableCache cached = {.uid = tableData->uid, .vgVersion = smlGetDbVgVersion(info), .vg = *pVg};
+  tstrncpy(cached.db, info->pRequest->pDb, sizeof(cached.db));
+  tstrncpy(cached.childTableName, tableData->childTableName, sizeof(cached.childTableName));
+  if (taosHashGetSize(info->cache->pCTables) >= SML_CACHE_MAX_TABLES) {
+    taosHashClear(info->cache->pCTables);
+  }
+  taosHashPut(info->cache->pCTables, key, keyLen, &cached, sizeof(SSmlCTableCache));
+}
+
+static void smlPutSTableCache(SSmlHandle *info, const char *sTableName, int32_t sTableNameLen,
+                              STableMeta *pTableMeta) {
+  if (info->cache == NULL) return;
+  char            key[TSDB_TABLE_FNAME_LEN] = {0};
+  int32_t         keyLen = smlBuildSTableCacheKey(info, sTableName, sTableNameLen, key);
+  SSmlSTableCache cached = {.sversion = pTableMeta->sversion, .tversion = pTableMeta->tversion};
+  taosHashPut(info->cache->pSTables, key, keyLen, &cached, sizeof(SSmlSTableCache));
+}
+
+// drops the tables of a batch rejected with a stale meta, the next batch checks them against the mnode again
+static void smlInvalidateCache(SSmlHandle *info) {
+  if (info->cache == NULL) return;
+  char   key[TSDB_TABLE_FNAME_LEN] = {0};
+  size_t keyLen = 0;
+  void **p1 = (void **)taosHashIterate(info->superTables, NULL);
+  while (p1) {
+    void   *superTable = taosHashGetKey(p1, &keyLen);
+    int32_t len = smlBuildSTableCacheKey(info, (const char *)superTable, (int32_t)keyLen, key);
+    taosHashRemove(info->cache->pSTables, key, len);
+    p1 = (void **)taosHashIterate(info->superTables, p1);
+  }
+
+  if (info->protocol != TSDB_SML_LINE_PROTOCOL) return;
+  p1 = (void **)taosHashIterate(info->childTables, NULL);
+  while (p1) {
+    void *childTable = taosHashGetKey(p1, &keyLen);
+    taosHashRemove(info->cache->pCTables, childTable, keyLen);
+    p1 = (void **)taosHashIterate(info->childTables, p1);
+  }
+}
+
 static inline bool smlDoubleToInt64OverFlow(double num) {
   if (num >= (double)INT64_MAX || num <= (double)INT64_MIN) return true;
   return false;
@@ -425,6 +605,39 @@ end:
   return code;
 }
 
+// The local meta of a super table is used without asking the mnode again when it has the versions checked by an
+// earlier batch and the batch needs no schema change.
+static bool smlCheckCachedSTable(SSmlHandle *info, SSmlSTableMeta *sTableData, const char *sTableName,
+                                 int32_t sTableNameLen, STableMeta *pTableMeta) {
+  if (info->cache == NULL) return false;
+
+  char            key[TSDB_TABLE_FNAME_LEN] = {0};
+  int32_t         keyLen = smlBuildSTableCacheKey(info, sTableName, sTableNameLen, key);
+  SSmlSTableCache cached = {0};
+  if (taosHashGetDup(info->cache->pSTables, key, keyLen, &cached) != 0 ||
+      cached.sversion != pTableMeta->sversion || cached.tversion != pTableMeta->tversion) {
+    return false;
+  }
+
+  int32_t   numOfCols = pTableMeta->tableInfo.numOfColumns;
+  int32_t   numOfTags = pTableMeta->tableInfo.numOfTags;
+  SHashObj *tagHash = taosHashInit(numOfTags, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
+  SHashObj *colHash = taosHashInit(numOfCols, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
+  for (uint16_t i = 0; i < numOfCols + numOfTags; i++) {
+    taosHashPut(i < numOfCols ? colHash : tagHash, pTableMeta->schema[i].name, strlen(pTableMeta->schema[i].name), &i,
+                SHORT_BYTES);
+  }
+
+  ESchemaAction action = SCHEMA_ACTION_NULL;
+  int32_t       code = smlProcessSchemaAction(info, pTableMeta->schema, tagHash, sTableData->tags, &action, true);
+  if (code == TSDB_CODE_SUCCESS && action == SCHEMA_ACTION_NULL) {
+    code = smlProcessSchemaAction(info, pTableMeta->schema, colHash, sTableData->cols, &action, false);
+  }
+  taosHashCleanup(tagHash);
+  taosHashCleanup(colHash);
+  return code == TSDB_CODE_SUCCESS && action == SCHEMA_ACTION_NULL;
+}
+
 static int32_t smlModifyDBSchemas(SSmlHandle *info) {
   int32_t     code = 0;
   SHashObj   *hashTmp = NULL;
@@ -451,6 +664,16 @@ static int32_t smlModifyDBSchemas(SSmlHandle *info) {
 
     code = catalogGetSTableMeta(info->pCatalog, &conn, &pName, &pTableMeta);
 
+    if (code == TSDB_CODE_SUCCESS &&
+        smlCheckCachedSTable(info, sTableData, (const char *)superTable, (int32_t)superTableLen, pTableMeta)) {
+      // the meta got by a previous try of the batch
+      taosMemoryFree(sTableData->tableMeta);
+      sTableData->tableMeta = pTableMeta;
+      pTableMeta = NULL;
+      tableMetaSml = (SSmlSTableMeta **)taosHashIterate(info->superTables, tableMetaSml);
+      continue;
+    }
+
     if (code == TSDB_CODE_PAR_TABLE_NOT_EXIST || code == TSDB_CODE_MND_STB_NOT_EXIST) {
       SArray *pColumns = taosArrayInit(taosArrayGetSize(sTableData->cols), sizeof(SField));
       SArray *pTags = taosArrayInit(taosArrayGetSize(sTableData->tags), sizeof(SField));
@@ -583,7 +806,10 @@ static int32_t smlModifyDBSchemas(SSmlHandle *info) {
       }
     }
 
+    taosMemoryFree(sTableData->tableMeta);
     sTableData->tableMeta = pTableMeta;
+    smlPutSTableCache(info, (const char *)superTable, (int32_t)superTableLen, pTableMeta);
+    pTableMeta = NULL;
 
     tableMetaSml = (SSmlSTableMeta **)taosHashIterate(info->superTables, tableMetaSml);
   }
@@ -925,6 +1151,8 @@ static int32_t smlParseInfluxString(const char *sql, const char *sqlEnd, SSmlLin
 
   // parse measure
   while (sql < sqlEnd) {
+    sql = smlSkipPlain(sql, sqlEnd);
+    if (sql >= sqlEnd) break;
     if ((sql != elements->measure) && IS_SLASH_LETTER(sql)) {
       MOVE_FORWARD_ONE(sql, sqlEnd - sql);
       sqlEnd--;
@@ -952,6 +1180,8 @@ static int32_t smlParseInfluxString(const char *sql, const char *sqlEnd, SSmlLin
     if (*sql == COMMA) sql++;
     elements->tags = sql;
     while (sql < sqlEnd) {
+      sql = smlSkipPlain(sql, sqlEnd);
+      if (sql >= sqlEnd) break;
       if (IS_SPACE(sql)) {
         break;
       }
@@ -966,6 +1196,8 @@ static int32_t smlParseInfluxString(const char *sql, const char *sqlEnd, SSmlLin
   elements->cols = sql;
   bool isInQuote = false;
   while (sql < sqlEnd) {
+    sql = smlSkipPlain(sql, sqlEnd);
+    if (sql >= sqlEnd) break;
     if (IS_QUOTE(sql)) {
       isInQuote = !isInQuote;
     }
@@ -1024,6 +1256,8 @@ static int32_t smlParseTelnetTags(const char *data, const char *sqlEnd, SArray *
 
     // parse key
     while (sql < sqlEnd) {
+      sql = smlSkipPlain(sql, sqlEnd);
+      if (sql >= sqlEnd) break;
       if (*sql == SPACE) {
         smlBuildInvalidDataMsg(msg, "invalid data", sql);
         return TSDB_CODE_SML_INVALID_DATA;
@@ -1050,6 +1284,8 @@ static int32_t smlParseTelnetTags(const char *data, const char *sqlEnd, SArray *
     int32_t     valueLen = 0;
     while (sql < sqlEnd) {
       // parse value
+      sql = smlSkipPlain(sql, sqlEnd);
+      if (sql >= sqlEnd) break;
       if (*sql == SPACE) {
         break;
       }
@@ -1163,6 +1399,8 @@ static int32_t smlParseCols(const char *data, int32_t len, SArray *cols, char *c
 
     while (sql < data + len) {
       // parse key
+      sql = smlSkipPlain(sql, data + len);
+      if (sql >= data + len) break;
       if (IS_COMMA(sql)) {
         smlBuildInvalidDataMsg(msg, "invalid data", sql);
         return TSDB_CODE_SML_INVALID_DATA;
@@ -1190,6 +1428,8 @@ static int32_t smlParseCols(const char *data, int32_t len, SArray *cols, char *c
     bool        isInQuote = false;
     while (sql < data + len) {
       // parse value
+      sql = smlSkipPlain(sql, data + len);
+      if (sql >= data + len) break;
       if (!isTag && IS_QUOTE(sql)) {
         isInQuote = !isInQuote;
         sql++;
@@ -1398,14 +1638,19 @@ static int32_t smlKvTimeHashCompare(const void *key1, const void *key2) {
   }
 }
 
+// the rows of a table are kept in time order, a row goes after the ones with the same timestamp
+static void smlInsertRow(SSmlTableInfo *oneTable, bool dataFormat, void *row) {
+  void *p = taosArraySearch(oneTable->cols, &row, dataFormat ? smlKvTimeArrayCompare : smlKvTimeHashCompare, TD_GT);
+  if (p == NULL) {
+    taosArrayPush(oneTable->cols, &row);
+  } else {
+    taosArrayInsert(oneTable->cols, TARRAY_ELEM_IDX(oneTable->cols, p), &row);
+  }
+}
+
 static int32_t smlDealCols(SSmlTableInfo *oneTable, bool dataFormat, SArray *cols) {
   if (dataFormat) {
-    void *p = taosArraySearch(oneTable->cols, &cols, smlKvTimeArrayCompare, TD_GT);
-    if (p == NULL) {
-      taosArrayPush(oneTable->cols, &cols);
-    } else {
-      taosArrayInsert(oneTable->cols, TARRAY_ELEM_IDX(oneTable->cols, p), &cols);
-    }
+    smlInsertRow(oneTable, dataFormat, cols);
     return TSDB_CODE_SUCCESS;
   }
 
@@ -1419,12 +1664,7 @@ static int32_t smlDealCols(SSmlTableInfo *oneTable, bool dataFormat, SArray *col
     taosHashPut(kvHash, kv->key, kv->keyLen, &kv, POINTER_BYTES);
   }
 
-  void *p = taosArraySearch(oneTable->cols, &kvHash, smlKvTimeHashCompare, TD_GT);
-  if (p == NULL) {
-    taosArrayPush(oneTable->cols, &kvHash);
-  } else {
-    taosArrayInsert(oneTable->cols, TARRAY_ELEM_IDX(oneTable->cols, p), &kvHash);
-  }
+  smlInsertRow(oneTable, dataFormat, kvHash);
   return TSDB_CODE_SUCCESS;
 }
 
@@ -1485,10 +1725,10 @@ static void smlDestroyInfo(SSmlHandle *info) {
   qDestroyQuery(info->pQuery);
   smlDestroyHandle(info->exec);
 
-  // destroy info->childTables
+  // destroy info->childTables, the ones moved to the merged handle are left as NULL
   void **p1 = (void **)taosHashIterate(info->childTables, NULL);
   while (p1) {
-    smlDestroyTableInfo(info, (SSmlTableInfo *)(*p1));
+    if (*p1) smlDestroyTableInfo(info, (SSmlTableInfo *)(*p1));
     p1 = (void **)taosHashIterate(info->childTables, p1);
   }
   taosHashCleanup(info->childTables);
@@ -1496,11 +1736,17 @@ static void smlDestroyInfo(SSmlHandle *info) {
   // destroy info->superTables
   p1 = (void **)taosHashIterate(info->superTables, NULL);
   while (p1) {
-    smlDestroySTableMeta((SSmlSTableMeta *)(*p1));
+    if (*p1) smlDestroySTableMeta((SSmlSTableMeta *)(*p1));
     p1 = (void **)taosHashIterate(info->superTables, p1);
   }
   taosHashCleanup(info->superTables);
 
+  // destroy info->subInfos
+  for (int32_t i = 0; i < taosArrayGetSize(info->subInfos); ++i) {
+    smlDestroyInfo((SSmlHandle *)taosArrayGetP(info->subInfos, i));
+  }
+  taosArrayDestroy(info->subInfos);
+
   // destroy info->pVgHash
   taosHashCleanup(info->pVgHash);
   taosHashCleanup(info->dumplicateKey);
@@ -1535,6 +1781,7 @@ static SSmlHandle *smlBuildSmlInfo(STscObj *pTscObj, SRequestObj *request, SMLPr
 
   if (pTscObj) {
     info->taos = pTscObj;
+    info->cache = smlGetCache(pTscObj);
     code = catalogGetHandle(info->taos->pAppInfo->clusterId, &info->pCatalog);
     if (code != TSDB_CODE_SUCCESS) {
       uError("SML:0x%" PRIx64 " get catalog error %d", info->id, code);
@@ -2116,10 +2363,14 @@ static int32_t smlParseInfluxLine(SSmlHandle *info, const char *sql, const int l
   }
 
   bool            hasTable = true;
+  bool            hasCache = false;
+  SSmlCTableCache cached;
   SSmlTableInfo  *tinfo = NULL;
   SSmlTableInfo **oneTable =
       (SSmlTableInfo **)taosHashGet(info->childTables, elements.measure, elements.measureTagsLen);
   if (!oneTable) {
+    // the tags are parsed in place, look up with the raw ones
+    hasCache = smlGetCTableCache(info, elements.measure, elements.measureTagsLen, &cached);
     tinfo = smlBuildTableInfo();
     if (!tinfo) {
       smlDestroyCols(cols);
@@ -2156,7 +2407,10 @@ static int32_t smlParseInfluxLine(SSmlHandle *info, const char *sql, const int l
 
     (*oneTable)->sTableName = elements.measure;
     (*oneTable)->sTableNameLen = elements.measureLen;
-    if (strlen((*oneTable)->childTableName) == 0) {
+    if (strlen((*oneTable)->childTableName) == 0 && hasCache) {
+      tstrncpy((*oneTable)->childTableName, cached.childTableName, TSDB_TABLE_NAME_LEN);
+      (*oneTable)->uid = cached.uid;
+    } else if (strlen((*oneTable)->childTableName) == 0) {
       RandTableName rName = {(*oneTable)->tags, (*oneTable)->sTableName, (uint8_t)(*oneTable)->sTableNameLen,
                              (*oneTable)->childTableName, 0};
 
@@ -2310,6 +2564,8 @@ end:
 
 static int32_t smlInsertData(SSmlHandle *info) {
   int32_t code = TSDB_CODE_SUCCESS;
+  // the cached vgroups are used only while the catalog has the version of the db vgroups they were got with
+  int32_t vgVersion = (info->protocol == TSDB_SML_LINE_PROTOCOL && info->cache) ? smlGetDbVgVersion(info) : -1;
 
   SSmlTableInfo **oneTable = (SSmlTableInfo **)taosHashIterate(info->childTables, NULL);
   while (oneTable) {
@@ -2325,11 +2581,25 @@ static int32_t smlInsertData(SSmlHandle *info) {
     conn.requestObjRefId = info->pRequest->self;
     conn.mgmtEps = getEpSet_s(&info->taos->pAppInfo->mgmtEp);
 
-    SVgroupInfo vg;
-    code = catalogGetTableHashVgroup(info->pCatalog, &conn, &pName, &vg);
-    if (code != TSDB_CODE_SUCCESS) {
-      uError("SML:0x%" PRIx64 " catalogGetTableHashVgroup failed. table name: %s", info->id, tableData->childTableName);
-      return code;
+    SVgroupInfo     vg;
+    SSmlCTableCache cached;
+    size_t          keyLen = 0;
+    void           *key = taosHashGetKey(oneTable, &keyLen);
+    if (info->protocol == TSDB_SML_LINE_PROTOCOL &&
+        smlGetCTableCache(info, (const char *)key, (int32_t)keyLen, &cached) && vgVersion >= 0 &&
+        cached.vgVersion == vgVersion && strcmp(cached.db, info->pRequest->pDb) == 0 &&
+        strcmp(cached.childTableName, tableData->childTableName) == 0) {
+      vg = cached.vg;
+    } else {
+      code = catalogGetTableHashVgroup(info->pCatalog, &conn, &pName, &vg);
+      if (code != TSDB_CODE_SUCCESS) {
+        uError("SML:0x%" PRIx64 " catalogGetTableHashVgroup failed. table name: %s", info->id,
+               tableData->childTableName);
+        return code;
+      }
+      if (info->protocol == TSDB_SML_LINE_PROTOCOL) {
+        smlPutCTableCache(info, (const char *)key, (int32_t)keyLen, tableData, &vg);
+      }
     }
     taosHashPut(info->pVgHash, (const char *)&vg.vgId, sizeof(vg.vgId), (char *)&vg, sizeof(vg));
 
@@ -2385,6 +2655,175 @@ static void smlPrintStatisticInfo(SSmlHandle *info) {
          info->cost.endTime - info->cost.insertRpcTime, info->cost.endTime - info->cost.parseTime);
 }
 
+static int32_t smlParseOneLine(SSmlHandle *info, char *tmp, int len) {
+  if (info->protocol == TSDB_SML_LINE_PROTOCOL) {
+    return smlParseInfluxLine(info, tmp, len);
+  } else if (info->protocol == TSDB_SML_TELNET_PROTOCOL) {
+    return smlParseTelnetLine(info, tmp, len);
+  }
+  ASSERT(0);
+  return TSDB_CODE_SML_INVALID_PROTOCOL_TYPE;
+}
+
+// the handle of a parse thread, only the parse states are built
+static SSmlHandle *smlBuildSubInfo(SSmlHandle *info, char *msg) {
+  SSmlHandle *sub = (SSmlHandle *)taosMemoryCalloc(1, sizeof(SSmlHandle));
+  if (NULL == sub) {
+    return NULL;
+  }
+  sub->id = info->id;
+  sub->protocol = info->protocol;
+  sub->precision = info->precision;
+  sub->dataFormat = info->dataFormat;
+  sub->cache = info->cache;
+  sub->msgBuf.buf = msg;
+  sub->msgBuf.len = ERROR_MSG_BUF_DEFAULT_SIZE;
+
+  sub->childTables = taosHashInit(32, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_NO_LOCK);
+  sub->superTables = taosHashInit(32, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_NO_LOCK);
+  sub->dumplicateKey = taosHashInit(32, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_NO_LOCK);
+  if (!sub->dataFormat) {
+    sub->colsContainer = taosArrayInit(32, POINTER_BYTES);
+  }
+  if (NULL == sub->childTables || NULL == sub->superTables || NULL == sub->dumplicateKey ||
+      (!sub->dataFormat && NULL == sub->colsContainer)) {
+    uError("SML:0x%" PRIx64 " create sub info failed", info->id);
+    smlDestroyInfo(sub);
+    return NULL;
+  }
+  return sub;
+}
+
+static void *smlParseThreadFp(void *param) {
+  SSmlParseTask *pTask = (SSmlParseTask *)param;
+  for (int32_t i = pTask->start; i < pTask->end; ++i) {
+    char *tmp = pTask->lines[i];
+    int   len = pTask->lens ? pTask->lens[i] : strlen(tmp);
+    pTask->code = smlParseOneLine(pTask->info, tmp, len);
+    if (pTask->code != TSDB_CODE_SUCCESS) {
+      uError("SML:0x%" PRIx64 " smlParseLine failed. line %d : %s", pTask->info->id, i, tmp);
+      break;
+    }
+  }
+  return NULL;
+}
+
+// Moves the tables parsed by a thread into the handle. A table found in both keeps the rows in time order, the
+// duplicated table info stays with the sub handle since the super table meta may point to its tags.
+static int32_t smlMergeSubInfo(SSmlHandle *info, SSmlHandle *sub) {
+  size_t keyLen = 0;
+  void **p1 = (void **)taosHashIterate(sub->childTables, NULL);
+  while (p1) {
+    SSmlTableInfo  *tinfo = (SSmlTableInfo *)(*p1);
+    void           *key = taosHashGetKey(p1, &keyLen);
+    SSmlTableInfo **oneTable = (SSmlTableInfo **)taosHashGet(info->childTables, key, keyLen);
+    if (oneTable == NULL) {
+      taosHashPut(info->childTables, key, keyLen, &tinfo, POINTER_BYTES);
+      *p1 = NULL;
+    } else {
+      for (int32_t i = 0; i < taosArrayGetSize(tinfo->cols); ++i) {
+        void *row = taosArrayGetP(tinfo->cols, i);
+        if (info->protocol == TSDB_SML_LINE_PROTOCOL) {
+          smlInsertRow(*oneTable, info->dataFormat, row);
+        } else {
+          taosArrayPush((*oneTable)->cols, &row);
+        }
+      }
+      taosArrayClear(tinfo->cols);
+    }
+    p1 = (void **)taosHashIterate(sub->childTables, p1);
+  }
+
+  p1 = (void **)taosHashIterate(sub->superTables, NULL);
+  while (p1) {
+    SSmlSTableMeta  *meta = (SSmlSTableMeta *)(*p1);
+    void            *key = taosHashGetKey(p1, &keyLen);
+    SSmlSTableMeta **tableMeta = (SSmlSTableMeta **)taosHashGet(info->superTables, key, keyLen);
+    if (tableMeta == NULL) {
+      taosHashPut(info->superTables, key, keyLen, &meta, POINTER_BYTES);
+      *p1 = NULL;
+    } else {
+      int32_t ret = smlUpdateMeta((*tableMeta)->colHash, (*tableMeta)->cols, meta->cols, &info->msgBuf);
+      if (ret == TSDB_CODE_SUCCESS) {
+        ret = smlUpdateMeta((*tableMeta)->tagHash, (*tableMeta)->tags, meta->tags, &info->msgBuf);
+      }
+      if (ret != TSDB_CODE_SUCCESS) {
+        uError("SML:0x%" PRIx64 " smlUpdateMeta failed", info->id);
+        taosHashCancelIterate(sub->superTables, p1);
+        return ret;
+      }
+    }
+    p1 = (void **)taosHashIterate(sub->superTables, p1);
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+// The lines are split into contiguous ranges parsed by threads into their own handles, the handles are merged in the
+// order of the ranges afterwards, so the result is the same as parsing in one thread.
+static int32_t smlParseLineParallel(SSmlHandle *info, char **lines, int32_t *lens, int32_t numLines,
+                                    int32_t numOfThreads) {
+  int32_t        code = TSDB_CODE_SUCCESS;
+  SSmlParseTask *pTasks = (SSmlParseTask *)taosMemoryCalloc(numOfThreads, sizeof(SSmlParseTask));
+  info->subInfos = taosArrayInit(numOfThreads, POINTER_BYTES);
+  if (pTasks == NULL || info->subInfos == NULL) {
+    taosMemoryFree(pTasks);
+    return TSDB_CODE_TSC_OUT_OF_MEMORY;
+  }
+
+  int32_t step = (numLines + numOfThreads - 1) / numOfThreads;
+  for (int32_t i = 0; i < numOfThreads; ++i) {
+    SSmlParseTask *pTask = &pTasks[i];
+    pTask->info = smlBuildSubInfo(info, pTask->msg);
+    if (pTask->info == NULL) {
+      code = TSDB_CODE_TSC_OUT_OF_MEMORY;
+      goto _end;
+    }
+    taosArrayPush(info->subInfos, &pTask->info);
+    pTask->lines = lines;
+    pTask->lens = lens;
+    pTask->start = TMIN(i * step, numLines);
+    pTask->end = TMIN(pTask->start + step, numLines);
+  }
+
+  // the current thread parses the first range
+  for (int32_t i = 1; i < numOfThreads; ++i) {
+    SSmlParseTask *pTask = &pTasks[i];
+    pTask->running = (taosThreadCreate(&pTask->thread, NULL, smlParseThreadFp, pTask) == 0);
+    if (!pTask->running) {
+      uWarn("SML:0x%" PRIx64 " failed to start parse thread:%d", info->id, i);
+    }
+  }
+
+  smlParseThreadFp(&pTasks[0]);
+
+  for (int32_t i = 1; i < numOfThreads; ++i) {
+    SSmlParseTask *pTask = &pTasks[i];
+    if (pTask->running) {
+      taosThreadJoin(pTask->thread, NULL);
+      pTask->running = false;
+    } else {
+      smlParseThreadFp(pTask);
+    }
+  }
+
+  for (int32_t i = 0; i < numOfThreads; ++i) {
+    SSmlParseTask *pTask = &pTasks[i];
+    code = pTask->code;
+    if (code == TSDB_CODE_SUCCESS) {
+      code = smlMergeSubInfo(info, pTask->info);
+    } else if (info->msgBuf.buf) {
+      tstrncpy(info->msgBuf.buf, pTask->msg, info->msgBuf.len);
+    }
+    if (code != TSDB_CODE_SUCCESS) {
+      break;
+    }
+  }
+
+_end:
+  taosMemoryFree(pTasks);
+  return code;
+}
+
 static int32_t smlParseLine(SSmlHandle *info, char *lines[], char *rawLine, char *rawLineEnd, int numLines) {
   int32_t code = TSDB_CODE_SUCCESS;
   if (info->protocol == TSDB_SML_JSON_PROTOCOL) {
@@ -2400,6 +2839,39 @@ static int32_t smlParseLine(SSmlHandle *info, char *lines[], char *rawLine, char
     return code;
   }
 
+  int32_t numOfThreads = TMIN(tsSmlParseThreads, numLines / SML_PARSE_MIN_LINES_PER_THREAD);
+  if (numOfThreads > 1) {
+    if (lines) {
+      return smlParseLineParallel(info, lines, NULL, numLines, numOfThreads);
+    }
+
+    // split the raw lines first, the comment lines are dropped
+    char   **pLines = (char **)taosMemoryMalloc(numLines * POINTER_BYTES);
+    int32_t *pLens = (int32_t *)taosMemoryMalloc(numLines * sizeof(int32_t));
+    if (pLines == NULL || pLens == NULL) {
+      taosMemoryFree(pLines);
+      taosMemoryFree(pLens);
+      return TSDB_CODE_TSC_OUT_OF_MEMORY;
+    }
+    int32_t num = 0;
+    for (int32_t i = 0; i < numLines; ++i) {
+      char *tmp = rawLine;
+      char *pEnd = rawLine < rawLineEnd ? (char *)memchr(rawLine, '\n', rawLineEnd - rawLine) : NULL;
+      int   len = pEnd ? pEnd - rawLine : rawLineEnd - rawLine;
+      rawLine = pEnd ? pEnd + 1 : rawLineEnd;
+      if (info->protocol == TSDB_SML_LINE_PROTOCOL && tmp[0] == '#') {  // this line is comment
+        continue;
+      }
+      pLines[num] = tmp;
+      pLens[num] = len;
+      num++;
+    }
+    code = smlParseLineParallel(info, pLines, pLens, num, numOfThreads);
+    taosMemoryFree(pLines);
+    taosMemoryFree(pLens);
+    return code;
+  }
+
   for (int32_t i = 0; i < numLines; ++i) {
     char *tmp = NULL;
     int   len = 0;
@@ -2419,13 +2891,7 @@ static int32_t smlParseLine(SSmlHandle *info, char *lines[], char *rawLine, char
       }
     }
 
-    if (info->protocol == TSDB_SML_LINE_PROTOCOL) {
-      code = smlParseInfluxLine(info, tmp, len);
-    } else if (info->protocol == TSDB_SML_TELNET_PROTOCOL) {
-      code = smlParseTelnetLine(info, tmp, len);
-    } else {
-      ASSERT(0);
-    }
+    code = smlParseOneLine(info, tmp, len);
     if (code != TSDB_CODE_SUCCESS) {
       uError("SML:0x%" PRIx64 " smlParseLine failed. line %d : %s", info->id, i, tmp);
       return code;
@@ -2434,22 +2900,10 @@ static int32_t smlParseLine(SSmlHandle *info, char *lines[], char *rawLine, char
   return code;
 }
 
-static int smlProcess(SSmlHandle *info, char *lines[], char *rawLine, char *rawLineEnd, int numLines) {
+static int32_t smlModifyAndInsert(SSmlHandle *info) {
   int32_t code = TSDB_CODE_SUCCESS;
   int32_t retryNum = 0;
 
-  info->cost.parseTime = taosGetTimestampUs();
-
-  code = smlParseLine(info, lines, rawLine, rawLineEnd, numLines);
-  if (code != 0) {
-    uError("SML:0x%" PRIx64 " smlParseLine error : %s", info->id, tstrerror(code));
-    return code;
-  }
-
-  info->cost.lineNum = numLines;
-  info->cost.numOfSTables = taosHashGetSize(info->superTables);
-  info->cost.numOfCTables = taosHashGetSize(info->childTables);
-
   info->cost.schemaTime = taosGetTimestampUs();
 
   do {
@@ -2472,6 +2926,24 @@ static int smlProcess(SSmlHandle *info, char *lines[], char *rawLine, char *rawL
   return code;
 }
 
+static int smlProcess(SSmlHandle *info, char *lines[], char *rawLine, char *rawLineEnd, int numLines) {
+  int32_t code = TSDB_CODE_SUCCESS;
+
+  info->cost.parseTime = taosGetTimestampUs();
+
+  code = smlParseLine(info, lines, rawLine, rawLineEnd, numLines);
+  if (code != 0) {
+    uError("SML:0x%" PRIx64 " smlParseLine error : %s", info->id, tstrerror(code));
+    return code;
+  }
+
+  info->cost.lineNum = numLines;
+  info->cost.numOfSTables = taosHashGetSize(info->superTables);
+  info->cost.numOfCTables = taosHashGetSize(info->childTables);
+
+  return smlModifyAndInsert(info);
+}
+
 static int32_t isSchemalessDb(STscObj *taos, SRequestObj *request) {
   //  SCatalog *catalog = NULL;
   //  int32_t   code = catalogGetHandle(((STscObj *)taos)->pAppInfo->clusterId, &catalog);
@@ -2504,12 +2976,121 @@ static int32_t isSchemalessDb(STscObj *taos, SRequestObj *request) {
   return TSDB_CODE_SUCCESS;
 }
 
+static void smlDestroyParams(Params *pParam) {
+  taosThreadSpinDestroy(&pParam->lock);
+  tsem_destroy(&pParam->sem);
+  taosMemoryFree(pParam);
+}
+
+// called once all the batches are finished, the params are released here in async mode
+static void smlDoneBatches(Params *pParam) {
+  if (pParam->fp == NULL) {
+    tsem_post(&pParam->sem);
+    return;
+  }
+
+  SRequestObj      *request = pParam->request;
+  __taos_async_fn_t fp = pParam->fp;
+  void             *param = pParam->param;
+  smlDestroyParams(pParam);
+  fp(param, request, request->code);
+}
+
+static void smlInsertCallback(void *param, void *res, int32_t code);
+
+// the parsed lines are bound again into a new request, the submitted one is released
+static int32_t smlResetBatch(SSmlHandle *info, SRequestObj *request) {
+  qDestroyQuery(info->pQuery);
+  smlDestroyHandle(info->exec);
+  info->exec = NULL;
+  taosHashClear(info->pVgHash);
+  destroyRequest(info->pRequest);
+
+  info->pRequest = request;
+  info->msgBuf.buf = request->msgBuf;
+  request->body.queryFp = smlInsertCallback;
+  request->body.param = info;
+
+  info->pQuery = (SQuery *)nodesMakeNode(QUERY_NODE_QUERY);
+  if (NULL == info->pQuery) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  info->pQuery->execMode = QUERY_EXEC_MODE_SCHEDULE;
+  info->pQuery->haveResultSet = false;
+  info->pQuery->msgType = TDMT_VND_SUBMIT;
+  info->pQuery->pRoot = (SNode *)nodesMakeNode(QUERY_NODE_VNODE_MODIF_STMT);
+  if (NULL == info->pQuery->pRoot) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  request->stmtType = info->pQuery->pRoot->type;
+
+  info->exec = smlInitHandle(info->pQuery);
+  if (NULL == info->exec) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+// a batch rejected with a stale meta or vgroup version is submitted once more with the meta got from the mnode
+static int32_t smlRetryBatch(void *param) {
+  SSmlHandle *info = (SSmlHandle *)param;
+  int32_t     code = TSDB_CODE_SUCCESS;
+
+  SRequestConnInfo conn = {0};
+  conn.pTrans = info->taos->pAppInfo->pTransporter;
+  conn.requestId = info->pRequest->requestId;
+  conn.requestObjRefId = info->pRequest->self;
+  conn.mgmtEps = getEpSet_s(&info->taos->pAppInfo->mgmtEp);
+
+  // the cached vgroups of the child tables are gone with the cache, the ones of the catalog are refreshed here
+  SName dbName = {0};
+  char  dbFName[TSDB_DB_FNAME_LEN] = {0};
+  tNameSetDbName(&dbName, info->taos->acctId, info->pRequest->pDb, strlen(info->pRequest->pDb));
+  tNameGetFullDbName(&dbName, dbFName);
+  code = catalogRefreshDBVgInfo(info->pCatalog, &conn, dbFName);
+
+  size_t keyLen = 0;
+  void **p1 = (void **)taosHashIterate(info->superTables, NULL);
+  while (p1) {
+    void *superTable = taosHashGetKey(p1, &keyLen);
+    SName sName = {TSDB_TABLE_NAME_T, info->taos->acctId, {0}, {0}};
+    tstrncpy(sName.dbname, info->pRequest->pDb, sizeof(sName.dbname));
+    memcpy(sName.tname, superTable, TMIN(keyLen, TSDB_TABLE_NAME_LEN - 1));
+    catalogRemoveTableMeta(info->pCatalog, &sName);
+    p1 = (void **)taosHashIterate(info->superTables, p1);
+  }
+
+  SRequestObj *request = NULL;
+  if (TSDB_CODE_SUCCESS == code) {
+    request = (SRequestObj *)createRequest(info->taos->id, TSDB_SQL_INSERT, 0);
+    code = request ? smlResetBatch(info, request) : TSDB_CODE_OUT_OF_MEMORY;
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    code = smlModifyAndInsert(info);
+  }
+  if (TSDB_CODE_SUCCESS != code) {
+    uError("SML:0x%" PRIx64 " retry failed since %s", info->id, tstrerror(code));
+    smlInsertCallback(info, info->pRequest, code);
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
 static void smlInsertCallback(void *param, void *res, int32_t code) {
   SRequestObj *pRequest = (SRequestObj *)res;
   SSmlHandle  *info = (SSmlHandle *)param;
   int32_t      rows = taos_affected_rows(pRequest);
 
   uDebug("SML:0x%" PRIx64 " result. code:%d, msg:%s", info->id, pRequest->code, pRequest->msgBuf);
+  if (NEED_CLIENT_HANDLE_ERROR(code)) {
+    smlInvalidateCache(info);
+    if (!info->retried) {
+      info->retried = true;
+      uDebug("SML:0x%" PRIx64 " retry the batch since %s", info->id, tstrerror(code));
+      if (taosAsyncExec(smlRetryBatch, info, NULL) == 0) {
+        return;
+      }
+    }
+  }
   Params *pParam = info->params;
   // lock
   taosThreadSpinLock(&pParam->lock);
@@ -2520,31 +3101,48 @@ static void smlInsertCallback(void *param, void *res, int32_t code) {
   } else {
     pParam->request->body.resInfo.numOfRows += info->affectedRows;
   }
+  bool done = (pParam->cnt == pParam->total);
   // unlock
   taosThreadSpinUnlock(&pParam->lock);
 
-  if (pParam->cnt == pParam->total) {
-    tsem_post(&pParam->sem);
-  }
   uDebug("SML:0x%" PRIx64 " insert finished, code: %d, rows: %d, total: %d", info->id, code, rows, info->affectedRows);
   info->cost.endTime = taosGetTimestampUs();
   info->cost.code = code;
   smlPrintStatisticInfo(info);
   smlDestroyInfo(info);
+
+  if (done) {
+    smlDoneBatches(pParam);
+  }
 }
 
+// The lines are parsed and bound in the calling thread, the batches are submitted asynchronously. Without fp the
+// call waits for all the batches and returns the request, otherwise it returns NULL and fp gets the request.
 TAOS_RES *taos_schemaless_insert_inner(SRequestObj *request, char *lines[], char *rawLine, char *rawLineEnd,
-                                       int numLines, int protocol, int precision) {
+                                       int numLines, int protocol, int precision, __taos_async_fn_t fp, void *param) {
   int      batchs = 0;
+  int      launched = 0;
   STscObj *pTscObj = request->pTscObj;
 
   pTscObj->schemalessType = 1;
   SSmlMsgBuf msg = {ERROR_MSG_BUF_DEFAULT_SIZE, request->msgBuf};
 
-  Params params = {0};
-  params.request = request;
-  tsem_init(&params.sem, 0, 0);
-  taosThreadSpinInit(&(params.lock), 0);
+  Params *params = (Params *)taosMemoryCalloc(1, sizeof(Params));
+  if (params == NULL) {
+    request->code = TSDB_CODE_OUT_OF_MEMORY;
+    if (fp) {
+      fp(param, request, request->code);
+      return NULL;
+    }
+    return (TAOS_RES *)request;
+  }
+  params->request = request;
+  params->fp = fp;
+  params->param = param;
+  // not reached by the batches finished while launching, only the launch below sets the number launched
+  params->total = INT32_MAX;
+  tsem_init(&params->sem, 0, 0);
+  taosThreadSpinInit(&(params->lock), 0);
 
   if (request->pDb == NULL) {
     request->code = TSDB_CODE_PAR_DB_NOT_SPECIFIED;
@@ -2580,7 +3178,6 @@ TAOS_RES *taos_schemaless_insert_inner(SRequestObj *request, char *lines[], char
   }
 
   batchs = ceil(((double)numLines) / LINE_BATCH);
-  params.total = batchs;
   for (int i = 0; i < batchs; ++i) {
     SRequestObj *req = (SRequestObj *)createRequest(pTscObj->id, TSDB_SQL_INSERT, 0);
     if (!req) {
@@ -2604,7 +3201,7 @@ TAOS_RES *taos_schemaless_insert_inner(SRequestObj *request, char *lines[], char
       numLines = 0;
     }
 
-    info->params = &params;
+    info->params = params;
     info->affectedRows = perBatch;
     info->pRequest->body.queryFp = smlInsertCallback;
     info->pRequest->body.param = info;
@@ -2623,21 +3220,55 @@ TAOS_RES *taos_schemaless_insert_inner(SRequestObj *request, char *lines[], char
         }
       }
     }
+    launched++;
     if (code != TSDB_CODE_SUCCESS) {
       info->pRequest->body.queryFp(info, req, code);
     }
   }
-  tsem_wait(&params.sem);
 
 end:
-  taosThreadSpinDestroy(&params.lock);
-  tsem_destroy(&params.sem);
   //  ((STscObj *)taos)->schemalessType = 0;
   pTscObj->schemalessType = 1;
+
+  // only the launched batches call back, finish here if all of them are done already
+  taosThreadSpinLock(&params->lock);
+  params->total = launched;
+  bool done = (params->cnt == params->total);
+  taosThreadSpinUnlock(&params->lock);
+  if (done) {
+    smlDoneBatches(params);
+  }
+  if (fp) {
+    return NULL;
+  }
+
+  tsem_wait(&params->sem);
+  smlDestroyParams(params);
   uDebug("resultend:%s", request->msgBuf);
   return (TAOS_RES *)request;
 }
 
+void smlInsertAsync(TAOS *taos, char *lines[], int numLines, int protocol, int precision, __taos_async_fn_t fp,
+                    void *param) {
+  SRequestObj *request = (SRequestObj *)createRequest(*(int64_t *)taos, TSDB_SQL_INSERT, 0);
+  if (!request) {
+    uError("SML:smlInsertAsync error request is null");
+    fp(param, NULL, terrno);
+    return;
+  }
+
+  if (!lines) {
+    SSmlMsgBuf msg = {ERROR_MSG_BUF_DEFAULT_SIZE, request->msgBuf};
+    request->code = TSDB_CODE_SML_INVALID_DATA;
+    smlBuildInvalidDataMsg(&msg, "lines is null", NULL);
+    fp(param, request, request->code);
+    return;
+  }
+
+  taos_schemaless_insert_inner(request, lines, NULL, NULL, numLines, protocol, precision, fp, param);
+}
+
+
 /**
  * taos_schemaless_insert() parse and insert data points into database according to
  * different protocol.
@@ -2676,7 +3307,7 @@ TAOS_RES *taos_schemaless_insert(TAOS *taos, char *lines[], int numLines, int pr
     return (TAOS_RES *)request;
   }
 
-  return taos_schemaless_insert_inner(request, lines, NULL, NULL, numLines, protocol, precision);
+  return taos_schemaless_insert_inner(request, lines, NULL, NULL, numLines, protocol, precision, NULL, NULL);
 }
 
 TAOS_RES *taos_schemaless_insert_with_reqid(TAOS *taos, char *lines[], int numLines, int protocol, int precision,
@@ -2699,7 +3330,7 @@ TAOS_RES *taos_schemaless_insert_with_reqid(TAOS *taos, char *lines[], int numLi
     return (TAOS_RES *)request;
   }
 
-  return taos_schemaless_insert_inner(request, lines, NULL, NULL, numLines, protocol, precision);
+  return taos_schemaless_insert_inner(request, lines, NULL, NULL, numLines, protocol, precision, NULL, NULL);
 }
 
 TAOS_RES *taos_schemaless_insert_raw(TAOS *taos, char *lines, int len, int32_t *totalRows, int protocol,
@@ -2734,7 +3365,7 @@ TAOS_RES *taos_schemaless_insert_raw(TAOS *taos, char *lines, int len, int32_t *
       tmp = lines + i + 1;
     }
   }
-  return taos_schemaless_insert_inner(request, NULL, lines, lines + len, numLines, protocol, precision);
+  return taos_schemaless_insert_inner(request, NULL, lines, lines + len, numLines, protocol, precision, NULL, NULL);
 }
 
 TAOS_RES *taos_schemaless_insert_raw_with_reqid(TAOS *taos, char *lines, int len, int32_t *totalRows, int protocol,
@@ -2769,5 +3400,5 @@ TAOS_RES *taos_schemaless_insert_raw_with_reqid(TAOS *taos, char *lines, int len
       tmp = lines + i + 1;
     }
   }
-  return taos_schemaless_insert_inner(request, NULL, lines, lines + len, numLines, protocol, precision);
+  return taos_schemaless_insert_inner(request, NULL, lines, lines + len, numLines, protocol, precision, NULL, NULL);
 }
@@ -753,6 +753,13 @@ int stmtBindBatch(TAOS_STMT* stmt, TAOS_MULTI_BIND* bind, int32_t colIdx) {
                             pStmt->bInfo.sBindRowNum);
   }
 
+  if (pStmt->autoBatch.maxRows > 0 && colIdx <= 0) {
+    if (0 == pStmt->autoBatch.numOfRows) {
+      pStmt->autoBatch.firstTs = taosGetTimestampMs();
+    }
+    pStmt->autoBatch.numOfRows += bind->num;
+  }
+
   return TSDB_CODE_SUCCESS;
 }
 
@@ -819,22 +826,9 @@ int stmtUpdateTableUid(STscStmt* pStmt, SSubmitRsp* pRsp) {
   return TSDB_CODE_SUCCESS;
 }
 
-int stmtExec(TAOS_STMT* stmt) {
-  STscStmt*   pStmt = (STscStmt*)stmt;
-  int32_t     code = 0;
-  SSubmitRsp* pRsp = NULL;
-  bool        autoCreateTbl = pStmt->exec.autoCreateTbl;
-
-  STMT_DLOG_E("start to exec");
-
-  STMT_ERR_RET(stmtSwitchStatus(pStmt, STMT_EXECUTE));
-
-  if (STMT_TYPE_QUERY == pStmt->sql.type) {
-    launchQueryImpl(pStmt->exec.pRequest, pStmt->sql.pQuery, true, NULL);
-  } else {
-    STMT_ERR_RET(qBuildStmtOutput(pStmt->sql.pQuery, pStmt->sql.pVgHash, pStmt->exec.pBlockHash));
-    launchQueryImpl(pStmt->exec.pRequest, pStmt->sql.pQuery, true, (autoCreateTbl ? (void**)&pRsp : NULL));
-  }
+// pRes, if not NULL, takes the request, which is then released by the caller
+static int32_t stmtExecDone(STscStmt* pStmt, bool autoCreateTbl, SSubmitRsp* pRsp, TAOS_RES** pRes) {
+  int32_t code = 0;
 
   if (pStmt->exec.pRequest->code && NEED_CLIENT_HANDLE_ERROR(pStmt->exec.pRequest->code)) {
     code = refreshMeta(pStmt->exec.pRequest->pTscObj, pStmt->exec.pRequest);
@@ -854,6 +848,10 @@ int stmtExec(TAOS_STMT* stmt) {
 
 _return:
 
+  if (pRes) {
+    *pRes = pStmt->exec.pRequest;
+    pStmt->exec.pRequest = NULL;
+  }
   stmtCleanExecInfo(pStmt, (code ? false : true), false);
 
   if (TSDB_CODE_SUCCESS == code && autoCreateTbl) {
@@ -872,9 +870,501 @@ _return:
   STMT_RET(code);
 }
 
+static int32_t stmtExecImpl(STscStmt* pStmt) {
+  SSubmitRsp* pRsp = NULL;
+  bool        autoCreateTbl = pStmt->exec.autoCreateTbl;
+
+  if (STMT_TYPE_QUERY == pStmt->sql.type) {
+    launchQueryImpl(pStmt->exec.pRequest, pStmt->sql.pQuery, true, NULL);
+  } else {
+    STMT_ERR_RET(qBuildStmtOutput(pStmt->sql.pQuery, pStmt->sql.pVgHash, pStmt->exec.pBlockHash));
+    launchQueryImpl(pStmt->exec.pRequest, pStmt->sql.pQuery, true, (autoCreateTbl ? (void**)&pRsp : NULL));
+  }
+
+  return stmtExecDone(pStmt, autoCreateTbl, pRsp, NULL);
+}
+
+typedef struct SStmtSubmitParam {
+  STscStmt* pStmt;
+  int32_t   vgId;
+  int64_t   startTs;
+  SArray*   pTables;  // SArray<SName>, written by the submit
+} SStmtSubmitParam;
+
+static void stmtSubmitCb(void* param, void* res, int32_t code) {
+  SStmtSubmitParam* pParam = (SStmtSubmitParam*)param;
+  SStmtAutoBatch*   pBatch = &pParam->pStmt->autoBatch;
+  SRequestObj*      pRequest = (SRequestObj*)res;
+  int64_t           latency = taosGetTimestampUs() - pParam->startTs;
+  int32_t           rows = (TSDB_CODE_SUCCESS == code) ? taos_affected_rows(pRequest) : 0;
+
+  if (code) {
+    tscError("stmt:%p submit to vgId:%d failed, error:%s", pParam->pStmt, pParam->vgId, tstrerror(code));
+  }
+
+  taosThreadMutexLock(&pBatch->mutex);
+  TAOS_STMT_VG_STAT* pStat = (TAOS_STMT_VG_STAT*)taosHashGet(pBatch->pVgStats, &pParam->vgId, sizeof(int32_t));
+  pStat->inflight--;
+  pStat->submits++;
+  pStat->rows += rows;
+  pStat->totalLatencyUs += latency;
+  pStat->maxLatencyUs = TMAX(pStat->maxLatencyUs, latency);
+  if (code) {
+    pStat->failed++;
+    if (TSDB_CODE_SUCCESS == pBatch->code) {
+      pBatch->code = code;
+    }
+  }
+  // the meta is refreshed by the app thread, it may block
+  if (NEED_CLIENT_HANDLE_ERROR(code)) {
+    if (NULL == pBatch->pStaleTables) {
+      TSWAP(pBatch->pStaleTables, pParam->pTables);
+    } else if (NULL == taosArrayAddAll(pBatch->pStaleTables, pParam->pTables)) {
+      tscError("stmt:%p failed to keep the tables of vgId:%d to refresh", pParam->pStmt, pParam->vgId);
+    }
+  }
+  pBatch->numOfInflight--;
+  pBatch->numOfAckRows += rows;
+  taosThreadCondBroadcast(&pBatch->cond);
+  taosThreadMutexUnlock(&pBatch->mutex);
+
+  // the stmt may be closed from here on
+  destroyRequest(pRequest);
+  taosArrayDestroy(pParam->pTables);
+  taosMemoryFree(pParam);
+}
+
+// the names of the tables bound in the vgroup, to refresh their meta if the submit fails with a stale one
+static SArray* stmtGetVgTables(STscStmt* pStmt, int32_t vgId) {
+  SArray* pTables = taosArrayInit(4, sizeof(SName));
+  if (NULL == pTables) {
+    return NULL;
+  }
+
+  size_t keyLen = 0;
+  void*  pIter = taosHashIterate(pStmt->exec.pBlockHash, NULL);
+  while (pIter) {
+    STableMeta* pMeta = qGetTableMetaInDataBlock(*(STableDataBlocks**)pIter);
+    char*       key = taosHashGetKey(pIter, &keyLen);
+    if (pMeta->vgId == vgId) {
+      char  tbFName[TSDB_TABLE_FNAME_LEN] = {0};
+      SName name = {0};
+      memcpy(tbFName, key, TMIN(keyLen, sizeof(tbFName) - 1));
+      if (tNameFromString(&name, tbFName, T_NAME_ACCT | T_NAME_DB | T_NAME_TABLE) ||
+          NULL == taosArrayPush(pTables, &name)) {
+        taosHashCancelIterate(pStmt->exec.pBlockHash, pIter);
+        taosArrayDestroy(pTables);
+        return NULL;
+      }
+    }
+    pIter = taosHashIterate(pStmt->exec.pBlockHash, pIter);
+  }
+
+  return pTables;
+}
+
+// sends the submit of one vgroup without waiting for it, pVgData is taken in any case
+static int32_t stmtSubmitVgData(STscStmt* pStmt, SVgDataBlocks* pVgData) {
+  SStmtAutoBatch*      pBatch = &pStmt->autoBatch;
+  int32_t              vgId = pVgData->vg.vgId;
+  int32_t              code = TSDB_CODE_SUCCESS;
+  SRequestObj*         pRequest = NULL;
+  SQuery*              pQuery = NULL;
+  SStmtSubmitParam*    pParam = NULL;
+  SSqlCallbackWrapper* pWrapper = NULL;
+
+  // wait for a free slot of the vgroup
+  taosThreadMutexLock(&pBatch->mutex);
+  TAOS_STMT_VG_STAT* pStat = (TAOS_STMT_VG_STAT*)taosHashGet(pBatch->pVgStats, &vgId, sizeof(vgId));
+  if (NULL == pStat) {
+    TAOS_STMT_VG_STAT stat = {.vgId = vgId};
+    if (taosHashPut(pBatch->pVgStats, &vgId, sizeof(vgId), &stat, sizeof(stat))) {
+      taosThreadMutexUnlock(&pBatch->mutex);
+      taosMemoryFree(pVgData->pData);
+      taosMemoryFree(pVgData);
+      STMT_ERR_RET(TSDB_CODE_TSC_OUT_OF_MEMORY);
+    }
+    pStat = (TAOS_STMT_VG_STAT*)taosHashGet(pBatch->pVgStats, &vgId, sizeof(vgId));
+  }
+  while (pStat->inflight >= pBatch->maxInflight) {
+    taosThreadCondWait(&pBatch->cond, &pBatch->mutex);
+  }
+  pStat->inflight++;
+  pBatch->numOfInflight++;
+  taosThreadMutexUnlock(&pBatch->mutex);
+
+  pRequest = (SRequestObj*)createRequest(pStmt->taos->id, TSDB_SQL_INSERT, 0);
+  pQuery = (SQuery*)nodesMakeNode(QUERY_NODE_QUERY);
+  pParam = (SStmtSubmitParam*)taosMemoryCalloc(1, sizeof(SStmtSubmitParam));
+  pWrapper = (SSqlCallbackWrapper*)taosMemoryCalloc(1, sizeof(SSqlCallbackWrapper));
+  if (NULL == pRequest || NULL == pQuery || NULL == pParam || NULL == pWrapper) {
+    STMT_ERR_JRET(TSDB_CODE_TSC_OUT_OF_MEMORY);
+  }
+  pParam->pTables = stmtGetVgTables(pStmt, vgId);
+  if (NULL == pParam->pTables) {
+    STMT_ERR_JRET(TSDB_CODE_TSC_OUT_OF_MEMORY);
+  }
+
+  pQuery->execMode = QUERY_EXEC_MODE_SCHEDULE;
+  pQuery->haveResultSet = false;
+  pQuery->msgType = TDMT_VND_SUBMIT;
+  pQuery->pRoot = nodesMakeNode(QUERY_NODE_VNODE_MODIF_STMT);
+  if (NULL == pQuery->pRoot) {
+    STMT_ERR_JRET(TSDB_CODE_TSC_OUT_OF_MEMORY);
+  }
+  SVnodeModifOpStmt* pModif = (SVnodeModifOpStmt*)pQuery->pRoot;
+  pModif->pDataBlocks = taosArrayInit(1, POINTER_BYTES);
+  if (NULL == pModif->pDataBlocks || NULL == taosArrayPush(pModif->pDataBlocks, &pVgData)) {
+    STMT_ERR_JRET(TSDB_CODE_TSC_OUT_OF_MEMORY);
+  }
+  pVgData = NULL;
+
+  pParam->pStmt = pStmt;
+  pParam->vgId = vgId;
+  pParam->startTs = taosGetTimestampUs();
+
+  SAppClusterSummary* pActivity = &pStmt->taos->pAppInfo->summary;
+  atomic_add_fetch_64((int64_t*)&pActivity->numOfInsertsReq, 1);
+
+  pRequest->pQuery = pQuery;
+  pRequest->stmtType = pQuery->pRoot->type;
+  pRequest->body.queryFp = stmtSubmitCb;
+  pRequest->body.param = pParam;
+  pWrapper->pRequest = pRequest;
+  launchAsyncQuery(pRequest, pQuery, NULL, pWrapper);
+  return TSDB_CODE_SUCCESS;
+
+_return:
+
+  taosThreadMutexLock(&pBatch->mutex);
+  pStat->inflight--;
+  pBatch->numOfInflight--;
+  taosThreadCondBroadcast(&pBatch->cond);
+  taosThreadMutexUnlock(&pBatch->mutex);
+
+  if (pVgData) {
+    taosMemoryFree(pVgData->pData);
+    taosMemoryFree(pVgData);
+  }
+  qDestroyQuery(pQuery);
+  destroyRequest(pRequest);
+  if (pParam) {
+    taosArrayDestroy(pParam->pTables);
+  }
+  taosMemoryFree(pParam);
+  taosMemoryFree(pWrapper);
+  return code;
+}
+
+// sends the buffered rows, one submit per vgroup
+static int32_t stmtAutoBatchFlush(STscStmt* pStmt) {
+  SStmtAutoBatch* pBatch = &pStmt->autoBatch;
+  int32_t         code = TSDB_CODE_SUCCESS;
+
+  if (0 == pBatch->numOfRows) {
+    return TSDB_CODE_SUCCESS;
+  }
+  pBatch->numOfRows = 0;
+
+  // the uids of the tables created are needed from the submit response, such rows are sent the usual way
+  if (pStmt->exec.autoCreateTbl) {
+    return stmtExecImpl(pStmt);
+  }
+
+  STMT_ERR_RET(qBuildStmtOutput(pStmt->sql.pQuery, pStmt->sql.pVgHash, pStmt->exec.pBlockHash));
+
+  SVnodeModifOpStmt* pModif = (SVnodeModifOpStmt*)pStmt->sql.pQuery->pRoot;
+  SArray*            pDataBlocks = pModif->pDataBlocks;
+  pModif->pDataBlocks = NULL;
+  for (int32_t i = 0; i < taosArrayGetSize(pDataBlocks); ++i) {
+    SVgDataBlocks* pVgData = (SVgDataBlocks*)taosArrayGetP(pDataBlocks, i);
+    if (TSDB_CODE_SUCCESS == code) {
+      code = stmtSubmitVgData(pStmt, pVgData);
+    } else {
+      taosMemoryFree(pVgData->pData);
+      taosMemoryFree(pVgData);
+    }
+  }
+  taosArrayDestroy(pDataBlocks);
+
+  stmtCleanExecInfo(pStmt, (code ? false : true), false);
+  ++pStmt->sql.runTimes;
+
+  STMT_RET(code);
+}
+
+static void stmtAutoBatchWait(STscStmt* pStmt) {
+  SStmtAutoBatch* pBatch = &pStmt->autoBatch;
+
+  taosThreadMutexLock(&pBatch->mutex);
+  while (pBatch->numOfInflight > 0) {
+    taosThreadCondWait(&pBatch->cond, &pBatch->mutex);
+  }
+  taosThreadMutexUnlock(&pBatch->mutex);
+}
+
+// refreshes the meta of the tables of the submits failed with a stale one, then resets the stmt like stmtExecDone
+static int32_t stmtAutoBatchRefreshMeta(STscStmt* pStmt, SArray* pTables) {
+  SArray* pDbs = taosArrayInit(1, TSDB_DB_FNAME_LEN);
+  if (NULL == pDbs) {
+    taosArrayDestroy(pTables);
+    STMT_ERR_RET(TSDB_CODE_TSC_OUT_OF_MEMORY);
+  }
+
+  // the vgroups of their dbs too, the error may come from a moved table
+  int32_t code = TSDB_CODE_SUCCESS;
+  for (int32_t i = 0; i < taosArrayGetSize(pTables) && TSDB_CODE_SUCCESS == code; ++i) {
+    char dbFName[TSDB_DB_FNAME_LEN] = {0};
+    tNameGetFullDbName(taosArrayGet(pTables, i), dbFName);
+
+    int32_t j = 0;
+    while (j < taosArrayGetSize(pDbs) && strcmp(taosArrayGet(pDbs, j), dbFName) != 0) {
+      ++j;
+    }
+    if (j == taosArrayGetSize(pDbs) && NULL == taosArrayPush(pDbs, dbFName)) {
+      code = TSDB_CODE_TSC_OUT_OF_MEMORY;
+    }
+  }
+
+  if (TSDB_CODE_SUCCESS == code) {
+    code = stmtCreateRequest(pStmt);
+  }
+  if (TSDB_CODE_SUCCESS == code) {
+    SRequestObj* pRequest = pStmt->exec.pRequest;
+    TSWAP(pRequest->dbList, pDbs);
+    TSWAP(pRequest->tableList, pTables);
+    code = refreshMeta(pStmt->taos, pRequest);
+    TSWAP(pRequest->dbList, pDbs);
+    TSWAP(pRequest->tableList, pTables);
+  }
+  taosArrayDestroy(pDbs);
+  taosArrayDestroy(pTables);
+  STMT_ERR_RET(code);
+
+  // the rows buffered are bound with the stale meta too
+  pStmt->autoBatch.numOfRows = 0;
+  STMT_ERR_RET(stmtResetStmt(pStmt));
+  STMT_RET(TSDB_CODE_NEED_RETRY);
+}
+
+// takes the rows affected and the first error of the submits finished since the last call
+static int32_t stmtAutoBatchCollect(STscStmt* pStmt) {
+  SStmtAutoBatch* pBatch = &pStmt->autoBatch;
+
+  taosThreadMutexLock(&pBatch->mutex);
+  // the submits in flight are built with the same meta, they are waited for so that it is refreshed once
+  while (pBatch->pStaleTables && pBatch->numOfInflight > 0) {
+    taosThreadCondWait(&pBatch->cond, &pBatch->mutex);
+  }
+  int32_t rows = pBatch->numOfAckRows;
+  int32_t code = pBatch->code;
+  SArray* pStaleTables = pBatch->pStaleTables;
+  pBatch->numOfAckRows = 0;
+  pBatch->code = TSDB_CODE_SUCCESS;
+  pBatch->pStaleTables = NULL;
+  taosThreadMutexUnlock(&pBatch->mutex);
+
+  pStmt->exec.affectedRows += rows;
+  pStmt->affectedRows += rows;
+
+  if (pStaleTables) {
+    return stmtAutoBatchRefreshMeta(pStmt, pStaleTables);
+  }
+  return code;
+}
+
+static int32_t stmtAutoBatchExec(STscStmt* pStmt) {
+  SStmtAutoBatch* pBatch = &pStmt->autoBatch;
+  int32_t         code = TSDB_CODE_SUCCESS;
+
+  pStmt->exec.affectedRows = 0;
+  if (pBatch->numOfRows >= pBatch->maxRows || taosGetTimestampMs() - pBatch->firstTs >= pBatch->maxDelayMs) {
+    code = stmtAutoBatchFlush(pStmt);
+  }
+
+  int32_t ackCode = stmtAutoBatchCollect(pStmt);
+  STMT_RET(code ? code : ackCode);
+}
+
+int stmtExec(TAOS_STMT* stmt) {
+  STscStmt* pStmt = (STscStmt*)stmt;
+
+  STMT_DLOG_E("start to exec");
+
+  STMT_ERR_RET(stmtSwitchStatus(pStmt, STMT_EXECUTE));
+
+  if (STMT_TYPE_QUERY != pStmt->sql.type && pStmt->autoBatch.maxRows > 0) {
+    return stmtAutoBatchExec(pStmt);
+  }
+
+  return stmtExecImpl(pStmt);
+}
+
+static void stmtExecAsyncCb(void* param, void* res, int32_t code) {
+  STscStmt* pStmt = (STscStmt*)param;
+  pStmt->execFp(pStmt->execParam, res, code);
+}
+
+// The insert is submitted without waiting, fp is called from the scheduler when it is finished. The stmt is not usable
+// until stmtExecAsyncDone is called out of fp, which may refresh the meta and must not block the scheduler. The
+// queries and the inserts in the auto batch mode, which does not wait anyway, are executed synchronously; fp gets no
+// result for them.
+int stmtExecAsync(TAOS_STMT* stmt, __taos_async_fn_t fp, void* param) {
+  STscStmt* pStmt = (STscStmt*)stmt;
+
+  STMT_DLOG_E("start to exec async");
+
+  if (STMT_TYPE_QUERY == pStmt->sql.type) {
+    int32_t code = stmtExec(stmt);
+    fp(param, NULL, code);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (pStmt->autoBatch.maxRows > 0) {
+    pStmt->autoBatch.execCode = stmtExec(stmt);
+    fp(param, NULL, pStmt->autoBatch.execCode);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  STMT_ERR_RET(stmtSwitchStatus(pStmt, STMT_EXECUTE));
+  STMT_ERR_RET(qBuildStmtOutput(pStmt->sql.pQuery, pStmt->sql.pVgHash, pStmt->exec.pBlockHash));
+
+  SSqlCallbackWrapper* pWrapper = (SSqlCallbackWrapper*)taosMemoryCalloc(1, sizeof(SSqlCallbackWrapper));
+  if (pWrapper == NULL) {
+    STMT_ERR_RET(TSDB_CODE_OUT_OF_MEMORY);
+  }
+
+  SRequestObj*        pRequest = pStmt->exec.pRequest;
+  SAppClusterSummary* pActivity = &pStmt->taos->pAppInfo->summary;
+  atomic_add_fetch_64((int64_t*)&pActivity->numOfInsertsReq, 1);
+
+  pStmt->execFp = fp;
+  pStmt->execParam = param;
+  pRequest->isStmtBind = true;
+  pRequest->stmtType = pStmt->sql.pQuery->pRoot->type;
+  pRequest->body.queryFp = stmtExecAsyncCb;
+
+  // nobody waits on the request, its param is the stmt which is not released with it
+  SSyncQueryParam* pSyncParam = pRequest->body.param;
+  if (pSyncParam != NULL) {
+    tsem_destroy(&pSyncParam->sem);
+    taosMemoryFree(pSyncParam);
+  }
+  pRequest->syncQuery = false;
+  pRequest->body.param = pStmt;
+  pWrapper->pRequest = pRequest;
+  launchAsyncQuery(pRequest, pStmt->sql.pQuery, NULL, pWrapper);
+  return TSDB_CODE_SUCCESS;
+}
+
+// pRes takes the request of an insert launched async, it is NULL for the others
+int stmtExecAsyncDone(TAOS_STMT* stmt, TAOS_RES** pRes) {
+  STscStmt*   pStmt = (STscStmt*)stmt;
+  SSubmitRsp* pRsp = NULL;
+  bool        autoCreateTbl = pStmt->exec.autoCreateTbl;
+
+  *pRes = NULL;
+
+  if (STMT_TYPE_QUERY == pStmt->sql.type) {
+    return pStmt->exec.pRequest->code;
+  }
+
+  if (pStmt->autoBatch.maxRows > 0) {
+    return pStmt->autoBatch.execCode;
+  }
+
+  if (autoCreateTbl) {
+    pRsp = pStmt->exec.pRequest->body.resInfo.execRes.res;
+    pStmt->exec.pRequest->body.resInfo.execRes.res = NULL;
+  }
+
+  return stmtExecDone(pStmt, autoCreateTbl, pRsp, pRes);
+}
+
+int stmtSetAutoBatch(TAOS_STMT* stmt, int32_t maxRows, int32_t maxDelayMs, int32_t maxInflight) {
+  STscStmt*       pStmt = (STscStmt*)stmt;
+  SStmtAutoBatch* pBatch = &pStmt->autoBatch;
+
+  STMT_DLOG("start to set auto batch, maxRows:%d, maxDelayMs:%d, maxInflight:%d", maxRows, maxDelayMs, maxInflight);
+
+  if (STMT_TYPE_QUERY == pStmt->sql.type) {
+    tscError("auto batch is not supported by query stmt");
+    STMT_ERR_RET(TSDB_CODE_TSC_STMT_API_ERROR);
+  }
+
+  // the rows buffered are sent with the old settings
+  STMT_ERR_RET(stmtFlush(stmt));
+
+  if (NULL == pBatch->pVgStats) {
+    pBatch->pVgStats = taosHashInit(16, taosGetDefaultHashFunction(TSDB_DATA_TYPE_INT), false, HASH_NO_LOCK);
+    if (NULL == pBatch->pVgStats) {
+      STMT_ERR_RET(TSDB_CODE_TSC_OUT_OF_MEMORY);
+    }
+    taosThreadMutexInit(&pBatch->mutex, NULL);
+    taosThreadCondInit(&pBatch->cond, NULL);
+  }
+
+  pBatch->maxRows = maxRows;
+  pBatch->maxDelayMs = maxDelayMs;
+  pBatch->maxInflight = maxInflight;
+  pBatch->numOfRows = 0;
+
+  return TSDB_CODE_SUCCESS;
+}
+
+int stmtFlush(TAOS_STMT* stmt) {
+  STscStmt* pStmt = (STscStmt*)stmt;
+
+  STMT_DLOG_E("start to flush");
+
+  if (pStmt->autoBatch.maxRows <= 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pStmt->exec.affectedRows = 0;
+  int32_t code = stmtAutoBatchFlush(pStmt);
+  stmtAutoBatchWait(pStmt);
+
+  int32_t ackCode = stmtAutoBatchCollect(pStmt);
+  STMT_RET(code ? code : ackCode);
+}
+
+int stmtGetVgStats(TAOS_STMT* stmt, TAOS_STMT_VG_STAT* stats, int32_t maxNum) {
+  STscStmt*       pStmt = (STscStmt*)stmt;
+  SStmtAutoBatch* pBatch = &pStmt->autoBatch;
+  int32_t         num = 0;
+
+  if (NULL == pBatch->pVgStats) {
+    return 0;
+  }
+
+  taosThreadMutexLock(&pBatch->mutex);
+  void* pIter = taosHashIterate(pBatch->pVgStats, NULL);
+  while (pIter && num < maxNum) {
+    stats[num++] = *(TAOS_STMT_VG_STAT*)pIter;
+    pIter = taosHashIterate(pBatch->pVgStats, pIter);
+  }
+  if (pIter) {
+    taosHashCancelIterate(pBatch->pVgStats, pIter);
+  }
+  taosThreadMutexUnlock(&pBatch->mutex);
+
+  return num;
+}
+
 int stmtClose(TAOS_STMT* stmt) {
   STscStmt* pStmt = (STscStmt*)stmt;
 
+  // the callbacks of the submits in flight still use the stmt
+  if (pStmt->autoBatch.pVgStats) {
+    stmtFlush(stmt);
+    stmtAutoBatchWait(pStmt);
+    taosHashCleanup(pStmt->autoBatch.pVgStats);
+    taosArrayDestroy(pStmt->autoBatch.pStaleTables);
+    taosThreadCondDestroy(&pStmt->autoBatch.cond);
+    taosThreadMutexDestroy(&pStmt->autoBatch.mutex);
+  }
+
   stmtCleanSQLInfo(pStmt);
   taosMemoryFree(stmt);
 
@@ -58,6 +58,9 @@ struct tmq_conf_t {
   int8_t  withTbName;
   int8_t  snapEnable;
   int32_t snapBatchSize;
+  int32_t batchRows;
+  int32_t batchDelayMs;
+  int32_t prefetchDepth;
 
   bool hbBgEnable;
 
@@ -80,6 +83,9 @@ struct tmq_t {
   int8_t  autoCommit;
   int32_t autoCommitInterval;
   int32_t resetOffsetCfg;
+  int32_t batchRows;
+  int32_t batchDelayMs;
+  int32_t prefetchDepth;  // rsp per vg polled ahead of the app
   int64_t consumerId;
 
   bool hbBgEnable;
@@ -107,6 +113,7 @@ struct tmq_t {
 
   // container
   SArray*     clientTopics;  // SArray<SMqClientTopic>
+  SRWLatch    lock;          // the vgs of clientTopics are freed by a rebalance under the write lock
   STaosQueue* mqueue;        // queue of rsp
   STaosQall*  qall;
   STaosQueue* delayedTask;  // delayed task queue for heartbeat and auto commit
@@ -138,11 +145,13 @@ typedef struct {
   int64_t pollCnt;
   // offset
   STqOffsetVal committedOffset;
-  STqOffsetVal currentOffset;
+  STqOffsetVal currentOffset;  // end of the rsp handed to the app
+  STqOffsetVal fetchOffset;    // end of the rsp received, where the next poll starts
   // connection info
   int32_t vgId;
   int32_t vgStatus;
   int32_t vgSkipCnt;
+  int32_t numOfBuffered;  // rsp with data received but not yet handed to the app
   SEpSet  epSet;
 } SMqClientVg;
 
@@ -221,6 +230,7 @@ tmq_conf_t* tmq_conf_new() {
   conf->autoCommitInterval = 5000;
   conf->resetOffset = TMQ_CONF__RESET_OFFSET__EARLIEAST;
   conf->hbBgEnable = true;
+  conf->prefetchDepth = 1;
   return conf;
 }
 
@@ -305,6 +315,27 @@ tmq_conf_res_t tmq_conf_set(tmq_conf_t* conf, const char* key, const char* value
     return TMQ_CONF_OK;
   }
 
+  if (strcmp(key, "msg.batch.rows") == 0) {
+    int32_t rows = atoi(value);
+    if (rows < 0) return TMQ_CONF_INVALID;
+    conf->batchRows = rows;
+    return TMQ_CONF_OK;
+  }
+
+  if (strcmp(key, "msg.batch.delay.ms") == 0) {
+    int32_t delay = atoi(value);
+    if (delay < 0) return TMQ_CONF_INVALID;
+    conf->batchDelayMs = delay;
+    return TMQ_CONF_OK;
+  }
+
+  if (strcmp(key, "msg.prefetch.depth") == 0) {
+    int32_t depth = atoi(value);
+    if (depth < 1) return TMQ_CONF_INVALID;
+    conf->prefetchDepth = depth;
+    return TMQ_CONF_OK;
+  }
+
   if (strcmp(key, "enable.heartbeat.background") == 0) {
     if (strcmp(value, "true") == 0) {
       conf->hbBgEnable = true;
@@ -942,11 +973,15 @@ tmq_t* tmq_consumer_new(tmq_conf_t* conf, char* errstr, int32_t errstrLen) {
   pTmq->commitCb = conf->commitCb;
   pTmq->commitCbUserParam = conf->commitCbUserParam;
   pTmq->resetOffsetCfg = conf->resetOffset;
+  pTmq->batchRows = conf->batchRows;
+  pTmq->batchDelayMs = conf->batchDelayMs;
+  pTmq->prefetchDepth = conf->prefetchDepth;
 
   pTmq->hbBgEnable = conf->hbBgEnable;
 
   // assign consumerId
   pTmq->consumerId = tGenIdPI64();
+  taosInitRWLatch(&pTmq->lock);
 
   // init semaphore
   if (tsem_init(&pTmq->rspSem, 0, 0) != 0) {
@@ -1107,6 +1142,8 @@ void tmq_conf_set_auto_commit_cb(tmq_conf_t* conf, tmq_commit_cb* cb, void* para
   conf->commitCbUserParam = param;
 }
 
+static int32_t tmqPollVg(tmq_t* tmq, int64_t timeout, SMqClientTopic* pTopic, SMqClientVg* pVg);
+
 int32_t tmqPollCb(void* param, SDataBuf* pMsg, int32_t code) {
   SMqPollCbParam* pParam = (SMqPollCbParam*)param;
   SMqClientVg*    pVg = pParam->pVg;
@@ -1178,6 +1215,9 @@ int32_t tmqPollCb(void* param, SDataBuf* pMsg, int32_t code) {
   pRspWrapper->vgHandle = pVg;
   pRspWrapper->topicHandle = pTopic;
 
+  STqOffsetVal rspOffset = {0};
+  bool         hasData = true;
+
   if (rspType == TMQ_MSG_TYPE__POLL_RSP) {
     SDecoder decoder;
     tDecoderInit(&decoder, POINTER_SHIFT(pMsg->pData, sizeof(SMqRspHead)), pMsg->len - sizeof(SMqRspHead));
@@ -1188,6 +1228,8 @@ int32_t tmqPollCb(void* param, SDataBuf* pMsg, int32_t code) {
     tscDebug("consumer:%" PRId64 ", recv poll: vgId:%d, req offset %" PRId64 ", rsp offset %" PRId64 " type %d",
              tmq->consumerId, pVg->vgId, pRspWrapper->dataRsp.reqOffset.version, pRspWrapper->dataRsp.rspOffset.version,
              rspType);
+    rspOffset = pRspWrapper->dataRsp.rspOffset;
+    hasData = pRspWrapper->dataRsp.blockNum > 0;
 
   } else if (rspType == TMQ_MSG_TYPE__POLL_META_RSP) {
     SDecoder decoder;
@@ -1195,12 +1237,15 @@ int32_t tmqPollCb(void* param, SDataBuf* pMsg, int32_t code) {
     tDecodeSMqMetaRsp(&decoder, &pRspWrapper->metaRsp);
     tDecoderClear(&decoder);
     memcpy(&pRspWrapper->metaRsp, pMsg->pData, sizeof(SMqRspHead));
+    rspOffset = pRspWrapper->metaRsp.rspOffset;
   } else if (rspType == TMQ_MSG_TYPE__TAOSX_RSP) {
     SDecoder decoder;
     tDecoderInit(&decoder, POINTER_SHIFT(pMsg->pData, sizeof(SMqRspHead)), pMsg->len - sizeof(SMqRspHead));
     tDecodeSTaosxRsp(&decoder, &pRspWrapper->taosxRsp);
     tDecoderClear(&decoder);
     memcpy(&pRspWrapper->taosxRsp, pMsg->pData, sizeof(SMqRspHead));
+    rspOffset = pRspWrapper->taosxRsp.rspOffset;
+    hasData = pRspWrapper->taosxRsp.blockNum > 0;
   } else {
     ASSERT(0);
   }
@@ -1208,14 +1253,38 @@ int32_t tmqPollCb(void* param, SDataBuf* pMsg, int32_t code) {
   taosMemoryFree(pMsg->pData);
   taosMemoryFree(pMsg->pEpSet);
 
+  // This runs on the rpc thread. The vg stays in wait status until this rsp is accounted, so the poll thread does not
+  // poll it concurrently. A rebalance frees the vgs of the old epoch, so the vg is only touched under the read lock
+  // and while the epoch of the rsp is still the current one; a rsp of an older epoch is dropped by the poll thread.
+  taosRLockLatch(&tmq->lock);
+  bool    current = (msgEpoch == atomic_load_32(&tmq->epoch));
+  int32_t numOfBuffered = 0;
+  if (current) {
+    pVg->fetchOffset = rspOffset;
+    if (hasData) numOfBuffered = atomic_add_fetch_32(&pVg->numOfBuffered, 1);
+  }
+
   taosWriteQitem(tmq->mqueue, pRspWrapper);
+
+  if (current) {
+    if (hasData && numOfBuffered < tmq->prefetchDepth) {
+      // prefetch, poll the next batch while the app is still consuming the buffered ones
+      tscDebug("consumer:%" PRId64 ", prefetch vgId:%d, buffered rsp:%d", tmq->consumerId, pVg->vgId, numOfBuffered);
+      tmqPollVg(tmq, 0, pTopic, pVg);
+    } else {
+      atomic_store_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE);
+    }
+  }
+  taosRUnLockLatch(&tmq->lock);
   tsem_post(&tmq->rspSem);
 
   return 0;
 CREATE_MSG_FAIL:
-  if (epoch == tmq->epoch) {
+  taosRLockLatch(&tmq->lock);
+  if (epoch == atomic_load_32(&tmq->epoch)) {
     atomic_store_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE);
   }
+  taosRUnLockLatch(&tmq->lock);
   tsem_post(&tmq->rspSem);
   return -1;
 }
@@ -1282,6 +1351,7 @@ bool tmqUpdateEp(tmq_t* tmq, int32_t epoch, const SMqAskEpRsp* pRsp) {
       SMqClientVg clientVg = {
           .pollCnt = 0,
           .currentOffset = offsetNew,
+          .fetchOffset = offsetNew,
           .vgId = pVgEp->vgId,
           .epSet = pVgEp->epSet,
           .vgStatus = TMQ_VG_STATUS__IDLE,
@@ -1292,6 +1362,8 @@ bool tmqUpdateEp(tmq_t* tmq, int32_t epoch, const SMqAskEpRsp* pRsp) {
     }
     taosArrayPush(newTopics, &topic);
   }
+  // the vgs of the old epoch are no longer touched by the poll callbacks once the epoch is moved on
+  taosWLockLatch(&tmq->lock);
   if (tmq->clientTopics) {
     int32_t sz = taosArrayGetSize(tmq->clientTopics);
     for (int32_t i = 0; i < sz; i++) {
@@ -1311,6 +1383,7 @@ bool tmqUpdateEp(tmq_t* tmq, int32_t epoch, const SMqAskEpRsp* pRsp) {
     atomic_store_8(&tmq->status, TMQ_CONSUMER_STATUS__READY);
 
   atomic_store_32(&tmq->epoch, epoch);
+  taosWUnLockLatch(&tmq->lock);
   return set;
 }
 
@@ -1472,10 +1545,12 @@ void tmqBuildConsumeReqImpl(SMqPollReq *pReq, tmq_t* tmq, int64_t timeout, SMqCl
 
   pReq->withTbName = tmq->withTbName;
   pReq->timeout = timeout;
+  pReq->batchRows = tmq->batchRows;
+  pReq->batchDelayMs = tmq->batchDelayMs;
   pReq->consumerId = tmq->consumerId;
   pReq->epoch = tmq->epoch;
   /*pReq->currentOffset = reqOffset;*/
-  pReq->reqOffset = pVg->currentOffset;
+  pReq->reqOffset = pVg->fetchOffset;
   pReq->reqId = generateRequestId();
 
   pReq->useSnapshot = tmq->useSnapshot;
@@ -1530,13 +1605,87 @@ SMqTaosxRspObj* tmqBuildTaosxRspFromWrapper(SMqPollRspWrapper* pWrapper) {
   return pRspObj;
 }
 
+static int32_t tmqPollVg(tmq_t* tmq, int64_t timeout, SMqClientTopic* pTopic, SMqClientVg* pVg) {
+  SMqPollReq req = {0};
+  tmqBuildConsumeReqImpl(&req, tmq, timeout, pTopic, pVg);
+  int32_t msgSize = tSerializeSMqPollReq(NULL, 0, &req);
+  if (msgSize < 0) {
+    atomic_store_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE);
+    tsem_post(&tmq->rspSem);
+    return -1;
+  }
+  char *msg = taosMemoryCalloc(1, msgSize);
+  if (NULL == msg) {
+    atomic_store_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE);
+    tsem_post(&tmq->rspSem);
+    return -1;
+  }
+
+  if (tSerializeSMqPollReq(msg, msgSize, &req) < 0) {
+    taosMemoryFree(msg);
+    atomic_store_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE);
+    tsem_post(&tmq->rspSem);
+    return -1;
+  }
+
+  SMqPollCbParam* pParam = taosMemoryMalloc(sizeof(SMqPollCbParam));
+  if (pParam == NULL) {
+    taosMemoryFree(msg);
+    atomic_store_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE);
+    tsem_post(&tmq->rspSem);
+    return -1;
+  }
+  pParam->refId = tmq->refId;
+  pParam->epoch = tmq->epoch;
+
+  pParam->pVg = pVg;
+  pParam->pTopic = pTopic;
+  pParam->vgId = pVg->vgId;
+
+  SMsgSendInfo* sendInfo = taosMemoryCalloc(1, sizeof(SMsgSendInfo));
+  if (sendInfo == NULL) {
+    taosMemoryFree(msg);
+    taosMemoryFree(pParam);
+    atomic_store_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE);
+    tsem_post(&tmq->rspSem);
+    return -1;
+  }
+
+  sendInfo->msgInfo = (SDataBuf){
+      .pData = msg,
+      .len = msgSize,
+      .handle = NULL,
+  };
+  sendInfo->requestId = req.reqId;
+  sendInfo->requestObjRefId = 0;
+  sendInfo->param = pParam;
+  sendInfo->fp = tmqPollCb;
+  sendInfo->msgType = TDMT_VND_TMQ_CONSUME;
+
+  int64_t transporterId = 0;
+  /*printf("send poll\n");*/
+
+  char offsetFormatBuf[80];
+  tFormatOffset(offsetFormatBuf, 80, &pVg->fetchOffset);
+  tscDebug("consumer:%" PRId64 ", send poll to %s vgId:%d, epoch %d, req offset:%s, reqId:%" PRIu64,
+           tmq->consumerId, pTopic->topicName, pVg->vgId, tmq->epoch, offsetFormatBuf, req.reqId);
+  /*printf("send vgId:%d %" PRId64 "\n", pVg->vgId, pVg->currentOffset);*/
+  asyncSendMsgToServer(tmq->pTscObj->pAppInfo->pTransporter, &pVg->epSet, &transporterId, sendInfo);
+  pVg->pollCnt++;
+  tmq->pollCnt++;
+  return 0;
+}
+
 int32_t tmqPollImpl(tmq_t* tmq, int64_t timeout) {
   /*tscDebug("call poll");*/
   for (int i = 0; i < taosArrayGetSize(tmq->clientTopics); i++) {
     SMqClientTopic* pTopic = taosArrayGet(tmq->clientTopics, i);
     for (int j = 0; j < taosArrayGetSize(pTopic->vgs); j++) {
       SMqClientVg* pVg = taosArrayGet(pTopic->vgs, j);
-      int32_t      vgStatus = atomic_val_compare_exchange_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE, TMQ_VG_STATUS__WAIT);
+      if (atomic_load_32(&pVg->numOfBuffered) >= tmq->prefetchDepth) {
+        continue;
+      }
+      int32_t vgStatus = atomic_val_compare_exchange_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE, TMQ_VG_STATUS__WAIT);
       if (vgStatus != TMQ_VG_STATUS__IDLE) {
         int32_t vgSkipCnt = atomic_add_fetch_32(&pVg->vgSkipCnt, 1);
         tscTrace("consumer:%" PRId64 ", epoch %d skip vgId:%d skip cnt %d", tmq->consumerId, tmq->epoch, pVg->vgId,
@@ -1552,74 +1701,9 @@ int32_t tmqPollImpl(tmq_t* tmq, int64_t timeout) {
 #endif
       }
       atomic_store_32(&pVg->vgSkipCnt, 0);
-
-      SMqPollReq req = {0};
-      tmqBuildConsumeReqImpl(&req, tmq, timeout, pTopic, pVg);
-      int32_t msgSize = tSerializeSMqPollReq(NULL, 0, &req);
-      if (msgSize < 0) {
-        atomic_store_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE);
-        tsem_post(&tmq->rspSem);
-        return -1;
-      }
-      char *msg = taosMemoryCalloc(1, msgSize);
-      if (NULL == msg) {
-        atomic_store_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE);
-        tsem_post(&tmq->rspSem);
+      if (tmqPollVg(tmq, timeout, pTopic, pVg) < 0) {
         return -1;
       }
-      
-      if (tSerializeSMqPollReq(msg, msgSize, &req) < 0) {
-        taosMemoryFree(msg);
-        atomic_store_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE);
-        tsem_post(&tmq->rspSem);
-        return -1;
-      }
-      
-      SMqPollCbParam* pParam = taosMemoryMalloc(sizeof(SMqPollCbParam));
-      if (pParam == NULL) {
-        taosMemoryFree(msg);
-        atomic_store_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE);
-        tsem_post(&tmq->rspSem);
-        return -1;
-      }
-      pParam->refId = tmq->refId;
-      pParam->epoch = tmq->epoch;
-
-      pParam->pVg = pVg;
-      pParam->pTopic = pTopic;
-      pParam->vgId = pVg->vgId;
-
-      SMsgSendInfo* sendInfo = taosMemoryCalloc(1, sizeof(SMsgSendInfo));
-      if (sendInfo == NULL) {
-        taosMemoryFree(msg);
-        taosMemoryFree(pParam);
-        atomic_store_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE);
-        tsem_post(&tmq->rspSem);
-        return -1;
-      }
-
-      sendInfo->msgInfo = (SDataBuf){
-          .pData = msg,
-          .len = msgSize,
-          .handle = NULL,
-      };
-      sendInfo->requestId = req.reqId;
-      sendInfo->requestObjRefId = 0;
-      sendInfo->param = pParam;
-      sendInfo->fp = tmqPollCb;
-      sendInfo->msgType = TDMT_VND_TMQ_CONSUME;
-
-      int64_t transporterId = 0;
-      /*printf("send poll\n");*/
-
-      char offsetFormatBuf[80];
-      tFormatOffset(offsetFormatBuf, 80, &pVg->currentOffset);
-      tscDebug("consumer:%" PRId64 ", send poll to %s vgId:%d, epoch %d, req offset:%s, reqId:%" PRIu64,
-               tmq->consumerId, pTopic->topicName, pVg->vgId, tmq->epoch, offsetFormatBuf, req.reqId);
-      /*printf("send vgId:%d %" PRId64 "\n", pVg->vgId, pVg->currentOffset);*/
-      asyncSendMsgToServer(tmq->pTscObj->pAppInfo->pTransporter, &pVg->epSet, &transporterId, sendInfo);
-      pVg->pollCnt++;
-      tmq->pollCnt++;
     }
   }
   return 0;
@@ -1672,12 +1756,12 @@ void* tmqHandleAllRsp(tmq_t* tmq, int64_t timeout, bool pollIfReset) {
         /*printf("vgId:%d, offset %" PRId64 " up to %" PRId64 "\n", pVg->vgId, pVg->currentOffset,
          * rspMsg->msg.rspOffset);*/
         pVg->currentOffset = pollRspWrapper->dataRsp.rspOffset;
-        atomic_store_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE);
         if (pollRspWrapper->dataRsp.blockNum == 0) {
           taosFreeQitem(pollRspWrapper);
           rspWrapper = NULL;
           continue;
         }
+        atomic_sub_fetch_32(&pVg->numOfBuffered, 1);
         // build rsp
         SMqRspObj* pRsp = tmqBuildRspFromWrapper(pollRspWrapper);
         taosFreeQitem(pollRspWrapper);
@@ -1695,7 +1779,7 @@ void* tmqHandleAllRsp(tmq_t* tmq, int64_t timeout, bool pollIfReset) {
         /*printf("vgId:%d, offset %" PRId64 " up to %" PRId64 "\n", pVg->vgId, pVg->currentOffset,
          * rspMsg->msg.rspOffset);*/
         pVg->currentOffset = pollRspWrapper->metaRsp.rspOffset;
-        atomic_store_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE);
+        atomic_sub_fetch_32(&pVg->numOfBuffered, 1);
         // build rsp
         SMqMetaRspObj* pRsp = tmqBuildMetaRspFromWrapper(pollRspWrapper);
         taosFreeQitem(pollRspWrapper);
@@ -1714,12 +1798,12 @@ void* tmqHandleAllRsp(tmq_t* tmq, int64_t timeout, bool pollIfReset) {
         /*printf("vgId:%d, offset %" PRId64 " up to %" PRId64 "\n", pVg->vgId, pVg->currentOffset,
          * rspMsg->msg.rspOffset);*/
         pVg->currentOffset = pollRspWrapper->taosxRsp.rspOffset;
-        atomic_store_32(&pVg->vgStatus, TMQ_VG_STATUS__IDLE);
         if (pollRspWrapper->taosxRsp.blockNum == 0) {
           taosFreeQitem(pollRspWrapper);
           rspWrapper = NULL;
           continue;
         }
+        atomic_sub_fetch_32(&pVg->numOfBuffered, 1);
 
         // build rsp
         void* pRsp = NULL;
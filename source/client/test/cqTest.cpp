@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include "clientInt.h"
+#include "taoserror.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "taos.h"
+
+// the cases except the first one need a running server
+
+namespace {
+
+const int32_t numOfTables = 8;
+const int32_t numOfRows = 100;
+const int64_t startTs = 1640966400000;
+
+void execQuery(TAOS* pConn, const char* sql) {
+  TAOS_RES* pRes = taos_query(pConn, sql);
+  ASSERT_EQ(taos_errno(pRes), TSDB_CODE_SUCCESS) << sql << ": " << taos_errstr(pRes);
+  taos_free_result(pRes);
+}
+
+int64_t queryCount(TAOS* pConn, const char* sql) {
+  TAOS_RES* pRes = taos_query(pConn, sql);
+  EXPECT_EQ(taos_errno(pRes), TSDB_CODE_SUCCESS) << sql << ": " << taos_errstr(pRes);
+  TAOS_ROW pRow = taos_fetch_row(pRes);
+  int64_t  count = (pRow != NULL) ? *(int64_t*)pRow[0] : -1;
+  taos_free_result(pRes);
+  return count;
+}
+
+TAOS* prepareDb(const char* db) {
+  TAOS* pConn = taos_connect("localhost", "root", "taosdata", NULL, 0);
+  if (pConn == NULL) {
+    return NULL;
+  }
+
+  char sql[256] = {0};
+  snprintf(sql, sizeof(sql), "drop database if exists %s", db);
+  execQuery(pConn, sql);
+  snprintf(sql, sizeof(sql), "create database %s vgroups 4", db);
+  execQuery(pConn, sql);
+  snprintf(sql, sizeof(sql), "use %s", db);
+  execQuery(pConn, sql);
+  execQuery(pConn, "create stable stb (ts timestamp, c1 int) tags (t1 int)");
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    snprintf(sql, sizeof(sql), "create table ct_%d using stb tags (%d)", i, i);
+    execQuery(pConn, sql);
+  }
+  return pConn;
+}
+
+// waits for num events, the results are left to the caller
+int32_t pollAll(TAOS_CQ* cq, TAOS_CQ_EVENT* events, int32_t num) {
+  int32_t got = 0;
+  while (got < num) {
+    int32_t n = taos_cq_poll(cq, events + got, num - got, 10000);
+    if (n <= 0) {
+      break;
+    }
+    got += n;
+  }
+  return got;
+}
+
+TAOS_STMT* prepareInsertStmt(TAOS* pConn, int32_t table, int64_t* ts, int32_t* c1, TAOS_MULTI_BIND* bind) {
+  TAOS_STMT* stmt = taos_stmt_init(pConn);
+  EXPECT_NE(stmt, nullptr);
+
+  const char* sql = "insert into ? values(?, ?)";
+  EXPECT_EQ(taos_stmt_prepare(stmt, sql, strlen(sql)), TSDB_CODE_SUCCESS);
+
+  char name[32] = {0};
+  snprintf(name, sizeof(name), "ct_%d", table);
+  EXPECT_EQ(taos_stmt_set_tbname(stmt, name), TSDB_CODE_SUCCESS);
+
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    ts[i] = startTs + i;
+    c1[i] = i;
+  }
+  bind[0] = {TSDB_DATA_TYPE_TIMESTAMP, ts, sizeof(int64_t), NULL, NULL, numOfRows};
+  bind[1] = {TSDB_DATA_TYPE_INT, c1, sizeof(int32_t), NULL, NULL, numOfRows};
+  return stmt;
+}
+
+void bindRows(TAOS_STMT* stmt, TAOS_MULTI_BIND* bind) {
+  ASSERT_EQ(taos_stmt_bind_param_batch(stmt, bind), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(taos_stmt_add_batch(stmt), TSDB_CODE_SUCCESS);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+TEST(cqTest, emptyQueue) {
+  TAOS_CQ_EVENT event = {};
+  EXPECT_EQ(taos_cq_poll(NULL, &event, 1, 0), -1);
+
+  TAOS_CQ* cq = taos_cq_create();
+  ASSERT_NE(cq, nullptr);
+  EXPECT_EQ(taos_cq_poll(cq, &event, 0, 0), -1);
+
+  // nothing in flight, returns at once whatever the timeout
+  EXPECT_EQ(taos_cq_poll(cq, &event, 1, 0), 0);
+  EXPECT_EQ(taos_cq_poll(cq, &event, 1, -1), 0);
+  EXPECT_EQ(taos_cq_poll(cq, &event, 1, 100), 0);
+
+  EXPECT_NE(taos_cq_query(cq, NULL, "show databases", NULL), TSDB_CODE_SUCCESS);
+  EXPECT_NE(taos_cq_stmt_execute(cq, NULL, NULL), TSDB_CODE_SUCCESS);
+  taos_cq_destroy(cq);
+}
+
+TEST(cqTest, queryAndFetch) {
+  TAOS* pConn = prepareDb("cq_db");
+  ASSERT_NE(pConn, nullptr);
+
+  TAOS_CQ* cq = taos_cq_create();
+  ASSERT_NE(cq, nullptr);
+
+  char sql[256] = {0};
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    snprintf(sql, sizeof(sql), "insert into ct_%d values (%" PRId64 ", %d) (%" PRId64 ", %d)", i, startTs, i,
+             startTs + 1, i);
+    ASSERT_EQ(taos_cq_query(cq, pConn, sql, (void*)(intptr_t)i), TSDB_CODE_SUCCESS);
+  }
+
+  TAOS_CQ_EVENT events[numOfTables] = {};
+  ASSERT_EQ(pollAll(cq, events, numOfTables), numOfTables);
+  bool seen[numOfTables] = {0};
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    EXPECT_EQ(events[i].op, TAOS_CQ_QUERY);
+    EXPECT_EQ(events[i].code, TSDB_CODE_SUCCESS);
+    EXPECT_EQ(events[i].numOfRows, 2);
+    seen[(intptr_t)events[i].userData] = true;
+    taos_free_result(events[i].res);
+  }
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    EXPECT_TRUE(seen[i]);
+  }
+
+  ASSERT_EQ(taos_cq_query(cq, pConn, "select * from stb", NULL), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(pollAll(cq, events, 1), 1);
+  ASSERT_EQ(events[0].code, TSDB_CODE_SUCCESS);
+  TAOS_RES* pRes = events[0].res;
+
+  // the fetch event gives back the result of the query, which is released once
+  int32_t rows = 0;
+  while (true) {
+    ASSERT_EQ(taos_cq_fetch(cq, pRes, NULL), TSDB_CODE_SUCCESS);
+    ASSERT_EQ(pollAll(cq, events, 1), 1);
+    EXPECT_EQ(events[0].op, TAOS_CQ_FETCH);
+    EXPECT_EQ(events[0].res, pRes);
+    ASSERT_EQ(events[0].code, TSDB_CODE_SUCCESS);
+    if (events[0].numOfRows == 0) {
+      break;
+    }
+    rows += events[0].numOfRows;
+  }
+  EXPECT_EQ(rows, numOfTables * 2);
+  taos_free_result(pRes);
+
+  // an unpolled result is released with the queue
+  ASSERT_EQ(taos_cq_query(cq, pConn, "select * from stb", NULL), TSDB_CODE_SUCCESS);
+  taos_cq_destroy(cq);
+  taos_close(pConn);
+}
+
+TEST(cqTest, stmtExecute) {
+  TAOS* pConn = prepareDb("cq_stmt_db");
+  ASSERT_NE(pConn, nullptr);
+
+  TAOS_CQ* cq = taos_cq_create();
+  ASSERT_NE(cq, nullptr);
+
+  int64_t         ts[numOfTables][numOfRows];
+  int32_t         c1[numOfTables][numOfRows];
+  TAOS_MULTI_BIND bind[numOfTables][2];
+  TAOS_STMT*      stmts[numOfTables];
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    stmts[i] = prepareInsertStmt(pConn, i, ts[i], c1[i], bind[i]);
+    bindRows(stmts[i], bind[i]);
+    ASSERT_EQ(taos_cq_stmt_execute(cq, stmts[i], (void*)(intptr_t)i), TSDB_CODE_SUCCESS);
+  }
+
+  // the result of each insert is owned by the app, the stmt is usable again once its event is polled
+  TAOS_CQ_EVENT events[numOfTables] = {};
+  ASSERT_EQ(pollAll(cq, events, numOfTables), numOfTables);
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    EXPECT_EQ(events[i].op, TAOS_CQ_STMT_EXECUTE);
+    EXPECT_EQ(events[i].code, TSDB_CODE_SUCCESS);
+    EXPECT_EQ(events[i].numOfRows, numOfRows);
+    EXPECT_EQ(events[i].stmt, stmts[(intptr_t)events[i].userData]);
+    ASSERT_NE(events[i].res, nullptr);
+    EXPECT_EQ(taos_errno(events[i].res), TSDB_CODE_SUCCESS);
+    EXPECT_EQ(taos_affected_rows(events[i].res), numOfRows);
+    taos_free_result(events[i].res);
+  }
+  EXPECT_EQ(queryCount(pConn, "select count(*) from stb"), numOfTables * numOfRows);
+
+  // the results of the inserts not polled are released with the queue, the stmts are still usable after it
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    for (int32_t j = 0; j < numOfRows; ++j) {
+      ts[i][j] += numOfRows;
+    }
+    bindRows(stmts[i], bind[i]);
+    ASSERT_EQ(taos_cq_stmt_execute(cq, stmts[i], NULL), TSDB_CODE_SUCCESS);
+  }
+  taos_cq_destroy(cq);
+  EXPECT_EQ(queryCount(pConn, "select count(*) from stb"), numOfTables * numOfRows * 2);
+
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    for (int32_t j = 0; j < numOfRows; ++j) {
+      ts[i][j] += numOfRows;
+    }
+    bindRows(stmts[i], bind[i]);
+    EXPECT_EQ(taos_stmt_execute(stmts[i]), TSDB_CODE_SUCCESS);
+    EXPECT_EQ(taos_stmt_affected_rows_once(stmts[i]), numOfRows);
+    taos_stmt_close(stmts[i]);
+  }
+  EXPECT_EQ(queryCount(pConn, "select count(*) from stb"), numOfTables * numOfRows * 3);
+  taos_close(pConn);
+}
+
+TEST(cqTest, stmtQuery) {
+  TAOS* pConn = prepareDb("cq_stmt_query_db");
+  ASSERT_NE(pConn, nullptr);
+  execQuery(pConn, "insert into ct_0 values (1640966400000, 1) (1640966400001, 2) (1640966400002, 3)");
+
+  TAOS_STMT*  stmt = taos_stmt_init(pConn);
+  const char* sql = "select * from ct_0 where c1 > ?";
+  ASSERT_NE(stmt, nullptr);
+  ASSERT_EQ(taos_stmt_prepare(stmt, sql, strlen(sql)), TSDB_CODE_SUCCESS);
+
+  int32_t         c1 = 1;
+  TAOS_MULTI_BIND bind = {TSDB_DATA_TYPE_INT, &c1, sizeof(int32_t), NULL, NULL, 1};
+  bindRows(stmt, &bind);
+
+  TAOS_CQ* cq = taos_cq_create();
+  ASSERT_NE(cq, nullptr);
+  ASSERT_EQ(taos_cq_stmt_execute(cq, stmt, NULL), TSDB_CODE_SUCCESS);
+
+  // executed at once, the result stays with the stmt
+  TAOS_CQ_EVENT event = {};
+  ASSERT_EQ(pollAll(cq, &event, 1), 1);
+  EXPECT_EQ(event.code, TSDB_CODE_SUCCESS);
+  EXPECT_EQ(event.res, nullptr);
+
+  TAOS_RES* pRes = taos_stmt_use_result(stmt);
+  ASSERT_NE(pRes, nullptr);
+  int32_t rows = 0;
+  while (taos_fetch_row(pRes) != NULL) {
+    rows++;
+  }
+  EXPECT_EQ(rows, 2);
+
+  taos_cq_destroy(cq);
+  taos_stmt_close(stmt);
+  taos_close(pConn);
+}
+
+TEST(cqTest, schemalessInsert) {
+  TAOS* pConn = prepareDb("cq_sml_db");
+  ASSERT_NE(pConn, nullptr);
+
+  TAOS_CQ* cq = taos_cq_create();
+  ASSERT_NE(cq, nullptr);
+
+  // the lines of each insert go to the tables of all vgroups, so they are submitted in several batches
+  const int32_t numOfInserts = 16;
+  char          buf[numOfInserts][numOfTables][128];
+  char*         lines[numOfInserts][numOfTables];
+  for (int32_t i = 0; i < numOfInserts; ++i) {
+    for (int32_t j = 0; j < numOfTables; ++j) {
+      snprintf(buf[i][j], sizeof(buf[i][j]), "sml_stb,t1=tb%d c1=%di32 %" PRId64, j, i, startTs + i);
+      lines[i][j] = buf[i][j];
+    }
+    ASSERT_EQ(taos_cq_schemaless_insert(cq, pConn, lines[i], numOfTables, TSDB_SML_LINE_PROTOCOL,
+                                        TSDB_SML_TIMESTAMP_MILLI_SECONDS, NULL),
+              TSDB_CODE_SUCCESS);
+  }
+
+  TAOS_CQ_EVENT events[numOfInserts] = {};
+  ASSERT_EQ(pollAll(cq, events, numOfInserts), numOfInserts);
+  for (int32_t i = 0; i < numOfInserts; ++i) {
+    EXPECT_EQ(events[i].op, TAOS_CQ_SCHEMALESS_INSERT);
+    EXPECT_EQ(events[i].code, TSDB_CODE_SUCCESS);
+    EXPECT_EQ(events[i].numOfRows, numOfTables);
+    taos_free_result(events[i].res);
+  }
+  EXPECT_EQ(queryCount(pConn, "select count(*) from sml_stb"), numOfInserts * numOfTables);
+
+  taos_cq_destroy(cq);
+  taos_close(pConn);
+}
+
+#pragma GCC diagnostic pop
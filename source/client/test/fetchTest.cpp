@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "clientInt.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+
+namespace {
+
+const int32_t kNumOfRows = 21;
+const int32_t kNumOfCols = 4;
+
+std::string binaryValue(int32_t row) { return std::string(row % 5, (char)('a' + row % 26)); }
+std::string ncharValue(int32_t row) { return "\xe4\xb8\xad" + std::to_string(row); }
+bool        isNull(int32_t col, int32_t row) { return col > 0 && (row + col) % 4 == 0; }
+
+// a block of ts, int, binary and nchar columns encoded as in a retrieve response, the rows from base on
+char *buildResultBlock(TAOS_FIELD *fields, int32_t base = 0) {
+  SSDataBlock *pBlock = createDataBlock();
+  int8_t       types[kNumOfCols] = {TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BINARY,
+                                    TSDB_DATA_TYPE_NCHAR};
+  int32_t      bytes[kNumOfCols] = {8, 4, 16 + VARSTR_HEADER_SIZE, 16 * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE};
+  for (int32_t i = 0; i < kNumOfCols; ++i) {
+    SColumnInfoData col = createColumnInfoData(types[i], bytes[i], i + 1);
+    blockDataAppendColInfo(pBlock, &col);
+    fields[i].type = types[i];
+    fields[i].bytes = bytes[i];
+  }
+  blockDataEnsureCapacity(pBlock, kNumOfRows);
+
+  char buf[128] = {0};
+  for (int32_t j = 0; j < kNumOfRows; ++j) {
+    int32_t row = base + j;
+    int64_t ts = 1660000000000 + row;
+    int32_t v = row * 10;
+    colDataAppend((SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 0), j, (const char *)&ts, false);
+    colDataAppend((SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 1), j, (const char *)&v, isNull(1, row));
+
+    std::string str = binaryValue(row);
+    STR_WITH_SIZE_TO_VARSTR(buf, str.c_str(), str.size());
+    colDataAppend((SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 2), j, buf, isNull(2, row));
+
+    str = ncharValue(row);
+    int32_t len = 0;
+    taosMbsToUcs4(str.c_str(), str.size(), (TdUcs4 *)varDataVal(buf), sizeof(buf) - VARSTR_HEADER_SIZE, &len);
+    varDataSetLen(buf, len);
+    colDataAppend((SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 3), j, buf, isNull(3, row));
+  }
+  pBlock->info.rows = kNumOfRows;
+
+  char *pData = (char *)taosMemoryCalloc(1, blockGetEncodeSize(pBlock));
+  blockEncode(pBlock, pData, kNumOfCols);
+  blockDataDestroy(pBlock);
+  return pData;
+}
+
+// reads the flatbuffer tables of the arrow messages
+struct FbTable {
+  const char *p;
+
+  const char *field(int32_t slot) const {
+    const char *vtable = p - *(const int32_t *)p;
+    if (4 + 2 * slot >= *(const uint16_t *)vtable) return NULL;
+    uint16_t off = *(const uint16_t *)(vtable + 4 + 2 * slot);
+    return off ? p + off : NULL;
+  }
+  template <typename T>
+  T scalar(int32_t slot) const {
+    const char *f = field(slot);
+    return f ? *(const T *)f : 0;
+  }
+  const char *ref(int32_t slot) const {
+    const char *f = field(slot);
+    return f ? f + *(const uint32_t *)f : NULL;
+  }
+  FbTable     table(int32_t slot) const { return FbTable{ref(slot)}; }
+  uint32_t    vectorSize(int32_t slot) const { return *(const uint32_t *)ref(slot); }
+  const char *vector(int32_t slot) const { return ref(slot) + sizeof(uint32_t); }
+  FbTable     tableAt(int32_t slot, int32_t i) const {
+    const char *e = vector(slot) + i * sizeof(uint32_t);
+    return FbTable{e + *(const uint32_t *)e};
+  }
+};
+
+struct ArrowBuffer {
+  int64_t offset;
+  int64_t length;
+};
+
+int appendArrowStream(void *param, const void *data, int64_t len) {
+  ((std::string *)param)->append((const char *)data, len);
+  return 0;
+}
+
+}  // namespace
+
+TEST(fetchTest, fillColumns) {
+  strcpy(tsCharset, "UTF-8");
+  taosConvInit();
+
+  SReqResultInfo resInfo = {0};
+  resInfo.numOfCols = kNumOfCols;
+  resInfo.fields = (TAOS_FIELD *)taosMemoryCalloc(kNumOfCols, sizeof(TAOS_FIELD));
+  char *pData = buildResultBlock(resInfo.fields);
+  resInfo.pData = pData;
+  resInfo.numOfRows = kNumOfRows;
+  ASSERT_EQ(setResultDataPtr(&resInfo, resInfo.fields, kNumOfCols, kNumOfRows, false), TSDB_CODE_SUCCESS);
+
+  // odd sized batches, the second one does not start at a byte of the null bitmap
+  const int32_t   maxRows = 9;
+  int64_t         ts[maxRows];
+  int32_t         ints[maxRows];
+  char            binary[64];
+  char            nchar[256];
+  int32_t         offsets[2][maxRows + 1];
+  uint8_t         validity[kNumOfCols][BitmapLen(maxRows)];
+  TAOS_COLUMN_BUF cols[kNumOfCols] = {{ts, sizeof(ts), NULL, validity[0]},
+                                      {ints, sizeof(ints), NULL, validity[1]},
+                                      {binary, sizeof(binary), offsets[0], validity[2]},
+                                      {nchar, sizeof(nchar), offsets[1], validity[3]}};
+
+  int32_t start = 0;
+  while (start < kNumOfRows) {
+    int32_t rows = doFillColumns(&resInfo, cols, maxRows);
+    ASSERT_GT(rows, 0);
+    ASSERT_LE(rows, maxRows);
+
+    for (int32_t col = 0; col < kNumOfCols; ++col) {
+      int32_t nulls = 0;
+      for (int32_t j = 0; j < rows; ++j) {
+        bool valid = (cols[col].validity[j / 8] >> (j % 8)) & 1;
+        ASSERT_EQ(valid, !isNull(col, start + j));
+        nulls += !valid;
+      }
+      ASSERT_EQ(cols[col].nullCount, nulls);
+    }
+
+    for (int32_t j = 0; j < rows; ++j) {
+      int32_t row = start + j;
+      ASSERT_EQ(ts[j], 1660000000000 + row);
+      if (!isNull(1, row)) {
+        ASSERT_EQ(ints[j], row * 10);
+      }
+      std::string str(binary + offsets[0][j], offsets[0][j + 1] - offsets[0][j]);
+      ASSERT_EQ(str, isNull(2, row) ? "" : binaryValue(row));
+      str.assign(nchar + offsets[1][j], offsets[1][j + 1] - offsets[1][j]);
+      ASSERT_EQ(str, isNull(3, row) ? "" : ncharValue(row));
+    }
+    ASSERT_EQ(cols[2].length, offsets[0][rows]);
+    start += rows;
+  }
+  ASSERT_EQ(start, kNumOfRows);
+  ASSERT_EQ(doFillColumns(&resInfo, cols, maxRows), 0);
+
+  // the rows are limited by the var data buffer
+  resInfo.current = 0;
+  cols[2].capacity = 5;
+  ASSERT_EQ(doFillColumns(&resInfo, cols, maxRows), 4);
+  cols[2].capacity = 0;
+  ASSERT_EQ(doFillColumns(&resInfo, cols, maxRows), TSDB_CODE_INVALID_PARA);
+  ASSERT_EQ(resInfo.current, 4);
+
+  doFreeReqResultInfo(&resInfo);
+  taosMemoryFree(pData);
+  taosConvDestroy();
+}
+
+TEST(fetchTest, exportArrow) {
+  strcpy(tsCharset, "UTF-8");
+  taosConvInit();
+
+  // the second block repeats some binary and nchar values of the first one
+  const int32_t bases[] = {0, 15};
+  const int32_t numOfBlocks = sizeof(bases) / sizeof(bases[0]);
+  TAOS_FIELD    fields[kNumOfCols] = {0};
+  std::string   out;
+  SArrowWriter *pWriter = NULL;
+  for (int32_t b = 0; b < numOfBlocks; ++b) {
+    SReqResultInfo resInfo = {0};
+    resInfo.numOfCols = kNumOfCols;
+    resInfo.fields = fields;
+    char *pData = buildResultBlock(fields, bases[b]);
+    if (pWriter == NULL) {
+      for (int32_t i = 0; i < kNumOfCols; ++i) {
+        snprintf(fields[i].name, sizeof(fields[i].name), "c%d", i);
+      }
+      pWriter = arrowWriterCreate(fields, kNumOfCols, TSDB_TIME_PRECISION_MILLI, appendArrowStream, &out);
+      ASSERT_NE(pWriter, nullptr);
+    }
+    resInfo.pData = pData;
+    resInfo.numOfRows = kNumOfRows;
+    ASSERT_EQ(setResultDataPtr(&resInfo, fields, kNumOfCols, kNumOfRows, false), TSDB_CODE_SUCCESS);
+    ASSERT_EQ(arrowWriteBlock(pWriter, &resInfo), TSDB_CODE_SUCCESS);
+    resInfo.fields = NULL;
+    doFreeReqResultInfo(&resInfo);
+    taosMemoryFree(pData);
+  }
+  ASSERT_EQ(arrowWriterFinish(pWriter), TSDB_CODE_SUCCESS);
+  arrowWriterDestroy(pWriter);
+
+  // read the stream back
+  std::vector<std::string> dicts[kNumOfCols];
+  int32_t                  numOfBatches = 0;
+  int32_t                  numOfDicts = 0;
+  size_t                   pos = 0;
+  while (true) {
+    ASSERT_LE(pos + 8, out.size());
+    ASSERT_EQ(*(const int32_t *)(out.data() + pos), -1);
+    int32_t metaLen = *(const int32_t *)(out.data() + pos + 4);
+    if (metaLen == 0) break;
+    ASSERT_EQ(metaLen % 8, 0);
+
+    const char *meta = out.data() + pos + 8;
+    FbTable     msg = {meta + *(const uint32_t *)meta};
+    int64_t     bodyLen = msg.scalar<int64_t>(3);
+    const char *body = meta + metaLen;
+    FbTable     header = msg.table(2);
+    ASSERT_EQ(msg.scalar<int16_t>(0), 4);
+    pos += 8 + metaLen + bodyLen;
+    ASSERT_LE(pos, out.size());
+
+    const ArrowBuffer *pBufs = NULL;
+    switch (msg.scalar<uint8_t>(1)) {
+      case 1: {  // schema
+        ASSERT_EQ(header.vectorSize(1), kNumOfCols);
+        const uint8_t types[kNumOfCols] = {10, 2, 5, 5};
+        for (int32_t i = 0; i < kNumOfCols; ++i) {
+          FbTable field = header.tableAt(1, i);
+          ASSERT_STREQ(field.ref(0) + sizeof(uint32_t), fields[i].name);
+          ASSERT_EQ(field.scalar<uint8_t>(2), types[i]);
+          ASSERT_EQ(field.ref(4) != NULL, i >= 2);
+        }
+        ASSERT_EQ(header.tableAt(1, 0).table(3).scalar<int16_t>(0), 1);  // milli second
+        break;
+      }
+      case 2: {  // dictionary
+        int64_t id = header.scalar<int64_t>(0);
+        ASSERT_TRUE(id == 2 || id == 3);
+        ASSERT_EQ(header.scalar<uint8_t>(2) != 0, !dicts[id].empty());
+        FbTable data = header.table(1);
+        pBufs = (const ArrowBuffer *)data.vector(2);
+        const int32_t *offsets = (const int32_t *)(body + pBufs[1].offset);
+        for (int64_t j = 0; j < data.scalar<int64_t>(0); ++j) {
+          dicts[id].push_back(std::string(body + pBufs[2].offset + offsets[j], offsets[j + 1] - offsets[j]));
+        }
+        numOfDicts++;
+        break;
+      }
+      case 3: {  // record batch
+        ASSERT_LT(numOfBatches, numOfBlocks);
+        ASSERT_EQ(header.scalar<int64_t>(0), kNumOfRows);
+        ASSERT_EQ(header.vectorSize(1), kNumOfCols);
+        ASSERT_EQ(header.vectorSize(2), kNumOfCols * 2);
+        pBufs = (const ArrowBuffer *)header.vector(2);
+        for (int32_t j = 0; j < kNumOfRows; ++j) {
+          int32_t row = bases[numOfBatches] + j;
+          for (int32_t col = 0; col < kNumOfCols; ++col) {
+            const uint8_t *validity = (const uint8_t *)(body + pBufs[col * 2].offset);
+            bool           valid = (validity[j / 8] >> (j % 8)) & 1;
+            ASSERT_EQ(valid, !isNull(col, row));
+          }
+          ASSERT_EQ(((const int64_t *)(body + pBufs[1].offset))[j], 1660000000000 + row);
+          if (!isNull(1, row)) {
+            ASSERT_EQ(((const int32_t *)(body + pBufs[3].offset))[j], row * 10);
+          }
+          if (!isNull(2, row)) {
+            ASSERT_EQ(dicts[2].at(((const int32_t *)(body + pBufs[5].offset))[j]), binaryValue(row));
+          }
+          if (!isNull(3, row)) {
+            ASSERT_EQ(dicts[3].at(((const int32_t *)(body + pBufs[7].offset))[j]), ncharValue(row));
+          }
+        }
+        numOfBatches++;
+        break;
+      }
+      default:
+        FAIL();
+    }
+  }
+  ASSERT_EQ(pos + 8, out.size());
+  ASSERT_EQ(numOfBatches, numOfBlocks);
+  ASSERT_EQ(numOfDicts, 2 * numOfBlocks);
+
+  // each value is sent once, the second block only sends the new ones
+  std::set<std::string> values[kNumOfCols];
+  for (int32_t b = 0; b < numOfBlocks; ++b) {
+    for (int32_t row = bases[b]; row < bases[b] + kNumOfRows; ++row) {
+      if (!isNull(2, row)) values[2].insert(binaryValue(row));
+      if (!isNull(3, row)) values[3].insert(ncharValue(row));
+    }
+  }
+  for (int32_t col = 2; col < kNumOfCols; ++col) {
+    ASSERT_EQ(dicts[col].size(), values[col].size());
+    ASSERT_EQ(std::set<std::string>(dicts[col].begin(), dicts[col].end()), values[col]);
+  }
+
+  taosConvDestroy();
+}
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
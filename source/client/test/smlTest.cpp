@@ -1008,3 +1008,167 @@ TEST(testCase, sml_col_4096_Test) {
   ASSERT_NE(ret, 0);
   smlDestroyInfo(info);
 }
+
+TEST(testCase, smlSkipPlain_Test) {
+  const char *sql[] = {"",
+                       "a",
+                       "abcdefgh",
+                       "abcdefghijklmnopq,",
+                       "abcdefg=hijklmnop",
+                       "st,t1=3,t2=4 c1=3i64,c3=\"passit hello,c1=2\",c2=false,c4=4f64 1626006833639000000",
+                       "01234567890123456789\\ escaped",
+                       "\"quoted\""};
+  for (int i = 0; i < sizeof(sql) / sizeof(sql[0]); i++) {
+    const char *sqlEnd = sql[i] + strlen(sql[i]);
+    for (const char *p = sql[i]; p <= sqlEnd; p++) {
+      const char *expect = p;
+      while (expect < sqlEnd && !IS_SML_SPECIAL(*expect)) expect++;
+      ASSERT_EQ(smlSkipPlain(p, sqlEnd), expect);
+    }
+  }
+}
+
+static char *smlBuildRawLines(int32_t numLines, int32_t numTables, int32_t *pLen) {
+  char   *buf = (char *)taosMemoryMalloc(numLines * 128);
+  int32_t len = 0;
+  for (int32_t i = 0; i < numLines; i++) {
+    len += sprintf(buf + len, "cpu,host=host_%d,region=r%d usage=%di64,idle=%d.5,state=\"ok\\\"s\" %" PRId64 "\n",
+                   i % numTables, i % 4, i, i, (int64_t)1626006833639000000 + i / numTables);
+  }
+  *pLen = len;
+  return buf;
+}
+
+TEST(testCase, smlParseLine_parallel_Test) {
+  const int32_t numLines = 20000;
+  const int32_t numTables = 100;
+  int32_t       parseThreads = tsSmlParseThreads;
+  int32_t       len = 0;
+  char         *raw = smlBuildRawLines(numLines, numTables, &len);
+  char         *buf = (char *)taosMemoryMalloc(len);
+
+  SSmlHandle *infos[2] = {0};
+  for (int32_t r = 0; r < 2; r++) {
+    tsSmlParseThreads = (r == 0) ? 1 : 4;
+    memcpy(buf, raw, len);
+
+    infos[r] = smlBuildSmlInfo(NULL, NULL, TSDB_SML_LINE_PROTOCOL, TSDB_SML_TIMESTAMP_NANO_SECONDS);
+    ASSERT_NE(infos[r], nullptr);
+    ASSERT_EQ(smlParseLine(infos[r], NULL, buf, buf + len, numLines), 0);
+  }
+  tsSmlParseThreads = parseThreads;
+
+  // the threads give the same tables, rows and schema as one thread
+  ASSERT_EQ(taosHashGetSize(infos[0]->childTables), numTables);
+  ASSERT_EQ(taosHashGetSize(infos[1]->childTables), numTables);
+  void  *p1 = taosHashIterate(infos[0]->childTables, NULL);
+  size_t keyLen = 0;
+  while (p1) {
+    SSmlTableInfo  *pLeft = *(SSmlTableInfo **)p1;
+    void           *key = taosHashGetKey(p1, &keyLen);
+    SSmlTableInfo **pRight = (SSmlTableInfo **)taosHashGet(infos[1]->childTables, key, keyLen);
+    ASSERT_NE(pRight, nullptr);
+    ASSERT_EQ(pLeft->uid, (*pRight)->uid);
+    ASSERT_EQ(taosArrayGetSize(pLeft->cols), taosArrayGetSize((*pRight)->cols));
+    for (int32_t i = 0; i < taosArrayGetSize(pLeft->cols); i++) {
+      ASSERT_EQ(smlKvTimeHashCompare(taosArrayGet(pLeft->cols, i), taosArrayGet((*pRight)->cols, i)), 0);
+    }
+    p1 = taosHashIterate(infos[0]->childTables, p1);
+  }
+
+  SSmlSTableMeta **pLeftMeta = (SSmlSTableMeta **)taosHashGet(infos[0]->superTables, "cpu", 3);
+  SSmlSTableMeta **pRightMeta = (SSmlSTableMeta **)taosHashGet(infos[1]->superTables, "cpu", 3);
+  ASSERT_NE(pLeftMeta, nullptr);
+  ASSERT_NE(pRightMeta, nullptr);
+  ASSERT_EQ(taosArrayGetSize((*pLeftMeta)->cols), taosArrayGetSize((*pRightMeta)->cols));
+  ASSERT_EQ(taosArrayGetSize((*pLeftMeta)->tags), taosArrayGetSize((*pRightMeta)->tags));
+
+  smlDestroyInfo(infos[0]);
+  smlDestroyInfo(infos[1]);
+  taosMemoryFree(buf);
+  taosMemoryFree(raw);
+}
+
+// a benchmark of the parse threads, run it with --gtest_also_run_disabled_tests
+TEST(testCase, DISABLED_smlParseLine_parallel_Benchmark) {
+  const int32_t numLines = 200000;
+  const int32_t numTables = 1000;
+  int32_t       parseThreads = tsSmlParseThreads;
+  int32_t       len = 0;
+  char         *raw = smlBuildRawLines(numLines, numTables, &len);
+  char         *buf = (char *)taosMemoryMalloc(len);
+
+  for (int32_t threads = 1; threads <= 4; threads *= 2) {
+    tsSmlParseThreads = threads;
+    memcpy(buf, raw, len);
+
+    SSmlHandle *info = smlBuildSmlInfo(NULL, NULL, TSDB_SML_LINE_PROTOCOL, TSDB_SML_TIMESTAMP_NANO_SECONDS);
+    ASSERT_NE(info, nullptr);
+    int64_t st = taosGetTimestampUs();
+    int32_t ret = smlParseLine(info, NULL, buf, buf + len, numLines);
+    int64_t et = taosGetTimestampUs();
+    ASSERT_EQ(ret, 0);
+    ASSERT_EQ(taosHashGetSize(info->childTables), numTables);
+    printf("parse %d lines with %d threads, elapsed time:%" PRId64 " us, %.0f lines/s\n", numLines, threads, et - st,
+           numLines * 1000000.0 / (et - st));
+    smlDestroyInfo(info);
+  }
+  tsSmlParseThreads = parseThreads;
+  taosMemoryFree(buf);
+  taosMemoryFree(raw);
+}
+
+TEST(testCase, smlParseLine_cache_Test) {
+  const int32_t numLines = 1000;
+  const int32_t numTables = 10;
+  int32_t       len = 0;
+  char         *raw = smlBuildRawLines(numLines, numTables, &len);
+  char         *buf = (char *)taosMemoryMalloc(len);
+
+  memcpy(buf, raw, len);
+  SSmlHandle *info = smlBuildSmlInfo(NULL, NULL, TSDB_SML_LINE_PROTOCOL, TSDB_SML_TIMESTAMP_NANO_SECONDS);
+  ASSERT_NE(info, nullptr);
+  ASSERT_EQ(smlParseLine(info, NULL, buf, buf + len, numLines), 0);
+
+  // keep the names of the tables, marked to tell them from the hashed ones
+  SSmlCache *pCache = smlCreateCache();
+  ASSERT_NE(pCache, nullptr);
+  void  *p1 = taosHashIterate(info->childTables, NULL);
+  size_t keyLen = 0;
+  while (p1) {
+    SSmlTableInfo  *tinfo = *(SSmlTableInfo **)p1;
+    void           *key = taosHashGetKey(p1, &keyLen);
+    SSmlCTableCache cached = {0};
+    snprintf(cached.childTableName, sizeof(cached.childTableName), "c%s", tinfo->childTableName);
+    cached.uid = tinfo->uid + 1;
+    taosHashPut(pCache->pCTables, key, keyLen, &cached, sizeof(SSmlCTableCache));
+    p1 = taosHashIterate(info->childTables, p1);
+  }
+
+  // the next batch of the same shape takes the names from the cache
+  memcpy(buf, raw, len);
+  SSmlHandle *next = smlBuildSmlInfo(NULL, NULL, TSDB_SML_LINE_PROTOCOL, TSDB_SML_TIMESTAMP_NANO_SECONDS);
+  ASSERT_NE(next, nullptr);
+  next->cache = pCache;
+  ASSERT_EQ(smlParseLine(next, NULL, buf, buf + len, numLines), 0);
+  ASSERT_EQ(taosHashGetSize(next->childTables), numTables);
+
+  p1 = taosHashIterate(info->childTables, NULL);
+  while (p1) {
+    SSmlTableInfo  *pLeft = *(SSmlTableInfo **)p1;
+    void           *key = taosHashGetKey(p1, &keyLen);
+    SSmlTableInfo **pRight = (SSmlTableInfo **)taosHashGet(next->childTables, key, keyLen);
+    ASSERT_NE(pRight, nullptr);
+    ASSERT_EQ((*pRight)->childTableName[0], 'c');
+    ASSERT_EQ(strcmp((*pRight)->childTableName + 1, pLeft->childTableName), 0);
+    ASSERT_EQ((*pRight)->uid, pLeft->uid + 1);
+    ASSERT_EQ(taosArrayGetSize((*pRight)->tags), taosArrayGetSize(pLeft->tags));
+    p1 = taosHashIterate(info->childTables, p1);
+  }
+
+  smlDestroyInfo(info);
+  smlDestroyInfo(next);
+  smlDestroyCache(pCache);
+  taosMemoryFree(buf);
+  taosMemoryFree(raw);
+}
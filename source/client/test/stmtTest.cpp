@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include "clientInt.h"
+#include "taoserror.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "taos.h"
+
+// the cases need a running server
+
+namespace {
+
+const int32_t numOfTables = 8;
+const int32_t numOfRows = 100;
+const int64_t startTs = 1640966400000;
+
+void execQuery(TAOS* pConn, const char* sql) {
+  TAOS_RES* pRes = taos_query(pConn, sql);
+  ASSERT_EQ(taos_errno(pRes), TSDB_CODE_SUCCESS) << sql << ": " << taos_errstr(pRes);
+  taos_free_result(pRes);
+}
+
+int64_t queryCount(TAOS* pConn, const char* sql) {
+  TAOS_RES* pRes = taos_query(pConn, sql);
+  EXPECT_EQ(taos_errno(pRes), TSDB_CODE_SUCCESS) << sql << ": " << taos_errstr(pRes);
+  TAOS_ROW pRow = taos_fetch_row(pRes);
+  int64_t  count = (pRow != NULL) ? *(int64_t*)pRow[0] : -1;
+  taos_free_result(pRes);
+  return count;
+}
+
+TAOS* prepareDb(const char* db) {
+  TAOS* pConn = taos_connect("localhost", "root", "taosdata", NULL, 0);
+  if (pConn == NULL) {
+    return NULL;
+  }
+
+  char sql[256] = {0};
+  snprintf(sql, sizeof(sql), "drop database if exists %s", db);
+  execQuery(pConn, sql);
+  snprintf(sql, sizeof(sql), "create database %s vgroups 4 keep 36500", db);
+  execQuery(pConn, sql);
+  snprintf(sql, sizeof(sql), "use %s", db);
+  execQuery(pConn, sql);
+  execQuery(pConn, "create stable stb (ts timestamp, c1 int) tags (t1 int)");
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    snprintf(sql, sizeof(sql), "create table ct_%d using stb tags (%d)", i, i);
+    execQuery(pConn, sql);
+  }
+  return pConn;
+}
+
+const char* insertSql = "insert into ? values(?, ?)";
+
+TAOS_STMT* prepareAutoBatchStmt(TAOS* pConn) {
+  TAOS_STMT* stmt = taos_stmt_init(pConn);
+  EXPECT_NE(stmt, nullptr);
+  EXPECT_EQ(taos_stmt_prepare(stmt, insertSql, strlen(insertSql)), TSDB_CODE_SUCCESS);
+
+  // sent by the flush only
+  EXPECT_EQ(taos_stmt_set_auto_batch(stmt, numOfTables * numOfRows * 2, 3600 * 1000, 2), TSDB_CODE_SUCCESS);
+  return stmt;
+}
+
+// the rows of all tables from ts on, returns the first error of the executes and the flush
+int32_t insertRows(TAOS_STMT* stmt, int64_t ts) {
+  int64_t         tsBuf[numOfRows];
+  int32_t         c1Buf[numOfRows];
+  TAOS_MULTI_BIND bind[2] = {{TSDB_DATA_TYPE_TIMESTAMP, tsBuf, sizeof(int64_t), NULL, NULL, numOfRows},
+                             {TSDB_DATA_TYPE_INT, c1Buf, sizeof(int32_t), NULL, NULL, numOfRows}};
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    tsBuf[i] = ts + i;
+    c1Buf[i] = i;
+  }
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  for (int32_t i = 0; i < numOfTables && TSDB_CODE_SUCCESS == code; ++i) {
+    char name[32] = {0};
+    snprintf(name, sizeof(name), "ct_%d", i);
+    code = taos_stmt_set_tbname(stmt, name);
+    if (TSDB_CODE_SUCCESS == code) {
+      code = taos_stmt_bind_param_batch(stmt, bind);
+    }
+    if (TSDB_CODE_SUCCESS == code) {
+      code = taos_stmt_add_batch(stmt);
+    }
+    if (TSDB_CODE_SUCCESS == code) {
+      code = taos_stmt_execute(stmt);
+    }
+  }
+
+  int32_t flushCode = taos_stmt_flush(stmt);
+  return code ? code : flushCode;
+}
+
+int64_t sumVgStats(TAOS_STMT* stmt, int64_t* failed) {
+  TAOS_STMT_VG_STAT stats[16] = {};
+  int32_t           num = taos_stmt_get_vgroup_stats(stmt, stats, 16);
+  int64_t           rows = 0;
+  *failed = 0;
+  for (int32_t i = 0; i < num; ++i) {
+    EXPECT_EQ(stats[i].inflight, 0);
+    rows += stats[i].rows;
+    *failed += stats[i].failed;
+  }
+  return rows;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+TEST(stmtTest, autoBatchSubmitError) {
+  TAOS* pConn = prepareDb("stmt_batch_db");
+  ASSERT_NE(pConn, nullptr);
+
+  TAOS_STMT* stmt = prepareAutoBatchStmt(pConn);
+  ASSERT_EQ(insertRows(stmt, startTs), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(taos_stmt_affected_rows(stmt), numOfTables * numOfRows);
+
+  // out of the keep of the db, reported by the flush and not counted as affected
+  int64_t failed = 0;
+  EXPECT_NE(insertRows(stmt, 0), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(sumVgStats(stmt, &failed), numOfTables * numOfRows);
+
+  // the error is reported once, the stmt is still usable
+  ASSERT_EQ(insertRows(stmt, startTs + numOfRows), TSDB_CODE_SUCCESS);
+  EXPECT_EQ(queryCount(pConn, "select count(*) from stb"), numOfTables * numOfRows * 2);
+
+  taos_stmt_close(stmt);
+  taos_close(pConn);
+}
+
+TEST(stmtTest, autoBatchStaleMeta) {
+  TAOS* pConn = prepareDb("stmt_stale_db");
+  ASSERT_NE(pConn, nullptr);
+
+  TAOS_STMT* stmt = prepareAutoBatchStmt(pConn);
+  ASSERT_EQ(insertRows(stmt, startTs), TSDB_CODE_SUCCESS);
+
+  // the schema cached with the blocks of the stmt is stale from now on
+  TAOS* pOther = taos_connect("localhost", "root", "taosdata", "stmt_stale_db", 0);
+  ASSERT_NE(pOther, nullptr);
+  execQuery(pOther, "alter stable stb add column c2 int");
+  taos_close(pOther);
+
+  // the submits refused are retried by the app after the meta is refreshed, the rows written again are the same. The
+  // stmt is reset, its auto batch settings are kept.
+  int32_t code = insertRows(stmt, startTs + numOfRows);
+  for (int32_t retry = 0; TSDB_CODE_NEED_RETRY == code && retry < 3; ++retry) {
+    ASSERT_EQ(taos_stmt_prepare(stmt, insertSql, strlen(insertSql)), TSDB_CODE_SUCCESS);
+    code = insertRows(stmt, startTs + numOfRows);
+  }
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+  EXPECT_EQ(queryCount(pConn, "select count(*) from stb"), numOfTables * numOfRows * 2);
+
+  taos_stmt_close(stmt);
+  taos_close(pConn);
+}
+
+#pragma GCC diagnostic pop
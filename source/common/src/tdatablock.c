@@ -118,6 +118,55 @@ int32_t colDataAppend(SColumnInfoData* pColumnInfoData, uint32_t currentRow, con
   return 0;
 }
 
+// Decode one column of a batch of rows, the capacity of pColumnInfoData must be no less than numOfRows.
+int32_t colDataAppendFromRows(SColumnInfoData* pColumnInfoData, STSRow** pRows, int32_t numOfRows, STSchema* pSchema,
+                              const STSRowColLoc* pLoc) {
+  if (pLoc->colId == PRIMARYKEY_TIMESTAMP_COL_ID) {
+    TSKEY* pTs = (TSKEY*)pColumnInfoData->pData;
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      pTs[i] = pRows[i]->ts;
+    }
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (pLoc->colIdx < 0) {
+    colDataAppendNNULL(pColumnInfoData, 0, numOfRows);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  bool    isVar = IS_VAR_DATA_TYPE(pColumnInfoData->info.type);
+  int32_t bytes = pColumnInfoData->info.bytes;
+  char*   pDst = pColumnInfoData->pData;
+
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    STSRow* pRow = pRows[i];
+
+    // a tuple row without any null value, the value is at the fixed offset
+    if (!isVar && TD_IS_TP_ROW(pRow) && pRow->statis == 0) {
+      memcpy(pDst + bytes * i, POINTER_SHIFT(TD_ROW_DATA(pRow), pLoc->offset), bytes);
+      continue;
+    }
+
+    SCellVal sVal = {0};
+    tdSTSRowGetValByLoc(pRow, pSchema, pLoc, &sVal);
+    if (sVal.valType != TD_VTYPE_NORM) {
+      colDataAppendNULL(pColumnInfoData, i);
+      continue;
+    }
+
+    if (isVar) {
+      int32_t code = colDataAppend(pColumnInfoData, i, sVal.val, false);
+      if (code != TSDB_CODE_SUCCESS) {
+        return code;
+      }
+    } else {
+      memcpy(pDst + bytes * i, sVal.val, bytes);
+    }
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t colDataReserve(SColumnInfoData* pColumnInfoData, size_t newSize) {
   if (!IS_VAR_DATA_TYPE(pColumnInfoData->info.type)) {
     return TSDB_CODE_SUCCESS;
@@ -356,7 +405,8 @@ size_t blockDataGetNumOfCols(const SSDataBlock* pBlock) { return taosArrayGetSiz
 size_t blockDataGetNumOfRows(const SSDataBlock* pBlock) { return pBlock->info.rows; }
 
 int32_t blockDataUpdateTsWindow(SSDataBlock* pDataBlock, int32_t tsColumnIndex) {
-  if (pDataBlock == NULL || pDataBlock->info.rows <= 0) {
+  // the time range of the block comes from the storage if the column data is not loaded
+  if (pDataBlock == NULL || pDataBlock->info.rows <= 0 || pDataBlock->info.noData) {
     return 0;
   }
 
@@ -487,6 +537,7 @@ SSDataBlock* blockDataExtractBlock(SSDataBlock* pBlock, int32_t startIndex, int3
   pDst->info = pBlock->info;
   pDst->info.rows = 0;
   pDst->info.capacity = 0;
+  pDst->info.noData = false;
   size_t numOfCols = taosArrayGetSize(pBlock->pDataBlock);
   for (int32_t i = 0; i < numOfCols; ++i) {
     SColumnInfoData  colInfo = {0};
@@ -1135,6 +1186,7 @@ void blockDataCleanup(SSDataBlock* pDataBlock) {
   pInfo->groupId = 0;
   pInfo->window.ekey = 0;
   pInfo->window.skey = 0;
+  pInfo->noData = false;
 
   if (pInfo->capacity == 0) {
     return;
@@ -1261,6 +1313,7 @@ int32_t assignOneDataBlock(SSDataBlock* dst, const SSDataBlock* src) {
   dst->info = src->info;
   dst->info.rows = 0;
   dst->info.capacity = 0;
+  dst->info.noData = false;
 
   size_t numOfCols = taosArrayGetSize(src->pDataBlock);
   for (int32_t i = 0; i < numOfCols; ++i) {
@@ -1288,6 +1341,7 @@ int32_t assignOneDataBlock(SSDataBlock* dst, const SSDataBlock* src) {
   uint32_t cap = dst->info.capacity;
   dst->info = src->info;
   dst->info.capacity = cap;
+  dst->info.noData = false;
   return 0;
 }
 
@@ -1314,6 +1368,7 @@ int32_t copyDataBlock(SSDataBlock* dst, const SSDataBlock* src) {
   uint32_t cap = dst->info.capacity;
   dst->info = src->info;
   dst->info.capacity = cap;
+  dst->info.noData = false;
   return TSDB_CODE_SUCCESS;
 }
 
@@ -1367,6 +1422,7 @@ SSDataBlock* blockCopyOneRow(const SSDataBlock* pDataBlock, int32_t rowIdx) {
   pBlock->info = pDataBlock->info;
   pBlock->info.rows = 0;
   pBlock->info.capacity = 0;
+  pBlock->info.noData = false;
 
   size_t numOfCols = taosArrayGetSize(pDataBlock->pDataBlock);
   for (int32_t i = 0; i < numOfCols; ++i) {
@@ -1404,6 +1460,7 @@ SSDataBlock* createOneDataBlock(const SSDataBlock* pDataBlock, bool copyData) {
   pBlock->info = pDataBlock->info;
   pBlock->info.rows = 0;
   pBlock->info.capacity = 0;
+  pBlock->info.noData = false;
   pBlock->info.rowSize = 0;
 
   size_t numOfCols = taosArrayGetSize(pDataBlock->pDataBlock);
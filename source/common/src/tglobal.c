@@ -76,6 +76,8 @@ char tsSmlChildTableName[TSDB_TABLE_NAME_LEN] = "";  // user defined child table
                                                      // If set to empty system will generate table name using MD5 hash.
 // true means that the name and order of cols in each line are the same(only for influx protocol)
 bool tsSmlDataFormat = false;
+// number of threads parsing the lines of one large schemaless batch, 1 means parse in the calling thread
+int32_t tsSmlParseThreads = 1;
 
 // query
 int32_t tsQueryPolicy = 1;
@@ -126,13 +128,31 @@ int32_t tsMaxMemUsedByInsert = 1024;
 // positive value (in MB)
 int32_t tsQueryBufferSize = -1;
 int64_t tsQueryBufferSizeBytes = -1;
+int32_t tsQueryMaxParallelism = 4;
 
 int32_t  tsDiskCfgNum = 0;
 SDiskCfg tsDiskCfg[TFS_MAX_DISKS] = {0};
 
+// the nchar columns of the databases created while set are VARCHAR columns keeping UTF-8, 4 bytes for each char, so
+// the values are neither widened to UCS-4 when stored nor converted back when fetched
+bool tsNcharUtf8 = false;
+
 // stream scheduler
 bool tsDeployOnSnode = true;
 
+// the window states of each stream task are cached in memory up to this size (in MB) before written to tdb
+// 0  the state cache is disabled
+int32_t tsStreamStateCacheSize = 16;
+
+// results waiting for dispatch are coalesced into one msg up to this size (in KB), and optionally compressed by lz4
+int32_t tsStreamDispatchBatchSize = 1024;
+bool    tsStreamDispatchCompress = false;
+
+// the state of each stream task is committed along with the processed wal version at this interval (in seconds), so
+// that only the wal written after the checkpoint is replayed after restart
+// 0  periodic checkpoint is disabled
+int32_t tsStreamCheckpointInterval = 60;
+
 /*
  * minimum scale for whole system, millisecond by default
  * for TSDB_TIME_PRECISION_MILLI: 60000L
@@ -300,6 +320,7 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
   if (cfgAddString(pCfg, "smlChildTableName", "", 1) != 0) return -1;
   if (cfgAddString(pCfg, "smlTagName", tsSmlTagName, 1) != 0) return -1;
   if (cfgAddBool(pCfg, "smlDataFormat", tsSmlDataFormat, 1) != 0) return -1;
+  if (cfgAddInt32(pCfg, "smlParseThreads", tsSmlParseThreads, 1, 64, 1) != 0) return -1;
   if (cfgAddInt32(pCfg, "maxMemUsedByInsert", tsMaxMemUsedByInsert, 1, INT32_MAX, true) != 0) return -1;
   if (cfgAddInt32(pCfg, "rpcRetryLimit", tsRpcRetryLimit, 1, 100000, 0) != 0) return -1;
   if (cfgAddInt32(pCfg, "rpcRetryInterval", tsRpcRetryInterval, 1, 100000, 0) != 0) return -1;
@@ -421,10 +442,16 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddInt32(pCfg, "ttlPushInterval", tsTtlPushInterval, 1, 100000, 1) != 0) return -1;
   if (cfgAddInt32(pCfg, "uptimeInterval", tsUptimeInterval, 1, 100000, 1) != 0) return -1;
   if (cfgAddInt32(pCfg, "queryRsmaTolerance", tsQueryRsmaTolerance, 0, 900000, 0) != 0) return -1;
+  if (cfgAddInt32(pCfg, "queryMaxParallelism", tsQueryMaxParallelism, 1, 64, 0) != 0) return -1;
+  if (cfgAddInt32(pCfg, "streamStateCacheSize", tsStreamStateCacheSize, 0, 4096, 0) != 0) return -1;
+  if (cfgAddInt32(pCfg, "streamDispatchBatchSize", tsStreamDispatchBatchSize, 1, 64 * 1024, 0) != 0) return -1;
+  if (cfgAddBool(pCfg, "streamDispatchCompress", tsStreamDispatchCompress, 0) != 0) return -1;
+  if (cfgAddInt32(pCfg, "streamCheckpointInterval", tsStreamCheckpointInterval, 0, 86400, 0) != 0) return -1;
 
   if (cfgAddInt64(pCfg, "walFsyncDataSizeLimit", tsWalFsyncDataSizeLimit, 100 * 1024 * 1024, INT64_MAX, 0) != 0)
     return -1;
 
+  if (cfgAddBool(pCfg, "ncharUtf8", tsNcharUtf8, 0) != 0) return -1;
   if (cfgAddBool(pCfg, "udf", tsStartUdfd, 0) != 0) return -1;
   if (cfgAddString(pCfg, "udfdResFuncs", tsUdfdResFuncs, 0) != 0) return -1;
   if (cfgAddString(pCfg, "udfdLdLibPath", tsUdfdLdLibPath, 0) != 0) return -1;
@@ -630,6 +657,7 @@ static int32_t taosSetClientCfg(SConfig *pCfg) {
   tstrncpy(tsSmlChildTableName, cfgGetItem(pCfg, "smlChildTableName")->str, TSDB_TABLE_NAME_LEN);
   tstrncpy(tsSmlTagName, cfgGetItem(pCfg, "smlTagName")->str, TSDB_COL_NAME_LEN);
   tsSmlDataFormat = cfgGetItem(pCfg, "smlDataFormat")->bval;
+  tsSmlParseThreads = cfgGetItem(pCfg, "smlParseThreads")->i32;
 
   tsMaxMemUsedByInsert = cfgGetItem(pCfg, "maxMemUsedByInsert")->i32;
 
@@ -712,9 +740,15 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsTtlPushInterval = cfgGetItem(pCfg, "ttlPushInterval")->i32;
   tsUptimeInterval = cfgGetItem(pCfg, "uptimeInterval")->i32;
   tsQueryRsmaTolerance = cfgGetItem(pCfg, "queryRsmaTolerance")->i32;
+  tsQueryMaxParallelism = cfgGetItem(pCfg, "queryMaxParallelism")->i32;
+  tsStreamStateCacheSize = cfgGetItem(pCfg, "streamStateCacheSize")->i32;
+  tsStreamDispatchBatchSize = cfgGetItem(pCfg, "streamDispatchBatchSize")->i32;
+  tsStreamDispatchCompress = cfgGetItem(pCfg, "streamDispatchCompress")->bval;
+  tsStreamCheckpointInterval = cfgGetItem(pCfg, "streamCheckpointInterval")->i32;
 
   tsWalFsyncDataSizeLimit = cfgGetItem(pCfg, "walFsyncDataSizeLimit")->i64;
 
+  tsNcharUtf8 = cfgGetItem(pCfg, "ncharUtf8")->bval;
   tsStartUdfd = cfgGetItem(pCfg, "udf")->bval;
   tstrncpy(tsUdfdResFuncs, cfgGetItem(pCfg, "udfdResFuncs")->str, sizeof(tsUdfdResFuncs));
   tstrncpy(tsUdfdLdLibPath, cfgGetItem(pCfg, "udfdLdLibPath")->str, sizeof(tsUdfdLdLibPath));
@@ -977,6 +1011,8 @@ int32_t taosSetCfg(SConfig *pCfg, char *name) {
         tsQueryUseNodeAllocator = cfgGetItem(pCfg, "queryUseNodeAllocator")->bval;
       } else if (strcasecmp("queryRsmaTolerance", name) == 0) {
         tsQueryRsmaTolerance = cfgGetItem(pCfg, "queryRsmaTolerance")->i32;
+      } else if (strcasecmp("queryMaxParallelism", name) == 0) {
+        tsQueryMaxParallelism = cfgGetItem(pCfg, "queryMaxParallelism")->i32;
       }
       break;
     }
@@ -1001,6 +1037,8 @@ int32_t taosSetCfg(SConfig *pCfg, char *name) {
         tstrncpy(tsSmlTagName, cfgGetItem(pCfg, "smlTagName")->str, TSDB_COL_NAME_LEN);
       } else if (strcasecmp("smlDataFormat", name) == 0) {
         tsSmlDataFormat = cfgGetItem(pCfg, "smlDataFormat")->bval;
+      } else if (strcasecmp("smlParseThreads", name) == 0) {
+        tsSmlParseThreads = cfgGetItem(pCfg, "smlParseThreads")->i32;
       } else if (strcasecmp("shellActivityTimer", name) == 0) {
         tsShellActivityTimer = cfgGetItem(pCfg, "shellActivityTimer")->i32;
       } else if (strcasecmp("supportVnodes", name) == 0) {
@@ -1024,6 +1062,14 @@ int32_t taosSetCfg(SConfig *pCfg, char *name) {
         sDebugFlag = cfgGetItem(pCfg, "sDebugFlag")->i32;
       } else if (strcasecmp("smaDebugFlag", name) == 0) {
         smaDebugFlag = cfgGetItem(pCfg, "smaDebugFlag")->i32;
+      } else if (strcasecmp("streamStateCacheSize", name) == 0) {
+        tsStreamStateCacheSize = cfgGetItem(pCfg, "streamStateCacheSize")->i32;
+      } else if (strcasecmp("streamDispatchBatchSize", name) == 0) {
+        tsStreamDispatchBatchSize = cfgGetItem(pCfg, "streamDispatchBatchSize")->i32;
+      } else if (strcasecmp("streamDispatchCompress", name) == 0) {
+        tsStreamDispatchCompress = cfgGetItem(pCfg, "streamDispatchCompress")->bval;
+      } else if (strcasecmp("streamCheckpointInterval", name) == 0) {
+        tsStreamCheckpointInterval = cfgGetItem(pCfg, "streamCheckpointInterval")->i32;
       }
       break;
     }
@@ -448,6 +448,46 @@ static FORCE_INLINE int32_t tdCompareColId(const void *arg1, const void *arg2) {
   }
 }
 
+void tdSTSRowColLocInit(STSchema *pSchema, col_id_t colId, STSRowColLoc *pLoc) {
+  pLoc->colId = colId;
+  pLoc->type = TSDB_DATA_TYPE_NULL;
+  pLoc->colIdx = -1;
+  pLoc->offset = 0;
+
+  int32_t   key = colId;  // tdCompareColId takes an int32_t key
+  STColumn *pCol =
+      (STColumn *)taosbsearch(&key, pSchema->columns, pSchema->numOfCols, sizeof(STColumn), tdCompareColId, TD_EQ);
+  if (pCol == NULL) {
+    return;
+  }
+
+  pLoc->type = pCol->type;
+  pLoc->colIdx = POINTER_DISTANCE(pCol, pSchema->columns) / sizeof(STColumn);
+  pLoc->offset = pCol->offset - sizeof(TSKEY);
+}
+
+void tdSTSRowGetValByLoc(STSRow *pRow, STSchema *pSchema, const STSRowColLoc *pLoc, SCellVal *pVal) {
+  if (pLoc->colId == PRIMARYKEY_TIMESTAMP_COL_ID) {
+    tdRowSetVal(pVal, TD_VTYPE_NORM, TD_ROW_KEY_ADDR(pRow));
+    return;
+  }
+
+  if (pLoc->colIdx < 0) {
+    pVal->valType = TD_VTYPE_NONE;
+    return;
+  }
+
+  if (TD_IS_TP_ROW(pRow)) {
+    // the bitmap of STpRow excludes the primary TS key
+    tdGetTpRowValOfCol(pVal, pRow, tdGetBitmapAddrTp(pRow, pSchema->flen), pLoc->type, pLoc->offset,
+                       pLoc->colIdx - 1);
+  } else if (TD_IS_KV_ROW(pRow)) {
+    tdSKvRowGetVal(pRow, pLoc->colId, pLoc->colIdx, pVal);
+  } else {
+    pVal->valType = TD_VTYPE_NONE;
+  }
+}
+
 bool tdSTSRowGetVal(STSRowIter *pIter, col_id_t colId, col_type_t colType, SCellVal *pVal) {
   if (colId == PRIMARYKEY_TIMESTAMP_COL_ID) {
     pVal->val = &pIter->pRow->ts;
@@ -154,6 +154,39 @@ TEST(testCase, Datablock_test) {
   taosArrayDestroy(pOrderInfo);
 }
 
+// only the block SMA of a scanned block may be loaded, copies and reused blocks must not claim so
+TEST(testCase, Datablock_noData_test) {
+  SSDataBlock* b = createDataBlock();
+
+  SColumnInfoData infoData = createColumnInfoData(TSDB_DATA_TYPE_INT, 4, 1);
+  blockDataAppendColInfo(b, &infoData);
+  blockDataEnsureCapacity(b, 10);
+  for (int32_t i = 0; i < 10; ++i) {
+    colDataAppend((SColumnInfoData*)taosArrayGet(b->pDataBlock, 0), i, (const char*)&i, false);
+  }
+  b->info.rows = 10;
+  b->info.noData = true;
+
+  SSDataBlock* pCopy = createOneDataBlock(b, true);
+  ASSERT_EQ(pCopy->info.noData, false);
+  ASSERT_EQ(pCopy->info.rows, 10);
+
+  SSDataBlock* pOneRow = blockCopyOneRow(b, 3);
+  ASSERT_EQ(pOneRow->info.noData, false);
+
+  SSDataBlock* pDst = createOneDataBlock(b, false);
+  ASSERT_EQ(copyDataBlock(pDst, b), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(pDst->info.noData, false);
+
+  blockDataCleanup(b);
+  ASSERT_EQ(b->info.noData, false);
+
+  blockDataDestroy(pDst);
+  blockDataDestroy(pOneRow);
+  blockDataDestroy(pCopy);
+  blockDataDestroy(b);
+}
+
 #if 0
 TEST(testCase, non_var_dataBlock_split_test) {
   SSDataBlock* b = static_cast<SSDataBlock*>(taosMemoryCalloc(1, sizeof(SSDataBlock)));
@@ -260,4 +293,116 @@ TEST(testCase, var_dataBlock_split_test) {
   }
 }
 
-#pragma GCC diagnostic pop
\ No newline at end of file
+#pragma GCC diagnostic pop
+TEST(testCase, transpose_rows_test) {
+  const int32_t numOfRows = 200000;
+  const int32_t numOfCols = 5;
+
+  SSchema schema[numOfCols] = {0};
+  int8_t  types[numOfCols] = {TSDB_DATA_TYPE_TIMESTAMP, TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_DOUBLE,
+                              TSDB_DATA_TYPE_BINARY};
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    schema[i].colId = PRIMARYKEY_TIMESTAMP_COL_ID + i;
+    schema[i].type = types[i];
+    schema[i].bytes = IS_VAR_DATA_TYPE(types[i]) ? 16 + VARSTR_HEADER_SIZE : tDataTypes[types[i]].bytes;
+  }
+
+  STSchema* pTSchema = tdGetSTSChemaFromSSChema(schema, numOfCols, 1);
+  ASSERT_NE(pTSchema, nullptr);
+
+  // every 7th row has a null int value, so both paths of the decoding are covered
+  int32_t  rowSize = TD_ROW_HEAD_LEN + pTSchema->flen + TD_BITMAP_BYTES(numOfCols - 1) + 16 + VARSTR_HEADER_SIZE;
+  char*    pBuf = (char*)taosMemoryCalloc(numOfRows, rowSize);
+  STSRow** pRows = (STSRow**)taosMemoryCalloc(numOfRows, POINTER_BYTES);
+  char     str[16 + VARSTR_HEADER_SIZE] = {0};
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    pRows[i] = (STSRow*)(pBuf + (int64_t)rowSize * i);
+
+    SRowBuilder rb = {0};
+    tdSRowInit(&rb, pTSchema->version);
+    tdSRowSetTpInfo(&rb, pTSchema->numOfCols, pTSchema->flen);
+    tdSRowResetBuf(&rb, pRows[i]);
+
+    int64_t ts = 1648791213000 + i;
+    int32_t v1 = i;
+    int64_t v2 = (int64_t)i * 3;
+    double  v3 = i * 0.5;
+    int32_t len = snprintf(varDataVal(str), 16, "row%d", i);
+    varDataSetLen(str, len);
+
+    void*     vals[numOfCols] = {&ts, &v1, &v2, &v3, str};
+    STColumn* pCols = pTSchema->columns;
+    for (int32_t k = 0; k < numOfCols; ++k) {
+      TDRowValT valType = (k == 1 && i % 7 == 0) ? TD_VTYPE_NULL : TD_VTYPE_NORM;
+      tdAppendColValToRow(&rb, pCols[k].colId, pCols[k].type, valType, valType == TD_VTYPE_NORM ? vals[k] : NULL, true,
+                          pCols[k].offset, k);
+    }
+    tdSRowEnd(&rb);
+  }
+
+  SSDataBlock* pRowWise = createDataBlock();
+  SSDataBlock* pColWise = createDataBlock();
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData colInfo = createColumnInfoData(schema[i].type, schema[i].bytes, schema[i].colId);
+    blockDataAppendColInfo(pRowWise, &colInfo);
+    blockDataAppendColInfo(pColWise, &colInfo);
+  }
+  blockDataEnsureCapacity(pRowWise, numOfRows);
+  blockDataEnsureCapacity(pColWise, numOfRows);
+
+  // row by row, the way the tq reader used to decode a submit block
+  int64_t    st = taosGetTimestampUs();
+  STSRowIter iter = {0};
+  tdSTSRowIterInit(&iter, pTSchema);
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    tdSTSRowIterReset(&iter, pRows[i]);
+    for (int32_t k = 0; k < numOfCols; ++k) {
+      SColumnInfoData* pColData = (SColumnInfoData*)taosArrayGet(pRowWise->pDataBlock, k);
+      SCellVal         sVal = {0};
+      if (!tdSTSRowIterFetch(&iter, pColData->info.colId, pColData->info.type, &sVal)) {
+        break;
+      }
+      colDataAppend(pColData, i, (const char*)sVal.val, sVal.valType != TD_VTYPE_NORM);
+    }
+  }
+  int64_t rowWiseUs = taosGetTimestampUs() - st;
+
+  // column by column with the column locations resolved once
+  st = taosGetTimestampUs();
+  for (int32_t k = 0; k < numOfCols; ++k) {
+    SColumnInfoData* pColData = (SColumnInfoData*)taosArrayGet(pColWise->pDataBlock, k);
+    STSRowColLoc     loc = {0};
+    tdSTSRowColLocInit(pTSchema, pColData->info.colId, &loc);
+    ASSERT_EQ(colDataAppendFromRows(pColData, pRows, numOfRows, pTSchema, &loc), TSDB_CODE_SUCCESS);
+  }
+  int64_t colWiseUs = taosGetTimestampUs() - st;
+
+  printf("decode %d rows, row-wise:%" PRId64 "us, column-wise:%" PRId64 "us\n", numOfRows, rowWiseUs, colWiseUs);
+
+  for (int32_t k = 0; k < numOfCols; ++k) {
+    SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(pRowWise->pDataBlock, k);
+    SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(pColWise->pDataBlock, k);
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      bool isNull = colDataIsNull_s(p0, i);
+      ASSERT_EQ(isNull, colDataIsNull_s(p1, i));
+      if (isNull) {
+        continue;
+      }
+
+      char* v0 = colDataGetData(p0, i);
+      char* v1 = colDataGetData(p1, i);
+      if (IS_VAR_DATA_TYPE(p0->info.type)) {
+        ASSERT_EQ(varDataTLen(v0), varDataTLen(v1));
+        ASSERT_EQ(memcmp(v0, v1, varDataTLen(v0)), 0);
+      } else {
+        ASSERT_EQ(memcmp(v0, v1, p0->info.bytes), 0);
+      }
+    }
+  }
+
+  blockDataDestroy(pRowWise);
+  blockDataDestroy(pColWise);
+  taosMemoryFree(pRows);
+  taosMemoryFree(pBuf);
+  taosMemoryFree(pTSchema);
+}
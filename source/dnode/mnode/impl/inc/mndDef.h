@@ -298,6 +298,7 @@ typedef struct {
   int8_t  hashMethod;  // default is 1
   int8_t  cacheLast;
   int8_t  schemaless;
+  int8_t  ncharUtf8;
   int16_t hashPrefix;
   int16_t hashSuffix;
   int16_t sstTrigger;
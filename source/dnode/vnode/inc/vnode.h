@@ -222,6 +222,8 @@ typedef struct STqReader {
   int64_t         cachedSchemaSuid;
   SSchemaWrapper *pSchemaWrapper;
   STSchema       *pSchema;
+  SArray         *pColLocList;  // SArray<STSRowColLoc>, location of the output columns in the cached schema
+  SArray         *pRowList;     // SArray<STSRow*>, rows of the submit block being decoded
 } STqReader;
 
 STqReader *tqOpenReader(SVnode *pVnode);
@@ -116,15 +116,29 @@ typedef struct {
   SMqDataRsp     dataRsp;
   char           subKey[TSDB_SUBSCRIBE_KEY_LEN];
   SRpcHandleInfo pInfo;
+  int64_t        parkTs;        // ms
+  int64_t        expireTs;      // ms, answered with what is collected by then
+  int64_t        firstDataTs;   // us, when the first block was collected into dataRsp
+  int32_t        numOfRows;     // rows collected into dataRsp
+  int32_t        batchRows;     // answered once so many rows are collected, 0 for the first block
+  int32_t        batchDelayMs;  // or once the first block has waited so long, 0 for no bound
 } STqPushEntry;
 
+typedef struct {
+  int64_t numOfRsp;
+  int64_t numOfExpired;  // empty rsp sent on expiry
+  int64_t totalDelayUs;  // from the first block landing to the rsp being sent
+  int64_t maxDelayUs;
+} STqPushStat;
+
 struct STQ {
   SVnode* pVnode;
   char*   path;
 
   SRWLatch pushLock;
 
-  SHashObj* pPushMgr;    // consumerId -> STqPushEntry
+  SHashObj*   pPushMgr;  // consumerId -> STqPushEntry
+  STqPushStat pushStat;  // guarded by pushLock
   SHashObj* pHandle;     // subKey -> STqHandle
   SHashObj* pCheckInfo;  // topic -> SAlterCheckInfo
 
@@ -138,8 +152,11 @@ struct STQ {
 };
 
 typedef struct {
-  int8_t inited;
-  tmr_h  timer;
+  int8_t        inited;
+  tmr_h         timer;
+  tmr_h         pushTimer;  // sweeps parked polls of all opened tq
+  TdThreadMutex lock;
+  SArray*       pTqList;  // SArray<STQ*>
 } STqMgmt;
 
 static STqMgmt tqMgmt = {0};
@@ -158,6 +175,13 @@ int32_t tqAddBlockDataToRsp(const SSDataBlock* pBlock, SMqDataRsp* pRsp, int32_t
 int32_t tqSendDataRsp(STQ* pTq, const SRpcMsg* pMsg, const SMqPollReq* pReq, const SMqDataRsp* pRsp);
 int32_t tqPushDataRsp(STQ* pTq, STqPushEntry* pPushEntry);
 
+// tqPush
+#define TQ_PUSH_SWEEP_INTERVAL_MS 100
+#define TQ_PUSH_PARK_TIMEOUT_MS   10000
+
+bool tqPushEntryReady(const STqPushEntry* pPushEntry, int64_t nowUs);
+void tqPushSweep(STQ* pTq);
+
 // tqMeta
 int32_t tqMetaOpen(STQ* pTq);
 int32_t tqMetaClose(STQ* pTq);
@@ -180,8 +204,11 @@ int32_t         tqOffsetDelete(STqOffsetStore* pStore, const char* subscribeKey)
 int32_t         tqOffsetCommitFile(STqOffsetStore* pStore);
 
 // tqSink
+#define TQ_SINK_SUBMIT_BATCH_SIZE (4 * 1024 * 1024)  // estimated max size of the submit req built by the sink
+
 // void tqSinkToTableMerge(SStreamTask* pTask, void* vnode, int64_t ver, void* data);
-void tqSinkToTablePipeline(SStreamTask* pTask, void* vnode, int64_t ver, void* data);
+void    tqSinkToTablePipeline(SStreamTask* pTask, void* vnode, int64_t ver, void* data);
+int32_t tqBlockToRows(const STSchema* pTSchema, const SSDataBlock* pDataBlock, void* pBuf);
 
 // tqOffset
 char*   tqOffsetBuildFName(const char* path, int32_t fVer);
@@ -15,6 +15,39 @@
 
 #include "tq.h"
 
+static void tqPushTimerFn(void* param, void* tmrId) {
+  if (atomic_load_8(&tqMgmt.inited) != 1) return;
+
+  // tqClose waits on the lock, so no tq is freed during the sweep
+  taosThreadMutexLock(&tqMgmt.lock);
+  int32_t sz = taosArrayGetSize(tqMgmt.pTqList);
+  for (int32_t i = 0; i < sz; i++) {
+    STQ* pTq = *(STQ**)taosArrayGet(tqMgmt.pTqList, i);
+    tqPushSweep(pTq);
+  }
+  taosThreadMutexUnlock(&tqMgmt.lock);
+
+  taosTmrReset(tqPushTimerFn, TQ_PUSH_SWEEP_INTERVAL_MS, NULL, tqMgmt.timer, &tqMgmt.pushTimer);
+}
+
+static void tqRegister(STQ* pTq) {
+  taosThreadMutexLock(&tqMgmt.lock);
+  taosArrayPush(tqMgmt.pTqList, &pTq);
+  taosThreadMutexUnlock(&tqMgmt.lock);
+}
+
+static void tqUnregister(STQ* pTq) {
+  taosThreadMutexLock(&tqMgmt.lock);
+  int32_t sz = taosArrayGetSize(tqMgmt.pTqList);
+  for (int32_t i = 0; i < sz; i++) {
+    if (*(STQ**)taosArrayGet(tqMgmt.pTqList, i) == pTq) {
+      taosArrayRemove(tqMgmt.pTqList, i);
+      break;
+    }
+  }
+  taosThreadMutexUnlock(&tqMgmt.lock);
+}
+
 int32_t tqInit() {
   int8_t old;
   while (1) {
@@ -31,7 +64,10 @@ int32_t tqInit() {
     if (streamInit() < 0) {
       return -1;
     }
+    taosThreadMutexInit(&tqMgmt.lock, NULL);
+    tqMgmt.pTqList = taosArrayInit(4, POINTER_BYTES);
     atomic_store_8(&tqMgmt.inited, 1);
+    tqMgmt.pushTimer = taosTmrStart(tqPushTimerFn, TQ_PUSH_SWEEP_INTERVAL_MS, NULL, tqMgmt.timer);
   }
 
   return 0;
@@ -45,7 +81,11 @@ void tqCleanUp() {
   }
 
   if (old == 1) {
+    taosTmrStopA(&tqMgmt.pushTimer);
     taosTmrCleanUp(tqMgmt.timer);
+    taosArrayDestroy(tqMgmt.pTqList);
+    tqMgmt.pTqList = NULL;
+    taosThreadMutexDestroy(&tqMgmt.lock);
     streamCleanUp();
     atomic_store_8(&tqMgmt.inited, 0);
   }
@@ -109,11 +149,19 @@ STQ* tqOpen(const char* path, SVnode* pVnode) {
     ASSERT(0);
   }
 
+  tqRegister(pTq);
+
   return pTq;
 }
 
 void tqClose(STQ* pTq) {
   if (pTq) {
+    tqUnregister(pTq);
+    tqDebug("vgId:%d, push stat, rsp:%" PRId64 ", expired:%" PRId64 ", avg delay:%" PRId64 "us, max delay:%" PRId64
+            "us",
+            TD_VID(pTq->pVnode), pTq->pushStat.numOfRsp, pTq->pushStat.numOfExpired,
+            pTq->pushStat.numOfRsp > 0 ? pTq->pushStat.totalDelayUs / pTq->pushStat.numOfRsp : 0,
+            pTq->pushStat.maxDelayUs);
     tqOffsetClose(pTq->pOffsetStore);
     taosHashCleanup(pTq->pHandle);
     taosHashCleanup(pTq->pPushMgr);
@@ -173,11 +221,12 @@ int32_t tqPushDataRsp(STQ* pTq, STqPushEntry* pPushEntry) {
   ASSERT(taosArrayGetSize(pRsp->blockSchema) == 0);
 
   if (pRsp->reqOffset.type == TMQ_OFFSET__LOG) {
-    /*if (pRsp->blockNum > 0) {*/
-    /*ASSERT(pRsp->rspOffset.version > pRsp->reqOffset.version);*/
-    /*} else {*/
-    ASSERT(pRsp->rspOffset.version > pRsp->reqOffset.version);
-    /*}*/
+    if (pRsp->blockNum > 0) {
+      ASSERT(pRsp->rspOffset.version > pRsp->reqOffset.version);
+    } else {
+      // expired without any data, the consumer polls again from where it was
+      ASSERT(pRsp->rspOffset.version >= pRsp->reqOffset.version);
+    }
   }
 
   int32_t len = 0;
@@ -212,12 +261,24 @@ int32_t tqPushDataRsp(STQ* pTq, STqPushEntry* pPushEntry) {
 
   tmsgSendRsp(&rsp);
 
+  int64_t delayUs = 0;
+  if (pPushEntry->firstDataTs > 0) {
+    delayUs = taosGetTimestampUs() - pPushEntry->firstDataTs;
+    pTq->pushStat.numOfRsp++;
+    pTq->pushStat.totalDelayUs += delayUs;
+    if (delayUs > pTq->pushStat.maxDelayUs) pTq->pushStat.maxDelayUs = delayUs;
+  } else {
+    pTq->pushStat.numOfExpired++;
+  }
+
   char buf1[80] = {0};
   char buf2[80] = {0};
   tFormatOffset(buf1, 80, &pRsp->reqOffset);
   tFormatOffset(buf2, 80, &pRsp->rspOffset);
-  tqDebug("vgId:%d, from consumer:%" PRId64 ", (epoch %d) push rsp, block num: %d, reqOffset:%s, rspOffset:%s",
-          TD_VID(pTq->pVnode), pRsp->head.consumerId, pRsp->head.epoch, pRsp->blockNum, buf1, buf2);
+  tqDebug("vgId:%d, from consumer:%" PRId64 ", (epoch %d) push rsp, block num: %d, rows:%d, delay:%" PRId64
+          "us, reqOffset:%s, rspOffset:%s",
+          TD_VID(pTq->pVnode), pRsp->head.consumerId, pRsp->head.epoch, pRsp->blockNum, pPushEntry->numOfRows,
+          delayUs, buf1, buf2);
 
   return 0;
 }
@@ -575,6 +636,21 @@ int32_t tqProcessPollReq(STQ* pTq, SRpcMsg* pMsg) {
         pPushEntry->dataRsp.head.consumerId = consumerId;
         pPushEntry->dataRsp.head.epoch = reqEpoch;
         pPushEntry->dataRsp.head.mqMsgType = TMQ_MSG_TYPE__POLL_RSP;
+        pPushEntry->parkTs = taosGetTimestampMs();
+        pPushEntry->expireTs = pPushEntry->parkTs + TQ_PUSH_PARK_TIMEOUT_MS;
+        pPushEntry->batchRows = req.batchRows;
+        pPushEntry->batchDelayMs = req.batchDelayMs;
+
+        // the previous poll parked for the same subscription is replaced, e.g., polled again after a client timeout.
+        // answer it with what it has, otherwise its rpc is never responded.
+        STqPushEntry** ppOld = taosHashGet(pTq->pPushMgr, pHandle->subKey, strlen(pHandle->subKey) + 1);
+        if (ppOld != NULL) {
+          tqDebug("tmq poll: consumer %" PRId64 ", subkey %s, vg %d answer the replaced parked poll", consumerId,
+                  pHandle->subKey, TD_VID(pTq->pVnode));
+          tqPushDataRsp(pTq, *ppOld);
+          taosHashRemove(pTq->pPushMgr, pHandle->subKey, strlen(pHandle->subKey) + 1);
+        }
+
         taosHashPut(pTq->pPushMgr, pHandle->subKey, strlen(pHandle->subKey) + 1, &pPushEntry, sizeof(void*));
         tqDebug("tmq poll: consumer %" PRId64 ", subkey %s, vg %d save handle to push mgr", consumerId, pHandle->subKey,
                 TD_VID(pTq->pVnode));
@@ -903,6 +979,8 @@ int32_t tqExpandTask(STQ* pTq, SStreamTask* pTask, int64_t ver) {
   pTask->pMsgCb = &pTq->pVnode->msgCb;
 
   pTask->startVer = ver;
+  pTask->lastCheckpointTs = taosGetTimestampMs();
+  pTask->dispatchCredit = STREAM_TASK_QUEUE_CAPACITY;
 
   // expand executor
   if (pTask->fillHistory) {
@@ -924,6 +1002,17 @@ int32_t tqExpandTask(STQ* pTq, SStreamTask* pTask, int64_t ver) {
     pTask->exec.executor = qCreateStreamExecTaskInfo(pTask->exec.qmsg, &handle);
     ASSERT(pTask->exec.executor);
 
+    // task reloaded after restart, the data committed to tsdb after the checkpoint is replayed before the new input.
+    // The wal entries after the vnode commit are applied and pushed again, except the ones the checkpoint covers.
+    int64_t checkpointVer = streamStateGetCommittedVer(pTask->pState);
+    int64_t committedVer = pTq->pVnode->state.committed;
+    if (ver < 0 && !pTask->fillHistory && checkpointVer >= 0) {
+      pTask->replayStartVer = checkpointVer;
+      pTask->replayEndVer = TMAX(checkpointVer, committedVer);
+      tqInfo("vgId:%d, stream task %d restored from checkpoint ver %" PRId64 ", replay to ver %" PRId64,
+             TD_VID(pTq->pVnode), pTask->taskId, checkpointVer, pTask->replayEndVer);
+    }
+
   } else if (pTask->taskLevel == TASK_LEVEL__AGG) {
     pTask->pState = streamStateOpen(pTq->pStreamMeta->path, pTask, false, -1, -1);
     if (pTask->pState == NULL) {
@@ -1348,12 +1437,22 @@ int32_t tqProcessSubmitReq(STQ* pTq, SSubmitReq* pReq, int64_t ver) {
       continue;
     }
 
-    tqDebug("data submit enqueue stream task: %d, ver: %" PRId64, pTask->taskId, ver);
+    if (streamTaskSubmitCovered(pTask, ver)) {
+      tqDebug("skip push task %d, ver %" PRId64 " is covered by its checkpoint", pTask->taskId, ver);
+      continue;
+    }
 
     if (!failed) {
-      if (streamTaskInput(pTask, (SStreamQueueItem*)pSubmit) < 0) {
-        tqError("stream task input failed, task id %d", pTask->taskId);
-        continue;
+      // the input is bounded, the submits beyond it are read again from the wal in order by the replay
+      if (streamTaskReplayPending(pTask) || streamTaskInputFull(pTask)) {
+        tqDebug("data submit deferred to replay, stream task: %d, ver: %" PRId64, pTask->taskId, ver);
+        streamTaskDeferSubmit(pTask, ver);
+      } else {
+        tqDebug("data submit enqueue stream task: %d, ver: %" PRId64, pTask->taskId, ver);
+        if (streamTaskInput(pTask, (SStreamQueueItem*)pSubmit) < 0) {
+          tqError("stream task input failed, task id %d", pTask->taskId);
+          continue;
+        }
       }
 
       if (streamSchedExec(pTask) < 0) {
@@ -1518,6 +1617,7 @@ FAIL:
   pRsp->downstreamNodeId = htonl(pVnode->config.vgId);
   pRsp->downstreamTaskId = htonl(req.taskId);
   pRsp->inputStatus = TASK_OUTPUT_STATUS__NORMAL;
+  pRsp->credit = htonl(STREAM_TASK_QUEUE_CAPACITY);
 
   SRpcMsg rsp = {
       .code = code,
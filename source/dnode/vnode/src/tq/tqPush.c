@@ -212,6 +212,64 @@ int32_t tqPushMsgNew(STQ* pTq, void* msg, int32_t msgLen, tmsg_t msgType, int64_
 }
 #endif
 
+bool tqPushEntryReady(const STqPushEntry* pPushEntry, int64_t nowUs) {
+  if (pPushEntry->dataRsp.blockNum == 0) return false;
+  if (pPushEntry->numOfRows >= pPushEntry->batchRows) return true;
+  // without a delay the rows alone decide, and the parked poll is answered with what it has on expiry
+  if (pPushEntry->batchDelayMs <= 0) return false;
+  return nowUs - pPushEntry->firstDataTs >= (int64_t)pPushEntry->batchDelayMs * 1000;
+}
+
+static void tqPushCacheKey(SArray* cachedKeys, SArray* cachedKeyLens, void* pIter) {
+  size_t kLen;
+  void*  key = taosHashGetKey(pIter, &kLen);
+  void*  keyCopy = taosMemoryMalloc(kLen);
+  memcpy(keyCopy, key, kLen);
+
+  taosArrayPush(cachedKeys, &keyCopy);
+  taosArrayPush(cachedKeyLens, &kLen);
+}
+
+static void tqPushRemoveCachedKeys(STQ* pTq, SArray* cachedKeys, SArray* cachedKeyLens) {
+  for (int32_t i = 0; i < taosArrayGetSize(cachedKeys); i++) {
+    void*  key = taosArrayGetP(cachedKeys, i);
+    size_t kLen = *(size_t*)taosArrayGet(cachedKeyLens, i);
+    if (taosHashRemove(pTq->pPushMgr, key, kLen) != 0) {
+      ASSERT(0);
+    }
+  }
+}
+
+// answer the parked polls whose batch is due or which waited too long for data, called by the tq push timer
+void tqPushSweep(STQ* pTq) {
+  taosWLockLatch(&pTq->pushLock);
+  if (taosHashGetSize(pTq->pPushMgr) == 0) {
+    taosWUnLockLatch(&pTq->pushLock);
+    return;
+  }
+
+  SArray* cachedKeys = taosArrayInit(0, sizeof(void*));
+  SArray* cachedKeyLens = taosArrayInit(0, sizeof(size_t));
+  int64_t nowUs = taosGetTimestampUs();
+
+  void* pIter = NULL;
+  while (1) {
+    pIter = taosHashIterate(pTq->pPushMgr, pIter);
+    if (pIter == NULL) break;
+    STqPushEntry* pPushEntry = *(STqPushEntry**)pIter;
+
+    if (tqPushEntryReady(pPushEntry, nowUs) || nowUs / 1000 >= pPushEntry->expireTs) {
+      tqPushCacheKey(cachedKeys, cachedKeyLens, pIter);
+      tqPushDataRsp(pTq, pPushEntry);
+    }
+  }
+
+  tqPushRemoveCachedKeys(pTq, cachedKeys, cachedKeyLens);
+  taosArrayDestroyP(cachedKeys, (FDelete)taosMemoryFree);
+  taosArrayDestroy(cachedKeyLens);
+  taosWUnLockLatch(&pTq->pushLock);
+}
+
 int tqPushMsg(STQ* pTq, void* msg, int32_t msgLen, tmsg_t msgType, int64_t ver) {
   tqDebug("vgId:%d, tq push msg ver %" PRId64 ", type: %s", pTq->pVnode->config.vgId, ver, TMSG_INFO(msgType));
 
@@ -254,6 +312,7 @@ int tqPushMsg(STQ* pTq, void* msg, int32_t msgLen, tmsg_t msgType, int64_t ver)
         qTaskInfo_t    task = pExec->task;
 
         SMqDataRsp* pRsp = &pPushEntry->dataRsp;
+        int32_t     numOfRows = 0;
 
         // prepare scan mem data
         qStreamScanMemData(task, pReq);
@@ -272,33 +331,28 @@ int tqPushMsg(STQ* pTq, void* msg, int32_t msgLen, tmsg_t msgType, int64_t ver)
 
           tqAddBlockDataToRsp(pDataBlock, pRsp, pExec->numOfCols, pTq->pVnode->config.tsdbCfg.precision);
           pRsp->blockNum++;
+          numOfRows += pDataBlock->info.rows;
         }
 
+        if (numOfRows > 0 && pPushEntry->firstDataTs == 0) {
+          pPushEntry->firstDataTs = taosGetTimestampUs();
+        }
+        pPushEntry->numOfRows += numOfRows;
+
         tqDebug("vgId:%d, tq handle push, subkey: %s, block num: %d", pTq->pVnode->config.vgId, pPushEntry->subKey,
                 pRsp->blockNum);
         if (pRsp->blockNum > 0) {
-          // set offset
+          // set offset, also for a batch still collecting since this version has been scanned
           tqOffsetResetToLog(&pRsp->rspOffset, ver);
+        }
+        if (tqPushEntryReady(pPushEntry, taosGetTimestampUs())) {
           // remove from hash
-          size_t kLen;
-          void*  key = taosHashGetKey(pIter, &kLen);
-          void*  keyCopy = taosMemoryMalloc(kLen);
-          memcpy(keyCopy, key, kLen);
-
-          taosArrayPush(cachedKeys, &keyCopy);
-          taosArrayPush(cachedKeyLens, &kLen);
-
+          tqPushCacheKey(cachedKeys, cachedKeyLens, pIter);
           tqPushDataRsp(pTq, pPushEntry);
         }
       }
       // delete entry
-      for (int32_t i = 0; i < taosArrayGetSize(cachedKeys); i++) {
-        void*  key = taosArrayGetP(cachedKeys, i);
-        size_t kLen = *(size_t*)taosArrayGet(cachedKeyLens, i);
-        if (taosHashRemove(pTq->pPushMgr, key, kLen) != 0) {
-          ASSERT(0);
-        }
-      }
+      tqPushRemoveCachedKeys(pTq, cachedKeys, cachedKeyLens);
       taosArrayDestroyP(cachedKeys, (FDelete)taosMemoryFree);
       taosArrayDestroy(cachedKeyLens);
       taosMemoryFree(data);
@@ -272,6 +272,15 @@ STqReader* tqOpenReader(SVnode* pVnode) {
   pReader->pSchema = NULL;
   pReader->pSchemaWrapper = NULL;
   pReader->tbIdHash = NULL;
+  pReader->pColLocList = taosArrayInit(8, sizeof(STSRowColLoc));
+  pReader->pRowList = taosArrayInit(1024, POINTER_BYTES);
+  if (pReader->pColLocList == NULL || pReader->pRowList == NULL) {
+    taosArrayDestroy(pReader->pColLocList);
+    taosArrayDestroy(pReader->pRowList);
+    walCloseReader(pReader->pWalReader);
+    taosMemoryFree(pReader);
+    return NULL;
+  }
   return pReader;
 }
 
@@ -290,6 +299,8 @@ void tqCloseReader(STqReader* pReader) {
   if (pReader->pColIdList) {
     taosArrayDestroy(pReader->pColIdList);
   }
+  taosArrayDestroy(pReader->pColLocList);
+  taosArrayDestroy(pReader->pRowList);
   // free hash
   taosHashCleanup(pReader->tbIdHash);
   taosMemoryFree(pReader);
@@ -471,6 +482,7 @@ int32_t tqRetrieveDataBlock(SSDataBlock* pBlock, STqReader* pReader) {
     }
     pReader->cachedSchemaVer = sversion;
     pReader->cachedSchemaSuid = pReader->msgIter.suid;
+    taosArrayClear(pReader->pColLocList);
   }
 
   STSchema*       pTschema = pReader->pSchema;
@@ -523,31 +535,46 @@ int32_t tqRetrieveDataBlock(SSDataBlock* pBlock, STqReader* pReader) {
 
   int32_t colActual = blockDataGetNumOfCols(pBlock);
 
-  STSRowIter iter = {0};
-  tdSTSRowIterInit(&iter, pTschema);
-  STSRow* row;
-  int32_t curRow = 0;
+  // the location of each output column is resolved once per schema version
+  if (taosArrayGetSize(pReader->pColLocList) != colActual) {
+    taosArrayClear(pReader->pColLocList);
+    for (int32_t i = 0; i < colActual; i++) {
+      SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, i);
+      STSRowColLoc     loc = {0};
+      tdSTSRowColLocInit(pTschema, pColData->info.colId, &loc);
+      if (taosArrayPush(pReader->pColLocList, &loc) == NULL) {
+        terrno = TSDB_CODE_OUT_OF_MEMORY;
+        goto FAIL;
+      }
+    }
+  }
 
+  STSRow* row;
+  taosArrayClear(pReader->pRowList);
   tInitSubmitBlkIter(&pReader->msgIter, pReader->pBlock, &pReader->blkIter);
+  while ((row = tGetSubmitBlkNext(&pReader->blkIter)) != NULL) {
+    if (taosArrayPush(pReader->pRowList, &row) == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      goto FAIL;
+    }
+  }
+
+  int32_t numOfRows = taosArrayGetSize(pReader->pRowList);
 
   pBlock->info.uid = pReader->msgIter.uid;
-  pBlock->info.rows = pReader->msgIter.numOfRows;
+  pBlock->info.rows = numOfRows;
   pBlock->info.version = pReader->pMsg->version;
 
-  while ((row = tGetSubmitBlkNext(&pReader->blkIter)) != NULL) {
-    tdSTSRowIterReset(&iter, row);
-    // get all wanted col of that block
-    for (int32_t i = 0; i < colActual; i++) {
-      SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, i);
-      SCellVal         sVal = {0};
-      if (!tdSTSRowIterFetch(&iter, pColData->info.colId, pColData->info.type, &sVal)) {
-        break;
-      }
-      if (colDataAppend(pColData, curRow, sVal.val, sVal.valType != TD_VTYPE_NORM) < 0) {
-        goto FAIL;
-      }
+  // transpose the rows column by column
+  STSRow** pRows = (STSRow**)pReader->pRowList->pData;
+  for (int32_t i = 0; i < colActual; i++) {
+    SColumnInfoData* pColData = taosArrayGet(pBlock->pDataBlock, i);
+    STSRowColLoc*    pLoc = taosArrayGet(pReader->pColLocList, i);
+    int32_t          code = colDataAppendFromRows(pColData, pRows, numOfRows, pTschema, pLoc);
+    if (code != TSDB_CODE_SUCCESS) {
+      terrno = code;
+      goto FAIL;
     }
-    curRow++;
   }
   return 0;
 
@@ -584,6 +611,7 @@ int32_t tqRetrieveTaosxBlock(STqReader* pReader, SArray* blocks, SArray* schemas
     }
     pReader->cachedSchemaVer = sversion;
     pReader->cachedSchemaSuid = pReader->msgIter.suid;
+    taosArrayClear(pReader->pColLocList);
   }
 
   STSchema*       pTschema = pReader->pSchema;
@@ -691,7 +719,10 @@ FAIL:
   return -1;
 }
 
-void tqReaderSetColIdList(STqReader* pReader, SArray* pColIdList) { pReader->pColIdList = pColIdList; }
+void tqReaderSetColIdList(STqReader* pReader, SArray* pColIdList) {
+  pReader->pColIdList = pColIdList;
+  taosArrayClear(pReader->pColLocList);
+}
 
 int tqReaderSetTbUidList(STqReader* pReader, const SArray* tbUidList) {
   if (pReader->tbIdHash) {
@@ -710,6 +741,7 @@ int tqReaderSetTbUidList(STqReader* pReader, const SArray* tbUidList) {
     taosHashPut(pReader->tbIdHash, pKey, sizeof(int64_t), NULL, 0);
   }
 
+  walReaderSetUidFilter(pReader->pWalReader, pReader->tbIdHash);
   return 0;
 }
 
@@ -727,6 +759,8 @@ int tqReaderAddTbUidList(STqReader* pReader, const SArray* tbUidList) {
     taosHashPut(pReader->tbIdHash, pKey, sizeof(int64_t), NULL, 0);
   }
 
+  // the files checked before may hold the new tables
+  walReaderSetUidFilter(pReader->pWalReader, pReader->tbIdHash);
   return 0;
 }
 
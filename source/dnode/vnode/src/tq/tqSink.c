@@ -69,6 +69,42 @@ int32_t tqBuildDeleteReq(SVnode* pVnode, const char* stbFullName, const SSDataBl
   return 0;
 }
 
+// The columns of the block are resolved once, instead of per cell, and the values of the columns without null are
+// appended without checking the bitmap.
+int32_t tqBlockToRows(const STSchema* pTSchema, const SSDataBlock* pDataBlock, void* pBuf) {
+  int32_t          numOfCols = pTSchema->numOfCols;
+  int32_t          rows = pDataBlock->info.rows;
+  SColumnInfoData* pCols[TSDB_MAX_COLUMNS];
+  for (int32_t k = 0; k < numOfCols; k++) {
+    pCols[k] = taosArrayGet(pDataBlock->pDataBlock, k);
+  }
+
+  int32_t dataLen = 0;
+  STSRow* rowData = pBuf;
+  for (int32_t j = 0; j < rows; j++) {
+    SRowBuilder rb = {0};
+    tdSRowInit(&rb, pTSchema->version);
+    tdSRowSetTpInfo(&rb, numOfCols, pTSchema->flen);
+    tdSRowResetBuf(&rb, rowData);
+
+    for (int32_t k = 0; k < numOfCols; k++) {
+      const STColumn*  pColumn = &pTSchema->columns[k];
+      SColumnInfoData* pColData = pCols[k];
+      if (pColData->hasNull && colDataIsNull_s(pColData, j)) {
+        tdAppendColValToRow(&rb, pColumn->colId, pColumn->type, TD_VTYPE_NULL, NULL, false, pColumn->offset, k);
+      } else {
+        void* colData = colDataGetData(pColData, j);
+        tdAppendColValToRow(&rb, pColumn->colId, pColumn->type, TD_VTYPE_NORM, colData, true, pColumn->offset, k);
+      }
+    }
+    tdSRowEnd(&rb);
+    int32_t rowLen = TD_ROW_LEN(rowData);
+    rowData = POINTER_SHIFT(rowData, rowLen);
+    dataLen += rowLen;
+  }
+  return dataLen;
+}
+
 SSubmitReq* tqBlockToSubmit(SVnode* pVnode, const SArray* pBlocks, const STSchema* pTSchema,
                             SSchemaWrapper* pTagSchemaWrapper, bool createTb, int64_t suid, const char* stbFullName,
                             SBatchDeleteReq* pDeleteReq) {
@@ -261,28 +297,7 @@ SSubmitReq* tqBlockToSubmit(SVnode* pVnode, const SArray* pBlocks, const STSchem
     }
     blkHead->schemaLen = htonl(schemaLen);
 
-    STSRow* rowData = POINTER_SHIFT(blkSchema, schemaLen);
-    for (int32_t j = 0; j < rows; j++) {
-      SRowBuilder rb = {0};
-      tdSRowInit(&rb, pTSchema->version);
-      tdSRowSetTpInfo(&rb, pTSchema->numOfCols, pTSchema->flen);
-      tdSRowResetBuf(&rb, rowData);
-
-      for (int32_t k = 0; k < pTSchema->numOfCols; k++) {
-        const STColumn*  pColumn = &pTSchema->columns[k];
-        SColumnInfoData* pColData = taosArrayGet(pDataBlock->pDataBlock, k);
-        if (colDataIsNull_s(pColData, j)) {
-          tdAppendColValToRow(&rb, pColumn->colId, pColumn->type, TD_VTYPE_NULL, NULL, false, pColumn->offset, k);
-        } else {
-          void* data = colDataGetData(pColData, j);
-          tdAppendColValToRow(&rb, pColumn->colId, pColumn->type, TD_VTYPE_NORM, data, true, pColumn->offset, k);
-        }
-      }
-      tdSRowEnd(&rb);
-      int32_t rowLen = TD_ROW_LEN(rowData);
-      rowData = POINTER_SHIFT(rowData, rowLen);
-      dataLen += rowLen;
-    }
+    dataLen = tqBlockToRows(pTSchema, pDataBlock, POINTER_SHIFT(blkSchema, schemaLen));
     blkHead->dataLen = htonl(dataLen);
 
     ret->length += sizeof(SSubmitBlk) + schemaLen + dataLen;
@@ -297,6 +312,163 @@ SSubmitReq* tqBlockToSubmit(SVnode* pVnode, const SArray* pBlocks, const STSchem
   return ret;
 }
 
+typedef struct {
+  SArray* pDataBlocks;  // SArray<SSDataBlock*>, the blocks of all groups written into the table
+  int32_t numOfRows;
+  void*   schemaStr;  // encoded SVCreateTbReq if the table does not exist
+  int32_t schemaLen;
+  int64_t uid;
+} STqSinkBlk;
+
+static int32_t tqSinkEncodeCreateTbReq(const SSDataBlock* pDataBlock, const char* stbFullName, int64_t suid,
+                                       char* ctbName, SArray* tagArray, void** ppSchemaStr, int32_t* pSchemaLen) {
+  SVCreateTbReq createTbReq = {0};
+
+  // set const
+  createTbReq.flags = 0;
+  createTbReq.type = TSDB_CHILD_TABLE;
+  createTbReq.ctb.suid = suid;
+
+  // set super table name
+  SName name = {0};
+  tNameFromString(&name, stbFullName, T_NAME_ACCT | T_NAME_DB | T_NAME_TABLE);
+  createTbReq.ctb.stbName = strdup((char*)tNameGetTableName(&name));  // strdup(stbFullName);
+  createTbReq.name = ctbName;
+
+  // set tag content
+  taosArrayClear(tagArray);
+  STagVal tagVal = {
+      .cid = taosArrayGetSize(pDataBlock->pDataBlock) + 1,
+      .type = TSDB_DATA_TYPE_UBIGINT,
+      .i64 = (int64_t)pDataBlock->info.groupId,
+  };
+  taosArrayPush(tagArray, &tagVal);
+  createTbReq.ctb.tagNum = taosArrayGetSize(tagArray);
+
+  STag* pTag = NULL;
+  tTagNew(tagArray, 1, false, &pTag);
+  if (pTag == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    tdDestroySVCreateTbReq(&createTbReq);
+    return -1;
+  }
+  createTbReq.ctb.pTag = (uint8_t*)pTag;
+
+  // set tag name
+  SArray* tagName = taosArrayInit(1, TSDB_COL_NAME_LEN);
+  char    tagNameStr[TSDB_COL_NAME_LEN] = {0};
+  strcpy(tagNameStr, "group_id");
+  taosArrayPush(tagName, tagNameStr);
+  createTbReq.ctb.tagName = tagName;
+
+  int32_t code;
+  int32_t schemaLen;
+  tEncodeSize(tEncodeSVCreateTbReq, &createTbReq, schemaLen, code);
+  if (code < 0) {
+    tdDestroySVCreateTbReq(&createTbReq);
+    return -1;
+  }
+
+  // set schema str
+  void* schemaStr = taosMemoryMalloc(schemaLen);
+  if (schemaStr == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    tdDestroySVCreateTbReq(&createTbReq);
+    return -1;
+  }
+
+  SEncoder encoder = {0};
+  tEncoderInit(&encoder, schemaStr, schemaLen);
+  code = tEncodeSVCreateTbReq(&encoder, &createTbReq);
+  tEncoderClear(&encoder);
+  tdDestroySVCreateTbReq(&createTbReq);
+  if (code < 0) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    taosMemoryFree(schemaStr);
+    return -1;
+  }
+
+  *ppSchemaStr = schemaStr;
+  *pSchemaLen = schemaLen;
+  return 0;
+}
+
+static void tqSinkSubmitBatch(SVnode* pVnode, const STSchema* pTSchema, int64_t suid, SArray* pSinkBlks,
+                              SHashObj* pSinkBlkIdx) {
+  int32_t numOfBlks = taosArrayGetSize(pSinkBlks);
+  if (numOfBlks == 0) {
+    return;
+  }
+
+  int32_t maxLen = TD_ROW_MAX_BYTES_FROM_SCHEMA(pTSchema);
+  int32_t cap = sizeof(SSubmitReq);
+  for (int32_t i = 0; i < numOfBlks; i++) {
+    STqSinkBlk* pBlk = taosArrayGet(pSinkBlks, i);
+    cap += sizeof(SSubmitBlk) + pBlk->schemaLen + pBlk->numOfRows * maxLen;
+  }
+
+  SSubmitReq* pSubmit = rpcMallocCont(cap);
+  if (pSubmit == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    tqError("vgId:%d, failed to build stream sink submit of %d blocks since %s", TD_VID(pVnode), numOfBlks,
+            terrstr());
+    goto _end;
+  }
+  pSubmit->header.vgId = pVnode->config.vgId;
+  pSubmit->length = sizeof(SSubmitReq);
+  pSubmit->numOfBlocks = htonl(numOfBlks);
+
+  SSubmitBlk* blkHead = POINTER_SHIFT(pSubmit, sizeof(SSubmitReq));
+  for (int32_t i = 0; i < numOfBlks; i++) {
+    STqSinkBlk* pBlk = taosArrayGet(pSinkBlks, i);
+
+    blkHead->numOfRows = htonl(pBlk->numOfRows);
+    blkHead->sversion = htonl(pTSchema->version);
+    blkHead->suid = htobe64(suid);
+    // uid is assigned by vnode if the table is auto created
+    blkHead->uid = pBlk->schemaStr ? 0 : htobe64(pBlk->uid);
+    blkHead->schemaLen = htonl(pBlk->schemaLen);
+
+    void* blkSchema = POINTER_SHIFT(blkHead, sizeof(SSubmitBlk));
+    if (pBlk->schemaStr) {
+      memcpy(blkSchema, pBlk->schemaStr, pBlk->schemaLen);
+    }
+
+    // the rows of all the blocks of a table follow its only create req
+    int32_t dataLen = 0;
+    for (int32_t j = 0; j < taosArrayGetSize(pBlk->pDataBlocks); j++) {
+      SSDataBlock* pDataBlock = taosArrayGetP(pBlk->pDataBlocks, j);
+      dataLen += tqBlockToRows(pTSchema, pDataBlock, POINTER_SHIFT(blkSchema, pBlk->schemaLen + dataLen));
+    }
+    blkHead->dataLen = htonl(dataLen);
+
+    pSubmit->length += sizeof(SSubmitBlk) + pBlk->schemaLen + dataLen;
+    blkHead = POINTER_SHIFT(blkHead, sizeof(SSubmitBlk) + pBlk->schemaLen + dataLen);
+  }
+
+  tqDebug("vgId:%d, stream sink submit %d blocks, len %d", TD_VID(pVnode), numOfBlks, pSubmit->length);
+  pSubmit->length = htonl(pSubmit->length);
+
+  SRpcMsg msg = {
+      .msgType = TDMT_VND_SUBMIT,
+      .pCont = pSubmit,
+      .contLen = ntohl(pSubmit->length),
+  };
+
+  if (tmsgPutToQueue(&pVnode->msgCb, WRITE_QUEUE, &msg) != 0) {
+    tqDebug("failed to put into write-queue since %s", terrstr());
+  }
+
+_end:
+  for (int32_t i = 0; i < numOfBlks; i++) {
+    STqSinkBlk* pBlk = taosArrayGet(pSinkBlks, i);
+    taosArrayDestroy(pBlk->pDataBlocks);
+    taosMemoryFree(pBlk->schemaStr);
+  }
+  taosArrayClear(pSinkBlks);
+  taosHashClear(pSinkBlkIdx);
+}
+
 void tqSinkToTablePipeline(SStreamTask* pTask, void* vnode, int64_t ver, void* data) {
   const SArray*   pBlocks = (const SArray*)data;
   SVnode*         pVnode = (SVnode*)vnode;
@@ -306,18 +478,31 @@ void tqSinkToTablePipeline(SStreamTask* pTask, void* vnode, int64_t ver, void* d
   SSchemaWrapper* pSchemaWrapper = pTask->tbSink.pSchemaWrapper;
 
   int32_t blockSz = taosArrayGetSize(pBlocks);
+  int32_t maxLen = TD_ROW_MAX_BYTES_FROM_SCHEMA(pTSchema);
 
   SArray* tagArray = taosArrayInit(1, sizeof(STagVal));
-  if (!tagArray) {
+  SArray* pSinkBlks = taosArrayInit(blockSz, sizeof(STqSinkBlk));
+  // child table name -> index of its sink blk in the batch, the table is created once whatever its blocks
+  SHashObj* pSinkBlkIdx = taosHashInit(blockSz, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_NO_LOCK);
+  if (!tagArray || !pSinkBlks || !pSinkBlkIdx) {
     terrno = TSDB_CODE_OUT_OF_MEMORY;
+    taosArrayDestroy(tagArray);
+    taosArrayDestroy(pSinkBlks);
+    taosHashCleanup(pSinkBlkIdx);
     return;
   }
 
+  // the blocks of many groups are batched into one submit req, and written into the vnode by a single write msg
+  int32_t batchSize = 0;
+
   tqDebug("vgId:%d, task %d write into table, block num: %d", TD_VID(pVnode), pTask->taskId, blockSz);
   for (int32_t i = 0; i < blockSz; i++) {
-    bool         createTb = true;
     SSDataBlock* pDataBlock = taosArrayGet(pBlocks, i);
     if (pDataBlock->info.type == STREAM_DELETE_RESULT) {
+      // keep the order of the inserted and deleted rows
+      tqSinkSubmitBatch(pVnode, pTSchema, suid, pSinkBlks, pSinkBlkIdx);
+      batchSize = 0;
+
       SBatchDeleteReq deleteReq = {0};
       deleteReq.deleteReqs = taosArrayInit(0, sizeof(SSingleDeleteReq));
       deleteReq.suid = suid;
@@ -361,87 +546,32 @@ void tqSinkToTablePipeline(SStreamTask* pTask, void* vnode, int64_t ver, void* d
         ctbName = buildCtbNameByGroupId(stbFullName, pDataBlock->info.groupId);
       }
 
-      int32_t schemaLen = 0;
-      void*   schemaStr = NULL;
+      char tbName[TSDB_TABLE_NAME_LEN] = {0};
+      tstrncpy(tbName, ctbName, TSDB_TABLE_NAME_LEN);
 
-      int64_t     uid = 0;
+      int32_t* pIdx = taosHashGet(pSinkBlkIdx, tbName, strlen(tbName));
+      if (pIdx != NULL) {
+        STqSinkBlk* pSinkBlk = taosArrayGet(pSinkBlks, *pIdx);
+        taosArrayPush(pSinkBlk->pDataBlocks, &pDataBlock);
+        pSinkBlk->numOfRows += pDataBlock->info.rows;
+        batchSize += pDataBlock->info.rows * maxLen;
+        taosMemoryFree(ctbName);
+        continue;
+      }
+
+      STqSinkBlk  sinkBlk = {0};
       SMetaReader mr = {0};
       metaReaderInit(&mr, pVnode->pMeta, 0);
       if (metaGetTableEntryByName(&mr, ctbName) < 0) {
         metaReaderClear(&mr);
         tqDebug("vgId:%d, stream write into %s, table auto created", TD_VID(pVnode), ctbName);
 
-        SVCreateTbReq createTbReq = {0};
-
-        // set const
-        createTbReq.flags = 0;
-        createTbReq.type = TSDB_CHILD_TABLE;
-        createTbReq.ctb.suid = suid;
-
-        // set super table name
-        SName name = {0};
-        tNameFromString(&name, stbFullName, T_NAME_ACCT | T_NAME_DB | T_NAME_TABLE);
-        createTbReq.ctb.stbName = strdup((char*)tNameGetTableName(&name));  // strdup(stbFullName);
-        createTbReq.name = ctbName;
-        ctbName = NULL;
-
-        // set tag content
-        taosArrayClear(tagArray);
-        STagVal tagVal = {
-            .cid = taosArrayGetSize(pDataBlock->pDataBlock) + 1,
-            .type = TSDB_DATA_TYPE_UBIGINT,
-            .i64 = (int64_t)pDataBlock->info.groupId,
-        };
-        taosArrayPush(tagArray, &tagVal);
-        createTbReq.ctb.tagNum = taosArrayGetSize(tagArray);
-
-        STag* pTag = NULL;
-        tTagNew(tagArray, 1, false, &pTag);
-        if (pTag == NULL) {
-          terrno = TSDB_CODE_OUT_OF_MEMORY;
-          taosArrayDestroy(tagArray);
-          tdDestroySVCreateTbReq(&createTbReq);
-          return;
-        }
-        createTbReq.ctb.pTag = (uint8_t*)pTag;
-
-        // set tag name
-        SArray* tagName = taosArrayInit(1, TSDB_COL_NAME_LEN);
-        char    tagNameStr[TSDB_COL_NAME_LEN] = {0};
-        strcpy(tagNameStr, "group_id");
-        taosArrayPush(tagName, tagNameStr);
-        createTbReq.ctb.tagName = tagName;
-
-        int32_t code;
-        tEncodeSize(tEncodeSVCreateTbReq, &createTbReq, schemaLen, code);
-        if (code < 0) {
-          tdDestroySVCreateTbReq(&createTbReq);
-          taosArrayDestroy(tagArray);
-          return;
-        }
-
-        // set schema str
-        schemaStr = taosMemoryMalloc(schemaLen);
-        if (schemaStr == NULL) {
-          terrno = TSDB_CODE_OUT_OF_MEMORY;
-          tdDestroySVCreateTbReq(&createTbReq);
-          taosArrayDestroy(tagArray);
-          return;
-        }
-
-        SEncoder encoder = {0};
-        tEncoderInit(&encoder, schemaStr, schemaLen);
-        code = tEncodeSVCreateTbReq(&encoder, &createTbReq);
-        if (code < 0) {
-          terrno = TSDB_CODE_OUT_OF_MEMORY;
-          tdDestroySVCreateTbReq(&createTbReq);
-          taosArrayDestroy(tagArray);
-          tEncoderClear(&encoder);
-          taosMemoryFree(schemaStr);
-          return;
+        // ctbName is owned by the create req from now on
+        if (tqSinkEncodeCreateTbReq(pDataBlock, stbFullName, suid, ctbName, tagArray, &sinkBlk.schemaStr,
+                                    &sinkBlk.schemaLen) < 0) {
+          tqError("vgId:%d, failed to build create table req since %s", TD_VID(pVnode), terrstr());
+          continue;
         }
-        tEncoderClear(&encoder);
-        tdDestroySVCreateTbReq(&createTbReq);
       } else {
         if (mr.me.type != TSDB_CHILD_TABLE) {
           tqError("vgId:%d, failed to write into %s, since table type incorrect, type %d", TD_VID(pVnode), ctbName,
@@ -459,92 +589,34 @@ void tqSinkToTablePipeline(SStreamTask* pTask, void* vnode, int64_t ver, void* d
           continue;
         }
 
-        createTb = false;
-        uid = mr.me.uid;
+        sinkBlk.uid = mr.me.uid;
         metaReaderClear(&mr);
 
         tqDebug("vgId:%d, stream write, table %s, uid %" PRId64 " already exist, skip create", TD_VID(pVnode), ctbName,
-                uid);
+                sinkBlk.uid);
 
         taosMemoryFreeClear(ctbName);
       }
 
-      int32_t cap = sizeof(SSubmitReq);
-
-      int32_t rows = pDataBlock->info.rows;
-      int32_t maxLen = TD_ROW_MAX_BYTES_FROM_SCHEMA(pTSchema);
-
-      cap += sizeof(SSubmitBlk) + schemaLen + rows * maxLen;
-
-      SSubmitReq* pSubmit = rpcMallocCont(cap);
-      pSubmit->header.vgId = pVnode->config.vgId;
-      pSubmit->length = sizeof(SSubmitReq);
-      pSubmit->numOfBlocks = htonl(1);
-
-      SSubmitBlk* blkHead = POINTER_SHIFT(pSubmit, sizeof(SSubmitReq));
-
-      blkHead->numOfRows = htonl(pDataBlock->info.rows);
-      blkHead->sversion = htonl(pTSchema->version);
-      blkHead->suid = htobe64(suid);
-      // uid is assigned by vnode
-      blkHead->uid = 0;
-      blkHead->schemaLen = 0;
-
-      tqDebug("tq sink, convert block2 %d, rows: %d", i, rows);
-
-      int32_t dataLen = 0;
-      void*   blkSchema = POINTER_SHIFT(blkHead, sizeof(SSubmitBlk));
-      STSRow* rowData = blkSchema;
-      if (createTb) {
-        memcpy(blkSchema, schemaStr, schemaLen);
-        blkHead->schemaLen = htonl(schemaLen);
-        rowData = POINTER_SHIFT(blkSchema, schemaLen);
-      } else {
-        blkHead->uid = htobe64(uid);
-      }
-
-      taosMemoryFreeClear(schemaStr);
-
-      for (int32_t j = 0; j < rows; j++) {
-        SRowBuilder rb = {0};
-        tdSRowInit(&rb, pTSchema->version);
-        tdSRowSetTpInfo(&rb, pTSchema->numOfCols, pTSchema->flen);
-        tdSRowResetBuf(&rb, rowData);
-
-        for (int32_t k = 0; k < pTSchema->numOfCols; k++) {
-          const STColumn*  pColumn = &pTSchema->columns[k];
-          SColumnInfoData* pColData = taosArrayGet(pDataBlock->pDataBlock, k);
-          if (colDataIsNull_s(pColData, j)) {
-            tdAppendColValToRow(&rb, pColumn->colId, pColumn->type, TD_VTYPE_NULL, NULL, false, pColumn->offset, k);
-          } else {
-            void* colData = colDataGetData(pColData, j);
-            if (k == 0) {
-              tqDebug("tq sink, row %d ts %" PRId64, j, *(int64_t*)colData);
-            }
-            tdAppendColValToRow(&rb, pColumn->colId, pColumn->type, TD_VTYPE_NORM, colData, true, pColumn->offset, k);
-          }
-        }
-        tdSRowEnd(&rb);
-        int32_t rowLen = TD_ROW_LEN(rowData);
-        rowData = POINTER_SHIFT(rowData, rowLen);
-        dataLen += rowLen;
-      }
-      blkHead->dataLen = htonl(dataLen);
-
-      pSubmit->length += sizeof(SSubmitBlk) + schemaLen + dataLen;
-      pSubmit->length = htonl(pSubmit->length);
-
-      SRpcMsg msg = {
-          .msgType = TDMT_VND_SUBMIT,
-          .pCont = pSubmit,
-          .contLen = ntohl(pSubmit->length),
-      };
-
-      if (tmsgPutToQueue(&pVnode->msgCb, WRITE_QUEUE, &msg) != 0) {
-        tqDebug("failed to put into write-queue since %s", terrstr());
+      int32_t blkSize = sizeof(SSubmitBlk) + sinkBlk.schemaLen + pDataBlock->info.rows * maxLen;
+      if (batchSize > 0 && batchSize + blkSize > TQ_SINK_SUBMIT_BATCH_SIZE) {
+        tqSinkSubmitBatch(pVnode, pTSchema, suid, pSinkBlks, pSinkBlkIdx);
+        batchSize = 0;
       }
+      sinkBlk.pDataBlocks = taosArrayInit(1, POINTER_BYTES);
+      taosArrayPush(sinkBlk.pDataBlocks, &pDataBlock);
+      sinkBlk.numOfRows = pDataBlock->info.rows;
+
+      int32_t idx = taosArrayGetSize(pSinkBlks);
+      taosArrayPush(pSinkBlks, &sinkBlk);
+      taosHashPut(pSinkBlkIdx, tbName, strlen(tbName), &idx, sizeof(int32_t));
+      batchSize += blkSize;
     }
   }
+
+  tqSinkSubmitBatch(pVnode, pTSchema, suid, pSinkBlks, pSinkBlkIdx);
+  taosArrayDestroy(pSinkBlks);
+  taosHashCleanup(pSinkBlkIdx);
   taosArrayDestroy(tagArray);
 }
 
@@ -347,6 +347,8 @@ int32_t vnodeProcessQueryMsg(SVnode *pVnode, SRpcMsg *pMsg) {
       return qWorkerProcessQueryMsg(&handle, pVnode->pQuery, pMsg, 0);
     case TDMT_SCH_QUERY_CONTINUE:
       return qWorkerProcessCQueryMsg(&handle, pVnode->pQuery, pMsg, 0);
+    case TDMT_SCH_QUERY_WORKER:
+      return qProcessWorkerMsg(pMsg);
     default:
       vError("unknown msg type:%d in query queue", pMsg->msgType);
       return TSDB_CODE_APP_ERROR;
@@ -934,6 +936,8 @@ static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t version, void *pReq
           taosArrayDestroy(createTbReq.ctb.tagName);
           goto _exit;
         }
+        // created by a req preprocessed before it was applied, the uid preprocessed is not the one of the table
+        createTbReq.uid = metaGetTableEntryUidByName(pVnode->pMeta, createTbReq.name);
       } else {
         if (NULL != submitBlkRsp.pMeta) {
           vnodeUpdateMetaRsp(pVnode, submitBlkRsp.pMeta);
@@ -123,11 +123,21 @@ typedef struct SCtgFetch {
   int32_t         vgId;
 } SCtgFetch;
 
+// the child tables of one stb not cached share one stb meta fetch
+typedef struct SCtgStbFetch {
+  int32_t     code;
+  STableMeta* pMeta;   // set once the stb meta is got
+  SArray*     pWaits;  // SArray<int32_t>, the fetchs waiting for the stb meta
+} SCtgStbFetch;
+
 typedef struct SCtgTbMetasCtx {
-  int32_t fetchNum;
-  SArray* pNames;
-  SArray* pResList;
-  SArray* pFetchs;
+  int32_t   fetchNum;
+  SArray*   pNames;
+  SArray*   pResList;
+  SArray*   pFetchs;
+  SArray*   pVgWaits;    // SArray<SArray<int32_t>*> by dbIdx, the fetchs waiting for the db vgInfo got by another one
+  SRWLatch  stbLock;
+  SHashObj* pStbFetchs;  // key: stb full name, value: SCtgStbFetch
 } SCtgTbMetasCtx;
 
 typedef struct SCtgTbIndexCtx {
@@ -178,8 +188,9 @@ typedef struct SCtgUserCtx {
 
 typedef STableIndexRsp STableIndex;
 
+// pMeta is never changed in place, the update thread replaces it as a whole and retires the old one, readers load it
+// once inside ctgEbrEnter/ctgEbrExit without any latch
 typedef struct SCtgTbCache {
-  SRWLatch     metaLock;
   STableMeta*  pMeta;
   SRWLatch     indexLock;
   STableIndex* pIndex;
@@ -476,6 +487,33 @@ typedef struct SCatalogMgmt {
   SCatalogCfg  cfg;
 } SCatalogMgmt;
 
+#define CTG_EBR_MAX_SLOTS 1024
+
+typedef void (*FCtgEbrFree)(void*);
+
+typedef struct SCtgEbrSlot {
+  int64_t epoch;  // the epoch the thread entered in, 0 if it is not reading
+  char    pad[56];
+} SCtgEbrSlot;
+
+typedef struct SCtgEbrRetired {
+  int64_t     epoch;
+  void*       p;
+  FCtgEbrFree freeFp;
+} SCtgEbrRetired;
+
+// epoch based reclamation of the cached objects replaced by the update thread
+typedef struct SCtgEbr {
+  int64_t     epoch;
+  int32_t     slotNum;        // ever taken, the slots below it are scanned
+  int32_t     sharedReaders;  // readers of the threads got no slot
+  SArray*     pRetired;       // SArray<SCtgEbrRetired>, only touched by the update thread
+  SRWLatch    slotLock;
+  int32_t     freeSlotNum;  // the slots released by the exited threads, guarded by slotLock
+  int32_t     freeSlots[CTG_EBR_MAX_SLOTS];
+  SCtgEbrSlot slots[CTG_EBR_MAX_SLOTS];
+} SCtgEbr;
+
 typedef uint32_t (*tableNameHashFp)(const char*, uint32_t);
 typedef int32_t (*ctgOpFunc)(SCtgCacheOperation*);
 
@@ -718,6 +756,7 @@ int32_t ctgOpUpdateTbIndex(SCtgCacheOperation* operation);
 int32_t ctgOpClearCache(SCtgCacheOperation* operation);
 int32_t ctgReadTbTypeFromCache(SCatalog* pCtg, char* dbFName, char* tableName, int32_t* tbType);
 int32_t ctgGetTbHashVgroupFromCache(SCatalog* pCtg, const SName* pTableName, SVgroupInfo** pVgroup);
+int32_t ctgReadTbHashVgroupFromCache(SCatalog* pCtg, const SName* pTableName, SVgroupInfo* pVgroup, bool* inCache);
 
 int32_t ctgProcessRspMsg(void* out, int32_t reqType, char* msg, int32_t msgSize, int32_t rspCode, char* target);
 int32_t ctgGetDBVgInfoFromMnode(SCatalog* pCtg, SRequestConnInfo* pConn, SBuildUseDBInput* input, SUseDbOutput* out,
@@ -785,6 +824,10 @@ void    ctgClearSubTaskRes(SCtgSubRes* pRes);
 void    ctgFreeQNode(SCtgQNode* node);
 void    ctgClearHandle(SCatalog* pCtg);
 void    ctgFreeTbCacheImpl(SCtgTbCache* pCache);
+void    ctgEbrEnter(void);
+void    ctgEbrExit(void);
+void    ctgEbrRetire(void* p, FCtgEbrFree freeFp);
+void    ctgEbrReclaim(bool all);
 int32_t ctgRemoveTbMeta(SCatalog* pCtg, SName* pTableName);
 int32_t ctgGetTbHashVgroup(SCatalog* pCtg, SRequestConnInfo* pConn, const SName* pTableName, SVgroupInfo* pVgroup, bool* exists);
 SName*  ctgGetFetchName(SArray* pNames, SCtgFetch* pFetch);
@@ -523,6 +523,16 @@ int32_t ctgGetTbHashVgroup(SCatalog* pCtg, SRequestConnInfo* pConn, const SName*
     CTG_ERR_RET(TSDB_CODE_CTG_INVALID_INPUT);
   }
 
+  bool inCache = false;
+  CTG_ERR_RET(ctgReadTbHashVgroupFromCache(pCtg, pTableName, pVgroup, &inCache));
+  if (inCache) {
+    if (exists) {
+      *exists = true;
+    }
+
+    return TSDB_CODE_SUCCESS;
+  }
+
   SCtgDBCache* dbCache = NULL;
   int32_t      code = 0;
   char         db[TSDB_DB_FNAME_LEN] = {0};
@@ -1455,6 +1465,8 @@ void catalogDestroy(void) {
   if (!taosCheckCurrentInDll()) {
     ctgClearCacheEnqueue(NULL, true, true, true);
     taosThreadJoin(gCtgMgmt.updateThread, NULL);
+
+    ctgEbrReclaim(true);
   }
 
   taosHashCleanup(gCtgMgmt.pCluster);
@@ -1101,6 +1101,173 @@ _return:
   CTG_RET(code);
 }
 
+static void ctgSetTbMetasFetchRes(SCtgTask* pTask, SCtgFetch* pFetch, int32_t code, STableMeta* pMeta) {
+  SCtgTbMetasCtx* ctx = (SCtgTbMetasCtx*)pTask->taskCtx;
+  SMetaRes*       pRes = taosArrayGet(ctx->pResList, pFetch->resIdx);
+  pRes->code = code;
+  pRes->pRes = pMeta;
+  if (0 == atomic_sub_fetch_32(&ctx->fetchNum, 1)) {
+    TSWAP(pTask->res, ctx->pResList);
+    ctgHandleTaskEnd(pTask, code);
+  }
+}
+
+// Called by the fetch that got the db vgInfo, the waiting fetchs are added to the same batchs as its own vnode request,
+// so all the tables of a vnode are fetched in one round trip.
+static void ctgHandleDbVgWaits(SCtgTask* pTask, int32_t dbIdx, SDBVgInfo* dbVgroup, SHashObj* pBatchs,
+                               int32_t rspCode) {
+  SCtgTbMetasCtx*   ctx = (SCtgTbMetasCtx*)pTask->taskCtx;
+  SCatalog*         pCtg = pTask->pJob->pCtg;
+  SRequestConnInfo* pConn = &pTask->pJob->conn;
+  if (NULL == ctx->pVgWaits) {
+    return;
+  }
+
+  SArray* pWaits = atomic_exchange_ptr(taosArrayGet(ctx->pVgWaits, dbIdx), NULL);
+  int32_t num = taosArrayGetSize(pWaits);
+  for (int32_t i = 0; i < num; ++i) {
+    SCtgFetch*  pFetch = taosArrayGet(ctx->pFetchs, *(int32_t*)taosArrayGet(pWaits, i));
+    SName*      pName = ctgGetFetchName(ctx->pNames, pFetch);
+    SCtgMsgCtx* pMsgCtx = CTG_GET_TASK_MSGCTX(pTask, pFetch->fetchIdx);
+    int32_t     code = rspCode;
+
+    if (TSDB_CODE_SUCCESS == code) {
+      SVgroupInfo vgInfo = {0};
+      SCtgTaskReq tReq = {.pTask = pTask, .msgIdx = pFetch->fetchIdx};
+      pMsgCtx->pBatchs = pBatchs;
+
+      code = ctgGetVgInfoFromHashValue(pCtg, dbVgroup, pName, &vgInfo);
+      if (TSDB_CODE_SUCCESS == code) {
+        pFetch->vgId = vgInfo.vgId;
+        code = ctgGetTbMetaFromVnode(pCtg, pConn, pName, &vgInfo, NULL, &tReq);
+      }
+    }
+
+    if (code) {
+      ctgSetTbMetasFetchRes(pTask, pFetch, code, NULL);
+    }
+  }
+
+  taosArrayDestroy(pWaits);
+}
+
+// pBatchs are the batchs of the fetch finishing the wait, a child table of a stb created again adds its own request
+static void ctgFinishStbFetchWait(SCtgTask* pTask, int32_t fetchIdx, STableMeta* stbMeta, SHashObj* pBatchs,
+                                  int32_t code) {
+  SCatalog*         pCtg = pTask->pJob->pCtg;
+  SCtgTbMetasCtx*   ctx = (SCtgTbMetasCtx*)pTask->taskCtx;
+  SCtgFetch*        pFetch = taosArrayGet(ctx->pFetchs, fetchIdx);
+  SCtgMsgCtx*       pMsgCtx = CTG_GET_TASK_MSGCTX(pTask, fetchIdx);
+  STableMetaOutput* pOut = (STableMetaOutput*)pMsgCtx->out;
+  STableMeta*       pMeta = NULL;
+
+  if (TSDB_CODE_SUCCESS == code && stbMeta->suid != pOut->ctbMeta.suid) {
+    // the stb is created again between the child table metas got, the stb meta of its own is got
+    ctgDebug("stb suid 0x%" PRIx64 " mismatch 0x%" PRIx64 ", tbName:%s", stbMeta->suid, pOut->ctbMeta.suid,
+             pOut->ctbName);
+
+    SCtgTaskReq tReq = {.pTask = pTask, .msgIdx = fetchIdx};
+    pMsgCtx->pBatchs = pBatchs;
+    TSWAP(pMsgCtx->lastOut, pMsgCtx->out);
+    code = ctgGetTbMetaFromMnodeImpl(pCtg, &pTask->pJob->conn, pOut->dbFName, pOut->tbName, NULL, &tReq);
+    if (TSDB_CODE_SUCCESS == code) {
+      return;
+    }
+  }
+
+  if (TSDB_CODE_SUCCESS == code) {
+    taosMemoryFreeClear(pOut->tbMeta);
+    code = cloneTableMeta(stbMeta, &pOut->tbMeta);
+  }
+
+  if (TSDB_CODE_SUCCESS == code) {
+    // the stb meta is cached by the fetch that got it
+    SET_META_TYPE_CTABLE(pOut->metaType);
+    ctgUpdateTbMetaToCache(pCtg, pOut, false);
+
+    memcpy(pOut->tbMeta, &pOut->ctbMeta, sizeof(pOut->ctbMeta));
+    pMeta = pOut->tbMeta;
+    pOut->tbMeta = NULL;
+  }
+
+  ctgSetTbMetasFetchRes(pTask, pFetch, code, pMeta);
+}
+
+// Returns true if the stb meta of the child table is got by another fetch, which then finishes this one.
+static bool ctgAddStbFetchWait(SCtgTask* pTask, SCtgFetch* pFetch, STableMetaOutput* pOut) {
+  SCatalog*       pCtg = pTask->pJob->pCtg;
+  SCtgTbMetasCtx* ctx = (SCtgTbMetasCtx*)pTask->taskCtx;
+  char            key[TSDB_DB_FNAME_LEN + TSDB_TABLE_NAME_LEN + 1];
+  int32_t         keyLen = snprintf(key, sizeof(key), "%s.%s", pOut->dbFName, pOut->tbName);
+  STableMeta*     stbMeta = NULL;
+  bool            wait = false;
+
+  if (NULL == ctx->pStbFetchs) {
+    return false;
+  }
+
+  CTG_LOCK(CTG_WRITE, &ctx->stbLock);
+
+  SCtgStbFetch* pStb = taosHashGet(ctx->pStbFetchs, key, keyLen);
+  if (NULL == pStb) {
+    SCtgStbFetch stb = {0};
+    taosHashPut(ctx->pStbFetchs, key, keyLen, &stb, sizeof(stb));
+  } else if (pStb->pMeta) {
+    stbMeta = pStb->pMeta;
+  } else if (TSDB_CODE_SUCCESS == pStb->code) {
+    if (NULL == pStb->pWaits) {
+      pStb->pWaits = taosArrayInit(4, sizeof(int32_t));
+    }
+    wait = (NULL != taosArrayPush(pStb->pWaits, &pFetch->fetchIdx));
+  }
+
+  CTG_UNLOCK(CTG_WRITE, &ctx->stbLock);
+
+  if (stbMeta) {
+    ctgDebug("use the stb meta got by another fetch, tbName:%s", pOut->ctbName);
+    SCtgMsgCtx* pMsgCtx = CTG_GET_TASK_MSGCTX(pTask, pFetch->fetchIdx);
+    ctgFinishStbFetchWait(pTask, pFetch->fetchIdx, stbMeta, pMsgCtx->pBatchs, TSDB_CODE_SUCCESS);
+    return true;
+  }
+
+  return wait;
+}
+
+// pOut is the child table output, with the stb meta got if code is TSDB_CODE_SUCCESS
+static void ctgHandleStbFetchWaits(SCtgTask* pTask, STableMetaOutput* pOut, SHashObj* pBatchs, int32_t code) {
+  SCtgTbMetasCtx* ctx = (SCtgTbMetasCtx*)pTask->taskCtx;
+  char            key[TSDB_DB_FNAME_LEN + TSDB_TABLE_NAME_LEN + 1];
+  int32_t         keyLen = snprintf(key, sizeof(key), "%s.%s", pOut->dbFName, pOut->tbName);
+  STableMeta*     stbMeta = NULL;
+  SArray*         pWaits = NULL;
+
+  if (NULL == ctx->pStbFetchs) {
+    return;
+  }
+
+  CTG_LOCK(CTG_WRITE, &ctx->stbLock);
+
+  SCtgStbFetch* pStb = taosHashGet(ctx->pStbFetchs, key, keyLen);
+  if (pStb && NULL == pStb->pMeta && TSDB_CODE_SUCCESS == pStb->code) {
+    if (TSDB_CODE_SUCCESS == code) {
+      code = cloneTableMeta(pOut->tbMeta, &pStb->pMeta);
+    }
+    pStb->code = code;
+    stbMeta = pStb->pMeta;
+    pWaits = pStb->pWaits;
+    pStb->pWaits = NULL;
+  }
+
+  CTG_UNLOCK(CTG_WRITE, &ctx->stbLock);
+
+  int32_t num = taosArrayGetSize(pWaits);
+  for (int32_t i = 0; i < num; ++i) {
+    ctgFinishStbFetchWait(pTask, *(int32_t*)taosArrayGet(pWaits, i), stbMeta, pBatchs, code);
+  }
+
+  taosArrayDestroy(pWaits);
+}
+
 int32_t ctgHandleGetTbMetasRsp(SCtgTaskReq* tReq, int32_t reqType, const SDataBuf* pMsg, int32_t rspCode) {
   int32_t           code = 0;
   SCtgDBCache*      dbCache = NULL;
@@ -1121,6 +1288,14 @@ int32_t ctgHandleGetTbMetasRsp(SCtgTaskReq* tReq, int32_t reqType, const SDataBu
     case TDMT_MND_USE_DB: {
       SUseDbOutput* pOut = (SUseDbOutput*)pMsgCtx->out;
 
+      if (!CTG_FLAG_IS_STB(flag)) {
+        SDBVgInfo* pDb = NULL;
+        CTG_ERR_JRET(cloneDbVgInfo(pOut->dbVgroup, &pDb));
+        CTG_ERR_JRET(ctgUpdateVgroupEnqueue(pCtg, pMsgCtx->target, pOut->dbId, pDb, false));
+
+        ctgHandleDbVgWaits(pTask, pFetch->dbIdx, pOut->dbVgroup, pMsgCtx->pBatchs, TSDB_CODE_SUCCESS);
+      }
+
       SVgroupInfo vgInfo = {0};
       CTG_ERR_JRET(ctgGetVgInfoFromHashValue(pCtg, pOut->dbVgroup, pName, &vgInfo));
 
@@ -1172,6 +1347,8 @@ int32_t ctgHandleGetTbMetasRsp(SCtgTaskReq* tReq, int32_t reqType, const SDataBu
         TSWAP(pMsgCtx->out, pMsgCtx->lastOut);
         STableMetaOutput* pLastOut = (STableMetaOutput*)pMsgCtx->out;
         TSWAP(pLastOut->tbMeta, pOut->tbMeta);
+
+        ctgHandleStbFetchWaits(pTask, pLastOut, pMsgCtx->pBatchs, TSDB_CODE_SUCCESS);
       }
 
       break;
@@ -1218,8 +1395,18 @@ int32_t ctgHandleGetTbMetasRsp(SCtgTaskReq* tReq, int32_t reqType, const SDataBu
         }
 
         if (0 == exist) {
+          if (ctgAddStbFetchWait(pTask, pFetch, pOut)) {
+            ctgDebug("stb meta is got by another fetch, tbName:%s", tNameGetTableName(pName));
+            return TSDB_CODE_SUCCESS;
+          }
+
           TSWAP(pMsgCtx->lastOut, pMsgCtx->out);
-          CTG_RET(ctgGetTbMetaFromMnodeImpl(pCtg, pConn, pOut->dbFName, pOut->tbName, NULL, tReq));
+          code = ctgGetTbMetaFromMnodeImpl(pCtg, pConn, pOut->dbFName, pOut->tbName, NULL, tReq);
+          if (code) {
+            ctgHandleStbFetchWaits(pTask, pOut, NULL, code);
+          }
+
+          CTG_RET(code);
         }
       }
       break;
@@ -1273,6 +1460,13 @@ _return:
   }
 
   if (code) {
+    // the fetchs waiting for this one fail with it
+    if (TDMT_MND_USE_DB == reqType && !CTG_FLAG_IS_STB(flag)) {
+      ctgHandleDbVgWaits(pTask, pFetch->dbIdx, NULL, NULL, code);
+    } else if (TDMT_MND_TABLE_META == reqType && pMsgCtx->lastOut) {
+      ctgHandleStbFetchWaits(pTask, (STableMetaOutput*)pMsgCtx->lastOut, NULL, code);
+    }
+
     SMetaRes* pRes = taosArrayGet(ctx->pResList, pFetch->resIdx);
     pRes->code = code;
     pRes->pRes = NULL;
@@ -1688,6 +1882,17 @@ int32_t ctgLaunchGetTbMetasTask(SCtgTask* pTask) {
   pTask->msgCtxs = taosArrayInit(pCtx->fetchNum, sizeof(SCtgMsgCtx));
   taosArraySetSize(pTask->msgCtxs, pCtx->fetchNum);
 
+  pCtx->pVgWaits = taosArrayInit(dbNum, POINTER_BYTES);
+  pCtx->pStbFetchs = taosHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_NO_LOCK);
+  if (NULL == pCtx->pVgWaits || NULL == pCtx->pStbFetchs) {
+    CTG_ERR_RET(TSDB_CODE_OUT_OF_MEMORY);
+  }
+  for (int32_t i = 0; i < dbNum; ++i) {
+    taosArrayPush(pCtx->pVgWaits, &(SArray*){NULL});
+  }
+
+  int32_t lastDbIdx = -1;
+  bool    vgCached = false;
   for (int32_t i = 0; i < pCtx->fetchNum; ++i) {
     SCtgFetch*  pFetch = taosArrayGet(pCtx->pFetchs, i);
     SName*      pName = ctgGetFetchName(pCtx->pNames, pFetch);
@@ -1696,9 +1901,44 @@ int32_t ctgLaunchGetTbMetasTask(SCtgTask* pTask) {
       pMsgCtx->pBatchs = pJob->pBatchs;
     }
 
+    if (pFetch->dbIdx != lastDbIdx) {
+      STablesReq*  pReq = taosArrayGet(pCtx->pNames, pFetch->dbIdx);
+      SCtgDBCache* dbCache = NULL;
+      CTG_ERR_RET(ctgAcquireVgInfoFromCache(pCtg, pReq->dbFName, &dbCache));
+      vgCached = (NULL != dbCache);
+      if (dbCache) {
+        ctgReleaseVgInfoToCache(pCtg, dbCache);
+      }
+      lastDbIdx = pFetch->dbIdx;
+    }
+
     SCtgTaskReq tReq;
     tReq.pTask = pTask;
     tReq.msgIdx = pFetch->fetchIdx;
+
+    // only the first table of a db without cached vgInfo gets the vgInfo, the others wait for it
+    if (!vgCached && !CTG_FLAG_IS_SYS_DB(pFetch->flag) && !CTG_FLAG_IS_STB(pFetch->flag)) {
+      SArray** ppWaits = taosArrayGet(pCtx->pVgWaits, pFetch->dbIdx);
+      if (*ppWaits) {
+        if (NULL == taosArrayPush(*ppWaits, &pFetch->fetchIdx)) {
+          CTG_ERR_RET(TSDB_CODE_OUT_OF_MEMORY);
+        }
+        continue;
+      }
+
+      *ppWaits = taosArrayInit(pCtx->fetchNum - i, sizeof(int32_t));
+      if (NULL == *ppWaits) {
+        CTG_ERR_RET(TSDB_CODE_OUT_OF_MEMORY);
+      }
+
+      SBuildUseDBInput input = {0};
+      tNameGetFullDbName(pName, input.db);
+      input.vgVersion = CTG_DEFAULT_INVALID_VERSION;
+
+      CTG_ERR_RET(ctgGetDBVgInfoFromMnode(pCtg, pConn, &input, NULL, &tReq));
+      continue;
+    }
+
     CTG_ERR_RET(ctgAsyncRefreshTbMeta(&tReq, pFetch->flag, pName, &pFetch->vgId));
   }
 
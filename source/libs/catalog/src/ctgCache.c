@@ -131,7 +131,7 @@ void ctgReleaseVgInfoToCache(SCatalog *pCtg, SCtgDBCache *dbCache) {
 
 void ctgReleaseTbMetaToCache(SCatalog *pCtg, SCtgDBCache *dbCache, SCtgTbCache *pCache) {
   if (pCache) {
-    CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+    ctgEbrExit();
     taosHashRelease(dbCache->tbCache, pCache);
   }
 
@@ -187,7 +187,8 @@ _return:
   return TSDB_CODE_SUCCESS;
 }
 
-int32_t ctgAcquireTbMetaFromCache(SCatalog *pCtg, char *dbFName, char *tbName, SCtgDBCache **pDb, SCtgTbCache **pTb) {
+int32_t ctgAcquireTbMetaFromCache(SCatalog *pCtg, char *dbFName, char *tbName, SCtgDBCache **pDb, SCtgTbCache **pTb,
+                                  STableMeta **pMeta) {
   SCtgDBCache *dbCache = NULL;
   SCtgTbCache *pCache = NULL;
   ctgAcquireDBCache(pCtg, dbFName, &dbCache);
@@ -202,14 +203,16 @@ int32_t ctgAcquireTbMetaFromCache(SCatalog *pCtg, char *dbFName, char *tbName, S
     goto _return;
   }
 
-  CTG_LOCK(CTG_READ, &pCache->metaLock);
-  if (NULL == pCache->pMeta) {
+  ctgEbrEnter();
+  STableMeta *tbMeta = atomic_load_ptr(&pCache->pMeta);
+  if (NULL == tbMeta) {
     ctgDebug("tb %s meta not in cache, dbFName:%s", tbName, dbFName);
     goto _return;
   }
 
   *pDb = dbCache;
   *pTb = pCache;
+  *pMeta = tbMeta;
 
   ctgDebug("tb %s meta got in cache, dbFName:%s", tbName, dbFName);
 
@@ -226,7 +229,8 @@ _return:
   return TSDB_CODE_SUCCESS;
 }
 
-int32_t ctgAcquireStbMetaFromCache(SCatalog *pCtg, char *dbFName, uint64_t suid, SCtgDBCache **pDb, SCtgTbCache **pTb) {
+int32_t ctgAcquireStbMetaFromCache(SCatalog *pCtg, char *dbFName, uint64_t suid, SCtgDBCache **pDb, SCtgTbCache **pTb,
+                                   STableMeta **pMeta) {
   SCtgDBCache *dbCache = NULL;
   SCtgTbCache *pCache = NULL;
   ctgAcquireDBCache(pCtg, dbFName, &dbCache);
@@ -250,14 +254,16 @@ int32_t ctgAcquireStbMetaFromCache(SCatalog *pCtg, char *dbFName, uint64_t suid,
 
   taosHashRelease(dbCache->stbCache, stName);
 
-  CTG_LOCK(CTG_READ, &pCache->metaLock);
-  if (NULL == pCache->pMeta) {
+  ctgEbrEnter();
+  STableMeta *stbMeta = atomic_load_ptr(&pCache->pMeta);
+  if (NULL == stbMeta) {
     ctgDebug("stb 0x%" PRIx64 " meta not in cache, dbFName:%s", suid, dbFName);
     goto _return;
   }
 
   *pDb = dbCache;
   *pTb = pCache;
+  *pMeta = stbMeta;
 
   ctgDebug("stb 0x%" PRIx64 " meta got in cache, dbFName:%s", suid, dbFName);
 
@@ -320,7 +326,8 @@ _return:
 int32_t ctgTbMetaExistInCache(SCatalog *pCtg, char *dbFName, char *tbName, int32_t *exist) {
   SCtgDBCache *dbCache = NULL;
   SCtgTbCache *tbCache = NULL;
-  ctgAcquireTbMetaFromCache(pCtg, dbFName, tbName, &dbCache, &tbCache);
+  STableMeta  *tbMeta = NULL;
+  ctgAcquireTbMetaFromCache(pCtg, dbFName, tbName, &dbCache, &tbCache, &tbMeta);
   if (NULL == tbCache) {
     ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
 
@@ -338,6 +345,7 @@ int32_t ctgReadTbMetaFromCache(SCatalog *pCtg, SCtgTbMetaCtx *ctx, STableMeta **
   int32_t      code = 0;
   SCtgDBCache *dbCache = NULL;
   SCtgTbCache *tbCache = NULL;
+  STableMeta  *tbMeta = NULL;
   *pTableMeta = NULL;
 
   char dbFName[TSDB_DB_FNAME_LEN] = {0};
@@ -347,13 +355,12 @@ int32_t ctgReadTbMetaFromCache(SCatalog *pCtg, SCtgTbMetaCtx *ctx, STableMeta **
     tNameGetFullDbName(ctx->pName, dbFName);
   }
 
-  ctgAcquireTbMetaFromCache(pCtg, dbFName, ctx->pName->tname, &dbCache, &tbCache);
+  ctgAcquireTbMetaFromCache(pCtg, dbFName, ctx->pName->tname, &dbCache, &tbCache, &tbMeta);
   if (NULL == tbCache) {
     ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
     return TSDB_CODE_SUCCESS;
   }
 
-  STableMeta *tbMeta = tbCache->pMeta;
   ctx->tbInfo.inCache = true;
   ctx->tbInfo.dbId = dbCache->dbId;
   ctx->tbInfo.suid = tbMeta->suid;
@@ -370,7 +377,7 @@ int32_t ctgReadTbMetaFromCache(SCatalog *pCtg, SCtgTbMetaCtx *ctx, STableMeta **
     memcpy(*pTableMeta, tbMeta, metaSize);
 
     ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
-    ctgDebug("Got tb %s meta from cache, type:%d, dbFName:%s", ctx->pName->tname, tbMeta->tableType, dbFName);
+    ctgDebug("Got tb %s meta from cache, type:%d, dbFName:%s", ctx->pName->tname, ctx->tbInfo.tbType, dbFName);
     return TSDB_CODE_SUCCESS;
   }
 
@@ -388,7 +395,8 @@ int32_t ctgReadTbMetaFromCache(SCatalog *pCtg, SCtgTbMetaCtx *ctx, STableMeta **
   ctgDebug("Got ctb %s meta from cache, will continue to get its stb meta, type:%d, dbFName:%s", ctx->pName->tname,
            ctx->tbInfo.tbType, dbFName);
 
-  ctgAcquireStbMetaFromCache(pCtg, dbFName, ctx->tbInfo.suid, &dbCache, &tbCache);
+  STableMeta *stbMeta = NULL;
+  ctgAcquireStbMetaFromCache(pCtg, dbFName, ctx->tbInfo.suid, &dbCache, &tbCache, &stbMeta);
   if (NULL == tbCache) {
     ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
     taosMemoryFreeClear(*pTableMeta);
@@ -396,10 +404,9 @@ int32_t ctgReadTbMetaFromCache(SCatalog *pCtg, SCtgTbMetaCtx *ctx, STableMeta **
     return TSDB_CODE_SUCCESS;
   }
 
-  STableMeta *stbMeta = tbCache->pMeta;
   if (stbMeta->suid != ctx->tbInfo.suid) {
-    ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
     ctgError("stb suid 0x%" PRIx64 " in stbCache mis-match, expected suid 0x%" PRIx64, stbMeta->suid, ctx->tbInfo.suid);
+    ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
     CTG_ERR_JRET(TSDB_CODE_CTG_INTERNAL_ERROR);
   }
 
@@ -434,16 +441,16 @@ int32_t ctgReadTbVerFromCache(SCatalog *pCtg, SName *pTableName, int32_t *sver,
 
   SCtgDBCache *dbCache = NULL;
   SCtgTbCache *tbCache = NULL;
+  STableMeta  *tbMeta = NULL;
   char         dbFName[TSDB_DB_FNAME_LEN] = {0};
   tNameGetFullDbName(pTableName, dbFName);
 
-  ctgAcquireTbMetaFromCache(pCtg, dbFName, pTableName->tname, &dbCache, &tbCache);
+  ctgAcquireTbMetaFromCache(pCtg, dbFName, pTableName->tname, &dbCache, &tbCache, &tbMeta);
   if (NULL == tbCache) {
     ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
     return TSDB_CODE_SUCCESS;
   }
 
-  STableMeta *tbMeta = tbCache->pMeta;
   *tbType = tbMeta->tableType;
   *suid = tbMeta->suid;
 
@@ -463,17 +470,17 @@ int32_t ctgReadTbVerFromCache(SCatalog *pCtg, SName *pTableName, int32_t *sver,
   ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
   ctgDebug("Got ctb %s ver from cache, will continue to get its stb ver, dbFName:%s", pTableName->tname, dbFName);
 
-  ctgAcquireStbMetaFromCache(pCtg, dbFName, *suid, &dbCache, &tbCache);
+  STableMeta *stbMeta = NULL;
+  ctgAcquireStbMetaFromCache(pCtg, dbFName, *suid, &dbCache, &tbCache, &stbMeta);
   if (NULL == tbCache) {
     ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
     ctgDebug("stb 0x%" PRIx64 " meta not in cache", *suid);
     return TSDB_CODE_SUCCESS;
   }
 
-  STableMeta *stbMeta = tbCache->pMeta;
   if (stbMeta->suid != *suid) {
-    ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
     ctgError("stb suid 0x%" PRIx64 " in stbCache mis-match, expected suid:0x%" PRIx64, stbMeta->suid, *suid);
+    ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
     CTG_ERR_RET(TSDB_CODE_CTG_INTERNAL_ERROR);
   }
 
@@ -497,13 +504,14 @@ int32_t ctgReadTbVerFromCache(SCatalog *pCtg, SName *pTableName, int32_t *sver,
 int32_t ctgReadTbTypeFromCache(SCatalog *pCtg, char *dbFName, char *tbName, int32_t *tbType) {
   SCtgDBCache *dbCache = NULL;
   SCtgTbCache *tbCache = NULL;
-  CTG_ERR_RET(ctgAcquireTbMetaFromCache(pCtg, dbFName, tbName, &dbCache, &tbCache));
+  STableMeta  *tbMeta = NULL;
+  CTG_ERR_RET(ctgAcquireTbMetaFromCache(pCtg, dbFName, tbName, &dbCache, &tbCache, &tbMeta));
   if (NULL == tbCache) {
     ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
     return TSDB_CODE_SUCCESS;
   }
 
-  *tbType = tbCache->pMeta->tableType;
+  *tbType = tbMeta->tableType;
   ctgReleaseTbMetaToCache(pCtg, dbCache, tbCache);
 
   ctgDebug("Got tb %s tbType %d from cache, dbFName:%s", tbName, *tbType, dbFName);
@@ -1407,10 +1415,7 @@ int32_t ctgWriteTbMetaToCache(SCatalog *pCtg, SCtgDBCache *dbCache, char *dbFNam
 
     pCache = taosHashGet(dbCache->tbCache, tbName, strlen(tbName));
   } else {
-    CTG_LOCK(CTG_WRITE, &pCache->metaLock);
-    taosMemoryFree(pCache->pMeta);
-    pCache->pMeta = meta;
-    CTG_UNLOCK(CTG_WRITE, &pCache->metaLock);
+    ctgEbrRetire(atomic_exchange_ptr(&pCache->pMeta, meta), taosMemoryFree);
   }
 
   if (NULL == orig) {
@@ -1598,11 +1603,9 @@ int32_t ctgOpUpdateVgroup(SCtgCacheOperation *operation) {
 
       goto _return;
     }
-
-    ctgFreeVgInfo(vgInfo);
   }
 
-  vgCache->vgInfo = dbInfo;
+  ctgEbrRetire(atomic_exchange_ptr(&vgCache->vgInfo, dbInfo), (FCtgEbrFree)ctgFreeVgInfo);
   msg->dbInfo = NULL;
 
   ctgDebug("db vgInfo updated, dbFName:%s, vgVer:%d, stateTs:%" PRId64 ", dbId:0x%" PRIx64, dbFName,
@@ -1673,8 +1676,7 @@ int32_t ctgOpDropDbVgroup(SCtgCacheOperation *operation) {
 
   CTG_ERR_JRET(ctgWLockVgInfo(pCtg, dbCache));
 
-  ctgFreeVgInfo(dbCache->vgCache.vgInfo);
-  dbCache->vgCache.vgInfo = NULL;
+  ctgEbrRetire(atomic_exchange_ptr(&dbCache->vgCache.vgInfo, NULL), (FCtgEbrFree)ctgFreeVgInfo);
 
   ctgDebug("db vgInfo removed, dbFName:%s", msg->dbFName);
 
@@ -1775,9 +1777,10 @@ int32_t ctgOpDropStbMeta(SCtgCacheOperation *operation) {
     goto _return;
   }
 
-  CTG_LOCK(CTG_WRITE, &pTbCache->metaLock);
+  ctgEbrRetire(atomic_exchange_ptr(&pTbCache->pMeta, NULL), taosMemoryFree);
+  CTG_LOCK(CTG_WRITE, &pTbCache->indexLock);
   ctgFreeTbCacheImpl(pTbCache);
-  CTG_UNLOCK(CTG_WRITE, &pTbCache->metaLock);
+  CTG_UNLOCK(CTG_WRITE, &pTbCache->indexLock);
 
   if (taosHashRemove(dbCache->tbCache, msg->stbName, strlen(msg->stbName))) {
     ctgError("stb not exist in cache, dbFName:%s, stb:%s, suid:0x%" PRIx64, msg->dbFName, msg->stbName, msg->suid);
@@ -1825,9 +1828,10 @@ int32_t ctgOpDropTbMeta(SCtgCacheOperation *operation) {
     goto _return;
   }
 
-  CTG_LOCK(CTG_WRITE, &pTbCache->metaLock);
+  ctgEbrRetire(atomic_exchange_ptr(&pTbCache->pMeta, NULL), taosMemoryFree);
+  CTG_LOCK(CTG_WRITE, &pTbCache->indexLock);
   ctgFreeTbCacheImpl(pTbCache);
-  CTG_UNLOCK(CTG_WRITE, &pTbCache->metaLock);
+  CTG_UNLOCK(CTG_WRITE, &pTbCache->indexLock);
 
   if (taosHashRemove(dbCache->tbCache, msg->tbName, strlen(msg->tbName))) {
     ctgError("tb %s not exist in cache, dbFName:%s", msg->tbName, msg->dbFName);
@@ -1933,6 +1937,11 @@ int32_t ctgOpUpdateEpset(SCtgCacheOperation *operation) {
     goto _return;
   }
 
+  // the vgInfo may be read without the vgLock, so the epset is updated in a copy
+  SDBVgInfo *newVgInfo = NULL;
+  CTG_ERR_JRET(ctgCloneVgInfo(vgInfo, &newVgInfo));
+  pInfo = taosHashGet(newVgInfo->vgHash, &msg->vgId, sizeof(msg->vgId));
+
   SEp *pOrigEp = &pInfo->epSet.eps[pInfo->epSet.inUse];
   SEp *pNewEp = &msg->epSet.eps[msg->epSet.inUse];
   ctgDebug("vgroup %d epset updated from %d/%d=>%s:%d to %d/%d=>%s:%d, dbFName:%s in ctg", pInfo->vgId,
@@ -1941,6 +1950,8 @@ int32_t ctgOpUpdateEpset(SCtgCacheOperation *operation) {
 
   pInfo->epSet = msg->epSet;
 
+  ctgEbrRetire(atomic_exchange_ptr(&dbCache->vgCache.vgInfo, newVgInfo), (FCtgEbrFree)ctgFreeVgInfo);
+
 _return:
 
   if (dbCache) {
@@ -2178,6 +2189,8 @@ void *ctgUpdateThreadFunc(void *param) {
 
     CTG_RT_STAT_INC(numOfOpDequeue, 1);
 
+    ctgEbrReclaim(false);
+
     ctgdShowCacheInfo();
   }
 
@@ -2323,8 +2336,12 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
       continue;
     }
 
-    CTG_LOCK(CTG_READ, &pCache->metaLock);
-    if (NULL == pCache->pMeta) {
+    ctgEbrEnter();
+    STableMeta *tbMeta = atomic_load_ptr(&pCache->pMeta);
+    if (NULL == tbMeta) {
+      ctgEbrExit();
+      taosHashRelease(dbCache->tbCache, pCache);
+
       ctgDebug("tb %s meta not in cache, dbFName:%s", pName->tname, dbFName);
       ctgAddFetch(&ctx->pFetchs, dbIdx, i, fetchIdx, baseResIdx + i, flag);
       taosArraySetSize(ctx->pResList, taosArrayGetSize(ctx->pResList) + 1);
@@ -2332,8 +2349,6 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
       continue;
     }
 
-    STableMeta *tbMeta = pCache->pMeta;
-
     SCtgTbMetaCtx nctx = {0};
     nctx.flag = flag;
     nctx.tbInfo.inCache = true;
@@ -2353,10 +2368,10 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
 
       memcpy(pTableMeta, tbMeta, metaSize);
 
-      CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+      ctgEbrExit();
       taosHashRelease(dbCache->tbCache, pCache);
 
-      ctgDebug("Got tb %s meta from cache, type:%d, dbFName:%s", pName->tname, tbMeta->tableType, dbFName);
+      ctgDebug("Got tb %s meta from cache, type:%d, dbFName:%s", pName->tname, nctx.tbInfo.tbType, dbFName);
 
       res.pRes = pTableMeta;
       taosArrayPush(ctx->pResList, &res);
@@ -2370,10 +2385,10 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
       cloneTableMeta(lastTableMeta, &pTableMeta);
       memcpy(pTableMeta, tbMeta, sizeof(SCTableMeta));
 
-      CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+      ctgEbrExit();
       taosHashRelease(dbCache->tbCache, pCache);
 
-      ctgDebug("Got tb %s meta from cache, type:%d, dbFName:%s", pName->tname, tbMeta->tableType, dbFName);
+      ctgDebug("Got tb %s meta from cache, type:%d, dbFName:%s", pName->tname, nctx.tbInfo.tbType, dbFName);
 
       res.pRes = pTableMeta;
       taosArrayPush(ctx->pResList, &res);
@@ -2390,7 +2405,7 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
 
     memcpy(pTableMeta, tbMeta, metaSize);
 
-    CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+    ctgEbrExit();
     taosHashRelease(dbCache->tbCache, pCache);
 
     ctgDebug("Got ctb %s meta from cache, will continue to get its stb meta, type:%d, dbFName:%s", pName->tname,
@@ -2420,10 +2435,11 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
 
     taosHashRelease(dbCache->stbCache, stName);
 
-    CTG_LOCK(CTG_READ, &pCache->metaLock);
-    if (NULL == pCache->pMeta) {
+    ctgEbrEnter();
+    STableMeta *stbMeta = atomic_load_ptr(&pCache->pMeta);
+    if (NULL == stbMeta) {
       ctgDebug("stb 0x%" PRIx64 " meta not in cache, dbFName:%s", pTableMeta->suid, dbFName);
-      CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+      ctgEbrExit();
       taosHashRelease(dbCache->tbCache, pCache);
 
       ctgAddFetch(&ctx->pFetchs, dbIdx, i, fetchIdx, baseResIdx + i, flag);
@@ -2434,14 +2450,13 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
       continue;
     }
 
-    STableMeta *stbMeta = pCache->pMeta;
     if (stbMeta->suid != nctx.tbInfo.suid) {
-      CTG_UNLOCK(CTG_READ, &pCache->metaLock);
-      taosHashRelease(dbCache->tbCache, pCache);
-
       ctgError("stb suid 0x%" PRIx64 " in stbCache mis-match, expected suid 0x%" PRIx64, stbMeta->suid,
                nctx.tbInfo.suid);
 
+      ctgEbrExit();
+      taosHashRelease(dbCache->tbCache, pCache);
+
       ctgAddFetch(&ctx->pFetchs, dbIdx, i, fetchIdx, baseResIdx + i, flag);
       taosArraySetSize(ctx->pResList, taosArrayGetSize(ctx->pResList) + 1);
 
@@ -2459,7 +2474,7 @@ int32_t ctgGetTbMetasFromCache(SCatalog *pCtg, SRequestConnInfo *pConn, SCtgTbMe
 
     memcpy(&pTableMeta->sversion, &stbMeta->sversion, metaSize - sizeof(SCTableMeta));
 
-    CTG_UNLOCK(CTG_READ, &pCache->metaLock);
+    ctgEbrExit();
     taosHashRelease(dbCache->tbCache, pCache);
 
     res.pRes = pTableMeta;
@@ -2510,29 +2525,51 @@ int32_t ctgGetTbHashVgroupFromCache(SCatalog *pCtg, const SName *pTableName, SVg
     CTG_ERR_RET(TSDB_CODE_CTG_INVALID_INPUT);
   }
 
-  SCtgDBCache *dbCache = NULL;
+  *pVgroup = taosMemoryCalloc(1, sizeof(SVgroupInfo));
+  if (NULL == *pVgroup) {
+    CTG_ERR_RET(TSDB_CODE_OUT_OF_MEMORY);
+  }
+
+  bool    inCache = false;
+  int32_t code = ctgReadTbHashVgroupFromCache(pCtg, pTableName, *pVgroup, &inCache);
+  if (code || !inCache) {
+    taosMemoryFreeClear(*pVgroup);
+  }
+
+  CTG_RET(code);
+}
+
+int32_t ctgReadTbHashVgroupFromCache(SCatalog *pCtg, const SName *pTableName, SVgroupInfo *pVgroup, bool *inCache) {
   int32_t      code = 0;
+  SCtgDBCache *dbCache = NULL;
   char         dbFName[TSDB_DB_FNAME_LEN] = {0};
   tNameGetFullDbName(pTableName, dbFName);
 
-  CTG_ERR_RET(ctgAcquireVgInfoFromCache(pCtg, dbFName, &dbCache));
+  *inCache = false;
 
+  ctgAcquireDBCache(pCtg, dbFName, &dbCache);
   if (NULL == dbCache) {
-    *pVgroup = NULL;
+    ctgDebug("db %s not in cache", dbFName);
+    CTG_CACHE_STAT_INC(numOfVgMiss, 1);
     return TSDB_CODE_SUCCESS;
   }
 
-  *pVgroup = taosMemoryCalloc(1, sizeof(SVgroupInfo));
-  CTG_ERR_JRET(ctgGetVgInfoFromHashValue(pCtg, dbCache->vgCache.vgInfo, pTableName, *pVgroup));
-
-_return:
-
-  if (dbCache) {
-    ctgReleaseVgInfoToCache(pCtg, dbCache);
+  // the vgInfo is replaced as a whole, the one loaded here stays valid until ctgEbrExit
+  ctgEbrEnter();
+  SDBVgInfo *vgInfo = atomic_load_ptr(&dbCache->vgCache.vgInfo);
+  if (vgInfo) {
+    code = ctgGetVgInfoFromHashValue(pCtg, vgInfo, pTableName, pVgroup);
+    *inCache = true;
   }
+  ctgEbrExit();
 
-  if (code) {
-    taosMemoryFreeClear(*pVgroup);
+  ctgReleaseDBCache(pCtg, dbCache);
+
+  if (*inCache) {
+    CTG_CACHE_STAT_INC(numOfVgHit, 1);
+  } else {
+    ctgDebug("vgInfo of db %s not in cache", dbFName);
+    CTG_CACHE_STAT_INC(numOfVgMiss, 1);
   }
 
   CTG_RET(code);
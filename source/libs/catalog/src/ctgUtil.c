@@ -446,6 +446,21 @@ void ctgFreeMsgCtx(SCtgMsgCtx* pCtx) {
   }
 }
 
+void ctgFreeStbFetchs(SHashObj* pStbFetchs) {
+  if (NULL == pStbFetchs) {
+    return;
+  }
+
+  SCtgStbFetch* pStb = taosHashIterate(pStbFetchs, NULL);
+  while (pStb) {
+    taosMemoryFreeClear(pStb->pMeta);
+    taosArrayDestroy(pStb->pWaits);
+    pStb = taosHashIterate(pStbFetchs, pStb);
+  }
+
+  taosHashCleanup(pStbFetchs);
+}
+
 void ctgFreeTbMetasMsgCtx(SCtgMsgCtx* pCtx) {
   ctgFreeMsgCtx(pCtx);
   if (pCtx->lastOut) {
@@ -651,6 +666,8 @@ void ctgFreeTaskCtx(SCtgTask* pTask) {
       SCtgTbMetasCtx* taskCtx = (SCtgTbMetasCtx*)pTask->taskCtx;
       taosArrayDestroyEx(taskCtx->pResList, ctgFreeBatchMeta);
       taosArrayDestroy(taskCtx->pFetchs);
+      taosArrayDestroyP(taskCtx->pVgWaits, (FDelete)taosArrayDestroy);
+      ctgFreeStbFetchs(taskCtx->pStbFetchs);
       // NO NEED TO FREE pNames
 
       taosArrayDestroyEx(pTask->msgCtxs, (FDelete)ctgFreeTbMetasMsgCtx);
@@ -1385,3 +1402,146 @@ void catalogFreeMetaData(SMetaData* pData) {
   taosMemoryFreeClear(pData->pSvrVer);
   taosMemoryFree(pData);
 }
+
+// Readers publish the epoch they entered in through a per thread slot, an object replaced by the update thread is
+// freed once every reader has entered in a later epoch. A reader enters before it loads the pointer and all the
+// accesses are sequentially consistent, so a reader still holding the replaced pointer always keeps it alive.
+static SCtgEbr gCtgEbr = {.epoch = 1};
+
+static threadlocal int32_t ctgEbrSlotIdx = -1;
+static threadlocal int32_t ctgEbrDepth = 0;
+
+// the slot of a thread is released to the free list by the key destructor when the thread exits
+static TdThreadOnce ctgEbrKeyOnce = PTHREAD_ONCE_INIT;
+static TdThreadKey  ctgEbrKey;
+
+static void ctgEbrReleaseSlot(void* param) {
+  int32_t idx = (int32_t)(intptr_t)param - 1;
+
+  atomic_store_64(&gCtgEbr.slots[idx].epoch, 0);
+
+  CTG_LOCK(CTG_WRITE, &gCtgEbr.slotLock);
+  gCtgEbr.freeSlots[gCtgEbr.freeSlotNum++] = idx;
+  CTG_UNLOCK(CTG_WRITE, &gCtgEbr.slotLock);
+}
+
+static void ctgEbrInitKey(void) {
+  if (taosThreadKeyCreate(&ctgEbrKey, ctgEbrReleaseSlot)) {
+    qError("failed to create the key of the epoch slots, the slots of the exited threads are not reused");
+  }
+}
+
+// CTG_EBR_MAX_SLOTS if all the slots are taken, the thread then reads as a shared reader
+static int32_t ctgEbrTakeSlot(void) {
+  int32_t idx = CTG_EBR_MAX_SLOTS;
+
+  taosThreadOnce(&ctgEbrKeyOnce, ctgEbrInitKey);
+
+  CTG_LOCK(CTG_WRITE, &gCtgEbr.slotLock);
+  if (gCtgEbr.freeSlotNum > 0) {
+    idx = gCtgEbr.freeSlots[--gCtgEbr.freeSlotNum];
+  } else if (gCtgEbr.slotNum < CTG_EBR_MAX_SLOTS) {
+    idx = atomic_fetch_add_32(&gCtgEbr.slotNum, 1);
+  }
+  CTG_UNLOCK(CTG_WRITE, &gCtgEbr.slotLock);
+
+  if (idx < CTG_EBR_MAX_SLOTS && taosThreadSetSpecific(ctgEbrKey, (void*)(intptr_t)(idx + 1))) {
+    qError("failed to set the epoch slot %d of the thread, it is not reused after the thread exits", idx);
+  }
+
+  return idx;
+}
+
+void ctgEbrEnter(void) {
+  if (ctgEbrDepth++ > 0) {
+    return;
+  }
+
+  // a shared reader takes the slot released since
+  if (ctgEbrSlotIdx < 0 || (ctgEbrSlotIdx >= CTG_EBR_MAX_SLOTS && atomic_load_32(&gCtgEbr.freeSlotNum) > 0)) {
+    ctgEbrSlotIdx = ctgEbrTakeSlot();
+  }
+
+  if (ctgEbrSlotIdx >= CTG_EBR_MAX_SLOTS) {
+    atomic_add_fetch_32(&gCtgEbr.sharedReaders, 1);
+    return;
+  }
+
+  atomic_store_64(&gCtgEbr.slots[ctgEbrSlotIdx].epoch, atomic_load_64(&gCtgEbr.epoch));
+}
+
+void ctgEbrExit(void) {
+  if (--ctgEbrDepth > 0) {
+    return;
+  }
+
+  if (ctgEbrSlotIdx >= CTG_EBR_MAX_SLOTS) {
+    atomic_sub_fetch_32(&gCtgEbr.sharedReaders, 1);
+    return;
+  }
+
+  atomic_store_64(&gCtgEbr.slots[ctgEbrSlotIdx].epoch, 0);
+}
+
+// the objects retired before the returned epoch are not visible to any reader
+static int64_t ctgEbrSafeEpoch(void) {
+  if (atomic_load_32(&gCtgEbr.sharedReaders) > 0) {
+    return 0;
+  }
+
+  int64_t safeEpoch = atomic_load_64(&gCtgEbr.epoch);
+  int32_t slotNum = TMIN(atomic_load_32(&gCtgEbr.slotNum), CTG_EBR_MAX_SLOTS);
+  for (int32_t i = 0; i < slotNum; ++i) {
+    int64_t epoch = atomic_load_64(&gCtgEbr.slots[i].epoch);
+    if (epoch > 0 && epoch < safeEpoch) {
+      safeEpoch = epoch;
+    }
+  }
+
+  return safeEpoch;
+}
+
+void ctgEbrRetire(void* p, FCtgEbrFree freeFp) {
+  if (NULL == p) {
+    return;
+  }
+
+  SCtgEbrRetired retired = {.epoch = atomic_fetch_add_64(&gCtgEbr.epoch, 1), .p = p, .freeFp = freeFp};
+
+  if (NULL == gCtgEbr.pRetired) {
+    gCtgEbr.pRetired = taosArrayInit(64, sizeof(SCtgEbrRetired));
+  }
+
+  if (NULL == gCtgEbr.pRetired || NULL == taosArrayPush(gCtgEbr.pRetired, &retired)) {
+    qWarn("no memory to retire %p, wait for the readers", p);
+    while (ctgEbrSafeEpoch() <= retired.epoch) {
+      taosMsleep(1);
+    }
+
+    (*freeFp)(p);
+  }
+}
+
+void ctgEbrReclaim(bool all) {
+  int32_t num = taosArrayGetSize(gCtgEbr.pRetired);
+  if (num <= 0) {
+    return;
+  }
+
+  int64_t safeEpoch = all ? INT64_MAX : ctgEbrSafeEpoch();
+  int32_t i = 0;
+  for (; i < num; ++i) {
+    SCtgEbrRetired* pRetired = taosArrayGet(gCtgEbr.pRetired, i);
+    if (pRetired->epoch >= safeEpoch) {
+      break;
+    }
+
+    (*pRetired->freeFp)(pRetired->p);
+  }
+
+  taosArrayPopFrontBatch(gCtgEbr.pRetired, i);
+  if (all) {
+    taosArrayDestroy(gCtgEbr.pRetired);
+    gCtgEbr.pRetired = NULL;
+  }
+}
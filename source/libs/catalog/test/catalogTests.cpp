@@ -2673,6 +2673,302 @@ TEST(multiThread, ctableMeta) {
   catalogDestroy();
 }
 
+int32_t ctgTestEbrState = 0;
+int32_t ctgTestEbrFreeNum = 0;
+
+void ctgTestEbrFree(void *p) {
+  ++ctgTestEbrFreeNum;
+  taosMemoryFree(p);
+}
+
+void *ctgTestEbrReadThread(void *param) {
+  ctgEbrEnter();
+  atomic_store_32(&ctgTestEbrState, 1);
+  while (atomic_load_32(&ctgTestEbrState) == 1) {
+    taosMsleep(1);
+  }
+  ctgEbrExit();
+
+  return NULL;
+}
+
+TEST(multiThread, epochReclaim) {
+  ctgEbrReclaim(true);
+  ctgTestEbrState = 0;
+  ctgTestEbrFreeNum = 0;
+
+  TdThreadAttr thattr;
+  taosThreadAttrInit(&thattr);
+
+  TdThread thread1;
+  taosThreadCreate(&(thread1), &thattr, ctgTestEbrReadThread, NULL);
+  while (atomic_load_32(&ctgTestEbrState) != 1) {
+    taosMsleep(1);
+  }
+
+  // the reader entered before the retirement keeps it alive
+  ctgEbrRetire(taosMemoryMalloc(16), ctgTestEbrFree);
+  ctgEbrReclaim(false);
+  ASSERT_EQ(ctgTestEbrFreeNum, 0);
+
+  // a reader entered after the retirement does not
+  ctgEbrEnter();
+  ctgEbrExit();
+
+  atomic_store_32(&ctgTestEbrState, 2);
+  taosThreadJoin(thread1, NULL);
+
+  ctgEbrReclaim(false);
+  ASSERT_EQ(ctgTestEbrFreeNum, 1);
+
+  // only the outermost exit leaves the epoch
+  ctgEbrEnter();
+  ctgEbrEnter();
+  ctgEbrRetire(taosMemoryMalloc(16), ctgTestEbrFree);
+  ctgEbrExit();
+  ctgEbrReclaim(false);
+  ASSERT_EQ(ctgTestEbrFreeNum, 1);
+
+  ctgEbrExit();
+  ctgEbrReclaim(false);
+  ASSERT_EQ(ctgTestEbrFreeNum, 2);
+
+  taosThreadAttrDestroy(&thattr);
+}
+
+void *ctgTestEbrShortThread(void *param) {
+  ctgEbrEnter();
+  ctgEbrExit();
+
+  return NULL;
+}
+
+TEST(multiThread, epochSlotReuse) {
+  ctgEbrReclaim(true);
+  ctgTestEbrState = 0;
+  ctgTestEbrFreeNum = 0;
+
+  TdThreadAttr thattr;
+  taosThreadAttrInit(&thattr);
+
+  // more threads than slots, each one releases its slot when it exits
+  for (int32_t i = 0; i < CTG_EBR_MAX_SLOTS * 2; ++i) {
+    TdThread thread;
+    taosThreadCreate(&thread, &thattr, ctgTestEbrShortThread, NULL);
+    taosThreadJoin(thread, NULL);
+  }
+
+  ctgEbrRetire(taosMemoryMalloc(16), ctgTestEbrFree);
+
+  TdThread thread1;
+  taosThreadCreate(&(thread1), &thattr, ctgTestEbrReadThread, NULL);
+  while (atomic_load_32(&ctgTestEbrState) != 1) {
+    taosMsleep(1);
+  }
+
+  // the reader got a slot, a shared reader would keep the objects retired before it entered alive too
+  ctgEbrReclaim(false);
+  ASSERT_EQ(ctgTestEbrFreeNum, 1);
+
+  ctgEbrRetire(taosMemoryMalloc(16), ctgTestEbrFree);
+  ctgEbrReclaim(false);
+  ASSERT_EQ(ctgTestEbrFreeNum, 1);
+
+  atomic_store_32(&ctgTestEbrState, 2);
+  taosThreadJoin(thread1, NULL);
+
+  ctgEbrReclaim(false);
+  ASSERT_EQ(ctgTestEbrFreeNum, 2);
+
+  taosThreadAttrDestroy(&thattr);
+}
+
+int32_t ctgTestAsyncTbNum = 200;
+int32_t ctgTestAsyncUseDbNum = 0;
+int32_t ctgTestAsyncStbNum = 0;
+int32_t ctgTestAsyncVnodeBatchNum = 0;
+int32_t ctgTestAsyncCode = -1;
+int32_t ctgTestAsyncOkNum = 0;
+
+uint64_t ctgTestAsyncTbUid(int32_t idx) { return 1000 + idx; }
+
+void ctgTestAsyncSetRspMsg(SBatchRspMsg *pRsp, STableMetaRsp *metaRsp) {
+  pRsp->msgLen = tSerializeSTableMetaRsp(NULL, 0, metaRsp);
+  pRsp->msg = taosMemoryMalloc(pRsp->msgLen);
+  tSerializeSTableMetaRsp(pRsp->msg, pRsp->msgLen, metaRsp);
+
+  tFreeSTableMetaRsp(metaRsp);
+}
+
+void ctgTestAsyncBuildRsp(SBatchMsg *pReq, int32_t vgId, SBatchRspMsg *pRsp) {
+  pRsp->reqType = pReq->msgType;
+  pRsp->msgIdx = pReq->msgIdx;
+  pRsp->rspCode = 0;
+
+  switch (pReq->msgType) {
+    case TDMT_MND_USE_DB: {
+      atomic_add_fetch_32(&ctgTestAsyncUseDbNum, 1);
+
+      SRpcMsg rpcReq = {0};
+      SRpcMsg rpcRsp = {0};
+      ctgTestRspDbVgroups(NULL, NULL, &rpcReq, &rpcRsp);
+      pRsp->msgLen = rpcRsp.contLen;
+      pRsp->msg = taosMemoryMalloc(rpcRsp.contLen);
+      memcpy(pRsp->msg, rpcRsp.pCont, rpcRsp.contLen);
+      rpcFreeCont(rpcRsp.pCont);
+      break;
+    }
+    case TDMT_MND_TABLE_META: {
+      atomic_add_fetch_32(&ctgTestAsyncStbNum, 1);
+
+      STableMetaRsp metaRsp = {0};
+      ctgTestBuildSTableMetaRsp(&metaRsp);
+      ctgTestAsyncSetRspMsg(pRsp, &metaRsp);
+      break;
+    }
+    case TDMT_VND_TABLE_META: {
+      STableInfoReq infoReq = {0};
+      tDeserializeSTableInfoReq(pReq->msg, pReq->msgLen, &infoReq);
+
+      int32_t idx = 0;
+      sscanf(infoReq.tbName, "ctb_%d", &idx);
+
+      // the child table of the stb of ctgTestBuildSTableMetaRsp
+      STableMetaRsp metaRsp = {0};
+      ctgTestBuildSTableMetaRsp(&metaRsp);
+      strcpy(metaRsp.tbName, infoReq.tbName);
+      metaRsp.tableType = TSDB_CHILD_TABLE;
+      metaRsp.tuid = ctgTestAsyncTbUid(idx);
+      metaRsp.vgId = vgId;
+      ctgTestAsyncSetRspMsg(pRsp, &metaRsp);
+      break;
+    }
+    default:
+      pRsp->rspCode = TSDB_CODE_INVALID_MSG;
+      break;
+  }
+}
+
+// answers a batch request the way the transport does, from another thread
+void *ctgTestAsyncRspThread(void *param) {
+  SMsgSendInfo *pInfo = (SMsgSendInfo *)param;
+  int32_t       vgId = ntohl(((SMsgHead *)pInfo->msgInfo.pData)->vgId);
+  SBatchReq     batchReq = {0};
+  SBatchRsp     batchRsp = {0};
+
+  if (TDMT_VND_BATCH_META == pInfo->msgType) {
+    atomic_add_fetch_32(&ctgTestAsyncVnodeBatchNum, 1);
+  }
+
+  tDeserializeSBatchReq(pInfo->msgInfo.pData, pInfo->msgInfo.len, &batchReq);
+
+  int32_t num = taosArrayGetSize(batchReq.pMsgs);
+  batchRsp.pRsps = taosArrayInit(num, sizeof(SBatchRspMsg));
+  for (int32_t i = 0; i < num; ++i) {
+    SBatchRspMsg rsp = {0};
+    ctgTestAsyncBuildRsp((SBatchMsg *)taosArrayGet(batchReq.pMsgs, i), vgId, &rsp);
+    taosArrayPush(batchRsp.pRsps, &rsp);
+  }
+
+  SDataBuf buf = {0};
+  buf.msgType = pInfo->msgType + 1;
+  buf.len = tSerializeSBatchRsp(NULL, 0, &batchRsp);
+  buf.pData = taosMemoryMalloc(buf.len);
+  tSerializeSBatchRsp(buf.pData, buf.len, &batchRsp);
+
+  (*pInfo->fp)(pInfo->param, &buf, TSDB_CODE_SUCCESS);
+  destroySendMsgInfo(pInfo);
+
+  taosArrayDestroyEx(batchReq.pMsgs, tFreeSBatchReqMsg);
+  taosArrayDestroyEx(batchRsp.pRsps, tFreeSBatchRspMsg);
+  return NULL;
+}
+
+int32_t ctgTestAsyncSendMsg(void *pTransporter, SEpSet *epSet, int64_t *pTransporterId, SMsgSendInfo *pInfo) {
+  TdThreadAttr thattr;
+  taosThreadAttrInit(&thattr);
+  taosThreadAttrSetDetachState(&thattr, PTHREAD_CREATE_DETACHED);
+
+  TdThread thread;
+  taosThreadCreate(&thread, &thattr, ctgTestAsyncRspThread, pInfo);
+  taosThreadAttrDestroy(&thattr);
+  return TSDB_CODE_SUCCESS;
+}
+
+void ctgTestAsyncMetaCb(SMetaData *pResult, void *param, int32_t code) {
+  ctgTestAsyncCode = code;
+
+  int32_t num = (TSDB_CODE_SUCCESS == code) ? taosArrayGetSize(pResult->pTableMeta) : 0;
+  for (int32_t i = 0; i < num; ++i) {
+    SMetaRes   *pRes = (SMetaRes *)taosArrayGet(pResult->pTableMeta, i);
+    STableMeta *pMeta = (STableMeta *)pRes->pRes;
+    if (pRes->code || NULL == pMeta) {
+      continue;
+    }
+
+    if (TSDB_CHILD_TABLE == pMeta->tableType && ctgTestAsyncTbUid(i) == pMeta->uid && ctgTestSuid == pMeta->suid &&
+        ctgTestSVersion + 1 == pMeta->sversion && ctgTestColNum == pMeta->tableInfo.numOfColumns) {
+      ++ctgTestAsyncOkNum;
+    }
+  }
+
+  tsem_post((tsem_t *)param);
+}
+
+TEST(multiThread, asyncChildTableMetas) {
+  struct SCatalog *pCtg = NULL;
+  SRequestConnInfo connInfo = {0};
+
+  ctgTestInitLogFile();
+
+  initQueryModuleMsgHandle();
+  initTaskQueue();
+
+  Stub stub;
+  stub.set(asyncSendMsgToServer, ctgTestAsyncSendMsg);
+
+  int32_t code = catalogInit(NULL);
+  ASSERT_EQ(code, 0);
+
+  // a cluster of its own, nothing of the db is cached
+  code = catalogGetHandle(ctgTestClusterId + 1, &pCtg);
+  ASSERT_EQ(code, 0);
+
+  STablesReq tbReq = {0};
+  strcpy(tbReq.dbFName, ctgTestDbname);
+  tbReq.pTables = taosArrayInit(ctgTestAsyncTbNum, sizeof(SName));
+  for (int32_t i = 0; i < ctgTestAsyncTbNum; ++i) {
+    SName n = {TSDB_TABLE_NAME_T, 1, {0}, {0}};
+    strcpy(n.dbname, "db1");
+    sprintf(n.tname, "ctb_%d", i);
+    taosArrayPush(tbReq.pTables, &n);
+  }
+
+  SCatalogReq req = {0};
+  req.pTableMeta = taosArrayInit(1, sizeof(STablesReq));
+  taosArrayPush(req.pTableMeta, &tbReq);
+
+  tsem_t  sem;
+  int64_t jobId = 0;
+  tsem_init(&sem, 0, 0);
+
+  code = catalogAsyncGetAllMeta(pCtg, &connInfo, &req, ctgTestAsyncMetaCb, &sem, &jobId);
+  ASSERT_EQ(code, 0);
+  tsem_wait(&sem);
+
+  ASSERT_EQ(ctgTestAsyncCode, 0);
+  ASSERT_EQ(ctgTestAsyncOkNum, ctgTestAsyncTbNum);
+
+  // the db vgInfo and the stb meta are got once for all the tables, a vnode gets all its tables in one batch
+  ASSERT_EQ(ctgTestAsyncUseDbNum, 1);
+  ASSERT_EQ(ctgTestAsyncStbNum, 1);
+  ASSERT_LE(ctgTestAsyncVnodeBatchNum, ctgTestVgNum);
+
+  tsem_destroy(&sem);
+  taosArrayDestroy(tbReq.pTables);
+  taosArrayDestroy(req.pTableMeta);
+}
+
 TEST(rentTest, allRent) {
   struct SCatalog  *pCtg = NULL;
   SRequestConnInfo connInfo = {0};  
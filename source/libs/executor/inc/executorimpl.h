@@ -163,6 +163,15 @@ typedef struct {
   SArray*  pStopInfo;
 } STaskStopInfo;
 
+typedef void (*__query_worker_fn_t)(void* param);
+
+// a work of a query task run by the vnode query workers, the msg is never sent out of the node
+typedef struct SQueryWorkerReq {
+  SMsgHead            header;
+  __query_worker_fn_t fp;
+  void*               param;
+} SQueryWorkerReq;
+
 struct SExecTaskInfo {
   STaskIdInfo   id;
   uint32_t      status;
@@ -500,6 +509,11 @@ typedef struct SIntervalAggOperatorInfo {
   EOPTR_EXEC_MODEL   execModel;          // operator execution model [batch model|stream model]
   STimeWindowAggSupp twAggSup;
   SArray*            pPrevValues;  //  SArray<SGroupKeys> used to keep the previous not null value for interpolation.
+  bool               streamingAgg;       // in-order input, only the open window is kept and closed ones are emitted
+  bool               hasOpenWindow;      // the open window of the streaming mode has been set up
+  uint64_t           openGroupId;        // group id of the open window in streaming mode
+  SResultRow*        pOpenRow;           // result row of the open window in streaming mode, not in the paged buffer
+  SSDataBlock*       prefetchedBlock;    // first block of the next group in streaming mode
 } SIntervalAggOperatorInfo;
 
 typedef struct SMergeAlignedIntervalAggOperatorInfo {
@@ -640,8 +654,9 @@ typedef struct SStreamPartitionOperatorInfo {
   SExprSupp             scalarSup;
   SExprSupp             tbnameCalSup;
   SExprSupp             tagCalSup;
-  SHashObj*             pPartitions;
+  SSHashObj*            pPartitions;
   void*                 parIte;
+  int32_t               parIter;
   SSDataBlock*          pInputDataBlock;
   int32_t               tsColIndex;
   SSDataBlock*          pDelRes;
@@ -739,6 +754,11 @@ void applyLimitOffset(SLimitInfo* pLimitInfo, SSDataBlock* pBlock, SExecTaskInfo
 
 void doApplyFunctions(SExecTaskInfo* taskInfo, SqlFunctionCtx* pCtx, SColumnInfoData* pTimeWindowData, int32_t offset,
                       int32_t forwardStep, int32_t numOfTotal, int32_t numOfOutput);
+void doBatchApplyFunctions(SExecTaskInfo* taskInfo, SqlFunctionCtx* pCtx, SResultRow** pRows,
+                           SResultRowEntryInfo** pResList, int32_t numOfRows, int32_t numOfOutput,
+                           const int32_t* rowEntryInfoOffset);
+void getBatchResultRows(SDiskbasedBuf* pBuf, SResultRowPosition** pPos, int32_t numOfRows, SResultRow** pRows);
+void releaseBatchResultRows(SDiskbasedBuf* pBuf, SResultRow** pRows, int32_t numOfRows);
 
 int32_t extractDataBlockFromFetchRsp(SSDataBlock* pRes, char* pData, SArray* pColList, char** pNextStart);
 void    updateLoadRemoteInfo(SLoadRemoteDataInfo* pInfo, int32_t numOfRows, int32_t dataLen, int64_t startTs,
@@ -747,6 +767,7 @@ void    updateLoadRemoteInfo(SLoadRemoteDataInfo* pInfo, int32_t numOfRows, int3
 STimeWindow getFirstQualifiedTimeWindow(int64_t ts, STimeWindow* pWindow, SInterval* pInterval, int32_t order);
 
 int32_t getTableScanInfo(SOperatorInfo* pOperator, int32_t* order, int32_t* scanFlag);
+void    resetTableScanInfo(STableScanInfo* pTableScanInfo, STimeWindow* pWin);
 int32_t getBufferPgSize(int32_t rowSize, uint32_t* defaultPgsz, uint32_t* defaultBufsz);
 
 void doDestroyExchangeOperatorInfo(void* param);
@@ -802,6 +823,8 @@ SOperatorInfo* createStreamFinalIntervalOperatorInfo(SOperatorInfo* downstream,
 SOperatorInfo* createSessionAggOperatorInfo(SOperatorInfo* downstream, SSessionWinodwPhysiNode* pSessionNode,
                                             SExecTaskInfo* pTaskInfo);
 SOperatorInfo* createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode* pAggNode, SExecTaskInfo* pTaskInfo);
+void           initGroupOptrParallelism(SOperatorInfo* pOperator, SAggPhysiNode* pAggNode, SReadHandle* pHandle);
+int32_t        qPutWorkerToQueryQueue(SMsgCb* pMsgCb, int32_t vgId, __query_worker_fn_t fp, void* param);
 SOperatorInfo* createDataBlockInfoScanOperator(SReadHandle* readHandle, SBlockDistScanPhysiNode* pBlockScanNode,
                                                SExecTaskInfo* pTaskInfo);
 
@@ -894,6 +917,7 @@ void     calBlockTbName(SStreamScanInfo* pInfo, SSDataBlock* pBlock);
 
 int32_t finalizeResultRows(SDiskbasedBuf* pBuf, SResultRowPosition* resultRowPosition, SExprSupp* pSup,
                            SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo);
+int32_t finalizeResultRow(SResultRow* pRow, SExprSupp* pSup, SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo);
 
 SOperatorInfo* createGroupSortOperatorInfo(SOperatorInfo* downstream, SGroupSortPhysiNode* pSortPhyNode,
                                            SExecTaskInfo* pTaskInfo);
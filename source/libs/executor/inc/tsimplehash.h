@@ -27,7 +27,7 @@ typedef int32_t (*_equal_fn_t)(const void *, const void *, size_t len);
 typedef void (*_hash_free_fn_t)(void *);
 
 /**
- * @brief single thread hash
+ * @brief single thread hash, based on open addressing with linear probing
  *
  */
 typedef struct SSHashObj SSHashObj;
@@ -72,6 +72,36 @@ int32_t tSimpleHashPut(SSHashObj *pHashObj, const void *key, size_t keyLen, cons
  */
 void *tSimpleHashGet(SSHashObj *pHashObj, const void *key, size_t keyLen);
 
+/**
+ * return the payload data of a batch of keys, the hash values of all keys are computed and the home slots are
+ * prefetched before probing the table. NULL is returned in pRes for absent keys.
+ *
+ * @param pHashObj
+ * @param keys
+ * @param keyLens
+ * @param num       number of keys
+ * @param pRes      payload data of each key
+ * @return int32_t
+ */
+int32_t tSimpleHashBatchGet(SSHashObj *pHashObj, const void **keys, const size_t *keyLens, int32_t num, void **pRes);
+
+/**
+ * return the payload data of a batch of keys, and add the absent keys into hash table with the given initial data.
+ * If data is NULL, the payload of new elements is filled with zero.
+ *
+ * @param pHashObj
+ * @param keys
+ * @param keyLens
+ * @param num       number of keys
+ * @param data      initial data of new elements
+ * @param dataLen
+ * @param pRes      payload data of each key
+ * @param numOfNew  number of new added elements
+ * @return int32_t
+ */
+int32_t tSimpleHashBatchGetOrPut(SSHashObj *pHashObj, const void **keys, const size_t *keyLens, int32_t num,
+                                 const void *data, size_t dataLen, void **pRes, int32_t *numOfNew);
+
 /**
  * remove item with the specified key
  * @param pHashObj
@@ -111,9 +141,13 @@ void tSimpleHashCleanup(SSHashObj *pHashObj);
  */
 size_t tSimpleHashGetMemSize(const SSHashObj *pHashObj);
 
+/**
+ * The element is kept in a node allocated from the arena of hash table, so the address of payload data is not changed
+ * when the hash table is resized.
+ */
 #pragma pack(push, 4)
 typedef struct SHNode {
-  struct SHNode *next;
+  struct SHNode *next;  // link of the free list, after the node is removed from hash table
   uint32_t       keyLen : 20;
   uint32_t       dataLen : 12;
   char           data[];
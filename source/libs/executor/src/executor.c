@@ -692,6 +692,27 @@ void qDestroyTask(qTaskInfo_t qTaskHandle) {
   doDestroyTask(pTaskInfo);
 }
 
+int32_t qPutWorkerToQueryQueue(SMsgCb* pMsgCb, int32_t vgId, __query_worker_fn_t fp, void* param) {
+  SQueryWorkerReq* pReq = rpcMallocCont(sizeof(SQueryWorkerReq));
+  if (pReq == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pReq->header.vgId = vgId;
+  pReq->header.contLen = sizeof(SQueryWorkerReq);
+  pReq->fp = fp;
+  pReq->param = param;
+
+  SRpcMsg msg = {.msgType = TDMT_SCH_QUERY_WORKER, .pCont = pReq, .contLen = sizeof(SQueryWorkerReq)};
+  return tmsgPutToQueue(pMsgCb, QUERY_QUEUE, &msg);
+}
+
+int32_t qProcessWorkerMsg(SRpcMsg* pMsg) {
+  SQueryWorkerReq* pReq = pMsg->pCont;
+  pReq->fp(pReq->param);
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t qGetExplainExecInfo(qTaskInfo_t tinfo, SArray* pExecInfoList) {
   SExecTaskInfo* pTaskInfo = (SExecTaskInfo*)tinfo;
   return getOperatorExplainExecInfo(pTaskInfo->pRoot, pExecInfoList);
@@ -362,6 +362,78 @@ void doApplyFunctions(SExecTaskInfo* taskInfo, SqlFunctionCtx* pCtx, SColumnInfo
   }
 }
 
+/**
+ * Apply the aggregate functions on the rows [0, numOfRows) of current input block, of which the i-th row belongs to
+ * the result row pRows[i]. The batch version of function is invoked if provided, otherwise the rows are processed one
+ * by one.
+ */
+void doBatchApplyFunctions(SExecTaskInfo* taskInfo, SqlFunctionCtx* pCtx, SResultRow** pRows,
+                           SResultRowEntryInfo** pResList, int32_t numOfRows, int32_t numOfOutput,
+                           const int32_t* rowEntryInfoOffset) {
+  for (int32_t k = 0; k < numOfOutput; ++k) {
+    if (pCtx[k].functionId == -1 || pCtx[k].fpSet.process == NULL) {
+      continue;
+    }
+
+    SFunctionCtxStatus status = {0};
+    functionCtxSave(&pCtx[k], &status);
+
+    // rows of different groups are interleaved, the statistics data of the whole block can not be used
+    pCtx[k].input.colDataAggIsSet = false;
+
+    for (int32_t j = 0; j < numOfRows; ++j) {
+      pResList[j] = getResultEntryInfo(pRows[j], k, rowEntryInfoOffset);
+    }
+
+    int32_t code = TSDB_CODE_SUCCESS;
+    if (pCtx[k].fpSet.batchProcess != NULL && pCtx[k].scanFlag == MAIN_SCAN) {
+      pCtx[k].input.startRowIndex = 0;
+      pCtx[k].input.numOfRows = numOfRows;
+      code = pCtx[k].fpSet.batchProcess(&pCtx[k], pResList);
+    } else {
+      pCtx[k].input.numOfRows = 1;
+      for (int32_t j = 0; j < numOfRows && code == TSDB_CODE_SUCCESS; ++j) {
+        pCtx[k].resultInfo = pResList[j];
+        pCtx[k].input.startRowIndex = j;
+        if (functionNeedToExecute(&pCtx[k])) {
+          code = pCtx[k].fpSet.process(&pCtx[k]);
+        }
+      }
+    }
+
+    functionCtxRestore(&pCtx[k], &status);
+    if (code != TSDB_CODE_SUCCESS) {
+      qError("%s apply functions error, code: %s", GET_TASKID(taskInfo), tstrerror(code));
+      taskInfo->code = code;
+      T_LONG_JMP(taskInfo->env, code);
+    }
+  }
+}
+
+/**
+ * Get the result rows of the given positions, and keep their pages in memory until releaseBatchResultRows is called.
+ * It must be called after all the rows are allocated, since allocating a new row releases the current page, and any
+ * page not kept in memory may be flushed to disk by a later allocation.
+ */
+void getBatchResultRows(SDiskbasedBuf* pBuf, SResultRowPosition** pPos, int32_t numOfRows, SResultRow** pRows) {
+  for (int32_t j = 0; j < numOfRows; ++j) {
+    if (j > 0 && pPos[j] == pPos[j - 1]) {
+      pRows[j] = pRows[j - 1];
+    } else {
+      pRows[j] = getResultRowByPos(pBuf, pPos[j], true);
+    }
+  }
+}
+
+void releaseBatchResultRows(SDiskbasedBuf* pBuf, SResultRow** pRows, int32_t numOfRows) {
+  for (int32_t j = 0; j < numOfRows; ++j) {
+    SResultRow* pRow = pRows[j];
+    if (j == 0 || pRow->pageId != pRows[j - 1]->pageId) {
+      releaseBufPage(pBuf, (char*)pRow - pRow->offset);
+    }
+  }
+}
+
 static int32_t doSetInputDataBlock(SExprSupp* pExprSup, SSDataBlock* pBlock, int32_t order, int32_t scanFlag,
                                    bool createDummyCol);
 
@@ -1182,19 +1254,14 @@ static void doCopyResultToDataBlock(SExprInfo* pExprInfo, int32_t numOfExprs, SR
 }
 
 // todo refactor. SResultRow has direct pointer in miainfo
-int32_t finalizeResultRows(SDiskbasedBuf* pBuf, SResultRowPosition* resultRowPosition, SExprSupp* pSup,
-                           SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo) {
-  SFilePage*  page = getBufPage(pBuf, resultRowPosition->pageId);
-  SResultRow* pRow = (SResultRow*)((char*)page + resultRowPosition->offset);
-
+static int32_t doFinalizeResultRow(SResultRow* pRow, SExprSupp* pSup, SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo) {
   SqlFunctionCtx* pCtx = pSup->pCtx;
   SExprInfo*      pExprInfo = pSup->pExprInfo;
   const int32_t*  rowEntryOffset = pSup->rowEntryInfoOffset;
 
   doUpdateNumOfRows(pCtx, pRow, pSup->numOfExprs, rowEntryOffset);
   if (pRow->numOfRows == 0) {
-    releaseBufPage(pBuf, page);
-    return 0;
+    return TSDB_CODE_SUCCESS;
   }
 
   int32_t size = pBlock->info.capacity;
@@ -1204,15 +1271,36 @@ int32_t finalizeResultRows(SDiskbasedBuf* pBuf, SResultRowPosition* resultRowPos
 
   int32_t code = blockDataEnsureCapacity(pBlock, size);
   if (TAOS_FAILED(code)) {
-    releaseBufPage(pBuf, page);
-    qError("%s ensure result data capacity failed, code %s", GET_TASKID(pTaskInfo), tstrerror(code));
-    T_LONG_JMP(pTaskInfo->env, code);
+    return code;
   }
 
   doCopyResultToDataBlock(pExprInfo, pSup->numOfExprs, pRow, pCtx, pBlock, rowEntryOffset, pTaskInfo);
+  pBlock->info.rows += pRow->numOfRows;
+  return TSDB_CODE_SUCCESS;
+}
 
+int32_t finalizeResultRows(SDiskbasedBuf* pBuf, SResultRowPosition* resultRowPosition, SExprSupp* pSup,
+                           SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo) {
+  SFilePage*  page = getBufPage(pBuf, resultRowPosition->pageId);
+  SResultRow* pRow = (SResultRow*)((char*)page + resultRowPosition->offset);
+
+  int32_t code = doFinalizeResultRow(pRow, pSup, pBlock, pTaskInfo);
   releaseBufPage(pBuf, page);
-  pBlock->info.rows += pRow->numOfRows;
+
+  if (TAOS_FAILED(code)) {
+    qError("%s ensure result data capacity failed, code %s", GET_TASKID(pTaskInfo), tstrerror(code));
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+  return 0;
+}
+
+// the result row is not kept in the paged buffer, e.g., the open window of the streaming interval aggregation
+int32_t finalizeResultRow(SResultRow* pRow, SExprSupp* pSup, SSDataBlock* pBlock, SExecTaskInfo* pTaskInfo) {
+  int32_t code = doFinalizeResultRow(pRow, pSup, pBlock, pTaskInfo);
+  if (TAOS_FAILED(code)) {
+    qError("%s ensure result data capacity failed, code %s", GET_TASKID(pTaskInfo), tstrerror(code));
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
   return 0;
 }
 
@@ -2588,6 +2676,9 @@ SOperatorInfo* createOperatorTree(SPhysiNode* pPhyNode, SExecTaskInfo* pTaskInfo
     SAggPhysiNode* pAggNode = (SAggPhysiNode*)pPhyNode;
     if (pAggNode->pGroupKeys != NULL) {
       pOptr = createGroupOperatorInfo(ops[0], pAggNode, pTaskInfo);
+      if (pOptr != NULL && pHandle != NULL) {
+        initGroupOptrParallelism(pOptr, pAggNode, pHandle);
+      }
     } else {
       pOptr = createAggregateOperatorInfo(ops[0], pAggNode, pTaskInfo);
     }
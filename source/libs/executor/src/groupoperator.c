@@ -15,30 +15,81 @@
 
 #include "filter.h"
 #include "function.h"
+#include "functionMgt.h"
 #include "os.h"
 #include "tname.h"
 
 #include "tdatablock.h"
+#include "tglobal.h"
 #include "tmsg.h"
 
 #include "executorInt.h"
 #include "executorimpl.h"
 #include "tcompare.h"
 #include "thash.h"
+#include "tsimplehash.h"
 #include "ttypes.h"
 
+typedef struct SGroupbyParallelInfo SGroupbyParallelInfo;
+
 typedef struct SGroupbyOperatorInfo {
-  SOptrBasicInfo binfo;
-  SAggSupporter  aggSup;
-  SArray*        pGroupCols;     // group by columns, SArray<SColumn>
-  SArray*        pGroupColVals;  // current group column values, SArray<SGroupKeys>
-  bool           isInit;         // denote if current val is initialized or not
-  char*          keyBuf;         // group by keys for hash
-  int32_t        groupKeyLen;    // total group by column width
-  SGroupResInfo  groupResInfo;
-  SExprSupp      scalarSup;
+  SOptrBasicInfo        binfo;
+  SAggSupporter         aggSup;
+  SArray*               pGroupCols;       // group by columns, SArray<SColumn>
+  SArray*               pGroupColVals;    // current group column values, SArray<SGroupKeys>
+  bool                  isInit;           // denote if current val is initialized or not
+  char*                 keyBuf;           // group by keys for hash
+  int32_t               groupKeyLen;      // total group by column width
+  SGroupResInfo         groupResInfo;
+  SExprSupp             scalarSup;
+  bool                  batchAggEnabled;  // all aggregate functions provide the batch version
+  int64_t               numOfProcRows;    // total processed rows
+  int64_t               numOfRuns;        // total runs of consecutive rows with identical group keys
+  int32_t               batchCapacity;    // capacity of the following per row buffers
+  char*                 pBatchKeyBuf;     // hash keys of rows in current block, | group id | key data |
+  const void**          pBatchKeys;
+  size_t*               pBatchKeyLens;
+  void**                pBatchPos;        // SResultRowPosition in the result row hash table
+  SResultRow**          pBatchRows;
+  SResultRowEntryInfo** pBatchEntries;
+  SGroupbyParallelInfo* pParallel;        // not NULL if the tables are scanned and aggregated by multiple workers
 } SGroupbyOperatorInfo;
 
+typedef struct SGroupbyAggWorker {
+  SGroupbyParallelInfo* pParallel;
+  SExecTaskInfo*        pTaskInfo;  // each worker has its own task info, to keep its own table list and jump env
+  SOperatorInfo*        pOperator;  // partial group by operator of this worker, on top of its own table scan operator
+} SGroupbyAggWorker;
+
+/*
+ * The current thread runs the first worker, on the table scan operator of the plan. The other workers are put into
+ * the query queue of the vnode, so the number of threads is bounded by the vnode query workers. A worker that starts
+ * after the current thread has scanned all morsels does nothing. The worker msgs not processed yet keep a reference
+ * of the parallel info, so the operator can be destroyed before they are processed.
+ */
+struct SGroupbyParallelInfo {
+  SExecTaskInfo*     pTaskInfo;
+  SMsgCb*            pMsgCb;
+  int32_t            vgId;
+  int32_t            numOfWorkers;
+  SGroupbyAggWorker* pWorkers;
+  int32_t            numOfMorsels;
+  int32_t            nextMorsel;    // the next morsel of tables to be scanned, acquired by workers
+  int32_t            code;          // the first error code of all workers
+  int32_t            ref;           // the operator and the worker msgs not processed yet
+  TdThreadMutex      lock;
+  TdThreadCond       cond;
+  int32_t            nextWorker;    // the next worker taken by a worker msg
+  int32_t            numOfRunning;  // the workers running in the query queue
+  bool               closed;        // no worker is allowed to start any more
+};
+
+// number of tables in each morsel of parallel group by aggregate
+#define GROUPBY_PARALLEL_MORSEL_SIZE 1024
+
+// the rows of a block are aggregated in batch, once the average length of runs is less than this value
+#define GROUPBY_BATCH_AVG_RUN_LEN 4
+
 // The sort in partition may be needed later.
 typedef struct SPartitionOperatorInfo {
   SOptrBasicInfo binfo;
@@ -46,7 +97,7 @@ typedef struct SPartitionOperatorInfo {
   SArray*        pGroupColVals;  // current group column values, SArray<SGroupKeys>
   char*          keyBuf;         // group by keys for hash
   int32_t        groupKeyLen;    // total group by column width
-  SHashObj*      pGroupSet;      // quick locate the window object for each result
+  SSHashObj*     pGroupSet;      // quick locate the window object for each result
 
   SDiskbasedBuf* pBuf;              // query result buffer based on blocked-wised disk file
   int32_t        rowCapacity;       // maximum number of rows for each buffer page
@@ -62,6 +113,7 @@ static int32_t* setupColumnOffset(const SSDataBlock* pBlock, int32_t rowCapacity
 static int32_t  setGroupResultOutputBuf(SOperatorInfo* pOperator, SOptrBasicInfo* binfo, int32_t numOfCols, char* pData,
                                         int16_t bytes, uint64_t groupId, SDiskbasedBuf* pBuf, SAggSupporter* pAggSup);
 static SArray*  extractColumnInfo(SNodeList* pNodeList);
+static void     destroyGroupbyParallelInfo(SGroupbyParallelInfo* pParallel);
 
 static void freeGroupKey(void* param) {
   SGroupKeys* pKey = (SGroupKeys*)param;
@@ -82,6 +134,14 @@ static void destroyGroupOperatorInfo(void* param) {
 
   cleanupGroupResInfo(&pInfo->groupResInfo);
   cleanupAggSup(&pInfo->aggSup);
+
+  taosMemoryFreeClear(pInfo->pBatchKeyBuf);
+  taosMemoryFreeClear(pInfo->pBatchKeys);
+  taosMemoryFreeClear(pInfo->pBatchKeyLens);
+  taosMemoryFreeClear(pInfo->pBatchPos);
+  taosMemoryFreeClear(pInfo->pBatchRows);
+  taosMemoryFreeClear(pInfo->pBatchEntries);
+  destroyGroupbyParallelInfo(pInfo->pParallel);
   taosMemoryFreeClear(param);
 }
 
@@ -279,6 +339,7 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
 
   terrno = TSDB_CODE_SUCCESS;
   int32_t num = 0;
+  int32_t numOfRuns = 0;
   for (int32_t j = 0; j < pBlock->info.rows; ++j) {
     // Compare with the previous row of this column, and do not set the output buffer again if they are identical.
     if (!pInfo->isInit) {
@@ -316,6 +377,7 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
 
     int32_t rowIndex = j - num;
     doApplyFunctions(pTaskInfo, pCtx, NULL, rowIndex, num, pBlock->info.rows, pOperator->exprSupp.numOfExprs);
+    numOfRuns += 1;
 
     // assign the group keys or user input constant values if required
     doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, rowIndex);
@@ -334,7 +396,170 @@ static void doHashGroupbyAgg(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
     int32_t rowIndex = pBlock->info.rows - num;
     doApplyFunctions(pTaskInfo, pCtx, NULL, rowIndex, num, pBlock->info.rows, pOperator->exprSupp.numOfExprs);
     doAssignGroupKeys(pCtx, pOperator->exprSupp.numOfExprs, pBlock->info.rows, rowIndex);
+    numOfRuns += 1;
+  }
+
+  pInfo->numOfProcRows += pBlock->info.rows;
+  pInfo->numOfRuns += numOfRuns;
+}
+
+static bool isBatchGroupbyAggEnabled(const SExprSupp* pSup) {
+  for (int32_t i = 0; i < pSup->numOfExprs; ++i) {
+    SqlFunctionCtx* pCtx = &pSup->pCtx[i];
+    if (pCtx->functionId != -1 && pCtx->fpSet.batchProcess == NULL) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// The group keys change frequently in the data block, e.g., the data is not sorted by the group by columns, so that
+// the result row is located for each row by probing hash table in batch, and the functions are applied in batch.
+static bool useBatchGroupbyAgg(const SGroupbyOperatorInfo* pInfo) {
+  if (!pInfo->batchAggEnabled || pInfo->numOfRuns == 0) {
+    return false;
+  }
+
+  return pInfo->numOfProcRows < pInfo->numOfRuns * GROUPBY_BATCH_AVG_RUN_LEN;
+}
+
+static int32_t ensureGroupBatchBuf(SGroupbyOperatorInfo* pInfo, int32_t rows) {
+  if (rows <= pInfo->batchCapacity) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  size_t keySize = sizeof(uint64_t) + pInfo->groupKeyLen;
+  char*  pKeyBuf = taosMemoryRealloc(pInfo->pBatchKeyBuf, keySize * rows);
+  if (pKeyBuf == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  pInfo->pBatchKeyBuf = pKeyBuf;
+
+  void* p = taosMemoryRealloc(pInfo->pBatchKeys, POINTER_BYTES * rows);
+  if (p == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  pInfo->pBatchKeys = p;
+
+  p = taosMemoryRealloc(pInfo->pBatchKeyLens, sizeof(size_t) * rows);
+  if (p == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  pInfo->pBatchKeyLens = p;
+
+  p = taosMemoryRealloc(pInfo->pBatchPos, POINTER_BYTES * rows);
+  if (p == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  pInfo->pBatchPos = p;
+
+  p = taosMemoryRealloc(pInfo->pBatchRows, POINTER_BYTES * rows);
+  if (p == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  pInfo->pBatchRows = p;
+
+  p = taosMemoryRealloc(pInfo->pBatchEntries, POINTER_BYTES * rows);
+  if (p == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  pInfo->pBatchEntries = p;
+
+  pInfo->batchCapacity = rows;
+  return TSDB_CODE_SUCCESS;
+}
+
+static void doHashGroupbyAggBatch(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SExprSupp*            pSup = &pOperator->exprSupp;
+  SAggSupporter*        pAggSup = &pInfo->aggSup;
+  SDiskbasedBuf*        pBuf = pAggSup->pResultBuf;
+  SResultRowInfo*       pResultRowInfo = &pInfo->binfo.resultRowInfo;
+  int32_t               rows = pBlock->info.rows;
+  size_t                keySize = sizeof(uint64_t) + pInfo->groupKeyLen;
+
+  int32_t code = ensureGroupBatchBuf(pInfo, rows);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+
+  // release the page of the active result row, which is kept by the row-wise version
+  if (pResultRowInfo->cur.pageId != -1) {
+    releaseBufPage(pBuf, getBufPage(pBuf, pResultRowInfo->cur.pageId));
+    pResultRowInfo->cur.pageId = -1;
+  }
+
+  // 1. build the hash keys of all rows
+  terrno = TSDB_CODE_SUCCESS;
+  for (int32_t j = 0; j < rows; ++j) {
+    recordNewGroupKeys(pInfo->pGroupCols, pInfo->pGroupColVals, pBlock, j);
+    if (terrno != TSDB_CODE_SUCCESS) {  // group by json error
+      T_LONG_JMP(pTaskInfo->env, terrno);
+    }
+
+    char* pKey = pInfo->pBatchKeyBuf + keySize * j;
+    *(uint64_t*)pKey = pBlock->info.groupId;
+    int32_t len = buildGroupKeys(pKey + sizeof(uint64_t), pInfo->pGroupColVals);
+
+    pInfo->pBatchKeys[j] = pKey;
+    pInfo->pBatchKeyLens[j] = GET_RES_WINDOW_KEY_LEN(len);
+  }
+
+  // the group keys of the last row are kept as the current group keys
+  pInfo->isInit = true;
+
+  // 2. locate or create the result row of each row
+  SResultRowPosition initPos = {.pageId = -1, .offset = -1};
+  int32_t            numOfNew = 0;
+  code = tSimpleHashBatchGetOrPut(pAggSup->pResultRowHashTable, pInfo->pBatchKeys, pInfo->pBatchKeyLens, rows,
+                                  &initPos, sizeof(SResultRowPosition), pInfo->pBatchPos, &numOfNew);
+  if (code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, code);
+  }
+
+  // only the positions are kept here, since a new row may push the pages of the rows got before out of memory
+  int64_t numOfRuns = 0;
+  for (int32_t j = 0; j < rows; ++j) {
+    SResultRowPosition* pPos = pInfo->pBatchPos[j];
+    if (j > 0 && pPos == pInfo->pBatchPos[j - 1]) {
+      continue;
+    }
+
+    numOfRuns += 1;
+    if (pPos->pageId == -1) {
+      SResultRow* pRow = getNewResultRow(pBuf, &pAggSup->currentPageId, pAggSup->resultRowSize);
+      if (pRow == NULL) {
+        T_LONG_JMP(pTaskInfo->env, TSDB_CODE_OUT_OF_MEMORY);
+      }
+
+      pPos->pageId = pRow->pageId;
+      pPos->offset = pRow->offset;
+
+      setResultRowInitCtx(pRow, pSup->pCtx, pSup->numOfExprs, pSup->rowEntryInfoOffset);
+      doAssignGroupKeys(pSup->pCtx, pSup->numOfExprs, rows, j);
+    }
   }
+
+  // all rows are allocated, keep the pages of them in memory until the functions are applied
+  getBatchResultRows(pBuf, (SResultRowPosition**)pInfo->pBatchPos, rows, pInfo->pBatchRows);
+
+  // too many groups in query
+  if (pTaskInfo->execModel == OPTR_EXEC_MODEL_BATCH &&
+      tSimpleHashGetSize(pAggSup->pResultRowHashTable) > MAX_INTERVAL_TIME_WINDOW) {
+    T_LONG_JMP(pTaskInfo->env, TSDB_CODE_QRY_TOO_MANY_TIMEWINDOW);
+  }
+
+  // 3. apply the aggregate functions
+  doBatchApplyFunctions(pTaskInfo, pSup->pCtx, pInfo->pBatchRows, pInfo->pBatchEntries, rows, pSup->numOfExprs,
+                        pSup->rowEntryInfoOffset);
+
+  // all pages touched by this block are not used anymore
+  releaseBatchResultRows(pBuf, pInfo->pBatchRows, rows);
+
+  pInfo->numOfProcRows += rows;
+  pInfo->numOfRuns += numOfRuns;
 }
 
 static SSDataBlock* buildGroupResultDataBlock(SOperatorInfo* pOperator) {
@@ -359,24 +584,15 @@ static SSDataBlock* buildGroupResultDataBlock(SOperatorInfo* pOperator) {
   return (pRes->info.rows == 0) ? NULL : pRes;
 }
 
-static SSDataBlock* hashGroupbyAggregate(SOperatorInfo* pOperator) {
-  if (pOperator->status == OP_EXEC_DONE) {
-    return NULL;
-  }
-
-  SExecTaskInfo* pTaskInfo = pOperator->pTaskInfo;
-
+// aggregate all data blocks of the downstream operator
+static void doGroupbyAggOnDownstream(SOperatorInfo* pOperator) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
   SGroupbyOperatorInfo* pInfo = pOperator->info;
-  if (pOperator->status == OP_RES_TO_RETURN) {
-    return buildGroupResultDataBlock(pOperator);
-  }
+  SOperatorInfo*        downstream = pOperator->pDownstream[0];
 
   int32_t order = TSDB_ORDER_ASC;
   int32_t scanFlag = MAIN_SCAN;
 
-  int64_t        st = taosGetTimestampUs();
-  SOperatorInfo* downstream = pOperator->pDownstream[0];
-
   while (1) {
     SSDataBlock* pBlock = downstream->fpSet.getNextFn(downstream);
     if (pBlock == NULL) {
@@ -400,7 +616,205 @@ static SSDataBlock* hashGroupbyAggregate(SOperatorInfo* pOperator) {
       }
     }
 
-    doHashGroupbyAgg(pOperator, pBlock);
+    if (useBatchGroupbyAgg(pInfo)) {
+      doHashGroupbyAggBatch(pOperator, pBlock);
+    } else {
+      doHashGroupbyAgg(pOperator, pBlock);
+    }
+  }
+}
+
+static void doGroupbyAggWorker(SGroupbyAggWorker* pWorker) {
+  SGroupbyParallelInfo* pParallel = pWorker->pParallel;
+  SExecTaskInfo*        pTaskInfo = pWorker->pTaskInfo;
+  SOperatorInfo*        pOperator = pWorker->pOperator;
+  SOperatorInfo*        pScanOp = pOperator->pDownstream[0];
+  STableListInfo*       pTableList = pParallel->pTaskInfo->pTableInfoList;
+  int32_t               numOfTables = (int32_t)tableListGetSize(pTableList);
+
+  int32_t code = setjmp(pTaskInfo->env);
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("%s group by aggregate worker abort, code:%s", GET_TASKID(pTaskInfo), tstrerror(code));
+    atomic_val_compare_exchange_32(&pParallel->code, TSDB_CODE_SUCCESS, code);
+    return;
+  }
+
+  while (atomic_load_32(&pParallel->code) == TSDB_CODE_SUCCESS && !isTaskKilled(pParallel->pTaskInfo)) {
+    int32_t index = atomic_fetch_add_32(&pParallel->nextMorsel, 1);
+    if (index >= pParallel->numOfMorsels) {
+      break;
+    }
+
+    int32_t start = index * GROUPBY_PARALLEL_MORSEL_SIZE;
+    int32_t end = TMIN(start + GROUPBY_PARALLEL_MORSEL_SIZE, numOfTables);
+
+    tableListClear(pTaskInfo->pTableInfoList);
+    for (int32_t i = start; i < end; ++i) {
+      STableKeyInfo* pKeyInfo = tableListGetInfo(pTableList, i);
+      tableListAddTableInfo(pTaskInfo->pTableInfoList, pKeyInfo->uid, pKeyInfo->groupId);
+    }
+
+    // restart the table scan on the tables of current morsel
+    STableScanInfo* pScanInfo = pScanOp->info;
+    resetTableScanInfo(pScanInfo, &pScanInfo->base.cond.twindows);
+    pScanOp->status = OP_NOT_OPENED;
+
+    qDebug("%s scan morsel:%d, tables:[%d, %d)", GET_TASKID(pTaskInfo), index, start, end);
+    doGroupbyAggOnDownstream(pOperator);
+  }
+}
+
+static void releaseGroupbyParallelInfo(SGroupbyParallelInfo* pParallel) {
+  if (atomic_sub_fetch_32(&pParallel->ref, 1) > 0) {
+    return;
+  }
+
+  taosThreadCondDestroy(&pParallel->cond);
+  taosThreadMutexDestroy(&pParallel->lock);
+  taosMemoryFree(pParallel);
+}
+
+// no worker starts after it returns, and all started ones have finished
+static void closeGroupbyParallelInfo(SGroupbyParallelInfo* pParallel) {
+  taosThreadMutexLock(&pParallel->lock);
+  pParallel->closed = true;
+  while (pParallel->numOfRunning > 0) {
+    taosThreadCondWait(&pParallel->cond, &pParallel->lock);
+  }
+  taosThreadMutexUnlock(&pParallel->lock);
+}
+
+// runs in the vnode query queue
+static void groupbyAggWorkerFp(void* param) {
+  SGroupbyParallelInfo* pParallel = param;
+  SGroupbyAggWorker*    pWorker = NULL;
+
+  taosThreadMutexLock(&pParallel->lock);
+  if (!pParallel->closed && pParallel->nextWorker < pParallel->numOfWorkers) {
+    pWorker = &pParallel->pWorkers[pParallel->nextWorker++];
+    pParallel->numOfRunning += 1;
+  }
+  taosThreadMutexUnlock(&pParallel->lock);
+
+  if (pWorker != NULL) {
+    doGroupbyAggWorker(pWorker);
+
+    taosThreadMutexLock(&pParallel->lock);
+    pParallel->numOfRunning -= 1;
+    taosThreadCondBroadcast(&pParallel->cond);
+    taosThreadMutexUnlock(&pParallel->lock);
+  }
+
+  releaseGroupbyParallelInfo(pParallel);
+}
+
+// merge the partial results of a worker into the result rows of the group by operator
+static void mergeGroupbyWorkerResult(SOperatorInfo* pOperator, SOperatorInfo* pWorkerOp) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SGroupbyOperatorInfo* pWorkerInfo = pWorkerOp->info;
+  SqlFunctionCtx*       pCtx = pOperator->exprSupp.pCtx;
+  SqlFunctionCtx*       pWorkerCtx = pWorkerOp->exprSupp.pCtx;
+  int32_t               numOfExprs = pOperator->exprSupp.numOfExprs;
+  SDiskbasedBuf*        pWorkerBuf = pWorkerInfo->aggSup.pResultBuf;
+
+  int32_t iter = 0;
+  void*   pIter = NULL;
+  while ((pIter = tSimpleHashIterate(pWorkerInfo->aggSup.pResultRowHashTable, pIter, &iter)) != NULL) {
+    size_t   keyLen = 0;
+    char*    pKey = tSimpleHashGetKey(pIter, &keyLen);
+    uint64_t groupId = *(uint64_t*)pKey;
+
+    SResultRow* pSrcRow = getResultRowByPos(pWorkerBuf, pIter, false);
+    setGroupResultOutputBuf(pOperator, &pInfo->binfo, numOfExprs, pKey + sizeof(uint64_t),
+                            keyLen - sizeof(uint64_t), groupId, pInfo->aggSup.pResultBuf, &pInfo->aggSup);
+
+    for (int32_t k = 0; k < numOfExprs; ++k) {
+      SResultRowEntryInfo* pSrcEntry = getResultEntryInfo(pSrcRow, k, pWorkerOp->exprSupp.rowEntryInfoOffset);
+
+      // the group keys are identical in all workers
+      if (pCtx[k].functionId == -1) {
+        SResultRowEntryInfo* pDestEntry = GET_RES_INFO(&pCtx[k]);
+        if (pDestEntry->numOfRes == 0) {
+          memcpy(GET_ROWCELL_INTERBUF(pDestEntry), GET_ROWCELL_INTERBUF(pSrcEntry), pCtx[k].resDataInfo.interBufSize);
+          pDestEntry->isNullRes = pSrcEntry->isNullRes;
+          pDestEntry->numOfRes = pSrcEntry->numOfRes;
+        }
+        continue;
+      }
+
+      pWorkerCtx[k].resultInfo = pSrcEntry;
+      int32_t code = pCtx[k].fpSet.combine(&pCtx[k], &pWorkerCtx[k]);
+      if (code != TSDB_CODE_SUCCESS) {
+        T_LONG_JMP(pTaskInfo->env, code);
+      }
+    }
+
+    releaseBufPage(pWorkerBuf, (char*)pSrcRow - pSrcRow->offset);
+  }
+}
+
+static void doParallelGroupbyAgg(SOperatorInfo* pOperator) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  SGroupbyParallelInfo* pParallel = pInfo->pParallel;
+
+  // the current thread works as the first worker
+  for (int32_t i = 1; i < pParallel->numOfWorkers; ++i) {
+    atomic_add_fetch_32(&pParallel->ref, 1);
+    int32_t code = qPutWorkerToQueryQueue(pParallel->pMsgCb, pParallel->vgId, groupbyAggWorkerFp, pParallel);
+    if (code != TSDB_CODE_SUCCESS) {
+      qWarn("%s failed to start group by aggregate worker:%d, code:%s", GET_TASKID(pTaskInfo), i, tstrerror(code));
+      releaseGroupbyParallelInfo(pParallel);
+      break;
+    }
+  }
+
+  doGroupbyAggWorker(&pParallel->pWorkers[0]);
+  closeGroupbyParallelInfo(pParallel);
+
+  if (pParallel->code != TSDB_CODE_SUCCESS) {
+    T_LONG_JMP(pTaskInfo->env, pParallel->code);
+  }
+
+  for (int32_t i = 0; i < pParallel->numOfWorkers; ++i) {
+    mergeGroupbyWorkerResult(pOperator, pParallel->pWorkers[i].pOperator);
+  }
+
+  // the first worker scans on the table scan operator of the plan, collect the load info of others for explain
+  STableScanInfo* pScanInfo = pOperator->pDownstream[0]->info;
+  for (int32_t i = 1; i < pParallel->numOfWorkers; ++i) {
+    SOperatorInfo*          pWorkerScanOp = pParallel->pWorkers[i].pOperator->pDownstream[0];
+    SFileBlockLoadRecorder* pSrc = &((STableScanInfo*)pWorkerScanOp->info)->base.readRecorder;
+    SFileBlockLoadRecorder* pDst = &pScanInfo->base.readRecorder;
+
+    pDst->totalRows += pSrc->totalRows;
+    pDst->totalCheckedRows += pSrc->totalCheckedRows;
+    pDst->totalBlocks += pSrc->totalBlocks;
+    pDst->loadBlocks += pSrc->loadBlocks;
+    pDst->loadBlockStatis += pSrc->loadBlockStatis;
+    pDst->skipBlocks += pSrc->skipBlocks;
+    pDst->filterOutBlocks += pSrc->filterOutBlocks;
+    pDst->elapsedTime += pSrc->elapsedTime;
+    pDst->filterTime += pSrc->filterTime;
+  }
+}
+
+static SSDataBlock* hashGroupbyAggregate(SOperatorInfo* pOperator) {
+  if (pOperator->status == OP_EXEC_DONE) {
+    return NULL;
+  }
+
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+  if (pOperator->status == OP_RES_TO_RETURN) {
+    return buildGroupResultDataBlock(pOperator);
+  }
+
+  int64_t st = taosGetTimestampUs();
+  if (pInfo->pParallel != NULL) {
+    doParallelGroupbyAgg(pOperator);
+  } else {
+    doGroupbyAggOnDownstream(pOperator);
   }
 
   pOperator->status = OP_RES_TO_RETURN;
@@ -467,6 +881,7 @@ SOperatorInfo* createGroupOperatorInfo(SOperatorInfo* downstream, SAggPhysiNode*
     goto _error;
   }
 
+  pInfo->batchAggEnabled = isBatchGroupbyAggEnabled(&pOperator->exprSupp);
   initResultRowInfo(&pInfo->binfo.resultRowInfo);
   setOperatorInfo(pOperator, "GroupbyAggOperator", 0, true, OP_NOT_OPENED, pInfo, pTaskInfo);
 
@@ -488,6 +903,193 @@ _error:
   return NULL;
 }
 
+static SExecTaskInfo* createGroupbyWorkerTaskInfo(SExecTaskInfo* pTaskInfo, int32_t index) {
+  SExecTaskInfo* pWorkerTask = taosMemoryCalloc(1, sizeof(SExecTaskInfo));
+  if (pWorkerTask == NULL) {
+    return NULL;
+  }
+
+  char* p = taosMemoryCalloc(1, 128);
+  pWorkerTask->pTableInfoList = tableListCreate();
+  if (p == NULL || pWorkerTask->pTableInfoList == NULL) {
+    taosMemoryFree(p);
+    tableListDestroy(pWorkerTask->pTableInfoList);
+    taosMemoryFree(pWorkerTask);
+    return NULL;
+  }
+
+  snprintf(p, 128, "%s WORKER:%d", GET_TASKID(pTaskInfo), index);
+  pWorkerTask->id = pTaskInfo->id;
+  pWorkerTask->id.str = p;
+  pWorkerTask->window = pTaskInfo->window;
+  pWorkerTask->cost.created = taosGetTimestampMs();
+  pWorkerTask->owner = pTaskInfo->owner;
+  pWorkerTask->version = pTaskInfo->version;
+  pWorkerTask->schemaInfo = pTaskInfo->schemaInfo;  // owned by the task of the plan
+  pWorkerTask->execModel = pTaskInfo->execModel;
+  pWorkerTask->sql = pTaskInfo->sql;
+  pWorkerTask->pSubplan = pTaskInfo->pSubplan;
+  setTaskStatus(pWorkerTask, TASK_NOT_COMPLETED);
+  return pWorkerTask;
+}
+
+static void destroyGroupbyParallelInfo(SGroupbyParallelInfo* pParallel) {
+  if (pParallel == NULL) {
+    return;
+  }
+
+  closeGroupbyParallelInfo(pParallel);
+
+  for (int32_t i = 0; i < pParallel->numOfWorkers; ++i) {
+    SGroupbyAggWorker* pWorker = &pParallel->pWorkers[i];
+    if (pWorker->pOperator != NULL) {
+      // the table scan operator of the first worker belongs to the plan
+      if (i == 0) {
+        pWorker->pOperator->pDownstream[0]->pTaskInfo = pParallel->pTaskInfo;
+        pWorker->pOperator->numOfDownstream = 0;
+      }
+      destroyOperatorInfo(pWorker->pOperator);
+    }
+
+    if (pWorker->pTaskInfo != NULL) {
+      tableListDestroy(pWorker->pTaskInfo->pTableInfoList);
+      taosMemoryFree(pWorker->pTaskInfo->id.str);
+      taosMemoryFree(pWorker->pTaskInfo);
+    }
+  }
+
+  taosMemoryFree(pParallel->pWorkers);
+  pParallel->pWorkers = NULL;
+  releaseGroupbyParallelInfo(pParallel);
+}
+
+static bool isParallelGroupbyAggApplicable(SOperatorInfo* pOperator, SAggPhysiNode* pAggNode, SReadHandle* pHandle) {
+  SExecTaskInfo* pTaskInfo = pOperator->pTaskInfo;
+  if (tsQueryMaxParallelism <= 1 || pTaskInfo->execModel != OPTR_EXEC_MODEL_BATCH) {
+    return false;
+  }
+
+  // the workers run in the query queue of the vnode
+  if (pHandle->vnode == NULL || pHandle->pMsgCb == NULL) {
+    return false;
+  }
+
+  // only the group by aggregate right on the top of an ordinary table scan is supported
+  if (LIST_LENGTH(pAggNode->node.pChildren) != 1) {
+    return false;
+  }
+
+  SNode* pChild = nodesListGetNode(pAggNode->node.pChildren, 0);
+  if (nodeType(pChild) != QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN) {
+    return false;
+  }
+
+  STableScanPhysiNode* pScanNode = (STableScanPhysiNode*)pChild;
+  if (pScanNode->scan.node.pLimit != NULL || pScanNode->scan.node.pSlimit != NULL || pScanNode->groupSort ||
+      pScanNode->scanSeq[0] != 1 || pScanNode->scanSeq[1] != 0) {
+    return false;
+  }
+
+  STableListInfo* pTableList = pTaskInfo->pTableInfoList;
+  if (tableListGetOutputGroups(pTableList) != 1 || tableListGetSize(pTableList) <= GROUPBY_PARALLEL_MORSEL_SIZE) {
+    return false;
+  }
+
+  // the partial results of workers are merged by the combine function, the udf is always invoked in single thread
+  SExprSupp* pSup = &pOperator->exprSupp;
+  for (int32_t i = 0; i < pSup->numOfExprs; ++i) {
+    SqlFunctionCtx* pCtx = &pSup->pCtx[i];
+    if (pCtx->functionId == -1) {
+      continue;
+    }
+
+    if (pCtx->fpSet.combine == NULL || pCtx->subsidiaries.num > 0 || fmIsUserDefinedFunc(pCtx->functionId)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void initGroupOptrParallelism(SOperatorInfo* pOperator, SAggPhysiNode* pAggNode, SReadHandle* pHandle) {
+  SExecTaskInfo*        pTaskInfo = pOperator->pTaskInfo;
+  SGroupbyOperatorInfo* pInfo = pOperator->info;
+
+  if (!isParallelGroupbyAggApplicable(pOperator, pAggNode, pHandle)) {
+    return;
+  }
+
+  // the degree is bounded by the vnode query workers, which are shared by all queries of the vnode
+  int32_t numOfTables = (int32_t)tableListGetSize(pTaskInfo->pTableInfoList);
+  int32_t numOfMorsels = (numOfTables + GROUPBY_PARALLEL_MORSEL_SIZE - 1) / GROUPBY_PARALLEL_MORSEL_SIZE;
+  int32_t numOfWorkers = TMIN(TMIN(tsQueryMaxParallelism, tsNumOfVnodeQueryThreads), numOfMorsels);
+  if (numOfWorkers <= 1) {
+    return;
+  }
+
+  SGroupbyParallelInfo* pParallel = taosMemoryCalloc(1, sizeof(SGroupbyParallelInfo));
+  if (pParallel == NULL) {
+    return;
+  }
+
+  pParallel->pTaskInfo = pTaskInfo;
+  pParallel->pMsgCb = pHandle->pMsgCb;
+  pParallel->numOfMorsels = numOfMorsels;
+  pParallel->ref = 1;
+  pParallel->nextWorker = 1;
+  taosThreadMutexInit(&pParallel->lock, NULL);
+  taosThreadCondInit(&pParallel->cond, NULL);
+  vnodeGetInfo(pHandle->vnode, NULL, &pParallel->vgId);
+  pParallel->pWorkers = taosMemoryCalloc(numOfWorkers, sizeof(SGroupbyAggWorker));
+  if (pParallel->pWorkers == NULL) {
+    goto _error;
+  }
+
+  STableScanPhysiNode* pScanNode = (STableScanPhysiNode*)nodesListGetNode(pAggNode->node.pChildren, 0);
+  for (int32_t i = 0; i < numOfWorkers; ++i) {
+    SGroupbyAggWorker* pWorker = &pParallel->pWorkers[i];
+    pParallel->numOfWorkers += 1;
+
+    pWorker->pParallel = pParallel;
+    pWorker->pTaskInfo = createGroupbyWorkerTaskInfo(pTaskInfo, i);
+    if (pWorker->pTaskInfo == NULL) {
+      goto _error;
+    }
+
+    // the first worker runs on the table scan operator of the plan
+    SOperatorInfo* pScanOp = NULL;
+    if (i == 0) {
+      pScanOp = pOperator->pDownstream[0];
+    } else {
+      pScanOp = createTableScanOperatorInfo(pScanNode, pHandle, pWorker->pTaskInfo);
+      if (pScanOp == NULL) {
+        goto _error;
+      }
+    }
+
+    pWorker->pOperator = createGroupOperatorInfo(pScanOp, pAggNode, pWorker->pTaskInfo);
+    if (pWorker->pOperator == NULL) {
+      if (i > 0) {
+        destroyOperatorInfo(pScanOp);
+      }
+      goto _error;
+    }
+
+    if (i == 0) {
+      pScanOp->pTaskInfo = pWorker->pTaskInfo;
+    }
+  }
+
+  pInfo->pParallel = pParallel;
+  qDebug("%s group by aggregate in %d workers, tables:%d, morsels:%d", GET_TASKID(pTaskInfo), numOfWorkers,
+         numOfTables, numOfMorsels);
+  return;
+
+_error:
+  qWarn("%s failed to init parallel group by aggregate, run in single thread", GET_TASKID(pTaskInfo));
+  destroyGroupbyParallelInfo(pParallel);
+}
+
 static void doHashPartition(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
   SPartitionOperatorInfo* pInfo = pOperator->info;
 
@@ -575,15 +1177,16 @@ static void doHashPartition(SOperatorInfo* pOperator, SSDataBlock* pBlock) {
 }
 
 void* getCurrentDataGroupInfo(const SPartitionOperatorInfo* pInfo, SDataGroupInfo** pGroupInfo, int32_t len) {
-  SDataGroupInfo* p = taosHashGet(pInfo->pGroupSet, pInfo->keyBuf, len);
+  SDataGroupInfo* p = tSimpleHashGet(pInfo->pGroupSet, pInfo->keyBuf, len);
 
   void* pPage = NULL;
   if (p == NULL) {  // it is a new group
     SDataGroupInfo gi = {0};
     gi.pPageList = taosArrayInit(100, sizeof(int32_t));
-    taosHashPut(pInfo->pGroupSet, pInfo->keyBuf, len, &gi, sizeof(SDataGroupInfo));
+    tSimpleHashPut(pInfo->pGroupSet, pInfo->keyBuf, len, &gi, sizeof(SDataGroupInfo));
 
-    p = taosHashGet(pInfo->pGroupSet, pInfo->keyBuf, len);
+    // the payload address is stable, until the group is removed from hash table
+    p = tSimpleHashGet(pInfo->pGroupSet, pInfo->keyBuf, len);
 
     int32_t pageId = 0;
     pPage = getNewBufPage(pInfo->pBuf, &pageId);
@@ -744,19 +1347,20 @@ static SSDataBlock* hashPartition(SOperatorInfo* pOperator) {
     }
   }
 
-  SArray* groupArray = taosArrayInit(taosHashGetSize(pInfo->pGroupSet), sizeof(SDataGroupInfo));
+  SArray* groupArray = taosArrayInit(tSimpleHashGetSize(pInfo->pGroupSet), sizeof(SDataGroupInfo));
 
-  void* pGroupIter = taosHashIterate(pInfo->pGroupSet, NULL);
+  int32_t iter = 0;
+  void*   pGroupIter = tSimpleHashIterate(pInfo->pGroupSet, NULL, &iter);
   while (pGroupIter != NULL) {
     SDataGroupInfo* pGroupInfo = pGroupIter;
     taosArrayPush(groupArray, pGroupInfo);
-    pGroupIter = taosHashIterate(pInfo->pGroupSet, pGroupIter);
+    pGroupIter = tSimpleHashIterate(pInfo->pGroupSet, pGroupIter, &iter);
   }
 
   taosArraySort(groupArray, compareDataGroupInfo);
   pInfo->sortedGroupArray = groupArray;
   pInfo->groupIndex = -1;
-  taosHashClear(pInfo->pGroupSet);
+  tSimpleHashClear(pInfo->pGroupSet);
 
   pOperator->cost.openCost = (taosGetTimestampUs() - st) / 1000.0;
 
@@ -779,14 +1383,15 @@ static void destroyPartitionOperatorInfo(void* param) {
   taosMemoryFree(pInfo->keyBuf);
   taosArrayDestroy(pInfo->sortedGroupArray);
 
-  void* pGroupIter = taosHashIterate(pInfo->pGroupSet, NULL);
+  int32_t iter = 0;
+  void*   pGroupIter = tSimpleHashIterate(pInfo->pGroupSet, NULL, &iter);
   while (pGroupIter != NULL) {
     SDataGroupInfo* pGroupInfo = pGroupIter;
     taosArrayDestroy(pGroupInfo->pPageList);
-    pGroupIter = taosHashIterate(pInfo->pGroupSet, pGroupIter);
+    pGroupIter = tSimpleHashIterate(pInfo->pGroupSet, pGroupIter, &iter);
   }
 
-  taosHashCleanup(pInfo->pGroupSet);
+  tSimpleHashCleanup(pInfo->pGroupSet);
   taosMemoryFree(pInfo->columnOffset);
 
   cleanupExprSupp(&pInfo->scalarSup);
@@ -816,7 +1421,7 @@ SOperatorInfo* createPartitionOperatorInfo(SOperatorInfo* downstream, SPartition
   }
 
   _hash_fn_t hashFn = taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY);
-  pInfo->pGroupSet = taosHashInit(100, hashFn, false, HASH_NO_LOCK);
+  pInfo->pGroupSet = tSimpleHashInit(100, hashFn);
   if (pInfo->pGroupSet == NULL) {
     goto _error;
   }
@@ -949,7 +1554,7 @@ static SSDataBlock* buildStreamPartitionResult(SOperatorInfo* pOperator) {
   blockDataUpdateTsWindow(pDest, pInfo->tsColIndex);
   pDest->info.groupId = pParInfo->groupId;
   pOperator->resultInfo.totalRows += pDest->info.rows;
-  pInfo->parIte = taosHashIterate(pInfo->pPartitions, pInfo->parIte);
+  pInfo->parIte = tSimpleHashIterate(pInfo->pPartitions, pInfo->parIte, &pInfo->parIter);
   ASSERT(pDest->info.rows > 0);
   printDataBlock(pDest, "stream partitionby");
   return pDest;
@@ -961,7 +1566,7 @@ static void doStreamHashPartitionImpl(SStreamPartitionOperatorInfo* pInfo, SSDat
     recordNewGroupKeys(pInfo->partitionSup.pGroupCols, pInfo->partitionSup.pGroupColVals, pBlock, i);
     int32_t             keyLen = buildGroupKeys(pInfo->partitionSup.keyBuf, pInfo->partitionSup.pGroupColVals);
     SPartitionDataInfo* pParData =
-        (SPartitionDataInfo*)taosHashGet(pInfo->pPartitions, pInfo->partitionSup.keyBuf, keyLen);
+        (SPartitionDataInfo*)tSimpleHashGet(pInfo->pPartitions, pInfo->partitionSup.keyBuf, keyLen);
     if (pParData) {
       taosArrayPush(pParData->rowIds, &i);
     } else {
@@ -969,7 +1574,7 @@ static void doStreamHashPartitionImpl(SStreamPartitionOperatorInfo* pInfo, SSDat
       newParData.groupId = calcGroupId(pInfo->partitionSup.keyBuf, keyLen);
       newParData.rowIds = taosArrayInit(64, sizeof(int32_t));
       taosArrayPush(newParData.rowIds, &i);
-      taosHashPut(pInfo->pPartitions, pInfo->partitionSup.keyBuf, keyLen, &newParData, sizeof(SPartitionDataInfo));
+      tSimpleHashPut(pInfo->pPartitions, pInfo->partitionSup.keyBuf, keyLen, &newParData, sizeof(SPartitionDataInfo));
     }
   }
 }
@@ -1019,12 +1624,13 @@ static SSDataBlock* doStreamHashPartition(SOperatorInfo* pOperator) {
         longjmp(pTaskInfo->env, pTaskInfo->code);
       }
     }
-    taosHashClear(pInfo->pPartitions);
+    tSimpleHashClear(pInfo->pPartitions);
     doStreamHashPartitionImpl(pInfo, pBlock);
   }
   pOperator->cost.openCost = (taosGetTimestampUs() - st) / 1000.0;
 
-  pInfo->parIte = taosHashIterate(pInfo->pPartitions, NULL);
+  pInfo->parIter = 0;
+  pInfo->parIte = tSimpleHashIterate(pInfo->pPartitions, NULL, &pInfo->parIter);
   return buildStreamPartitionResult(pOperator);
 }
 
@@ -1044,7 +1650,7 @@ static void destroyStreamPartitionOperatorInfo(void* param) {
   cleanupExprSupp(&pInfo->tbnameCalSup);
   cleanupExprSupp(&pInfo->tagCalSup);
   blockDataDestroy(pInfo->pDelRes);
-  taosHashCleanup(pInfo->pPartitions);
+  tSimpleHashCleanup(pInfo->pPartitions);
   taosMemoryFreeClear(param);
 }
 
@@ -1125,7 +1731,7 @@ SOperatorInfo* createStreamPartitionOperatorInfo(SOperatorInfo* downstream, SStr
   pInfo->pInputDataBlock = NULL;
 
   _hash_fn_t hashFn = taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY);
-  pInfo->pPartitions = taosHashInit(1024, hashFn, false, HASH_NO_LOCK);
+  pInfo->pPartitions = tSimpleHashInit(1024, hashFn);
   pInfo->tsColIndex = 0;
   pInfo->pDelRes = createSpecialDataBlock(STREAM_DELETE_RESULT);
 
@@ -101,55 +101,20 @@ static void getNextTimeWindow(SInterval* pInterval, STimeWindow* tw, int32_t ord
   tw->ekey -= 1;
 }
 
-static bool overlapWithTimeWindow(SInterval* pInterval, SDataBlockInfo* pBlockInfo, int32_t order) {
-  STimeWindow w = {0};
-
+// the data block needs to be loaded if it spreads over more than one time window of the upstream interval operator.
+static bool overlapWithTimeWindow(SInterval* pInterval, SDataBlockInfo* pBlockInfo) {
   // 0 by default, which means it is not a interval operator of the upstream operator.
   if (pInterval->interval == 0) {
     return false;
   }
 
-  if (order == TSDB_ORDER_ASC) {
-    w = getAlignQueryTimeWindow(pInterval, pInterval->precision, pBlockInfo->window.skey);
-    assert(w.ekey >= pBlockInfo->window.skey);
-
-    if (TMAX(w.skey, pBlockInfo->window.skey) <= TMIN(w.ekey, pBlockInfo->window.ekey)) {
-      return true;
-    }
-
-    while (1) {
-      getNextTimeWindow(pInterval, &w, order);
-      if (w.skey > pBlockInfo->window.ekey) {
-        break;
-      }
-
-      assert(w.ekey > pBlockInfo->window.ekey);
-      if (TMAX(w.skey, pBlockInfo->window.skey) <= pBlockInfo->window.ekey) {
-        return true;
-      }
-    }
-  } else {
-    w = getAlignQueryTimeWindow(pInterval, pInterval->precision, pBlockInfo->window.ekey);
-    assert(w.skey <= pBlockInfo->window.ekey);
-
-    if (TMAX(w.skey, pBlockInfo->window.skey) <= TMIN(w.ekey, pBlockInfo->window.ekey)) {
-      return true;
-    }
-
-    while (1) {
-      getNextTimeWindow(pInterval, &w, order);
-      if (w.ekey < pBlockInfo->window.skey) {
-        break;
-      }
-
-      assert(w.skey < pBlockInfo->window.skey);
-      if (pBlockInfo->window.skey <= TMIN(w.ekey, pBlockInfo->window.ekey)) {
-        return true;
-      }
-    }
+  // each timestamp belongs to more than one sliding time window
+  if (pInterval->interval != pInterval->sliding || pInterval->intervalUnit != pInterval->slidingUnit) {
+    return true;
   }
 
-  return false;
+  STimeWindow w = getAlignQueryTimeWindow(pInterval, pInterval->precision, pBlockInfo->window.skey);
+  return w.skey > pBlockInfo->window.skey || w.ekey < pBlockInfo->window.ekey;
 }
 
 // this function is for table scanner to extract temporary results of upstream aggregate results.
@@ -315,12 +280,13 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   bool loadSMA = false;
   *status = pTableScanInfo->dataBlockLoadFlag;
   if (pOperator->exprSupp.pFilterInfo != NULL ||
-      overlapWithTimeWindow(&pTableScanInfo->pdInfo.interval, &pBlock->info, pTableScanInfo->cond.order)) {
+      overlapWithTimeWindow(&pTableScanInfo->pdInfo.interval, &pBlock->info)) {
     (*status) = FUNC_DATA_REQUIRED_DATA_LOAD;
   }
 
   SDataBlockInfo* pBlockInfo = &pBlock->info;
   taosMemoryFreeClear(pBlock->pBlockAgg);
+  pBlockInfo->noData = false;
 
   if (*status == FUNC_DATA_REQUIRED_FILTEROUT) {
     qDebug("%s data block filter out, brange:%" PRId64 "-%" PRId64 ", rows:%d", GET_TASKID(pTaskInfo),
@@ -333,6 +299,7 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
            pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
     doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, 1);
     pCost->skipBlocks += 1;
+    pBlockInfo->noData = true;
     return TSDB_CODE_SUCCESS;
   } else if (*status == FUNC_DATA_REQUIRED_SMA_LOAD) {
     pCost->loadBlockStatis += 1;
@@ -342,6 +309,7 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
       qDebug("%s data block SMA loaded, brange:%" PRId64 "-%" PRId64 ", rows:%d", GET_TASKID(pTaskInfo),
              pBlockInfo->window.skey, pBlockInfo->window.ekey, pBlockInfo->rows);
       doSetTagColumnData(pTableScanInfo, pBlock, pTaskInfo, 1);
+      pBlockInfo->noData = true;
       return TSDB_CODE_SUCCESS;
     } else {
       qDebug("%s failed to load SMA, since not all columns have SMA", GET_TASKID(pTaskInfo));
@@ -1672,6 +1640,7 @@ static int32_t filterDelBlockByUid(SSDataBlock* pDst, const SSDataBlock* pSrc, S
   pDst->info = pSrc->info;
   pDst->info.rows = j;
   pDst->info.capacity = cap;
+  pDst->info.noData = false;
 
   return 0;
 }
@@ -1818,7 +1787,7 @@ FETCH_NEXT_BLOCK:
         pInfo->scanMode = STREAM_SCAN_FROM_DATAREADER_RETRIEVE;
         copyDataBlock(pInfo->pUpdateRes, pBlock);
         prepareRangeScan(pInfo, pInfo->pUpdateRes, &pInfo->updateResIndex);
-        updateInfoAddCloseWindowSBF(pInfo->pUpdateInfo);
+        updateInfoAddCloseWindowSet(pInfo->pUpdateInfo);
       } break;
       case STREAM_DELETE_DATA: {
         printDataBlock(pBlock, "stream scan delete recv");
@@ -1926,7 +1895,7 @@ FETCH_NEXT_BLOCK:
     while (1) {
       if (pInfo->tqReader->pMsg == NULL) {
         if (pInfo->validBlockIndex >= totBlockNum) {
-          updateInfoDestoryColseWinSBF(pInfo->pUpdateInfo);
+          updateInfoDestroyCloseWindowSet(pInfo->pUpdateInfo);
           doClearBufferedBlocks(pInfo);
           return NULL;
         }
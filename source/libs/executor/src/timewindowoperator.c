@@ -1013,7 +1013,8 @@ SResultRowPosition addToOpenWindowList(SResultRowInfo* pResultRowInfo, const SRe
 int64_t* extractTsCol(SSDataBlock* pBlock, const SIntervalAggOperatorInfo* pInfo) {
   TSKEY* tsCols = NULL;
 
-  if (pBlock->pDataBlock != NULL) {
+  // only the block SMA is loaded, and all rows fall into one time window, see overlapWithTimeWindow in table scan.
+  if (pBlock->pDataBlock != NULL && !pBlock->info.noData) {
     SColumnInfoData* pColDataInfo = taosArrayGet(pBlock->pDataBlock, pInfo->primaryTsIndex);
     tsCols = (int64_t*)pColDataInfo->pData;
 
@@ -1071,6 +1072,171 @@ static int32_t doOpenIntervalAgg(SOperatorInfo* pOperator) {
   return TSDB_CODE_SUCCESS;
 }
 
+static void closeStreamingIntervalWindow(SOperatorInfo* pOperator, SSDataBlock* pRes) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  if (!pInfo->hasOpenWindow) {
+    return;
+  }
+
+  finalizeResultRow(pInfo->pOpenRow, &pOperator->exprSupp, pRes, pOperator->pTaskInfo);
+  pInfo->hasOpenWindow = false;
+}
+
+static void openStreamingIntervalWindow(SOperatorInfo* pOperator, STimeWindow* pWin, uint64_t groupId) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SExprSupp*                pSup = &pOperator->exprSupp;
+
+  resetResultRow(pInfo->pOpenRow, pInfo->aggSup.resultRowSize - sizeof(SResultRow));
+  pInfo->pOpenRow->win = *pWin;
+  setResultRowInitCtx(pInfo->pOpenRow, pSup->pCtx, pSup->numOfExprs, pSup->rowEntryInfoOffset);
+
+  pInfo->openGroupId = groupId;
+  pInfo->hasOpenWindow = true;
+}
+
+// the data of each group arrives in the timestamp order, so a time window is closed as soon as the first row beyond it
+// is met. Only the result row of the open window is kept, and no result row is put into the hash table or paged buffer.
+static void doStreamingIntervalAggImpl(SOperatorInfo* pOperator, SSDataBlock* pBlock, SSDataBlock* pRes) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SExecTaskInfo*            pTaskInfo = pOperator->pTaskInfo;
+  SExprSupp*                pSup = &pOperator->exprSupp;
+
+  int32_t  numOfOutput = pSup->numOfExprs;
+  int64_t* tsCols = extractTsCol(pBlock, pInfo);
+  bool     ascScan = (pInfo->inputOrder == TSDB_ORDER_ASC);
+  TSKEY    ts = getStartTsKey(&pBlock->info.window, tsCols);
+  int32_t  startPos = 0;
+
+  STimeWindow win = {0};
+  if (pInfo->hasOpenWindow && pInfo->pOpenRow->win.skey <= ts && pInfo->pOpenRow->win.ekey >= ts) {
+    win = pInfo->pOpenRow->win;
+  } else {
+    closeStreamingIntervalWindow(pOperator, pRes);
+
+    SResultRowInfo dumyInfo = {0};
+    dumyInfo.cur.pageId = -1;
+    win = getActiveTimeWindow(NULL, &dumyInfo, ts, &pInfo->interval, pInfo->inputOrder);
+    openStreamingIntervalWindow(pOperator, &win, pBlock->info.groupId);
+  }
+
+  TSKEY   ekey = ascScan ? win.ekey : win.skey;
+  int32_t forwardRows =
+      getNumOfRowsInTimeWindow(&pBlock->info, tsCols, startPos, ekey, binarySearchForKey, NULL, pInfo->inputOrder);
+  ASSERT(forwardRows > 0);
+
+  updateTimeWindowInfo(&pInfo->twAggSup.timeWindowData, &win, true);
+  doApplyFunctions(pTaskInfo, pSup->pCtx, &pInfo->twAggSup.timeWindowData, startPos, forwardRows, pBlock->info.rows,
+                   numOfOutput);
+
+  STimeWindow nextWin = win;
+  while (1) {
+    int32_t prevEndPos = forwardRows - 1 + startPos;
+    startPos = getNextQualifiedWindow(&pInfo->interval, &nextWin, &pBlock->info, tsCols, prevEndPos, pInfo->inputOrder);
+    if (startPos < 0) {
+      break;
+    }
+
+    // no rows of the current window are left in the following data, emit it right now
+    closeStreamingIntervalWindow(pOperator, pRes);
+    openStreamingIntervalWindow(pOperator, &nextWin, pBlock->info.groupId);
+
+    ekey = ascScan ? nextWin.ekey : nextWin.skey;
+    forwardRows =
+        getNumOfRowsInTimeWindow(&pBlock->info, tsCols, startPos, ekey, binarySearchForKey, NULL, pInfo->inputOrder);
+
+    updateTimeWindowInfo(&pInfo->twAggSup.timeWindowData, &nextWin, true);
+    doApplyFunctions(pTaskInfo, pSup->pCtx, &pInfo->twAggSup.timeWindowData, startPos, forwardRows, pBlock->info.rows,
+                     numOfOutput);
+  }
+}
+
+static void doStreamingIntervalAgg(SOperatorInfo* pOperator) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SExprSupp*                pSup = &pOperator->exprSupp;
+  SSDataBlock*              pRes = pInfo->binfo.pRes;
+  SOperatorInfo*            downstream = pOperator->pDownstream[0];
+  int32_t                   scanFlag = MAIN_SCAN;
+
+  while (1) {
+    SSDataBlock* pBlock = NULL;
+    if (pInfo->prefetchedBlock == NULL) {
+      pBlock = downstream->fpSet.getNextFn(downstream);
+    } else {
+      pBlock = pInfo->prefetchedBlock;
+      pInfo->prefetchedBlock = NULL;
+    }
+
+    // no data exists, close the last open time window
+    if (pBlock == NULL) {
+      if (pInfo->hasOpenWindow) {
+        pRes->info.groupId = pInfo->openGroupId;
+        closeStreamingIntervalWindow(pOperator, pRes);
+      }
+
+      setOperatorCompleted(pOperator);
+      break;
+    }
+
+    // the results of different groups can not be packed into one data block
+    if (pInfo->hasOpenWindow && pInfo->openGroupId != pBlock->info.groupId) {
+      pRes->info.groupId = pInfo->openGroupId;
+      closeStreamingIntervalWindow(pOperator, pRes);
+
+      pInfo->prefetchedBlock = pBlock;
+      break;
+    }
+
+    pRes->info.groupId = pBlock->info.groupId;
+    getTableScanInfo(pOperator, &pInfo->inputOrder, &scanFlag);
+
+    if (pInfo->scalarSupp.pExprInfo != NULL) {
+      SExprSupp* pExprSup = &pInfo->scalarSupp;
+      projectApplyFunctions(pExprSup->pExprInfo, pBlock, pBlock, pExprSup->pCtx, pExprSup->numOfExprs, NULL);
+    }
+
+    setInputDataBlock(pSup, pBlock, pInfo->inputOrder, scanFlag, true);
+    blockDataUpdateTsWindow(pBlock, pInfo->primaryTsIndex);
+
+    doStreamingIntervalAggImpl(pOperator, pBlock, pRes);
+    if (pRes->info.rows >= pOperator->resultInfo.capacity) {
+      break;
+    }
+  }
+}
+
+static SSDataBlock* doStreamingIntervalResult(SOperatorInfo* pOperator) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  if (pOperator->status == OP_EXEC_DONE) {
+    return NULL;
+  }
+
+  SSDataBlock* pRes = pInfo->binfo.pRes;
+  blockDataCleanup(pRes);
+
+  int64_t st = taosGetTimestampUs();
+  while (1) {
+    doStreamingIntervalAgg(pOperator);
+
+    // the results of current group are merged with those of the next group
+    if (pOperator->status != OP_EXEC_DONE && pInfo->binfo.mergeResultBlock &&
+        pRes->info.rows < pOperator->resultInfo.threshold) {
+      continue;
+    }
+
+    // the emitted rows are filtered only once, all of them may be removed by the filter
+    doFilter(pRes, pOperator->exprSupp.pFilterInfo, NULL);
+    if (pOperator->status == OP_EXEC_DONE || pRes->info.rows > 0) {
+      break;
+    }
+  }
+
+  pOperator->cost.totalCost += (taosGetTimestampUs() - st) / 1000.0;
+
+  size_t rows = pRes->info.rows;
+  pOperator->resultInfo.totalRows += rows;
+  return (rows == 0) ? NULL : pRes;
+}
+
 static bool compareVal(const char* v, const SStateKeys* pKey) {
   if (IS_VAR_DATA_TYPE(pKey->type)) {
     if (varDataLen(v) != varDataLen(pKey->pData)) {
@@ -1592,6 +1758,7 @@ void destroyIntervalOperatorInfo(void* param) {
 
   cleanupGroupResInfo(&pInfo->groupResInfo);
   colDataDestroy(&pInfo->twAggSup.timeWindowData);
+  taosMemoryFreeClear(pInfo->pOpenRow);
   taosMemoryFreeClear(param);
 }
 
@@ -1698,6 +1865,34 @@ void initStreamFunciton(SqlFunctionCtx* pCtx, int32_t numOfExpr) {
   }
 }
 
+static bool isStreamingIntervalAggApplicable(SOperatorInfo* pOperator, SOperatorInfo* downstream, bool isStream) {
+  SIntervalAggOperatorInfo* pInfo = pOperator->info;
+  SExecTaskInfo*            pTaskInfo = pOperator->pTaskInfo;
+
+  if (isStream || pInfo->execModel != OPTR_EXEC_MODEL_BATCH || pInfo->timeWindowInterpo) {
+    return false;
+  }
+
+  // only one window is open at any time for the tumbling time window, and windows are closed in the input order
+  if (pInfo->interval.interval != pInfo->interval.sliding ||
+      pInfo->interval.intervalUnit != pInfo->interval.slidingUnit || pInfo->inputOrder != pInfo->resultTsOrder) {
+    return false;
+  }
+
+  // the data of each group arrives in the timestamp order only if it comes from one table which is scanned just once
+  if (downstream->operatorType != QUERY_NODE_PHYSICAL_PLAN_TABLE_SCAN) {
+    return false;
+  }
+
+  STableScanInfo* pScanInfo = downstream->info;
+  if (pScanInfo->scanInfo.numOfAsc + pScanInfo->scanInfo.numOfDesc != 1) {
+    return false;
+  }
+
+  STableListInfo* pTableList = pTaskInfo->pTableInfoList;
+  return tableListGetOutputGroups(pTableList) == tableListGetSize(pTableList);
+}
+
 SOperatorInfo* createIntervalOperatorInfo(SOperatorInfo* downstream, SIntervalPhysiNode* pPhyNode,
                                           SExecTaskInfo* pTaskInfo, bool isStream) {
   SIntervalAggOperatorInfo* pInfo = taosMemoryCalloc(1, sizeof(SIntervalAggOperatorInfo));
@@ -1777,8 +1972,20 @@ SOperatorInfo* createIntervalOperatorInfo(SOperatorInfo* downstream, SIntervalPh
   setOperatorInfo(pOperator, "TimeIntervalAggOperator", QUERY_NODE_PHYSICAL_PLAN_HASH_INTERVAL, true, OP_NOT_OPENED,
                   pInfo, pTaskInfo);
 
-  pOperator->fpSet =
-      createOperatorFpSet(doOpenIntervalAgg, doBuildIntervalResult, NULL, destroyIntervalOperatorInfo, NULL);
+  pInfo->streamingAgg = isStreamingIntervalAggApplicable(pOperator, downstream, isStream);
+  if (pInfo->streamingAgg) {
+    pInfo->pOpenRow = taosMemoryCalloc(1, pInfo->aggSup.resultRowSize);
+    if (pInfo->pOpenRow == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _error;
+    }
+
+    pOperator->fpSet = createOperatorFpSet(operatorDummyOpenFn, doStreamingIntervalResult, NULL,
+                                           destroyIntervalOperatorInfo, NULL);
+  } else {
+    pOperator->fpSet =
+        createOperatorFpSet(doOpenIntervalAgg, doBuildIntervalResult, NULL, destroyIntervalOperatorInfo, NULL);
+  }
 
   code = appendDownstream(pOperator, &downstream, 1);
   if (code != TSDB_CODE_SUCCESS) {
@@ -20,24 +20,65 @@
 
 #define SHASH_DEFAULT_LOAD_FACTOR 0.75
 #define HASH_MAX_CAPACITY         (1024 * 1024 * 16L)
-#define SHASH_NEED_RESIZE(_h)     ((_h)->size >= (_h)->capacity * SHASH_DEFAULT_LOAD_FACTOR)
+// open addressing needs spare slots, so the table keeps growing beyond the initial limit. Slots are indexed by int32_t.
+#define SHASH_MAX_SLOTS           (1024 * 1024 * 1024L)
+#define SHASH_NEED_RESIZE(_h, _n) (((_h)->size + (_h)->deleted + (_n)) > (_h)->capacity * SHASH_DEFAULT_LOAD_FACTOR)
 
 #define GET_SHASH_NODE_KEY(_n, _dl) ((char *)(_n) + sizeof(SHNode) + (_dl))
 #define GET_SHASH_NODE_DATA(_n)     ((char *)(_n) + sizeof(SHNode))
 
 #define HASH_INDEX(v, c) ((v) & ((c)-1))
 
-#define FREE_HASH_NODE(_n)   \
-  do {                       \
-    taosMemoryFreeClear(_n); \
-  } while (0);
+/*
+ * Each slot owns one control byte. The control bytes are kept in a separate dense array, so that probing a run of
+ * slots touches only a few cache lines. A full slot stores the highest 7 bits of the hash value as its tag.
+ */
+#define SHASH_CTRL_EMPTY   ((uint8_t)0x80)
+#define SHASH_CTRL_DELETED ((uint8_t)0xFE)
+#define SHASH_CTRL_TAG(_h) ((uint8_t)((_h) >> 25))
+#define SHASH_CTRL_FULL(_c) (((_c)&0x80) == 0)
+
+// keys no longer than this are copied into the slot, and compared without touching the node
+#define SHASH_INLINE_KEY_LEN 16
+
+// payload nodes are allocated from a chunk based arena, larger ones are allocated individually
+#define SHASH_ARENA_CHUNK_SIZE    (64 * 1024)
+#define SHASH_NODE_ALIGN          8
+#define SHASH_FREE_LIST_NUM       64
+#define SHASH_ARENA_MAX_NODE_SIZE (SHASH_NODE_ALIGN * SHASH_FREE_LIST_NUM)
+#define SHASH_NODE_SIZE(_k, _d)   (((sizeof(SHNode) + (_k) + (_d)) + SHASH_NODE_ALIGN - 1) & ~(SHASH_NODE_ALIGN - 1))
+
+#if defined(__GNUC__)
+#define SHASH_PREFETCH(_p) __builtin_prefetch((_p))
+#else
+#define SHASH_PREFETCH(_p)
+#endif
+
+typedef struct SHSlot {
+  uint32_t hashVal;
+  uint32_t keyLen;
+  SHNode  *pNode;
+  char     key[SHASH_INLINE_KEY_LEN];
+} SHSlot;
+
+typedef struct SHArena {
+  SArray *pChunks;   // SArray<char*>, all allocated chunks
+  char   *pCur;      // next available position in the last chunk
+  size_t  remain;    // remain bytes in the last chunk
+  SHNode *freeList[SHASH_FREE_LIST_NUM];  // recycled nodes, grouped by the node size
+} SHArena;
 
 struct SSHashObj {
-  SHNode    **hashList;
+  uint8_t    *ctrl;      // control byte of each slot
+  SHSlot     *slots;
   size_t      capacity;  // number of slots
   int64_t     size;      // number of elements in hash table
+  int64_t     deleted;   // number of deleted slots
   _hash_fn_t  hashFp;    // hash function
   _equal_fn_t equalFp;   // equal function
+  SHArena     arena;
+  uint32_t   *pHashBuf;  // hash values of keys in batch operations
+  int32_t     hashBufSize;
 };
 
 static FORCE_INLINE int32_t taosHashCapacity(int32_t length) {
@@ -48,6 +89,24 @@ static FORCE_INLINE int32_t taosHashCapacity(int32_t length) {
   return i;
 }
 
+static int32_t doAllocSlots(SSHashObj *pHashObj, size_t capacity) {
+  uint8_t *ctrl = taosMemoryMalloc(capacity * sizeof(uint8_t));
+  SHSlot  *slots = taosMemoryMalloc(capacity * sizeof(SHSlot));
+  if (ctrl == NULL || slots == NULL) {
+    taosMemoryFree(ctrl);
+    taosMemoryFree(slots);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  memset(ctrl, SHASH_CTRL_EMPTY, capacity * sizeof(uint8_t));
+  pHashObj->ctrl = ctrl;
+  pHashObj->slots = slots;
+  pHashObj->capacity = capacity;
+  pHashObj->deleted = 0;
+  return TSDB_CODE_SUCCESS;
+}
+
 SSHashObj *tSimpleHashInit(size_t capacity, _hash_fn_t fn) {
   ASSERT(fn != NULL);
 
@@ -61,19 +120,16 @@ SSHashObj *tSimpleHashInit(size_t capacity, _hash_fn_t fn) {
     return NULL;
   }
 
-  // the max slots is not defined by user
-  pHashObj->capacity = taosHashCapacity((int32_t)capacity);
-
   pHashObj->equalFp = memcmp;
   pHashObj->hashFp = fn;
-  ASSERT((pHashObj->capacity & (pHashObj->capacity - 1)) == 0);
 
-  pHashObj->hashList = (SHNode **)taosMemoryCalloc(pHashObj->capacity, sizeof(void *));
-  if (!pHashObj->hashList) {
+  // the max slots is not defined by user
+  if (doAllocSlots(pHashObj, taosHashCapacity((int32_t)capacity)) != TSDB_CODE_SUCCESS) {
     taosMemoryFree(pHashObj);
-    terrno = TSDB_CODE_OUT_OF_MEMORY;
     return NULL;
   }
+
+  ASSERT((pHashObj->capacity & (pHashObj->capacity - 1)) == 0);
   return pHashObj;
 }
 
@@ -81,11 +137,73 @@ int32_t tSimpleHashGetSize(const SSHashObj *pHashObj) {
   if (!pHashObj) {
     return 0;
   }
-  return (int32_t)atomic_load_64((int64_t *)&pHashObj->size);
+  return (int32_t)pHashObj->size;
+}
+
+static SHNode *doAllocNodeFromArena(SHArena *pArena, size_t size) {
+  if (size > SHASH_ARENA_MAX_NODE_SIZE) {
+    return taosMemoryMalloc(size);
+  }
+
+  int32_t index = size / SHASH_NODE_ALIGN - 1;
+  if (pArena->freeList[index] != NULL) {
+    SHNode *pNode = pArena->freeList[index];
+    pArena->freeList[index] = pNode->next;
+    return pNode;
+  }
+
+  if (pArena->remain < size) {
+    if (pArena->pChunks == NULL) {
+      pArena->pChunks = taosArrayInit(4, POINTER_BYTES);
+      if (pArena->pChunks == NULL) {
+        return NULL;
+      }
+    }
+
+    char *pChunk = taosMemoryMalloc(SHASH_ARENA_CHUNK_SIZE);
+    if (pChunk == NULL) {
+      return NULL;
+    }
+
+    taosArrayPush(pArena->pChunks, &pChunk);
+    pArena->pCur = pChunk;
+    pArena->remain = SHASH_ARENA_CHUNK_SIZE;
+  }
+
+  SHNode *pNode = (SHNode *)pArena->pCur;
+  pArena->pCur += size;
+  pArena->remain -= size;
+  return pNode;
+}
+
+static void doRecycleNode(SHArena *pArena, SHNode *pNode) {
+  size_t size = SHASH_NODE_SIZE(pNode->keyLen, pNode->dataLen);
+  if (size > SHASH_ARENA_MAX_NODE_SIZE) {
+    taosMemoryFree(pNode);
+    return;
+  }
+
+  int32_t index = size / SHASH_NODE_ALIGN - 1;
+  pNode->next = pArena->freeList[index];
+  pArena->freeList[index] = pNode;
+}
+
+static void doResetArena(SHArena *pArena) {
+  size_t num = taosArrayGetSize(pArena->pChunks);
+  for (int32_t i = 0; i < num; ++i) {
+    char **p = taosArrayGet(pArena->pChunks, i);
+    taosMemoryFree(*p);
+  }
+
+  taosArrayClear(pArena->pChunks);
+  pArena->pCur = NULL;
+  pArena->remain = 0;
+  memset(pArena->freeList, 0, sizeof(pArena->freeList));
 }
 
-static SHNode *doCreateHashNode(const void *key, size_t keyLen, const void *data, size_t dataLen, uint32_t hashVal) {
-  SHNode *pNewNode = taosMemoryMalloc(sizeof(SHNode) + keyLen + dataLen);
+static SHNode *doCreateHashNode(SSHashObj *pHashObj, const void *key, size_t keyLen, const void *data,
+                                size_t dataLen) {
+  SHNode *pNewNode = doAllocNodeFromArena(&pHashObj->arena, SHASH_NODE_SIZE(keyLen, dataLen));
   if (!pNewNode) {
     terrno = TSDB_CODE_OUT_OF_MEMORY;
     return NULL;
@@ -93,68 +211,128 @@ static SHNode *doCreateHashNode(const void *key, size_t keyLen, const void *data
   pNewNode->keyLen = keyLen;
   pNewNode->dataLen = dataLen;
   pNewNode->next = NULL;
-  if (data) memcpy(GET_SHASH_NODE_DATA(pNewNode), data, dataLen);
+  if (data) {
+    memcpy(GET_SHASH_NODE_DATA(pNewNode), data, dataLen);
+  } else if (dataLen > 0) {
+    memset(GET_SHASH_NODE_DATA(pNewNode), 0, dataLen);
+  }
   memcpy(GET_SHASH_NODE_KEY(pNewNode, dataLen), key, keyLen);
   return pNewNode;
 }
 
-static void tSimpleHashTableResize(SSHashObj *pHashObj) {
-  if (!SHASH_NEED_RESIZE(pHashObj)) {
-    return;
+static FORCE_INLINE bool doSlotKeyEqual(const SSHashObj *pHashObj, const SHSlot *pSlot, const void *key,
+                                        size_t keyLen) {
+  if (pSlot->keyLen != keyLen) {
+    return false;
   }
 
-  int32_t newCapacity = (int32_t)(pHashObj->capacity << 1u);
-  if (newCapacity > HASH_MAX_CAPACITY) {
-    uDebug("current capacity:%" PRIzu ", maximum capacity:%" PRId32 ", no resize applied due to limitation is reached",
-           pHashObj->capacity, (int32_t)HASH_MAX_CAPACITY);
-    return;
+  const char *p =
+      (keyLen <= SHASH_INLINE_KEY_LEN) ? pSlot->key : GET_SHASH_NODE_KEY(pSlot->pNode, pSlot->pNode->dataLen);
+  return (*pHashObj->equalFp)(p, key, keyLen) == 0;
+}
+
+/**
+ * Find the slot of the given key. If not found, return -1, and the first slot that is available for insertion is
+ * returned in pInsertPos, if required.
+ */
+static int32_t doSearchSlot(const SSHashObj *pHashObj, const void *key, size_t keyLen, uint32_t hashVal,
+                            int32_t *pInsertPos) {
+  uint8_t tag = SHASH_CTRL_TAG(hashVal);
+  size_t  mask = pHashObj->capacity - 1;
+  int32_t firstDeleted = -1;
+
+  size_t pos = HASH_INDEX(hashVal, pHashObj->capacity);
+  for (size_t i = 0; i < pHashObj->capacity; ++i, pos = (pos + 1) & mask) {
+    uint8_t c = pHashObj->ctrl[pos];
+    if (c == tag) {
+      const SHSlot *pSlot = &pHashObj->slots[pos];
+      if (pSlot->hashVal == hashVal && doSlotKeyEqual(pHashObj, pSlot, key, keyLen)) {
+        return (int32_t)pos;
+      }
+    } else if (c == SHASH_CTRL_EMPTY) {
+      if (pInsertPos != NULL) {
+        *pInsertPos = (firstDeleted != -1) ? firstDeleted : (int32_t)pos;
+      }
+      return -1;
+    } else if (c == SHASH_CTRL_DELETED && firstDeleted == -1) {
+      firstDeleted = (int32_t)pos;
+    }
+  }
+
+  if (pInsertPos != NULL) {
+    *pInsertPos = firstDeleted;
+  }
+  return -1;
+}
+
+static FORCE_INLINE void doFillSlot(SSHashObj *pHashObj, int32_t pos, uint32_t hashVal, const void *key,
+                                    size_t keyLen, SHNode *pNode) {
+  SHSlot *pSlot = &pHashObj->slots[pos];
+  pSlot->hashVal = hashVal;
+  pSlot->keyLen = (uint32_t)keyLen;
+  pSlot->pNode = pNode;
+  if (keyLen <= SHASH_INLINE_KEY_LEN) {
+    memcpy(pSlot->key, key, keyLen);
+  }
+
+  if (pHashObj->ctrl[pos] == SHASH_CTRL_DELETED) {
+    pHashObj->deleted -= 1;
   }
+  pHashObj->ctrl[pos] = SHASH_CTRL_TAG(hashVal);
+  pHashObj->size += 1;
+}
 
-  int64_t st = taosGetTimestampUs();
-  void   *pNewEntryList = taosMemoryRealloc(pHashObj->hashList, POINTER_BYTES * newCapacity);
-  if (!pNewEntryList) {
-    uWarn("hash resize failed due to out of memory, capacity remain:%zu", pHashObj->capacity);
+static void tSimpleHashTableResize(SSHashObj *pHashObj, int32_t num) {
+  if (!SHASH_NEED_RESIZE(pHashObj, num)) {
     return;
   }
 
-  size_t inc = newCapacity - pHashObj->capacity;
-  memset((char *)pNewEntryList + pHashObj->capacity * POINTER_BYTES, 0, inc * sizeof(void *));
+  // lots of deleted slots, rehash in place instead of growing the table
+  size_t newCapacity = pHashObj->capacity;
+  while ((pHashObj->size + num) > newCapacity * SHASH_DEFAULT_LOAD_FACTOR) {
+    newCapacity = (newCapacity << 1u);
+  }
 
-  pHashObj->hashList = pNewEntryList;
-  pHashObj->capacity = newCapacity;
+  if (newCapacity > SHASH_MAX_SLOTS) {
+    uWarn("current capacity:%" PRIzu ", maximum capacity:%" PRId64 ", no resize applied due to limitation is reached",
+          pHashObj->capacity, (int64_t)SHASH_MAX_SLOTS);
+    if (pHashObj->deleted == 0) {
+      return;
+    }
+    newCapacity = pHashObj->capacity;
+  }
+
+  int64_t  st = taosGetTimestampUs();
+  uint8_t *pOldCtrl = pHashObj->ctrl;
+  SHSlot  *pOldSlots = pHashObj->slots;
+  size_t   oldCapacity = pHashObj->capacity;
+
+  if (doAllocSlots(pHashObj, newCapacity) != TSDB_CODE_SUCCESS) {
+    uWarn("hash resize failed due to out of memory, capacity remain:%zu", oldCapacity);
+    pHashObj->ctrl = pOldCtrl;
+    pHashObj->slots = pOldSlots;
+    return;
+  }
 
-  for (int32_t idx = 0; idx < pHashObj->capacity; ++idx) {
-    SHNode *pNode = pHashObj->hashList[idx];
-    if (!pNode) {
+  size_t mask = newCapacity - 1;
+  for (size_t i = 0; i < oldCapacity; ++i) {
+    if (!SHASH_CTRL_FULL(pOldCtrl[i])) {
       continue;
     }
 
-    SHNode *pNext = NULL;
-    SHNode *pPrev = NULL;
-
-    while (pNode != NULL) {
-      void    *key = GET_SHASH_NODE_KEY(pNode, pNode->dataLen);
-      uint32_t hashVal = (*pHashObj->hashFp)(key, (uint32_t)pNode->keyLen);
-
-      int32_t newIdx = HASH_INDEX(hashVal, pHashObj->capacity);
-      pNext = pNode->next;
-      if (newIdx != idx) {
-        if (!pPrev) {
-          pHashObj->hashList[idx] = pNext;
-        } else {
-          pPrev->next = pNext;
-        }
-
-        pNode->next = pHashObj->hashList[newIdx];
-        pHashObj->hashList[newIdx] = pNode;
-      } else {
-        pPrev = pNode;
-      }
-
-      pNode = pNext;
+    // the hash values are kept in slots, no need to hash the key again
+    size_t pos = HASH_INDEX(pOldSlots[i].hashVal, newCapacity);
+    while (pHashObj->ctrl[pos] != SHASH_CTRL_EMPTY) {
+      pos = (pos + 1) & mask;
     }
+
+    pHashObj->ctrl[pos] = pOldCtrl[i];
+    pHashObj->slots[pos] = pOldSlots[i];
   }
 
+  taosMemoryFree(pOldCtrl);
+  taosMemoryFree(pOldSlots);
+
   int64_t et = taosGetTimestampUs();
 
   //  uDebug("hash table resize completed, new capacity:%d, load factor:%f, elapsed time:%fms",
@@ -162,91 +340,150 @@ static void tSimpleHashTableResize(SSHashObj *pHashObj) {
   //         ((double)pHashObj->size) / pHashObj->capacity, (et - st) / 1000.0);
 }
 
+static SHNode *doPutImpl(SSHashObj *pHashObj, const void *key, size_t keyLen, uint32_t hashVal, const void *data,
+                         size_t dataLen, bool update, bool *isNew) {
+  int32_t insertPos = -1;
+  int32_t pos = doSearchSlot(pHashObj, key, keyLen, hashVal, &insertPos);
+  if (pos >= 0) {
+    SHNode *pNode = pHashObj->slots[pos].pNode;
+    if (update && data) {  // update data
+      memcpy(GET_SHASH_NODE_DATA(pNode), data, dataLen);
+    }
+    *isNew = false;
+    return pNode;
+  }
+
+  // need the resize process
+  if (SHASH_NEED_RESIZE(pHashObj, 1)) {
+    tSimpleHashTableResize(pHashObj, 1);
+    doSearchSlot(pHashObj, key, keyLen, hashVal, &insertPos);
+  }
+
+  if (insertPos < 0) {  // no available slot any more
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  SHNode *pNewNode = doCreateHashNode(pHashObj, key, keyLen, data, dataLen);
+  if (!pNewNode) {
+    return NULL;
+  }
+
+  doFillSlot(pHashObj, insertPos, hashVal, key, keyLen, pNewNode);
+  *isNew = true;
+  return pNewNode;
+}
+
 int32_t tSimpleHashPut(SSHashObj *pHashObj, const void *key, size_t keyLen, const void *data, size_t dataLen) {
   if (!pHashObj || !key) {
     return -1;
   }
 
   uint32_t hashVal = (*pHashObj->hashFp)(key, (uint32_t)keyLen);
+  bool     isNew = false;
+  return (doPutImpl(pHashObj, key, keyLen, hashVal, data, dataLen, true, &isNew) == NULL) ? -1 : 0;
+}
 
-  // need the resize process, write lock applied
-  if (SHASH_NEED_RESIZE(pHashObj)) {
-    tSimpleHashTableResize(pHashObj);
+void *tSimpleHashGet(SSHashObj *pHashObj, const void *key, size_t keyLen) {
+  if (!pHashObj || pHashObj->size == 0 || !key) {
+    return NULL;
   }
 
-  int32_t slot = HASH_INDEX(hashVal, pHashObj->capacity);
+  uint32_t hashVal = (*pHashObj->hashFp)(key, (uint32_t)keyLen);
+  int32_t  pos = doSearchSlot(pHashObj, key, keyLen, hashVal, NULL);
+  return (pos < 0) ? NULL : GET_SHASH_NODE_DATA(pHashObj->slots[pos].pNode);
+}
 
-  SHNode *pNode = pHashObj->hashList[slot];
-  if (!pNode) {
-    SHNode *pNewNode = doCreateHashNode(key, keyLen, data, dataLen, hashVal);
-    if (!pNewNode) {
-      return -1;
+static int32_t doPrepareBatchHash(SSHashObj *pHashObj, const void **keys, const size_t *keyLens, int32_t num) {
+  if (pHashObj->hashBufSize < num) {
+    uint32_t *p = taosMemoryRealloc(pHashObj->pHashBuf, num * sizeof(uint32_t));
+    if (p == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return TSDB_CODE_OUT_OF_MEMORY;
     }
 
-    pHashObj->hashList[slot] = pNewNode;
-    atomic_add_fetch_64(&pHashObj->size, 1);
-    return 0;
+    pHashObj->pHashBuf = p;
+    pHashObj->hashBufSize = num;
   }
 
-  while (pNode) {
-    if ((keyLen == pNode->keyLen) && (*(pHashObj->equalFp))(GET_SHASH_NODE_KEY(pNode, pNode->dataLen), key, keyLen) == 0) {
-      break;
-    }
-    pNode = pNode->next;
+  // compute all hash values first, and issue the prefetch of the home slots before probing any of them
+  size_t mask = pHashObj->capacity - 1;
+  for (int32_t i = 0; i < num; ++i) {
+    uint32_t hashVal = (*pHashObj->hashFp)(keys[i], (uint32_t)keyLens[i]);
+    pHashObj->pHashBuf[i] = hashVal;
+    SHASH_PREFETCH(&pHashObj->ctrl[hashVal & mask]);
+    SHASH_PREFETCH(&pHashObj->slots[hashVal & mask]);
   }
 
-  if (!pNode) {
-    SHNode *pNewNode = doCreateHashNode(key, keyLen, data, dataLen, hashVal);
-    if (!pNewNode) {
-      return -1;
-    }
-    pNewNode->next = pHashObj->hashList[slot];
-    pHashObj->hashList[slot] = pNewNode;
-    atomic_add_fetch_64(&pHashObj->size, 1);
-  } else if (data) {  // update data
-    memcpy(GET_SHASH_NODE_DATA(pNode), data, dataLen);
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t tSimpleHashBatchGet(SSHashObj *pHashObj, const void **keys, const size_t *keyLens, int32_t num, void **pRes) {
+  if (!pHashObj || !keys || !pRes) {
+    return TSDB_CODE_FAILED;
   }
 
-  return 0;
-}
+  if (pHashObj->size == 0) {
+    memset(pRes, 0, num * POINTER_BYTES);
+    return TSDB_CODE_SUCCESS;
+  }
 
-static FORCE_INLINE SHNode *doSearchInEntryList(SSHashObj *pHashObj, const void *key, size_t keyLen, int32_t index) {
-  SHNode *pNode = pHashObj->hashList[index];
-  while (pNode) {
-    const char* p = GET_SHASH_NODE_KEY(pNode, pNode->dataLen);
-    ASSERT(keyLen > 0);
+  int32_t code = doPrepareBatchHash(pHashObj, keys, keyLens, num);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
 
-    if (pNode->keyLen == keyLen && ((*(pHashObj->equalFp))(p, key, keyLen) == 0)) {
-      break;
-    }
-    pNode = pNode->next;
+  for (int32_t i = 0; i < num; ++i) {
+    int32_t pos = doSearchSlot(pHashObj, keys[i], keyLens[i], pHashObj->pHashBuf[i], NULL);
+    pRes[i] = (pos < 0) ? NULL : GET_SHASH_NODE_DATA(pHashObj->slots[pos].pNode);
   }
 
-  return pNode;
+  return TSDB_CODE_SUCCESS;
 }
 
-static FORCE_INLINE bool taosHashTableEmpty(const SSHashObj *pHashObj) { return tSimpleHashGetSize(pHashObj) == 0; }
+int32_t tSimpleHashBatchGetOrPut(SSHashObj *pHashObj, const void **keys, const size_t *keyLens, int32_t num,
+                                 const void *data, size_t dataLen, void **pRes, int32_t *numOfNew) {
+  if (!pHashObj || !keys || !pRes) {
+    return TSDB_CODE_FAILED;
+  }
 
-void *tSimpleHashGet(SSHashObj *pHashObj, const void *key, size_t keyLen) {
-  if (!pHashObj || taosHashTableEmpty(pHashObj) || !key) {
-    return NULL;
+  int32_t code = doPrepareBatchHash(pHashObj, keys, keyLens, num);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
   }
 
-  uint32_t hashVal = (*pHashObj->hashFp)(key, (uint32_t)keyLen);
+  int32_t newItems = 0;
+  for (int32_t i = 0; i < num; ++i) {
+    bool    isNew = false;
+    SHNode *pNode = doPutImpl(pHashObj, keys[i], keyLens[i], pHashObj->pHashBuf[i], data, dataLen, false, &isNew);
+    if (pNode == NULL) {
+      return terrno;
+    }
 
-  int32_t slot = HASH_INDEX(hashVal, pHashObj->capacity);
-  SHNode *pNode = pHashObj->hashList[slot];
-  if (!pNode) {
-    return NULL;
+    pRes[i] = GET_SHASH_NODE_DATA(pNode);
+    newItems += isNew;
   }
 
-  char *data = NULL;
-  pNode = doSearchInEntryList(pHashObj, key, keyLen, slot);
-  if (pNode != NULL) {
-    data = GET_SHASH_NODE_DATA(pNode);
+  if (numOfNew != NULL) {
+    *numOfNew = newItems;
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+static void doRemoveSlot(SSHashObj *pHashObj, int32_t pos) {
+  doRecycleNode(&pHashObj->arena, pHashObj->slots[pos].pNode);
+  pHashObj->slots[pos].pNode = NULL;
+
+  // no probe sequence goes across an empty slot, so the deleted slot can be set to be empty directly if the next one
+  // is empty.
+  if (pHashObj->ctrl[(pos + 1) & (pHashObj->capacity - 1)] == SHASH_CTRL_EMPTY) {
+    pHashObj->ctrl[pos] = SHASH_CTRL_EMPTY;
+  } else {
+    pHashObj->ctrl[pos] = SHASH_CTRL_DELETED;
+    pHashObj->deleted += 1;
   }
 
-  return data;
+  pHashObj->size -= 1;
 }
 
 int32_t tSimpleHashRemove(SSHashObj *pHashObj, const void *key, size_t keyLen) {
@@ -256,25 +493,10 @@ int32_t tSimpleHashRemove(SSHashObj *pHashObj, const void *key, size_t keyLen) {
   }
 
   uint32_t hashVal = (*pHashObj->hashFp)(key, (uint32_t)keyLen);
-
-  int32_t slot = HASH_INDEX(hashVal, pHashObj->capacity);
-
-  SHNode *pNode = pHashObj->hashList[slot];
-  SHNode *pPrev = NULL;
-  while (pNode) {
-    if ((*(pHashObj->equalFp))(GET_SHASH_NODE_KEY(pNode, pNode->dataLen), key, keyLen) == 0) {
-      if (!pPrev) {
-        pHashObj->hashList[slot] = pNode->next;
-      } else {
-        pPrev->next = pNode->next;
-      }
-      FREE_HASH_NODE(pNode);
-      atomic_sub_fetch_64(&pHashObj->size, 1);
-      code = TSDB_CODE_SUCCESS;
-      break;
-    }
-    pPrev = pNode;
-    pNode = pNode->next;
+  int32_t  pos = doSearchSlot(pHashObj, key, keyLen, hashVal, NULL);
+  if (pos >= 0) {
+    doRemoveSlot(pHashObj, pos);
+    code = TSDB_CODE_SUCCESS;
   }
 
   return code;
@@ -286,54 +508,37 @@ int32_t tSimpleHashIterateRemove(SSHashObj *pHashObj, const void *key, size_t ke
   }
 
   uint32_t hashVal = (*pHashObj->hashFp)(key, (uint32_t)keyLen);
-
-  int32_t slot = HASH_INDEX(hashVal, pHashObj->capacity);
-
-  SHNode *pNode = pHashObj->hashList[slot];
-  SHNode *pPrev = NULL;
-  while (pNode) {
-    if ((*(pHashObj->equalFp))(GET_SHASH_NODE_KEY(pNode, pNode->dataLen), key, keyLen) == 0) {
-      if (!pPrev) {
-        pHashObj->hashList[slot] = pNode->next;
-      } else {
-        pPrev->next = pNode->next;
-      }
-
-      if (*pIter == (void *)GET_SHASH_NODE_DATA(pNode)) {
-        *pIter = pPrev ? GET_SHASH_NODE_DATA(pPrev) : NULL;
-      }
-
-      FREE_HASH_NODE(pNode);
-      atomic_sub_fetch_64(&pHashObj->size, 1);
-      break;
+  int32_t  pos = doSearchSlot(pHashObj, key, keyLen, hashVal, NULL);
+  if (pos >= 0) {
+    // the iteration restarts from the current slot, since the removed one is not available any more
+    if (*pIter == (void *)GET_SHASH_NODE_DATA(pHashObj->slots[pos].pNode)) {
+      *pIter = NULL;
     }
-    pPrev = pNode;
-    pNode = pNode->next;
+
+    doRemoveSlot(pHashObj, pos);
   }
 
   return TSDB_CODE_SUCCESS;
 }
 
 void tSimpleHashClear(SSHashObj *pHashObj) {
-  if (!pHashObj || taosHashTableEmpty(pHashObj)) {
+  if (!pHashObj) {
     return;
   }
 
-  SHNode *pNode = NULL, *pNext = NULL;
-  for (int32_t i = 0; i < pHashObj->capacity; ++i) {
-    pNode = pHashObj->hashList[i];
-    if (!pNode) {
-      continue;
-    }
-
-    while (pNode) {
-      pNext = pNode->next;
-      FREE_HASH_NODE(pNode);
-      pNode = pNext;
+  for (int32_t i = 0; i < pHashObj->capacity && pHashObj->size > 0; ++i) {
+    if (SHASH_CTRL_FULL(pHashObj->ctrl[i])) {
+      SHNode *pNode = pHashObj->slots[i].pNode;
+      if (SHASH_NODE_SIZE(pNode->keyLen, pNode->dataLen) > SHASH_ARENA_MAX_NODE_SIZE) {
+        taosMemoryFree(pNode);
+      }
     }
-    pHashObj->hashList[i] = NULL;
   }
-  atomic_store_64(&pHashObj->size, 0);
+
+  doResetArena(&pHashObj->arena);
+  memset(pHashObj->ctrl, SHASH_CTRL_EMPTY, pHashObj->capacity * sizeof(uint8_t));
+  pHashObj->size = 0;
+  pHashObj->deleted = 0;
 }
 
 void tSimpleHashCleanup(SSHashObj *pHashObj) {
@@ -342,7 +547,10 @@ void tSimpleHashCleanup(SSHashObj *pHashObj) {
   }
 
   tSimpleHashClear(pHashObj);
-  taosMemoryFreeClear(pHashObj->hashList);
+  taosArrayDestroy(pHashObj->arena.pChunks);
+  taosMemoryFreeClear(pHashObj->ctrl);
+  taosMemoryFreeClear(pHashObj->slots);
+  taosMemoryFreeClear(pHashObj->pHashBuf);
   taosMemoryFree(pHashObj);
 }
 
@@ -351,7 +559,8 @@ size_t tSimpleHashGetMemSize(const SSHashObj *pHashObj) {
     return 0;
   }
 
-  return (pHashObj->capacity * sizeof(void *)) + sizeof(SHNode) * tSimpleHashGetSize(pHashObj) + sizeof(SSHashObj);
+  return pHashObj->capacity * (sizeof(SHSlot) + sizeof(uint8_t)) +
+         taosArrayGetSize(pHashObj->arena.pChunks) * SHASH_ARENA_CHUNK_SIZE + sizeof(SSHashObj);
 }
 
 void *tSimpleHashIterate(const SSHashObj *pHashObj, void *data, int32_t *iter) {
@@ -359,34 +568,15 @@ void *tSimpleHashIterate(const SSHashObj *pHashObj, void *data, int32_t *iter) {
     return NULL;
   }
 
-  SHNode *pNode = NULL;
-
-  if (!data) {
-    for (int32_t i = *iter; i < pHashObj->capacity; ++i) {
-      pNode = pHashObj->hashList[i];
-      if (!pNode) {
-        continue;
-      }
-      *iter = i;
-      return GET_SHASH_NODE_DATA(pNode);
-    }
-    return NULL;
-  }
-
-  pNode = (SHNode *)((char *)data - offsetof(SHNode, data));
-
-  if (pNode->next) {
-    return GET_SHASH_NODE_DATA(pNode->next);
-  }
-
-  ++(*iter);
-  for (int32_t i = *iter; i < pHashObj->capacity; ++i) {
-    pNode = pHashObj->hashList[i];
-    if (!pNode) {
+  // each slot holds at most one element, so the iterator only needs to move to the next full slot
+  int32_t start = (data == NULL) ? (*iter) : (*iter) + 1;
+  for (int32_t i = start; i < pHashObj->capacity; ++i) {
+    if (!SHASH_CTRL_FULL(pHashObj->ctrl[i])) {
       continue;
     }
+
     *iter = i;
-    return GET_SHASH_NODE_DATA(pNode);
+    return GET_SHASH_NODE_DATA(pHashObj->slots[i].pNode);
   }
 
   return NULL;
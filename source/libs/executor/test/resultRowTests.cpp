@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <tglobal.h>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#include "os.h"
+
+#include "executorimpl.h"
+#include "tpagedbuf.h"
+
+// the rows of a block refer to groups on many more pages than the buffer keeps in memory
+TEST(testCase, batchResultRows_spill_Test) {
+  SDiskbasedBuf* pBuf = NULL;
+  int32_t        pageSize = 4096;
+  int32_t        rowSize = 512;
+  int32_t        code = createDiskbasedBuf(&pBuf, pageSize, pageSize * 2, "batchResultRows", tsTempDir);
+  ASSERT_EQ(code, TSDB_CODE_SUCCESS);
+
+  int32_t                         numOfGroups = 200;
+  int32_t                         currentPageId = -1;
+  std::vector<SResultRowPosition> groups(numOfGroups);
+  for (int32_t i = 0; i < numOfGroups; ++i) {
+    SResultRow* pRow = getNewResultRow(pBuf, &currentPageId, rowSize);
+    ASSERT_NE(pRow, nullptr);
+
+    pRow->numOfRows = i;
+    groups[i].pageId = pRow->pageId;
+    groups[i].offset = pRow->offset;
+  }
+  releaseBufPage(pBuf, getBufPage(pBuf, currentPageId));
+
+  // each group is referred twice, in an order jumping between pages
+  int32_t                          numOfRows = numOfGroups * 2;
+  std::vector<SResultRowPosition*> pPos(numOfRows);
+  std::vector<SResultRow*>         pRows(numOfRows);
+  for (int32_t j = 0; j < numOfRows; ++j) {
+    pPos[j] = &groups[(j * 7) % numOfGroups];
+  }
+
+  getBatchResultRows(pBuf, pPos.data(), numOfRows, pRows.data());
+  for (int32_t j = 0; j < numOfRows; ++j) {
+    EXPECT_EQ(pRows[j]->pageId, pPos[j]->pageId);
+    EXPECT_EQ(pRows[j]->numOfRows % 1000, (j * 7) % numOfGroups);
+    pRows[j]->numOfRows += 1000;
+  }
+  releaseBatchResultRows(pBuf, pRows.data(), numOfRows);
+
+  for (int32_t i = 0; i < numOfGroups; ++i) {
+    SResultRow* pRow = getResultRowByPos(pBuf, &groups[i], false);
+    EXPECT_EQ(pRow->numOfRows, i + 2000);
+    releaseBufPage(pBuf, (char*)pRow - pRow->offset);
+  }
+
+  destroyDiskbasedBuf(pBuf);
+}
+
+#pragma GCC diagnostic pop
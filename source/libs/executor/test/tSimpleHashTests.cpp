@@ -15,6 +15,8 @@
 
 #include <gtest/gtest.h>
 #include <iostream>
+#include <unordered_map>
+#include <vector>
 #include "taos.h"
 #include "thash.h"
 #include "tsimplehash.h"
@@ -137,4 +139,181 @@ TEST(testCase, tSimpleHashTest_binaryKey) {
   tSimpleHashCleanup(pHashObj);
 }
 
+TEST(testCase, tSimpleHashTest_largeKey) {
+  SSHashObj *pHashObj = tSimpleHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
+  ASSERT_NE(pHashObj, nullptr);
+
+  // both the key and payload are too large to be kept inline or in the arena
+  char key[64] = {0};
+  char data[1024] = {0};
+  for (int32_t i = 0; i < 1000; ++i) {
+    snprintf(key, tListLen(key), "a_long_key_that_cannot_be_inlined_%d", i);
+    *(int32_t *)data = i;
+    ASSERT_EQ(0, tSimpleHashPut(pHashObj, key, strlen(key), data, sizeof(data)));
+  }
+  ASSERT_EQ(1000, tSimpleHashGetSize(pHashObj));
+
+  for (int32_t i = 0; i < 1000; ++i) {
+    snprintf(key, tListLen(key), "a_long_key_that_cannot_be_inlined_%d", i);
+    void *p = tSimpleHashGet(pHashObj, key, strlen(key));
+    ASSERT_NE(p, nullptr);
+    ASSERT_EQ(i, *(int32_t *)p);
+
+    size_t kLen = 0;
+    ASSERT_EQ(0, memcmp(tSimpleHashGetKey(p, &kLen), key, strlen(key)));
+    ASSERT_EQ(strlen(key), kLen);
+  }
+
+  for (int32_t i = 0; i < 1000; i += 2) {
+    snprintf(key, tListLen(key), "a_long_key_that_cannot_be_inlined_%d", i);
+    ASSERT_EQ(0, tSimpleHashRemove(pHashObj, key, strlen(key)));
+  }
+  ASSERT_EQ(500, tSimpleHashGetSize(pHashObj));
+
+  tSimpleHashClear(pHashObj);
+  ASSERT_EQ(0, tSimpleHashGetSize(pHashObj));
+  tSimpleHashCleanup(pHashObj);
+}
+
+TEST(testCase, tSimpleHashTest_removeAndIterate) {
+  SSHashObj *pHashObj = tSimpleHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT));
+  ASSERT_NE(pHashObj, nullptr);
+
+  std::unordered_map<int64_t, int64_t> ref;
+  taosSeedRand(1);
+
+  // random put/remove, the deleted slots are reused by the following put
+  for (int32_t i = 0; i < 200000; ++i) {
+    int64_t k = taosRand() % 5000;
+    if (taosRand() % 3 == 0) {
+      int32_t code = tSimpleHashRemove(pHashObj, &k, sizeof(k));
+      ASSERT_EQ(code == 0, ref.erase(k) == 1);
+    } else {
+      int64_t v = k * 3;
+      tSimpleHashPut(pHashObj, &k, sizeof(k), &v, sizeof(v));
+      ref[k] = v;
+    }
+  }
+
+  ASSERT_EQ(ref.size(), tSimpleHashGetSize(pHashObj));
+  for (auto &it : ref) {
+    void *p = tSimpleHashGet(pHashObj, &it.first, sizeof(int64_t));
+    ASSERT_NE(p, nullptr);
+    ASSERT_EQ(it.second, *(int64_t *)p);
+  }
+
+  // remove the odd keys during iteration
+  size_t  total = ref.size();
+  void   *data = NULL;
+  int32_t iter = 0;
+  int32_t num = 0;
+  while ((data = tSimpleHashIterate(pHashObj, data, &iter))) {
+    num++;
+    int64_t key = *(int64_t *)tSimpleHashGetKey(data, NULL);
+    if (key % 2 == 1) {
+      tSimpleHashIterateRemove(pHashObj, &key, sizeof(key), &data, &iter);
+      ref.erase(key);
+    }
+  }
+
+  ASSERT_EQ(total, num);
+  ASSERT_EQ(ref.size(), tSimpleHashGetSize(pHashObj));
+
+  data = NULL;
+  iter = 0;
+  while ((data = tSimpleHashIterate(pHashObj, data, &iter))) {
+    int64_t key = *(int64_t *)tSimpleHashGetKey(data, NULL);
+    ASSERT_EQ(0, key % 2);
+    ASSERT_EQ(1, ref.count(key));
+  }
+
+  tSimpleHashCleanup(pHashObj);
+}
+
+TEST(testCase, tSimpleHashTest_batch) {
+  SSHashObj *pHashObj = tSimpleHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT));
+  ASSERT_NE(pHashObj, nullptr);
+
+  const int32_t        num = 4096;
+  std::vector<int64_t> keyVals(num);
+  std::vector<const void *> keys(num);
+  std::vector<size_t>  keyLens(num, sizeof(int64_t));
+  std::vector<void *>  res(num);
+
+  // the keys are duplicated in the batch
+  for (int32_t i = 0; i < num; ++i) {
+    keyVals[i] = i % 1000;
+    keys[i] = &keyVals[i];
+  }
+
+  int32_t numOfNew = 0;
+  ASSERT_EQ(0, tSimpleHashBatchGetOrPut(pHashObj, keys.data(), keyLens.data(), num, NULL, sizeof(int64_t), res.data(),
+                                        &numOfNew));
+  ASSERT_EQ(1000, numOfNew);
+  ASSERT_EQ(1000, tSimpleHashGetSize(pHashObj));
+
+  for (int32_t i = 0; i < num; ++i) {
+    *(int64_t *)res[i] += 1;
+  }
+
+  for (int32_t i = 0; i < num; ++i) {
+    keyVals[i] = i;
+  }
+
+  ASSERT_EQ(0, tSimpleHashBatchGet(pHashObj, keys.data(), keyLens.data(), num, res.data()));
+  for (int32_t i = 0; i < num; ++i) {
+    if (i < 1000) {
+      ASSERT_NE(res[i], nullptr);
+      ASSERT_EQ(i < 96 ? 5 : 4, *(int64_t *)res[i]);
+    } else {
+      ASSERT_EQ(res[i], nullptr);
+    }
+  }
+
+  tSimpleHashCleanup(pHashObj);
+}
+
+TEST(testCase, tSimpleHashTest_perf) {
+  const int32_t        num = 1000000;
+  std::vector<int64_t> keyVals(num);
+  std::vector<const void *> keys(num);
+  std::vector<size_t>  keyLens(num, sizeof(int64_t));
+  std::vector<void *>  res(num);
+  for (int32_t i = 0; i < num; ++i) {
+    keyVals[i] = ((int64_t)taosRand() << 16) ^ i;
+    keys[i] = &keyVals[i];
+  }
+
+  SSHashObj *pHashObj = tSimpleHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT));
+  SHashObj  *pRef = taosHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), false, HASH_NO_LOCK);
+
+  int64_t st = taosGetTimestampUs();
+  for (int32_t i = 0; i < num; ++i) {
+    tSimpleHashPut(pHashObj, keys[i], sizeof(int64_t), &i, sizeof(int32_t));
+  }
+  int64_t et = taosGetTimestampUs();
+  for (int32_t i = 0; i < num; ++i) {
+    ASSERT_NE(tSimpleHashGet(pHashObj, keys[i], sizeof(int64_t)), nullptr);
+  }
+  int64_t et1 = taosGetTimestampUs();
+  ASSERT_EQ(0, tSimpleHashBatchGet(pHashObj, keys.data(), keyLens.data(), num, res.data()));
+  int64_t et2 = taosGetTimestampUs();
+  std::cout << "simple hash, put:" << (et - st) / 1000.0 << "ms, get:" << (et1 - et) / 1000.0
+            << "ms, batch get:" << (et2 - et1) / 1000.0 << "ms, mem:" << tSimpleHashGetMemSize(pHashObj) << std::endl;
+
+  st = taosGetTimestampUs();
+  for (int32_t i = 0; i < num; ++i) {
+    taosHashPut(pRef, keys[i], sizeof(int64_t), &i, sizeof(int32_t));
+  }
+  et = taosGetTimestampUs();
+  for (int32_t i = 0; i < num; ++i) {
+    ASSERT_NE(taosHashGet(pRef, keys[i], sizeof(int64_t)), nullptr);
+  }
+  et1 = taosGetTimestampUs();
+  std::cout << "hash, put:" << (et - st) / 1000.0 << "ms, get:" << (et1 - et) / 1000.0 << "ms" << std::endl;
+
+  tSimpleHashCleanup(pHashObj);
+  taosHashCleanup(pRef);
+}
+
 #pragma GCC diagnostic pop
\ No newline at end of file
@@ -42,6 +42,7 @@ typedef struct SBuiltinFuncDefinition {
   FExecFinalize              finalizeFunc;
   FExecProcess               invertFunc;
   FExecCombine               combineFunc;
+  FExecBatchProcess          batchProcessFunc;
   const char*                pPartialFunc;
   const char*                pMergeFunc;
   FCreateMergeFuncParameters createMergeParaFuc;
@@ -316,7 +316,8 @@ static int32_t translateInOutStr(SFunctionNode* pFunc, char* pErrBuf, int32_t le
     return invaildFuncParaTypeErrMsg(pErrBuf, len, pFunc->functionName);
   }
 
-  pFunc->node.resType = (SDataType){.bytes = pPara1->resType.bytes, .type = pPara1->resType.type};
+  pFunc->node.resType =
+      (SDataType){.bytes = pPara1->resType.bytes, .type = pPara1->resType.type, .scale = pPara1->resType.scale};
   return TSDB_CODE_SUCCESS;
 }
 
@@ -341,7 +342,7 @@ static int32_t translateTrimStr(SFunctionNode* pFunc, char* pErrBuf, int32_t len
   }
 
   int32_t resBytes = pPara1->resType.bytes - numOfSpaces;
-  pFunc->node.resType = (SDataType){.bytes = resBytes, .type = pPara1->resType.type};
+  pFunc->node.resType = (SDataType){.bytes = resBytes, .type = pPara1->resType.type, .scale = pPara1->resType.scale};
   return TSDB_CODE_SUCCESS;
 }
 
@@ -1834,7 +1835,8 @@ static int32_t translateSubstr(SFunctionNode* pFunc, char* pErrBuf, int32_t len)
     }
   }
 
-  pFunc->node.resType = (SDataType){.bytes = pPara0->resType.bytes, .type = pPara0->resType.type};
+  pFunc->node.resType =
+      (SDataType){.bytes = pPara0->resType.bytes, .type = pPara0->resType.type, .scale = pPara0->resType.scale};
   return TSDB_CODE_SUCCESS;
 }
 
@@ -2095,6 +2097,7 @@ const SBuiltinFuncDefinition funcMgtBuiltins[] = {
     .finalizeFunc = functionFinalize,
     .invertFunc   = countInvertFunction,
     .combineFunc  = combineFunction,
+    .batchProcessFunc = countBatchFunction,
     .pPartialFunc = "count",
     .pMergeFunc   = "sum"
   },
@@ -2111,6 +2114,7 @@ const SBuiltinFuncDefinition funcMgtBuiltins[] = {
     .finalizeFunc = functionFinalize,
     .invertFunc   = sumInvertFunction,
     .combineFunc  = sumCombine,
+    .batchProcessFunc = sumBatchFunction,
     .pPartialFunc = "sum",
     .pMergeFunc   = "sum"
   },
@@ -2126,6 +2130,7 @@ const SBuiltinFuncDefinition funcMgtBuiltins[] = {
     .sprocessFunc = minScalarFunction,
     .finalizeFunc = minmaxFunctionFinalize,
     .combineFunc  = minCombine,
+    .batchProcessFunc = minBatchFunction,
     .pPartialFunc = "min",
     .pMergeFunc   = "min"
   },
@@ -2141,6 +2146,7 @@ const SBuiltinFuncDefinition funcMgtBuiltins[] = {
     .sprocessFunc = maxScalarFunction,
     .finalizeFunc = minmaxFunctionFinalize,
     .combineFunc  = maxCombine,
+    .batchProcessFunc = maxBatchFunction,
     .pPartialFunc = "max",
     .pMergeFunc   = "max"
   },
@@ -2209,6 +2215,7 @@ const SBuiltinFuncDefinition funcMgtBuiltins[] = {
     .finalizeFunc = avgFinalize,
     .invertFunc   = avgInvertFunction,
     .combineFunc  = avgCombine,
+    .batchProcessFunc = avgBatchFunction,
     .pPartialFunc = "_avg_partial",
     .pMergeFunc   = "_avg_merge"
   },
@@ -2224,6 +2231,7 @@ const SBuiltinFuncDefinition funcMgtBuiltins[] = {
     .finalizeFunc = avgPartialFinalize,
     .invertFunc   = avgInvertFunction,
     .combineFunc  = avgCombine,
+    .batchProcessFunc = avgBatchFunction,
   },
   {
     .name = "_avg_merge",
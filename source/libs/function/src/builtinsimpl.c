@@ -497,6 +497,59 @@ int32_t functionFinalizeWithResultBuf(SqlFunctionCtx* pCtx, SSDataBlock* pBlock,
   return pResInfo->numOfRes;
 }
 
+// apply the single result version of function row by row, for the cases not covered by the batch kernels
+static int32_t doBatchProcessByRow(SqlFunctionCtx* pCtx, SResultRowEntryInfo** pResList, FExecProcess fp) {
+  SInputColumnInfoData* pInput = &pCtx->input;
+  int32_t               start = pInput->startRowIndex;
+  int32_t               numOfRows = pInput->numOfRows;
+  int32_t               code = TSDB_CODE_SUCCESS;
+
+  pInput->numOfRows = 1;
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    pCtx->resultInfo = pResList[i];
+    pInput->startRowIndex = start + i;
+    code = fp(pCtx);
+    if (code != TSDB_CODE_SUCCESS) {
+      break;
+    }
+  }
+
+  pInput->startRowIndex = start;
+  pInput->numOfRows = numOfRows;
+  return code;
+}
+
+#define LIST_ADD_BATCH(_resList, _col, _start, _rows, _t, _resType, _field) \
+  do {                                                                   \
+    _t* d = (_t*)((_col)->pData);                                        \
+    for (int32_t i = 0; i < (_rows); ++i) {                              \
+      _resType* _r = GET_ROWCELL_INTERBUF((_resList)[i]);                \
+      _r->type = type;                                                   \
+      if (((_col)->hasNull) && colDataIsNull_f((_col)->nullbitmap, (_start) + i)) { \
+        continue;                                                        \
+      }                                                                  \
+      _r->_field += d[(_start) + i];                                     \
+      (_resList)[i]->numOfRes = 1;                                       \
+    }                                                                    \
+  } while (0)
+
+// the same as above for the float sum, the overflowed sum is not a valid result
+#define LIST_ADD_BATCH_F(_resList, _col, _start, _rows, _t)                          \
+  do {                                                                              \
+    _t* d = (_t*)((_col)->pData);                                                   \
+    for (int32_t i = 0; i < (_rows); ++i) {                                         \
+      SSumRes* _r = GET_ROWCELL_INTERBUF((_resList)[i]);                            \
+      _r->type = type;                                                              \
+      if (((_col)->hasNull) && colDataIsNull_f((_col)->nullbitmap, (_start) + i)) { \
+        continue;                                                                   \
+      }                                                                             \
+      _r->dsum += d[(_start) + i];                                                  \
+      if (!isinf(_r->dsum) && !isnan(_r->dsum)) {                                   \
+        (_resList)[i]->numOfRes = 1;                                                \
+      }                                                                             \
+    }                                                                               \
+  } while (0)
+
 EFuncDataRequired countDataRequired(SFunctionNode* pFunc, STimeWindow* pTimeWindow) {
   SNode* pParam = nodesListGetNode(pFunc->pParameterList, 0);
   if (QUERY_NODE_COLUMN == nodeType(pParam) && PRIMARYKEY_TIMESTAMP_COL_ID == ((SColumnNode*)pParam)->colId) {
@@ -581,6 +634,31 @@ int32_t countInvertFunction(SqlFunctionCtx* pCtx) {
   return TSDB_CODE_SUCCESS;
 }
 
+int32_t countBatchFunction(SqlFunctionCtx* pCtx, SResultRowEntryInfo** pResList) {
+  SInputColumnInfoData* pInput = &pCtx->input;
+  SColumnInfoData*      pInputCol = pInput->pData[0];
+  int32_t               start = pInput->startRowIndex;
+
+  if (IS_NULL_TYPE(pInputCol->info.type)) {
+    return doBatchProcessByRow(pCtx, pResList, countFunction);
+  }
+
+  for (int32_t i = 0; i < pInput->numOfRows; ++i) {
+    SResultRowEntryInfo* pResInfo = pResList[i];
+    if (pInputCol->hasNull && colDataIsNull(pInputCol, pInput->totalRows, start + i, NULL)) {
+      if (tsCountAlwaysReturnValue) {
+        pResInfo->numOfRes = 1;
+      }
+      continue;
+    }
+
+    *(int64_t*)GET_ROWCELL_INTERBUF(pResInfo) += 1;
+    pResInfo->numOfRes = 1;
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t combineFunction(SqlFunctionCtx* pDestCtx, SqlFunctionCtx* pSourceCtx) {
   SResultRowEntryInfo* pDResInfo = GET_RES_INFO(pDestCtx);
   char*                pDBuf = GET_ROWCELL_INTERBUF(pDResInfo);
@@ -589,7 +667,8 @@ int32_t combineFunction(SqlFunctionCtx* pDestCtx, SqlFunctionCtx* pSourceCtx) {
   char*                pSBuf = GET_ROWCELL_INTERBUF(pSResInfo);
   *((int64_t*)pDBuf) += *((int64_t*)pSBuf);
 
-  SET_VAL(pDResInfo, *((int64_t*)pDBuf), 1);
+  // the count result of source may be generated in case of tsCountAlwaysReturnValue
+  pDResInfo->numOfRes = TMAX(pDResInfo->numOfRes, pSResInfo->numOfRes);
   return TSDB_CODE_SUCCESS;
 }
 
@@ -723,6 +802,52 @@ int32_t sumInvertFunction(SqlFunctionCtx* pCtx) {
   return TSDB_CODE_SUCCESS;
 }
 
+int32_t sumBatchFunction(SqlFunctionCtx* pCtx, SResultRowEntryInfo** pResList) {
+  SInputColumnInfoData* pInput = &pCtx->input;
+  SColumnInfoData*      pCol = pInput->pData[0];
+  int32_t               type = pCol->info.type;
+  int32_t               start = pInput->startRowIndex;
+  int32_t               numOfRows = pInput->numOfRows;
+
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      LIST_ADD_BATCH(pResList, pCol, start, numOfRows, int8_t, SSumRes, isum);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      LIST_ADD_BATCH(pResList, pCol, start, numOfRows, int16_t, SSumRes, isum);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      LIST_ADD_BATCH(pResList, pCol, start, numOfRows, int32_t, SSumRes, isum);
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+      LIST_ADD_BATCH(pResList, pCol, start, numOfRows, int64_t, SSumRes, isum);
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      LIST_ADD_BATCH(pResList, pCol, start, numOfRows, uint8_t, SSumRes, usum);
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      LIST_ADD_BATCH(pResList, pCol, start, numOfRows, uint16_t, SSumRes, usum);
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      LIST_ADD_BATCH(pResList, pCol, start, numOfRows, uint32_t, SSumRes, usum);
+      break;
+    case TSDB_DATA_TYPE_UBIGINT:
+      LIST_ADD_BATCH(pResList, pCol, start, numOfRows, uint64_t, SSumRes, usum);
+      break;
+    case TSDB_DATA_TYPE_FLOAT:
+      LIST_ADD_BATCH_F(pResList, pCol, start, numOfRows, float);
+      break;
+    case TSDB_DATA_TYPE_DOUBLE:
+      LIST_ADD_BATCH_F(pResList, pCol, start, numOfRows, double);
+      break;
+    default:
+      return doBatchProcessByRow(pCtx, pResList, sumFunction);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t sumCombine(SqlFunctionCtx* pDestCtx, SqlFunctionCtx* pSourceCtx) {
   SResultRowEntryInfo* pDResInfo = GET_RES_INFO(pDestCtx);
   SSumRes*             pDBuf = GET_ROWCELL_INTERBUF(pDResInfo);
@@ -992,6 +1117,66 @@ int32_t avgFunctionMerge(SqlFunctionCtx* pCtx) {
   return TSDB_CODE_SUCCESS;
 }
 
+#define LIST_AVG_BATCH(_resList, _col, _start, _rows, _t, _field)                    \
+  do {                                                                              \
+    _t* d = (_t*)((_col)->pData);                                                   \
+    for (int32_t i = 0; i < (_rows); ++i) {                                         \
+      SAvgRes* _r = GET_ROWCELL_INTERBUF((_resList)[i]);                            \
+      _r->type = type;                                                              \
+      if (((_col)->hasNull) && colDataIsNull_f((_col)->nullbitmap, (_start) + i)) { \
+        continue;                                                                   \
+      }                                                                             \
+      _r->count += 1;                                                               \
+      _r->sum._field += d[(_start) + i];                                            \
+      (_resList)[i]->numOfRes = 1;                                                  \
+    }                                                                               \
+  } while (0)
+
+int32_t avgBatchFunction(SqlFunctionCtx* pCtx, SResultRowEntryInfo** pResList) {
+  SInputColumnInfoData* pInput = &pCtx->input;
+  SColumnInfoData*      pCol = pInput->pData[0];
+  int32_t               type = pCol->info.type;
+  int32_t               start = pInput->startRowIndex;
+  int32_t               numOfRows = pInput->numOfRows;
+
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      LIST_AVG_BATCH(pResList, pCol, start, numOfRows, int8_t, isum);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      LIST_AVG_BATCH(pResList, pCol, start, numOfRows, int16_t, isum);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      LIST_AVG_BATCH(pResList, pCol, start, numOfRows, int32_t, isum);
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+      LIST_AVG_BATCH(pResList, pCol, start, numOfRows, int64_t, isum);
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      LIST_AVG_BATCH(pResList, pCol, start, numOfRows, uint8_t, usum);
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      LIST_AVG_BATCH(pResList, pCol, start, numOfRows, uint16_t, usum);
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      LIST_AVG_BATCH(pResList, pCol, start, numOfRows, uint32_t, usum);
+      break;
+    case TSDB_DATA_TYPE_UBIGINT:
+      LIST_AVG_BATCH(pResList, pCol, start, numOfRows, uint64_t, usum);
+      break;
+    case TSDB_DATA_TYPE_FLOAT:
+      LIST_AVG_BATCH(pResList, pCol, start, numOfRows, float, dsum);
+      break;
+    case TSDB_DATA_TYPE_DOUBLE:
+      LIST_AVG_BATCH(pResList, pCol, start, numOfRows, double, dsum);
+      break;
+    default:
+      return doBatchProcessByRow(pCtx, pResList, avgFunction);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t avgInvertFunction(SqlFunctionCtx* pCtx) {
   int32_t numOfElem = 0;
 
@@ -1073,7 +1258,9 @@ int32_t avgCombine(SqlFunctionCtx* pDestCtx, SqlFunctionCtx* pSourceCtx) {
     pDBuf->sum.dsum += pSBuf->sum.dsum;
   }
   pDBuf->count += pSBuf->count;
+  pDBuf->type = type;
 
+  pDResInfo->numOfRes = TMAX(pDResInfo->numOfRes, pSResInfo->numOfRes);
   return TSDB_CODE_SUCCESS;
 }
 
@@ -1683,6 +1870,86 @@ int32_t maxFunction(SqlFunctionCtx* pCtx) {
   return TSDB_CODE_SUCCESS;
 }
 
+#define LIST_MINMAX_BATCH(_resList, _col, _start, _rows, _t, _isMin)                \
+  do {                                                                              \
+    _t* d = (_t*)((_col)->pData);                                                   \
+    for (int32_t i = 0; i < (_rows); ++i) {                                         \
+      SMinmaxResInfo* _r = GET_ROWCELL_INTERBUF((_resList)[i]);                     \
+      _t*             _v = (_t*)&_r->v;                                             \
+      _r->type = type;                                                              \
+      if (((_col)->hasNull) && colDataIsNull_f((_col)->nullbitmap, (_start) + i)) { \
+        continue;                                                                   \
+      }                                                                             \
+      _t _d = d[(_start) + i];                                                      \
+      if (!_r->assign) {                                                            \
+        *_v = _d;                                                                   \
+        _r->assign = true;                                                          \
+      } else if ((_isMin) ? (*_v > _d) : (*_v < _d)) {                              \
+        *_v = _d;                                                                   \
+      }                                                                             \
+      (_resList)[i]->numOfRes = 1;                                                  \
+    }                                                                               \
+  } while (0)
+
+static int32_t doMinMaxBatchHelper(SqlFunctionCtx* pCtx, SResultRowEntryInfo** pResList, int32_t isMinFunc) {
+  SInputColumnInfoData* pInput = &pCtx->input;
+  SColumnInfoData*      pCol = pInput->pData[0];
+  int32_t               type = pCol->info.type;
+  int32_t               start = pInput->startRowIndex;
+  int32_t               numOfRows = pInput->numOfRows;
+
+  // the selectivity tuples are saved row by row
+  if (pCtx->subsidiaries.num > 0) {
+    return doBatchProcessByRow(pCtx, pResList, isMinFunc ? minFunction : maxFunction);
+  }
+
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      LIST_MINMAX_BATCH(pResList, pCol, start, numOfRows, int8_t, isMinFunc);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      LIST_MINMAX_BATCH(pResList, pCol, start, numOfRows, int16_t, isMinFunc);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      LIST_MINMAX_BATCH(pResList, pCol, start, numOfRows, int32_t, isMinFunc);
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+      LIST_MINMAX_BATCH(pResList, pCol, start, numOfRows, int64_t, isMinFunc);
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      LIST_MINMAX_BATCH(pResList, pCol, start, numOfRows, uint8_t, isMinFunc);
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      LIST_MINMAX_BATCH(pResList, pCol, start, numOfRows, uint16_t, isMinFunc);
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      LIST_MINMAX_BATCH(pResList, pCol, start, numOfRows, uint32_t, isMinFunc);
+      break;
+    case TSDB_DATA_TYPE_UBIGINT:
+      LIST_MINMAX_BATCH(pResList, pCol, start, numOfRows, uint64_t, isMinFunc);
+      break;
+    case TSDB_DATA_TYPE_FLOAT:
+      LIST_MINMAX_BATCH(pResList, pCol, start, numOfRows, float, isMinFunc);
+      break;
+    case TSDB_DATA_TYPE_DOUBLE:
+      LIST_MINMAX_BATCH(pResList, pCol, start, numOfRows, double, isMinFunc);
+      break;
+    default:
+      return doBatchProcessByRow(pCtx, pResList, isMinFunc ? minFunction : maxFunction);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t minBatchFunction(SqlFunctionCtx* pCtx, SResultRowEntryInfo** pResList) {
+  return doMinMaxBatchHelper(pCtx, pResList, 1);
+}
+
+int32_t maxBatchFunction(SqlFunctionCtx* pCtx, SResultRowEntryInfo** pResList) {
+  return doMinMaxBatchHelper(pCtx, pResList, 0);
+}
+
 static void setNullSelectivityValue(SqlFunctionCtx* pCtx, SSDataBlock* pBlock, int32_t rowIndex);
 static void setSelectivityValue(SqlFunctionCtx* pCtx, SSDataBlock* pBlock, const STuplePos* pTuplePos,
                                 int32_t rowIndex);
@@ -1803,6 +2070,35 @@ void replaceTupleData(STuplePos* pDestPos, STuplePos* pSourcePos) {
   *pDestPos = *pSourcePos;
 }
 
+// compare the values kept in SMinmaxResInfo, which are saved in the low bytes of int64_t with the original type
+static int32_t minMaxCompareVal(int16_t type, const int64_t* p1, const int64_t* p2) {
+#define MINMAX_COMPARE(_t) ((*(_t*)p1 < *(_t*)p2) ? -1 : ((*(_t*)p1 > *(_t*)p2) ? 1 : 0))
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      return MINMAX_COMPARE(int8_t);
+    case TSDB_DATA_TYPE_SMALLINT:
+      return MINMAX_COMPARE(int16_t);
+    case TSDB_DATA_TYPE_INT:
+      return MINMAX_COMPARE(int32_t);
+    case TSDB_DATA_TYPE_UTINYINT:
+      return MINMAX_COMPARE(uint8_t);
+    case TSDB_DATA_TYPE_USMALLINT:
+      return MINMAX_COMPARE(uint16_t);
+    case TSDB_DATA_TYPE_UINT:
+      return MINMAX_COMPARE(uint32_t);
+    case TSDB_DATA_TYPE_UBIGINT:
+      return MINMAX_COMPARE(uint64_t);
+    case TSDB_DATA_TYPE_FLOAT:
+      return MINMAX_COMPARE(float);
+    case TSDB_DATA_TYPE_DOUBLE:
+      return MINMAX_COMPARE(double);
+    default:
+      return MINMAX_COMPARE(int64_t);
+  }
+#undef MINMAX_COMPARE
+}
+
 int32_t minMaxCombine(SqlFunctionCtx* pDestCtx, SqlFunctionCtx* pSourceCtx, int32_t isMinFunc) {
   SResultRowEntryInfo* pDResInfo = GET_RES_INFO(pDestCtx);
   SMinmaxResInfo*      pDBuf = GET_ROWCELL_INTERBUF(pDResInfo);
@@ -1810,19 +2106,15 @@ int32_t minMaxCombine(SqlFunctionCtx* pDestCtx, SqlFunctionCtx* pSourceCtx, int3
   SResultRowEntryInfo* pSResInfo = GET_RES_INFO(pSourceCtx);
   SMinmaxResInfo*      pSBuf = GET_ROWCELL_INTERBUF(pSResInfo);
   int16_t              type = pDBuf->type == TSDB_DATA_TYPE_NULL ? pSBuf->type : pDBuf->type;
-  if (IS_FLOAT_TYPE(type)) {
-    if (pSBuf->assign && ((((*(double*)&pDBuf->v) < (*(double*)&pSBuf->v)) ^ isMinFunc) || !pDBuf->assign)) {
-      *(double*)&pDBuf->v = *(double*)&pSBuf->v;
-      replaceTupleData(&pDBuf->tuplePos, &pSBuf->tuplePos);
-      pDBuf->assign = true;
-    }
-  } else {
-    if (pSBuf->assign && (((pDBuf->v < pSBuf->v) ^ isMinFunc) || !pDBuf->assign)) {
+  if (pSBuf->assign) {
+    int32_t ret = minMaxCompareVal(type, &pDBuf->v, &pSBuf->v);
+    if (!pDBuf->assign || (isMinFunc ? ret > 0 : ret < 0)) {
       pDBuf->v = pSBuf->v;
       replaceTupleData(&pDBuf->tuplePos, &pSBuf->tuplePos);
       pDBuf->assign = true;
     }
   }
+  pDBuf->type = type;
   pDResInfo->numOfRes = TMAX(pDResInfo->numOfRes, pSResInfo->numOfRes);
   pDResInfo->isNullRes &= pSResInfo->isNullRes;
   return TSDB_CODE_SUCCESS;
@@ -37,6 +37,24 @@
     pSql += (token).n;                          \
   } while (TK_NK_SPACE == (token).type)
 
+#define INS_TEMPLATE_KEEP_TIME_MS 60000
+#define INS_TEMPLATE_MAX_NUM      1024
+#define INS_TEMPLATE_MAX_COLS_LEN 1024
+#define INS_TEMPLATE_KEY_LEN      (TSDB_TABLE_FNAME_LEN + INS_TEMPLATE_MAX_COLS_LEN)
+#define INS_TEMPLATE_META_OFFSET  ALIGN8(sizeof(SInsertTemplate))
+
+// The resolved schema clause of a table, i.e. the table meta, the vgroup and the bound columns, is kept in the
+// insert cache of the connection. The key is the full table name and the text of the column list, so a statement
+// repeating the clause skips the catalog and the column names. A template is a flat copy read with
+// taosHashGetDup_m, another thread may clear the cache meanwhile:
+//   SInsertTemplate | STableMeta | boundColumns | cols | colIdxInfo
+typedef struct SInsertTemplate {
+  int64_t            createTs;
+  SVgroupInfo        vg;
+  int32_t            metaSize;
+  SParsedDataColInfo boundColumnInfo;  // numOfCols is 0 without a column list, the pointers are not used
+} SInsertTemplate;
+
 typedef struct SInsertParseContext {
   SParseContext*     pComCxt;
   SMsgBuf            msg;
@@ -44,6 +62,11 @@ typedef struct SInsertParseContext {
   SParsedDataColInfo tags;  // for stmt
   bool               missCache;
   bool               usingDuplicateTable;
+  bool               hitTemplate;     // the schema clause of the current table is from pTemplate
+  SInsertTemplate*   pTemplate;       // buffer reused by the table clauses
+  int32_t            templateSize;
+  SMemParam*         pColParams;      // the append info of each bound column, see initColAppendParams
+  int32_t            numOfColParams;
 } SInsertParseContext;
 
 typedef int32_t (*_row_append_fn_t)(SMsgBuf* pMsgBuf, const void* value, int32_t len, void* param);
@@ -72,6 +95,43 @@ static FORCE_INLINE int32_t toDouble(SToken* pToken, double* value, char** endPt
   return pToken->type;
 }
 
+// the plain decimal integers, most of the values written, are converted without strtoll
+static FORCE_INLINE int32_t toIntegerFast(const char* z, int32_t n, int64_t* value) {
+  int32_t i = (n > 0 && ('-' == z[0] || '+' == z[0])) ? 1 : 0;
+  if (n - i < 1 || n - i > 18) {
+    return toInteger(z, n, 10, value);
+  }
+
+  int64_t v = 0;
+  for (int32_t k = i; k < n; ++k) {
+    uint8_t d = (uint8_t)(z[k] - '0');
+    if (d > 9) {
+      return toInteger(z, n, 10, value);
+    }
+    v = v * 10 + d;
+  }
+  *value = ('-' == z[0]) ? -v : v;
+  return TSDB_CODE_SUCCESS;
+}
+
+static FORCE_INLINE int32_t toUIntegerFast(const char* z, int32_t n, uint64_t* value) {
+  int32_t i = (n > 0 && '+' == z[0]) ? 1 : 0;
+  if (n - i < 1 || n - i > 18) {
+    return toUInteger(z, n, 10, value);
+  }
+
+  uint64_t v = 0;
+  for (int32_t k = i; k < n; ++k) {
+    uint8_t d = (uint8_t)(z[k] - '0');
+    if (d > 9) {
+      return toUInteger(z, n, 10, value);
+    }
+    v = v * 10 + d;
+  }
+  *value = v;
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t skipInsertInto(const char** pSql, SMsgBuf* pMsg) {
   SToken token;
   NEXT_TOKEN(*pSql, token);
@@ -269,7 +329,7 @@ static int parseTime(const char** end, SToken* pToken, int16_t timePrec, int64_t
   } else if (pToken->type == TK_TODAY) {
     ts = taosGetTimestampToday(timePrec);
   } else if (pToken->type == TK_NK_INTEGER) {
-    if (TSDB_CODE_SUCCESS != toInteger(pToken->z, pToken->n, 10, &ts)) {
+    if (TSDB_CODE_SUCCESS != toIntegerFast(pToken->z, pToken->n, &ts)) {
       return buildSyntaxErrMsg(pMsgBuf, "invalid timestamp format", pToken->z);
     }
   } else {  // parse the RFC-3339/ISO-8601 timestamp format string
@@ -828,7 +888,154 @@ static int32_t getTableVgroup(SParseContext* pCxt, SVnodeModifOpStmt* pStmt, boo
   return code;
 }
 
+static bool canUseInsertTemplate(SInsertParseContext* pCxt, SVnodeModifOpStmt* pStmt) {
+  return NULL != pCxt->pComCxt->pInsertCache && NULL == pCxt->pComCxt->pStmtCb && !pStmt->usingTableProcessing;
+}
+
+// the '\0' of the table name separates it from the column list
+static int32_t buildInsertTemplateKey(SVnodeModifOpStmt* pStmt, const char* pBoundCols, int32_t boundColsLen,
+                                      char* pKey) {
+  if (boundColsLen > INS_TEMPLATE_MAX_COLS_LEN) {
+    return -1;
+  }
+  if (tNameExtractFullName(&pStmt->targetTableName, pKey) < 0) {
+    return -1;
+  }
+  int32_t len = strlen(pKey) + 1;
+  if (boundColsLen > 0) {
+    memcpy(pKey + len, pBoundCols, boundColsLen);
+  }
+  return len + boundColsLen;
+}
+
+// input pStmt->pBoundCols: field1_name, ...)
+// input pStmt->pSql: after the column list
+static bool getInsertTemplate(SInsertParseContext* pCxt, SVnodeModifOpStmt* pStmt) {
+  if (!canUseInsertTemplate(pCxt, pStmt)) {
+    return false;
+  }
+
+  char    key[INS_TEMPLATE_KEY_LEN];
+  int32_t boundColsLen = (NULL == pStmt->pBoundCols ? 0 : (int32_t)(pStmt->pSql - pStmt->pBoundCols));
+  int32_t keyLen = buildInsertTemplateKey(pStmt, pStmt->pBoundCols, boundColsLen, key);
+  if (keyLen < 0) {
+    return false;
+  }
+
+  // the copy is left untouched if the key is not found
+  if (NULL != pCxt->pTemplate) {
+    pCxt->pTemplate->createTs = 0;
+  }
+  if (TSDB_CODE_SUCCESS != taosHashGetDup_m(pCxt->pComCxt->pInsertCache, key, keyLen, (void**)&pCxt->pTemplate,
+                                            &pCxt->templateSize) ||
+      NULL == pCxt->pTemplate || 0 == pCxt->pTemplate->createTs) {
+    return false;
+  }
+
+  if (taosGetTimestampMs() - pCxt->pTemplate->createTs > INS_TEMPLATE_KEEP_TIME_MS) {
+    taosHashRemove(pCxt->pComCxt->pInsertCache, key, keyLen);
+    return false;
+  }
+
+  pCxt->hitTemplate = true;
+  return true;
+}
+
+static void saveInsertTemplate(SInsertParseContext* pCxt, SVnodeModifOpStmt* pStmt, const char* pBoundCols,
+                               STableDataBlocks* pDataBuf) {
+  if (pCxt->hitTemplate || !canUseInsertTemplate(pCxt, pStmt)) {
+    return;
+  }
+
+  char         key[INS_TEMPLATE_KEY_LEN];
+  int32_t      boundColsLen = (NULL == pBoundCols ? 0 : (int32_t)(pStmt->pBoundCols - pBoundCols));
+  int32_t      keyLen = buildInsertTemplateKey(pStmt, pBoundCols, boundColsLen, key);
+  int32_t      vgId = pStmt->pTableMeta->vgId;
+  SVgroupInfo* pVg = taosHashGet(pStmt->pVgroupsHashObj, &vgId, sizeof(vgId));
+  if (keyLen < 0 || NULL == pVg) {
+    return;
+  }
+
+  SParsedDataColInfo* pCols = &pDataBuf->boundColumnInfo;
+  col_id_t            numOfCols = (NULL == pBoundCols ? 0 : pCols->numOfCols);
+  int32_t numOfIdx = (numOfCols > 0 && ORDER_STATUS_DISORDERED == pCols->orderStatus) ? pCols->numOfBound : 0;
+  int32_t metaSize = sizeof(STableMeta) + TABLE_TOTAL_COL_NUM(pStmt->pTableMeta) * sizeof(SSchema);
+  int32_t size = INS_TEMPLATE_META_OFFSET + metaSize + numOfCols * (sizeof(col_id_t) + sizeof(SBoundColumn)) +
+                 numOfIdx * sizeof(SBoundIdxInfo);
+
+  SInsertTemplate* pTemplate = taosMemoryCalloc(1, size);
+  if (NULL == pTemplate) {
+    return;
+  }
+
+  pTemplate->createTs = taosGetTimestampMs();
+  pTemplate->vg = *pVg;
+  pTemplate->metaSize = metaSize;
+  char* p = POINTER_SHIFT(pTemplate, INS_TEMPLATE_META_OFFSET);
+  memcpy(p, pStmt->pTableMeta, metaSize);
+  p += metaSize;
+  if (numOfCols > 0) {
+    pTemplate->boundColumnInfo = *pCols;
+    memcpy(p, pCols->boundColumns, numOfCols * sizeof(col_id_t));
+    p += numOfCols * sizeof(col_id_t);
+    memcpy(p, pCols->cols, numOfCols * sizeof(SBoundColumn));
+    p += numOfCols * sizeof(SBoundColumn);
+    if (numOfIdx > 0) {
+      memcpy(p, pCols->colIdxInfo, numOfIdx * sizeof(SBoundIdxInfo));
+    }
+  }
+
+  SHashObj* pCache = pCxt->pComCxt->pInsertCache;
+  if (taosHashGetSize(pCache) >= INS_TEMPLATE_MAX_NUM) {
+    taosHashClear(pCache);
+  }
+  taosHashPut(pCache, key, keyLen, pTemplate, size);
+  taosMemoryFree(pTemplate);
+}
+
+static int32_t getTargetTableSchemaFromTemplate(SInsertParseContext* pCxt, SVnodeModifOpStmt* pStmt) {
+  SInsertTemplate* pTemplate = pCxt->pTemplate;
+  int32_t          code = checkAuth(pCxt->pComCxt, &pStmt->targetTableName, &pCxt->missCache);
+  if (TSDB_CODE_SUCCESS == code && !pCxt->missCache) {
+    pStmt->pTableMeta = taosMemoryMalloc(pTemplate->metaSize);
+    if (NULL == pStmt->pTableMeta) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    memcpy(pStmt->pTableMeta, POINTER_SHIFT(pTemplate, INS_TEMPLATE_META_OFFSET), pTemplate->metaSize);
+    code = taosHashPut(pStmt->pVgroupsHashObj, (const char*)&pTemplate->vg.vgId, sizeof(pTemplate->vg.vgId),
+                       (char*)&pTemplate->vg, sizeof(pTemplate->vg));
+  }
+  return code;
+}
+
+static int32_t setBoundColumnsFromTemplate(SInsertParseContext* pCxt, SParsedDataColInfo* pCols) {
+  SInsertTemplate*          pTemplate = pCxt->pTemplate;
+  const SParsedDataColInfo* pTmplCols = &pTemplate->boundColumnInfo;
+  col_id_t                  numOfCols = pTmplCols->numOfCols;
+  const char*               p = POINTER_SHIFT(pTemplate, INS_TEMPLATE_META_OFFSET + pTemplate->metaSize);
+
+  taosMemoryFreeClear(pCols->colIdxInfo);
+  if (ORDER_STATUS_DISORDERED == pTmplCols->orderStatus) {
+    pCols->colIdxInfo = taosMemoryMalloc(pTmplCols->numOfBound * sizeof(SBoundIdxInfo));
+    if (NULL == pCols->colIdxInfo) {
+      return TSDB_CODE_TSC_OUT_OF_MEMORY;
+    }
+    memcpy(pCols->colIdxInfo, p + numOfCols * (sizeof(col_id_t) + sizeof(SBoundColumn)),
+           pTmplCols->numOfBound * sizeof(SBoundIdxInfo));
+  }
+  memcpy(pCols->boundColumns, p, numOfCols * sizeof(col_id_t));
+  memcpy(pCols->cols, p + numOfCols * sizeof(col_id_t), numOfCols * sizeof(SBoundColumn));
+  pCols->numOfBound = pTmplCols->numOfBound;
+  pCols->boundNullLen = pTmplCols->boundNullLen;
+  pCols->orderStatus = pTmplCols->orderStatus;
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t getTargetTableSchema(SInsertParseContext* pCxt, SVnodeModifOpStmt* pStmt) {
+  if (getInsertTemplate(pCxt, pStmt)) {
+    return getTargetTableSchemaFromTemplate(pCxt, pStmt);
+  }
+
   int32_t code = checkAuth(pCxt->pComCxt, &pStmt->targetTableName, &pCxt->missCache);
   if (TSDB_CODE_SUCCESS == code && !pCxt->missCache) {
     code = getTableMeta(pCxt, &pStmt->targetTableName, false, &pStmt->pTableMeta, &pCxt->missCache);
@@ -946,6 +1153,9 @@ static int32_t parseBoundColumnsClause(SInsertParseContext* pCxt, SVnodeModifOpS
   }
 
   if (NULL != pStmt->pBoundCols) {
+    if (pCxt->hitTemplate && pCxt->pTemplate->boundColumnInfo.numOfCols == pDataBuf->boundColumnInfo.numOfCols) {
+      return setBoundColumnsFromTemplate(pCxt, &pDataBuf->boundColumnInfo);
+    }
     return parseBoundColumns(pCxt, &pStmt->pBoundCols, false, &pDataBuf->boundColumnInfo,
                              getTableColumnSchema(pStmt->pTableMeta));
   }
@@ -959,13 +1169,17 @@ static int32_t parseBoundColumnsClause(SInsertParseContext* pCxt, SVnodeModifOpS
 // output pStmt->pSql: VALUES ... | FILE ...
 static int32_t parseSchemaClauseBottom(SInsertParseContext* pCxt, SVnodeModifOpStmt* pStmt,
                                        STableDataBlocks** pDataBuf) {
-  int32_t code = parseUsingClauseBottom(pCxt, pStmt);
+  const char* pBoundCols = pStmt->pBoundCols;
+  int32_t     code = parseUsingClauseBottom(pCxt, pStmt);
   if (TSDB_CODE_SUCCESS == code) {
     code = getTableDataBlocks(pCxt, pStmt, pDataBuf);
   }
   if (TSDB_CODE_SUCCESS == code) {
     code = parseBoundColumnsClause(pCxt, pStmt, *pDataBuf);
   }
+  if (TSDB_CODE_SUCCESS == code) {
+    saveInsertTemplate(pCxt, pStmt, pBoundCols, *pDataBuf);
+  }
   return code;
 }
 
@@ -1014,7 +1228,7 @@ static int32_t parseValueTokenImpl(SInsertParseContext* pCxt, const char** pSql,
     }
 
     case TSDB_DATA_TYPE_TINYINT: {
-      if (TSDB_CODE_SUCCESS != toInteger(pToken->z, pToken->n, 10, &iv)) {
+      if (TSDB_CODE_SUCCESS != toIntegerFast(pToken->z, pToken->n, &iv)) {
         return buildSyntaxErrMsg(&pCxt->msg, "invalid tinyint data", pToken->z);
       } else if (!IS_VALID_TINYINT(iv)) {
         return buildSyntaxErrMsg(&pCxt->msg, "tinyint data overflow", pToken->z);
@@ -1025,7 +1239,7 @@ static int32_t parseValueTokenImpl(SInsertParseContext* pCxt, const char** pSql,
     }
 
     case TSDB_DATA_TYPE_UTINYINT: {
-      if (TSDB_CODE_SUCCESS != toUInteger(pToken->z, pToken->n, 10, &uv)) {
+      if (TSDB_CODE_SUCCESS != toUIntegerFast(pToken->z, pToken->n, &uv)) {
         return buildSyntaxErrMsg(&pCxt->msg, "invalid unsigned tinyint data", pToken->z);
       } else if (uv > UINT8_MAX) {
         return buildSyntaxErrMsg(&pCxt->msg, "unsigned tinyint data overflow", pToken->z);
@@ -1035,7 +1249,7 @@ static int32_t parseValueTokenImpl(SInsertParseContext* pCxt, const char** pSql,
     }
 
     case TSDB_DATA_TYPE_SMALLINT: {
-      if (TSDB_CODE_SUCCESS != toInteger(pToken->z, pToken->n, 10, &iv)) {
+      if (TSDB_CODE_SUCCESS != toIntegerFast(pToken->z, pToken->n, &iv)) {
         return buildSyntaxErrMsg(&pCxt->msg, "invalid smallint data", pToken->z);
       } else if (!IS_VALID_SMALLINT(iv)) {
         return buildSyntaxErrMsg(&pCxt->msg, "smallint data overflow", pToken->z);
@@ -1045,7 +1259,7 @@ static int32_t parseValueTokenImpl(SInsertParseContext* pCxt, const char** pSql,
     }
 
     case TSDB_DATA_TYPE_USMALLINT: {
-      if (TSDB_CODE_SUCCESS != toUInteger(pToken->z, pToken->n, 10, &uv)) {
+      if (TSDB_CODE_SUCCESS != toUIntegerFast(pToken->z, pToken->n, &uv)) {
         return buildSyntaxErrMsg(&pCxt->msg, "invalid unsigned smallint data", pToken->z);
       } else if (uv > UINT16_MAX) {
         return buildSyntaxErrMsg(&pCxt->msg, "unsigned smallint data overflow", pToken->z);
@@ -1055,7 +1269,7 @@ static int32_t parseValueTokenImpl(SInsertParseContext* pCxt, const char** pSql,
     }
 
     case TSDB_DATA_TYPE_INT: {
-      if (TSDB_CODE_SUCCESS != toInteger(pToken->z, pToken->n, 10, &iv)) {
+      if (TSDB_CODE_SUCCESS != toIntegerFast(pToken->z, pToken->n, &iv)) {
         return buildSyntaxErrMsg(&pCxt->msg, "invalid int data", pToken->z);
       } else if (!IS_VALID_INT(iv)) {
         return buildSyntaxErrMsg(&pCxt->msg, "int data overflow", pToken->z);
@@ -1065,7 +1279,7 @@ static int32_t parseValueTokenImpl(SInsertParseContext* pCxt, const char** pSql,
     }
 
     case TSDB_DATA_TYPE_UINT: {
-      if (TSDB_CODE_SUCCESS != toUInteger(pToken->z, pToken->n, 10, &uv)) {
+      if (TSDB_CODE_SUCCESS != toUIntegerFast(pToken->z, pToken->n, &uv)) {
         return buildSyntaxErrMsg(&pCxt->msg, "invalid unsigned int data", pToken->z);
       } else if (uv > UINT32_MAX) {
         return buildSyntaxErrMsg(&pCxt->msg, "unsigned int data overflow", pToken->z);
@@ -1075,14 +1289,14 @@ static int32_t parseValueTokenImpl(SInsertParseContext* pCxt, const char** pSql,
     }
 
     case TSDB_DATA_TYPE_BIGINT: {
-      if (TSDB_CODE_SUCCESS != toInteger(pToken->z, pToken->n, 10, &iv)) {
+      if (TSDB_CODE_SUCCESS != toIntegerFast(pToken->z, pToken->n, &iv)) {
         return buildSyntaxErrMsg(&pCxt->msg, "invalid bigint data", pToken->z);
       }
       return func(&pCxt->msg, &iv, pSchema->bytes, param);
     }
 
     case TSDB_DATA_TYPE_UBIGINT: {
-      if (TSDB_CODE_SUCCESS != toUInteger(pToken->z, pToken->n, 10, &uv)) {
+      if (TSDB_CODE_SUCCESS != toUIntegerFast(pToken->z, pToken->n, &uv)) {
         return buildSyntaxErrMsg(&pCxt->msg, "invalid unsigned bigint data", pToken->z);
       }
       return func(&pCxt->msg, &uv, pSchema->bytes, param);
@@ -1165,20 +1379,42 @@ static int32_t parseValueToken(SInsertParseContext* pCxt, const char** pSql, STo
   return code;
 }
 
+// the append info of the bound columns is the same for all the rows of a table clause, it is found once
+static int32_t initColAppendParams(SInsertParseContext* pCxt, STableDataBlocks* pDataBuf) {
+  SParsedDataColInfo* pCols = &pDataBuf->boundColumnInfo;
+  if (pCols->numOfBound > pCxt->numOfColParams) {
+    SMemParam* pParams = taosMemoryRealloc(pCxt->pColParams, pCols->numOfBound * sizeof(SMemParam));
+    if (NULL == pParams) {
+      return TSDB_CODE_TSC_OUT_OF_MEMORY;
+    }
+    pCxt->pColParams = pParams;
+    pCxt->numOfColParams = pCols->numOfBound;
+  }
+
+  SSchema* pSchemas = getTableColumnSchema(pDataBuf->pTableMeta);
+  for (col_id_t i = 0; i < pCols->numOfBound; ++i) {
+    SMemParam* pParam = pCxt->pColParams + i;
+    pParam->rb = &pDataBuf->rowBuilder;
+    pParam->schema = &pSchemas[pCols->boundColumns[i]];
+    insGetSTSRowAppendInfo(pDataBuf->rowBuilder.rowType, pCols, i, &pParam->toffset, &pParam->colIdx);
+  }
+  return TSDB_CODE_SUCCESS;
+}
+
+// the append info is from initColAppendParams
 static int parseOneRow(SInsertParseContext* pCxt, const char** pSql, STableDataBlocks* pDataBuf, bool* pGotRow,
                        SToken* pToken) {
   SRowBuilder*        pBuilder = &pDataBuf->rowBuilder;
   STSRow*             row = (STSRow*)(pDataBuf->pData + pDataBuf->size);  // skip the SSubmitBlk header
   SParsedDataColInfo* pCols = &pDataBuf->boundColumnInfo;
   bool                isParseBindParam = false;
-  SSchema*            pSchemas = getTableColumnSchema(pDataBuf->pTableMeta);
-  SMemParam           param = {.rb = pBuilder};
+  int16_t             precision = getTableInfo(pDataBuf->pTableMeta).precision;
 
   int32_t code = tdSRowResetBuf(pBuilder, row);
   // 1. set the parsed value from sql string
   for (int i = 0; i < pCols->numOfBound && TSDB_CODE_SUCCESS == code; ++i) {
     NEXT_TOKEN_WITH_PREV(*pSql, *pToken);
-    SSchema* pSchema = &pSchemas[pCols->boundColumns[i]];
+    SMemParam* pParam = pCxt->pColParams + i;
 
     if (pToken->type == TK_NK_QUESTION) {
       isParseBindParam = true;
@@ -1197,10 +1433,7 @@ static int parseOneRow(SInsertParseContext* pCxt, const char** pSql, STableDataB
     }
 
     if (TSDB_CODE_SUCCESS == code) {
-      param.schema = pSchema;
-      insGetSTSRowAppendInfo(pBuilder->rowType, pCols, i, &param.toffset, &param.colIdx);
-      code = parseValueToken(pCxt, pSql, pToken, pSchema, getTableInfo(pDataBuf->pTableMeta).precision, insMemRowAppend,
-                             &param);
+      code = parseValueToken(pCxt, pSql, pToken, pParam->schema, precision, insMemRowAppend, pParam);
     }
 
     if (TSDB_CODE_SUCCESS == code && i < pCols->numOfBound - 1) {
@@ -1268,6 +1501,9 @@ static int32_t allocateMemIfNeed(STableDataBlocks* pDataBlock, int32_t rowSize,
 static int32_t parseValues(SInsertParseContext* pCxt, SVnodeModifOpStmt* pStmt, STableDataBlocks* pDataBuf,
                            int32_t maxRows, int32_t* pNumOfRows, SToken* pToken) {
   int32_t code = insInitRowBuilder(&pDataBuf->rowBuilder, pDataBuf->pTableMeta->sversion, &pDataBuf->boundColumnInfo);
+  if (TSDB_CODE_SUCCESS == code) {
+    code = initColAppendParams(pCxt, pDataBuf);
+  }
 
   int32_t extendedRowSize = insGetExtendedRowSize(pDataBuf);
   (*pNumOfRows) = 0;
@@ -1334,6 +1570,9 @@ static int32_t parseValuesClause(SInsertParseContext* pCxt, SVnodeModifOpStmt* p
 static int32_t parseCsvFile(SInsertParseContext* pCxt, SVnodeModifOpStmt* pStmt, STableDataBlocks* pDataBuf,
                             int maxRows, int32_t* pNumOfRows) {
   int32_t code = insInitRowBuilder(&pDataBuf->rowBuilder, pDataBuf->pTableMeta->sversion, &pDataBuf->boundColumnInfo);
+  if (TSDB_CODE_SUCCESS == code) {
+    code = initColAppendParams(pCxt, pDataBuf);
+  }
 
   int32_t extendedRowSize = insGetExtendedRowSize(pDataBuf);
   (*pNumOfRows) = 0;
@@ -1462,6 +1701,7 @@ static void resetEnvPreTable(SInsertParseContext* pCxt, SVnodeModifOpStmt* pStmt
   tdDestroySVCreateTbReq(&pStmt->createTblReq);
   pCxt->missCache = false;
   pCxt->usingDuplicateTable = false;
+  pCxt->hitTemplate = false;
   pStmt->pBoundCols = NULL;
   pStmt->usingTableProcessing = false;
   pStmt->fileProcessing = false;
@@ -1920,5 +2160,15 @@ int32_t parseInsertSql(SParseContext* pCxt, SQuery** pQuery, SCatalogReq* pCatal
     code = setRefreshMate(*pQuery);
   }
   destroyBoundColumnInfo(&context.tags);
+  taosMemoryFree(context.pTemplate);
+  taosMemoryFree(context.pColParams);
   return code;
 }
+
+void* qCreateInsertCache() {
+  return taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_ENTRY_LOCK);
+}
+
+void qClearInsertCache(void* pCache) { taosHashClear(pCache); }
+
+void qDestroyInsertCache(void* pCache) { taosHashCleanup(pCache); }
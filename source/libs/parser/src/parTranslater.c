@@ -783,6 +783,9 @@ static void setColumnInfoBySchema(const SRealTableNode* pTable, const SSchema* p
   if (TSDB_DATA_TYPE_TIMESTAMP == pCol->node.resType.type) {
     pCol->node.resType.precision = pTable->pMeta->tableInfo.precision;
   }
+  if (pColSchema->flags & COL_NCHAR_UTF8) {
+    pCol->node.resType.scale = TSDB_UTF8_NCHAR_SCALE;
+  }
 }
 
 static void setColumnInfoByExpr(STempTableNode* pTable, SExprNode* pExpr, SColumnNode** pColRef) {
@@ -1220,6 +1223,8 @@ static int32_t calcTypeBytes(SDataType dt) {
   }
 }
 
+static int8_t calcTypeFlags(SDataType dt) { return IS_UTF8_NCHAR_TYPE(dt.type, dt.scale) ? COL_NCHAR_UTF8 : 0; }
+
 static EDealRes translateValue(STranslateContext* pCxt, SValueNode* pVal) {
   SDataType dt = pVal->node.resType;
   dt.bytes = calcTypeBytes(dt);
@@ -4174,7 +4179,9 @@ static int32_t columnDefNodeToField(SNodeList* pList, SArray** pArray) {
   SNode* pNode;
   FOREACH(pNode, pList) {
     SColumnDefNode* pCol = (SColumnDefNode*)pNode;
-    SField          field = {.type = pCol->dataType.type, .bytes = calcTypeBytes(pCol->dataType)};
+    SField          field = {.type = pCol->dataType.type,
+                             .flags = calcTypeFlags(pCol->dataType),
+                             .bytes = calcTypeBytes(pCol->dataType)};
     strcpy(field.name, pCol->colName);
     if (pCol->sma) {
       field.flags |= COL_SMA_ON;
@@ -4438,6 +4445,21 @@ static int32_t checkTableWatermarkOption(STranslateContext* pCxt, STableOptions*
   return code;
 }
 
+// the nchar columns of a database keeping UTF-8 are VARCHAR columns of 4 bytes for each char, flagged so that their
+// chars are counted instead of their bytes
+static void toUtf8NcharType(SDataType* pType) {
+  if (TSDB_DATA_TYPE_NCHAR == pType->type) {
+    pType->type = TSDB_DATA_TYPE_VARCHAR;
+    pType->bytes *= TSDB_NCHAR_SIZE;
+    pType->scale = TSDB_UTF8_NCHAR_SCALE;
+  }
+}
+
+static void toUtf8NcharColumns(SNodeList* pCols) {
+  SNode* pNode = NULL;
+  FOREACH(pNode, pCols) { toUtf8NcharType(&((SColumnDefNode*)pNode)->dataType); }
+}
+
 static int32_t checkCreateTable(STranslateContext* pCxt, SCreateTableStmt* pStmt, bool createStable) {
   if (NULL != strchr(pStmt->tableName, '.')) {
     return generateSyntaxErrMsgExt(&pCxt->msgBuf, TSDB_CODE_PAR_INVALID_IDENTIFIER_NAME,
@@ -4451,6 +4473,10 @@ static int32_t checkCreateTable(STranslateContext* pCxt, SCreateTableStmt* pStmt
         &pCxt->msgBuf, TSDB_CODE_PAR_INVALID_TABLE_OPTION,
         "Only super table creation is supported in databases configured with the 'RETENTIONS' option");
   }
+  if (TSDB_CODE_SUCCESS == code && dbCfg.ncharUtf8) {
+    toUtf8NcharColumns(pStmt->pCols);
+    toUtf8NcharColumns(pStmt->pTags);
+  }
   if (TSDB_CODE_SUCCESS == code) {
     code = checkTableMaxDelayOption(pCxt, pStmt->pOptions, createStable, &dbCfg);
   }
@@ -4470,7 +4496,7 @@ static int32_t checkCreateTable(STranslateContext* pCxt, SCreateTableStmt* pStmt
 }
 
 static void toSchema(const SColumnDefNode* pCol, col_id_t colId, SSchema* pSchema) {
-  int8_t flags = 0;
+  int8_t flags = calcTypeFlags(pCol->dataType);
   if (pCol->sma) {
     flags |= COL_SMA_ON;
   }
@@ -4812,7 +4838,7 @@ static int32_t buildAlterSuperTableReq(STranslateContext* pCxt, SAlterTableStmt*
     return TSDB_CODE_SUCCESS;
   }
 
-  pAlterReq->pFields = taosArrayInit(2, sizeof(TAOS_FIELD));
+  pAlterReq->pFields = taosArrayInit(2, sizeof(SField));
   if (NULL == pAlterReq->pFields) {
     return TSDB_CODE_OUT_OF_MEMORY;
   }
@@ -4824,17 +4850,19 @@ static int32_t buildAlterSuperTableReq(STranslateContext* pCxt, SAlterTableStmt*
     case TSDB_ALTER_TABLE_DROP_COLUMN:
     case TSDB_ALTER_TABLE_UPDATE_COLUMN_BYTES:
     case TSDB_ALTER_TABLE_UPDATE_TAG_BYTES: {
-      TAOS_FIELD field = {.type = pStmt->dataType.type, .bytes = calcTypeBytes(pStmt->dataType)};
+      SField field = {.type = pStmt->dataType.type,
+                      .flags = calcTypeFlags(pStmt->dataType),
+                      .bytes = calcTypeBytes(pStmt->dataType)};
       strcpy(field.name, pStmt->colName);
       taosArrayPush(pAlterReq->pFields, &field);
       break;
     }
     case TSDB_ALTER_TABLE_UPDATE_TAG_NAME:
     case TSDB_ALTER_TABLE_UPDATE_COLUMN_NAME: {
-      TAOS_FIELD oldField = {0};
+      SField oldField = {0};
       strcpy(oldField.name, pStmt->colName);
       taosArrayPush(pAlterReq->pFields, &oldField);
-      TAOS_FIELD newField = {0};
+      SField newField = {0};
       strcpy(newField.name, pStmt->newColName);
       taosArrayPush(pAlterReq->pFields, &newField);
       break;
@@ -4963,6 +4991,9 @@ static int32_t checkAlterSuperTable(STranslateContext* pCxt, SAlterTableStmt* pS
                                    "Modifying the table schema is not supported in databases "
                                    "configured with the 'RETENTIONS' option");
   }
+  if (TSDB_CODE_SUCCESS == code && dbCfg.ncharUtf8) {
+    toUtf8NcharType(&pStmt->dataType);
+  }
   STableMeta* pTableMeta = NULL;
   if (TSDB_CODE_SUCCESS == code) {
     code = getTableMeta(pCxt, pStmt->dbName, pStmt->tableName, &pTableMeta);
@@ -7173,7 +7204,7 @@ static int32_t buildAddColReq(STranslateContext* pCxt, SAlterTableStmt* pStmt, S
   }
 
   pReq->type = pStmt->dataType.type;
-  pReq->flags = COL_SMA_ON;
+  pReq->flags = COL_SMA_ON | calcTypeFlags(pStmt->dataType);
   pReq->bytes = calcTypeBytes(pStmt->dataType);
   return TSDB_CODE_SUCCESS;
 }
@@ -7397,8 +7428,16 @@ static int32_t rewriteAlterTable(STranslateContext* pCxt, SQuery* pQuery) {
     return generateSyntaxErrMsg(&pCxt->msgBuf, TSDB_CODE_PAR_INVALID_COL_JSON);
   }
 
+  SDbCfgInfo dbCfg = {0};
+  int32_t    code = getDBCfg(pCxt, pStmt->dbName, &dbCfg);
+  if (TSDB_CODE_SUCCESS == code && dbCfg.ncharUtf8) {
+    toUtf8NcharType(&pStmt->dataType);
+  }
+
   STableMeta* pTableMeta = NULL;
-  int32_t     code = getTableMeta(pCxt, pStmt->dbName, pStmt->tableName, &pTableMeta);
+  if (TSDB_CODE_SUCCESS == code) {
+    code = getTableMeta(pCxt, pStmt->dbName, pStmt->tableName, &pTableMeta);
+  }
   if (TSDB_CODE_SUCCESS == code) {
     code = rewriteAlterTableImpl(pCxt, pStmt, pTableMeta, pQuery);
   }
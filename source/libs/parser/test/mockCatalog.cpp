@@ -217,6 +217,7 @@ void generateDatabases(MockCatalogService* mcs) {
   generateTestTables(g_mockCatalogService.get(), "cache_db");
   generateTestStables(g_mockCatalogService.get(), "cache_db");
   mcs->createDatabase("rollup_db", true);
+  mcs->createDatabase("utf8_db", false, 0, 1);
 }
 
 }  // namespace
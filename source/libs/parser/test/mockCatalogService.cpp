@@ -354,12 +354,13 @@ class MockCatalogServiceImpl {
     dnode_.insert(std::make_pair(dnodeId, epSet));
   }
 
-  void createDatabase(const std::string& db, bool rollup, int8_t cacheLast) {
+  void createDatabase(const std::string& db, bool rollup, int8_t cacheLast, int8_t ncharUtf8) {
     SDbCfgInfo cfg = {0};
     if (rollup) {
       cfg.pRetensions = taosArrayInit(TARRAY_MIN_SIZE, sizeof(SRetention));
     }
     cfg.cacheLast = cacheLast;
+    cfg.ncharUtf8 = ncharUtf8;
     dbCfg_.insert(std::make_pair(db, cfg));
   }
 
@@ -657,8 +658,8 @@ void MockCatalogService::createDnode(int32_t dnodeId, const std::string& host, i
   impl_->createDnode(dnodeId, host, port);
 }
 
-void MockCatalogService::createDatabase(const std::string& db, bool rollup, int8_t cacheLast) {
-  impl_->createDatabase(db, rollup, cacheLast);
+void MockCatalogService::createDatabase(const std::string& db, bool rollup, int8_t cacheLast, int8_t ncharUtf8) {
+  impl_->createDatabase(db, rollup, cacheLast, ncharUtf8);
 }
 
 int32_t MockCatalogService::catalogGetTableMeta(const SName* pTableName, STableMeta** pTableMeta,
@@ -551,6 +551,17 @@ TEST_F(ParserInitialCTest, createStable) {
       "a12 TINYINT UNSIGNED, a13 BOOL, a14 NCHAR(30), a15 VARCHAR(50)) "
       "TTL 100 COMMENT 'test create table' SMA(c1, c2, c3) ROLLUP (MIN) MAX_DELAY 100s,10m WATERMARK 10a,1m");
   clearCreateStbReq();
+
+  // the nchar columns and tags of a database keeping UTF-8 are flagged VARCHAR of 4 bytes for each char
+  setCreateStbReqFunc("utf8_db", "t1");
+  addFieldToCreateStbReqFunc(true, "ts", TSDB_DATA_TYPE_TIMESTAMP);
+  addFieldToCreateStbReqFunc(true, "c1", TSDB_DATA_TYPE_VARCHAR, 30 * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE,
+                             COL_SMA_ON | COL_NCHAR_UTF8);
+  addFieldToCreateStbReqFunc(true, "c2", TSDB_DATA_TYPE_VARCHAR, 50 + VARSTR_HEADER_SIZE);
+  addFieldToCreateStbReqFunc(false, "a1", TSDB_DATA_TYPE_VARCHAR, 30 * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE,
+                             COL_SMA_ON | COL_NCHAR_UTF8);
+  run("CREATE STABLE utf8_db.t1(ts TIMESTAMP, c1 NCHAR(30), c2 VARCHAR(50)) TAGS (a1 NCHAR(30))");
+  clearCreateStbReq();
 }
 
 TEST_F(ParserInitialCTest, createStableSemanticCheck) {
@@ -15,12 +15,59 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 #include "parTestUtil.h"
+#include "parser.h"
 
 using namespace std;
 
 namespace ParserTest {
 
+namespace {
+
+// the submit payloads of the vgroups
+vector<string> parseInsertPayloads(const string& sql, void* pInsertCache) {
+  char          msg[1024] = {0};
+  SParseContext cxt = {0};
+  cxt.db = "test";
+  cxt.pUser = "root";
+  cxt.isSuperUser = true;
+  cxt.enableSysInfo = true;
+  cxt.pSql = sql.c_str();
+  cxt.sqlLen = sql.length();
+  cxt.pMsg = msg;
+  cxt.msgLen = sizeof(msg);
+  cxt.svrVer = "3.0.0.0";
+  cxt.pInsertCache = pInsertCache;
+
+  vector<string> payloads;
+  SQuery*        pQuery = nullptr;
+  int32_t        code = qParseSql(&cxt, &pQuery);
+  EXPECT_EQ(code, TSDB_CODE_SUCCESS) << msg;
+  if (TSDB_CODE_SUCCESS == code) {
+    SArray* pBlocks = ((SVnodeModifOpStmt*)pQuery->pRoot)->pDataBlocks;
+    for (int32_t i = 0; i < taosArrayGetSize(pBlocks); ++i) {
+      SVgDataBlocks* pVg = (SVgDataBlocks*)taosArrayGetP(pBlocks, i);
+      payloads.emplace_back(to_string(pVg->vg.vgId) + ":" + string((const char*)pVg->pData, pVg->size));
+    }
+    sort(payloads.begin(), payloads.end());
+  }
+  qDestroyQuery(pQuery);
+  return payloads;
+}
+
+string buildInsertSql(int64_t startTs, int32_t numOfRows) {
+  string sql = "insert into t1 (c1, ts, c2, c3) values ";
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    sql += "(" + to_string(i - numOfRows / 2) + ", " + to_string(startTs + i) + ", 'beijing', +" + to_string(i) + ")";
+  }
+  sql += " st1s1 values (" + to_string(startTs) + ", 1, 'a') st1s2 (ts, c1) values (" + to_string(startTs) + ", 2)";
+  return sql;
+}
+
+}  // namespace
+
 // syntax:
 // INSERT INTO
 //   tb_name
@@ -84,4 +131,25 @@ TEST_F(ParserInsertTest, autoCreateTableTest) {
       "st1s2 (ts, c1, c2) USING st1 TAGS(2, 'abc', now) VALUES (now+1s, 2, 'shanghai')");
 }
 
+// the table clauses repeated on a connection are parsed with the templates of the insert cache
+TEST_F(ParserInsertTest, insertTemplate) {
+  void* pCache = qCreateInsertCache();
+  ASSERT_NE(pCache, nullptr);
+
+  for (int32_t i = 0; i < 3; ++i) {
+    string sql = buildInsertSql(1664000000000 + i * 100, 10);
+    ASSERT_EQ(parseInsertPayloads(sql, pCache), parseInsertPayloads(sql, nullptr));
+    ASSERT_EQ(taosHashGetSize((SHashObj*)pCache), 3);
+  }
+
+  // a different column list is another template
+  string sql = "insert into t1 (ts, c1) values (1664000000000, 1)(1664000000001, -2147483648)";
+  ASSERT_EQ(parseInsertPayloads(sql, pCache), parseInsertPayloads(sql, nullptr));
+  ASSERT_EQ(taosHashGetSize((SHashObj*)pCache), 4);
+
+  qClearInsertCache(pCache);
+  ASSERT_EQ(taosHashGetSize((SHashObj*)pCache), 0);
+  qDestroyInsertCache(pCache);
+}
+
 }  // namespace ParserTest
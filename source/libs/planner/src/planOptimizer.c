@@ -209,7 +209,10 @@ static int32_t scanPathOptGetRelatedFuncs(SScanLogicNode* pScan, SNodeList** pSd
   FOREACH(pNode, pAllFuncs) {
     SFunctionNode* pFunc = (SFunctionNode*)pNode;
     int32_t        code = TSDB_CODE_SUCCESS;
-    if (scanPathOptNeedOptimizeDataRequire(pFunc)) {
+    if (fmIsWindowPseudoColumnFunc(pFunc->funcId)) {
+      // calculated from the time window only, the data of scan is not required
+      continue;
+    } else if (scanPathOptNeedOptimizeDataRequire(pFunc)) {
       code = nodesListMakeStrictAppend(&pTmpSdrFuncs, nodesCloneNode(pNode));
     } else if (scanPathOptNeedDynOptimize(pFunc)) {
       code = nodesListMakeStrictAppend(&pTmpDsoFuncs, nodesCloneNode(pNode));
@@ -150,7 +150,9 @@ __compar_fn_t gDataCompare[] = {compareInt32Val,
                                 setChkNotInBytes8,
                                 compareChkNotInString,
                                 compareStrPatternNotMatch,
-                                compareWStrPatternNotMatch};
+                                compareWStrPatternNotMatch,
+                                compareUtf8PatternMatch,
+                                compareUtf8PatternNotMatch};
 
 __compar_fn_t gInt8SignCompare[] = {compareInt8Val,   compareInt8Int16, compareInt8Int32,
                                     compareInt8Int64, compareInt8Float, compareInt8Double};
@@ -335,6 +337,23 @@ int8_t filterGetCompFuncIdx(int32_t type, int32_t optr) {
 
 __compar_fn_t filterGetCompFunc(int32_t type, int32_t optr) { return gDataCompare[filterGetCompFuncIdx(type, optr)]; }
 
+// LIKE on a column keeping the UTF-8 of an nchar matches '_' with a whole char
+static int8_t filterGetColCompFuncIdx(int32_t type, uint8_t scale, int32_t optr) {
+  if (IS_UTF8_NCHAR_TYPE(type, scale)) {
+    if (optr == OP_TYPE_LIKE) {
+      return 28;
+    } else if (optr == OP_TYPE_NOT_LIKE) {
+      return 29;
+    }
+  }
+
+  return filterGetCompFuncIdx(type, optr);
+}
+
+__compar_fn_t filterGetColCompFunc(int32_t type, uint8_t scale, int32_t optr) {
+  return gDataCompare[filterGetColCompFuncIdx(type, scale, optr)];
+}
+
 __compar_fn_t filterGetCompFuncEx(int32_t lType, int32_t rType, int32_t optr) {
   if (TSDB_DATA_TYPE_NULL == rType) {
     return NULL;
@@ -2768,7 +2787,9 @@ int32_t filterGenerateComInfo(SFilterInfo *info) {
   for (uint32_t i = 0; i < info->unitNum; ++i) {
     SFilterUnit *unit = &info->units[i];
 
-    info->cunits[i].func = filterGetCompFuncIdx(FILTER_UNIT_DATA_TYPE(unit), unit->compare.optr);
+    SFilterField *col = FILTER_UNIT_LEFT_FIELD(info, unit);
+    uint8_t       scale = FILTER_GET_COL_FIELD_DESC(col)->node.resType.scale;
+    info->cunits[i].func = filterGetColCompFuncIdx(FILTER_UNIT_DATA_TYPE(unit), scale, unit->compare.optr);
     info->cunits[i].rfunc = filterGetRangeCompFuncFromOptrs(unit->compare.optr, unit->compare.optr2);
     info->cunits[i].optr = FILTER_UNIT_OPTR(unit);
     info->cunits[i].colData = NULL;
@@ -12,7 +12,7 @@ typedef double (*_double_fn)(double);
 typedef double (*_double_fn_2)(double, double);
 typedef int (*_conv_fn)(int);
 typedef void (*_trim_fn)(char *, char *, int32_t, int32_t);
-typedef int16_t (*_len_fn)(char *, int32_t);
+typedef int16_t (*_len_fn)(char *, int32_t, uint8_t);
 
 /** Math functions **/
 static double tlog(double v) { return log(v); }
@@ -286,10 +286,12 @@ static int32_t doScalarFunction(SScalarParam *pInput, int32_t inputNum, SScalarP
 }
 
 /** String functions **/
-static int16_t tlength(char *input, int32_t type) { return varDataLen(input); }
+static int16_t tlength(char *input, int32_t type, uint8_t scale) { return varDataLen(input); }
 
-static int16_t tcharlength(char *input, int32_t type) {
-  if (type == TSDB_DATA_TYPE_VARCHAR) {
+static int16_t tcharlength(char *input, int32_t type, uint8_t scale) {
+  if (IS_UTF8_NCHAR_TYPE(type, scale)) {
+    return taosUtf8StrLen(varDataVal(input), varDataLen(input));
+  } else if (type == TSDB_DATA_TYPE_VARCHAR) {
     return varDataLen(input);
   } else {  // NCHAR
     return varDataLen(input) / TSDB_NCHAR_SIZE;
@@ -357,6 +359,7 @@ static void trtrim(char *input, char *output, int32_t type, int32_t charLen) {
 
 static int32_t doLengthFunction(SScalarParam *pInput, int32_t inputNum, SScalarParam *pOutput, _len_fn lenFn) {
   int32_t type = GET_PARAM_TYPE(pInput);
+  uint8_t scale = pInput->columnData->info.scale;
 
   SColumnInfoData *pInputData = pInput->columnData;
   SColumnInfoData *pOutputData = pOutput->columnData;
@@ -371,7 +374,7 @@ static int32_t doLengthFunction(SScalarParam *pInput, int32_t inputNum, SScalarP
     }
 
     char *in = colDataGetData(pInputData, i);
-    out[i] = lenFn(in, type);
+    out[i] = lenFn(in, type, scale);
   }
 
   pOutput->numOfRows = pInput->numOfRows;
@@ -654,6 +657,7 @@ int32_t substrFunction(SScalarParam *pInput, int32_t inputNum, SScalarParam *pOu
 
   SColumnInfoData *pInputData = pInput->columnData;
   SColumnInfoData *pOutputData = pOutput->columnData;
+  bool             utf8 = IS_UTF8_NCHAR_TYPE(GET_PARAM_TYPE(pInput), pInputData->info.scale);
 
   int32_t outputLen = pInputData->varmeta.length * pInput->numOfRows;
   char   *outputBuf = taosMemoryCalloc(outputLen, 1);
@@ -667,17 +671,25 @@ int32_t substrFunction(SScalarParam *pInput, int32_t inputNum, SScalarParam *pOu
     char   *input = colDataGetData(pInput[0].columnData, i);
     int32_t len = varDataLen(input);
     int32_t startPosBytes;
+    int32_t resLen;
 
-    if (subPos > 0) {
-      startPosBytes = (GET_PARAM_TYPE(pInput) == TSDB_DATA_TYPE_VARCHAR) ? subPos - 1 : (subPos - 1) * TSDB_NCHAR_SIZE;
-      startPosBytes = TMIN(startPosBytes, len);
+    if (utf8) {
+      // the positions count the chars of UTF-8, found without converting the value
+      int32_t startPos = (subPos > 0) ? subPos - 1 : TMAX(taosUtf8StrLen(varDataVal(input), len) + subPos, 0);
+      startPosBytes = taosUtf8Offset(varDataVal(input), len, startPos);
+      resLen = taosUtf8Offset(varDataVal(input) + startPosBytes, len - startPosBytes, subLen);
     } else {
-      startPosBytes =
-          (GET_PARAM_TYPE(pInput) == TSDB_DATA_TYPE_VARCHAR) ? len + subPos : len + subPos * TSDB_NCHAR_SIZE;
-      startPosBytes = TMAX(startPosBytes, 0);
+      if (subPos > 0) {
+        startPosBytes =
+            (GET_PARAM_TYPE(pInput) == TSDB_DATA_TYPE_VARCHAR) ? subPos - 1 : (subPos - 1) * TSDB_NCHAR_SIZE;
+        startPosBytes = TMIN(startPosBytes, len);
+      } else {
+        startPosBytes =
+            (GET_PARAM_TYPE(pInput) == TSDB_DATA_TYPE_VARCHAR) ? len + subPos : len + subPos * TSDB_NCHAR_SIZE;
+        startPosBytes = TMAX(startPosBytes, 0);
+      }
+      resLen = TMIN(subLen, len - startPosBytes);
     }
-
-    int32_t resLen = TMIN(subLen, len - startPosBytes);
     if (resLen > 0) {
       memcpy(varDataVal(output), varDataVal(input) + startPosBytes, resLen);
     }
@@ -1600,7 +1600,7 @@ void doVectorCompare(SScalarParam* pLeft, SScalarParam* pRight, SScalarParam *pO
   int32_t       compRows = 0;
   
   if (lType == rType) {
-    fp = filterGetCompFunc(lType, optr);
+    fp = filterGetColCompFunc(lType, pLeft->columnData->info.scale, optr);
   } else {
     fp = filterGetCompFuncEx(lType, rType, optr);
   }
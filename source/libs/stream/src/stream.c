@@ -111,6 +111,54 @@ int32_t streamSchedExec(SStreamTask* pTask) {
   return 0;
 }
 
+int32_t streamTaskGetCredit(SStreamTask* pTask) {
+  int32_t queued = taosQueueItemSize(pTask->inputQueue->queue);
+  if (pTask->outputQueue) queued += taosQueueItemSize(pTask->outputQueue->queue);
+  return TMAX(STREAM_TASK_QUEUE_CAPACITY - queued, 0);
+}
+
+bool streamTaskOutputFull(SStreamTask* pTask) {
+  if (pTask->outputType != TASK_OUTPUT__FIXED_DISPATCH && pTask->outputType != TASK_OUTPUT__SHUFFLE_DISPATCH) {
+    return false;
+  }
+  // no more results are held than the downstream tasks are able to take
+  int32_t credit = TMAX(atomic_load_32(&pTask->dispatchCredit), 1);
+  return taosQueueItemSize(pTask->outputQueue->queue) >= TMIN(credit, STREAM_TASK_QUEUE_CAPACITY);
+}
+
+bool streamTaskInputFull(SStreamTask* pTask) {
+  return taosQueueItemSize(pTask->inputQueue->queue) >= STREAM_TASK_QUEUE_CAPACITY;
+}
+
+bool streamTaskReplayPending(SStreamTask* pTask) {
+  // the end is loaded first, so a range moved on by streamTaskDeferSubmit is never seen with the old start
+  int64_t endVer = atomic_load_64(&pTask->replayEndVer);
+  return endVer > atomic_load_64(&pTask->replayStartVer);
+}
+
+void streamTaskDeferSubmit(SStreamTask* pTask, int64_t ver) {
+  if (!streamTaskReplayPending(pTask)) {
+    atomic_store_64(&pTask->replayStartVer, ver - 1);
+  }
+  atomic_store_64(&pTask->replayEndVer, ver);
+}
+
+bool streamTaskSubmitCovered(SStreamTask* pTask, int64_t ver) {
+  // the wal entries after the vnode commit are applied again on restart, the checkpoint may already cover some
+  return ver <= atomic_load_64(&pTask->replayStartVer);
+}
+
+static void streamDispatchByTimer(void* param, void* tmrId) {
+  SStreamTask* pTask = (void*)param;
+
+  if (atomic_load_8(&pTask->taskStatus) != TASK_STATUS__DROPPING) {
+    qDebug("task %d probe downstream after back off", pTask->taskId);
+    atomic_val_compare_exchange_8(&pTask->outputStatus, TASK_OUTPUT_STATUS__BLOCKED, TASK_OUTPUT_STATUS__NORMAL);
+    streamDispatch(pTask);
+  }
+  streamMetaReleaseTask(NULL, pTask);
+}
+
 int32_t streamTaskEnqueue(SStreamTask* pTask, const SStreamDispatchReq* pReq, SRpcMsg* pRsp) {
   SStreamDataBlock* pData = taosAllocateQitem(sizeof(SStreamDataBlock), DEF_QITEM);
   int8_t            status;
@@ -122,8 +170,11 @@ int32_t streamTaskEnqueue(SStreamTask* pTask, const SStreamDispatchReq* pReq, SR
     // decode
     /*pData->blocks = pReq->data;*/
     /*pBlock->sourceVer = pReq->sourceVer;*/
-    streamDispatchReqToData(pReq, pData);
-    if (streamTaskInput(pTask, (SStreamQueueItem*)pData) == 0) {
+    if (streamDispatchReqToData(pReq, pData) < 0) {
+      taosFreeQitem(pData);
+      streamTaskInputFail(pTask);
+      status = TASK_INPUT_STATUS__FAILED;
+    } else if (streamTaskInput(pTask, (SStreamQueueItem*)pData) == 0) {
       status = TASK_INPUT_STATUS__NORMAL;
     } else {
       status = TASK_INPUT_STATUS__FAILED;
@@ -143,6 +194,7 @@ int32_t streamTaskEnqueue(SStreamTask* pTask, const SStreamDispatchReq* pReq, SR
   pCont->upstreamTaskId = htonl(pReq->upstreamTaskId);
   pCont->downstreamNodeId = htonl(pTask->nodeId);
   pCont->downstreamTaskId = htonl(pTask->taskId);
+  pCont->credit = htonl(streamTaskGetCredit(pTask));
   pRsp->pCont = buf;
   pRsp->contLen = sizeof(SMsgHead) + sizeof(SStreamDispatchRsp);
   tmsgSendRsp(pRsp);
@@ -212,13 +264,32 @@ int32_t streamProcessDispatchReq(SStreamTask* pTask, SStreamDispatchReq* pReq, S
 int32_t streamProcessDispatchRsp(SStreamTask* pTask, SStreamDispatchRsp* pRsp, int32_t code) {
   ASSERT(pRsp->inputStatus == TASK_OUTPUT_STATUS__NORMAL || pRsp->inputStatus == TASK_OUTPUT_STATUS__BLOCKED);
 
-  qDebug("task %d receive dispatch rsp, code: %x", pTask->taskId, code);
+  int32_t credit = ntohl(pRsp->credit);
+  qDebug("task %d receive dispatch rsp, code: %x, credit: %d", pTask->taskId, code, credit);
+
+  // a shuffle round goes on at the pace of its slowest downstream task
+  while (1) {
+    int32_t minCredit = atomic_load_32(&pTask->roundCredit);
+    if (credit >= minCredit) break;
+    if (atomic_val_compare_exchange_32(&pTask->roundCredit, minCredit, credit) == minCredit) break;
+  }
 
   if (pTask->outputType == TASK_OUTPUT__SHUFFLE_DISPATCH) {
     int32_t leftRsp = atomic_sub_fetch_32(&pTask->shuffleDispatcher.waitingRspCnt, 1);
     qDebug("task %d is shuffle, left waiting rsp %d", pTask->taskId, leftRsp);
     if (leftRsp > 0) return 0;
   }
+  atomic_store_32(&pTask->dispatchCredit, atomic_load_32(&pTask->roundCredit));
+
+  if (pRsp->inputStatus == TASK_INPUT_STATUS__NORMAL && atomic_load_32(&pTask->dispatchCredit) <= 0) {
+    // downstream is full, hold the output and probe again later
+    int8_t old = atomic_exchange_8(&pTask->outputStatus, TASK_OUTPUT_STATUS__BLOCKED);
+    ASSERT(old == TASK_OUTPUT_STATUS__WAIT);
+    qDebug("task %d dispatch blocked since no credit, back off %d ms", pTask->taskId, STREAM_DISPATCH_BACKOFF_MS);
+    atomic_add_fetch_32(&pTask->refCnt, 1);
+    taosTmrStart(streamDispatchByTimer, STREAM_DISPATCH_BACKOFF_MS, pTask, streamEnv.timer);
+    return 0;
+  }
 
   int8_t old = atomic_exchange_8(&pTask->outputStatus, pRsp->inputStatus);
   ASSERT(old == TASK_OUTPUT_STATUS__WAIT);
@@ -229,6 +300,11 @@ int32_t streamProcessDispatchRsp(SStreamTask* pTask, SStreamDispatchRsp* pRsp, i
   }
   // continue dispatch
   streamDispatch(pTask);
+
+  // the output queue is draining and the downstream grants room, resume exec stopped by back pressure
+  if (!streamTaskOutputFull(pTask) && atomic_exchange_8(&pTask->execPaused, 0)) {
+    streamSchedExec(pTask);
+  }
   return 0;
 }
 
@@ -14,6 +14,7 @@
  */
 
 #include "streamInc.h"
+#include "tcompression.h"
 
 int32_t streamDispatchReqToData(const SStreamDispatchReq* pReq, SStreamDataBlock* pData) {
   int32_t blockNum = pReq->blockNum;
@@ -29,7 +30,21 @@ int32_t streamDispatchReqToData(const SStreamDispatchReq* pReq, SStreamDataBlock
   for (int32_t i = 0; i < blockNum; i++) {
     SRetrieveTableRsp* pRetrieve = taosArrayGetP(pReq->data, i);
     SSDataBlock*       pDataBlock = taosArrayGet(pArray, i);
-    blockDecode(pDataBlock, pRetrieve->data);
+    if (pRetrieve->compressed) {
+      int32_t rawLen = ntohl(*(int32_t*)pRetrieve->data);
+      char*   pRaw = taosMemoryMalloc(rawLen);
+      if (pRaw == NULL || tsDecompressString(pRetrieve->data + sizeof(int32_t), ntohl(pRetrieve->compLen), 1, pRaw,
+                                             rawLen, ONE_STAGE_COMP, NULL, 0) != rawLen) {
+        taosMemoryFree(pRaw);
+        taosArraySetSize(pArray, i);
+        taosArrayDestroyEx(pArray, (FDelete)blockDataFreeRes);
+        return -1;
+      }
+      blockDecode(pDataBlock, pRaw);
+      taosMemoryFree(pRaw);
+    } else {
+      blockDecode(pDataBlock, pRetrieve->data);
+    }
     // TODO: refactor
     pDataBlock->info.window.skey = be64toh(pRetrieve->skey);
     pDataBlock->info.window.ekey = be64toh(pRetrieve->ekey);
@@ -14,6 +14,8 @@
  */
 
 #include "streamInc.h"
+#include "tcompression.h"
+#include "tglobal.h"
 
 int32_t tEncodeStreamDispatchReq(SEncoder* pEncoder, const SStreamDispatchReq* pReq) {
   if (tStartEncode(pEncoder) < 0) return -1;
@@ -178,7 +180,7 @@ CLEAR:
   return code;
 }
 
-static int32_t streamAddBlockToDispatchMsg(const SSDataBlock* pBlock, SStreamDispatchReq* pReq) {
+int32_t streamAddBlockToDispatchMsg(const SSDataBlock* pBlock, SStreamDispatchReq* pReq) {
   int32_t dataStrLen = sizeof(SRetrieveTableRsp) + blockGetEncodeSize(pBlock);
   void*   buf = taosMemoryCalloc(1, dataStrLen);
   if (buf == NULL) return -1;
@@ -200,8 +202,29 @@ static int32_t streamAddBlockToDispatchMsg(const SSDataBlock* pBlock, SStreamDis
   pRetrieve->numOfCols = htonl(numOfCols);
 
   int32_t actualLen = blockEncode(pBlock, pRetrieve->data, numOfCols);
+  ASSERT(actualLen + sizeof(SRetrieveTableRsp) <= dataStrLen);
+
+  if (tsStreamDispatchCompress) {
+    // data: raw length, followed by the lz4 output of the encoded block
+    void* pCompBuf = taosMemoryCalloc(1, sizeof(SRetrieveTableRsp) + sizeof(int32_t) + actualLen + 1);
+    if (pCompBuf == NULL) {
+      taosMemoryFree(buf);
+      return -1;
+    }
+    SRetrieveTableRsp* pComp = (SRetrieveTableRsp*)pCompBuf;
+    memcpy(pComp, pRetrieve, sizeof(SRetrieveTableRsp));
+    *(int32_t*)pComp->data = htonl(actualLen);
+    int32_t compLen = tsCompressString(pRetrieve->data, actualLen, 1, pComp->data + sizeof(int32_t), actualLen + 1,
+                                       ONE_STAGE_COMP, NULL, 0);
+    pComp->compressed = 1;
+    pComp->compLen = htonl(compLen);
+
+    taosMemoryFree(buf);
+    buf = pCompBuf;
+    actualLen = sizeof(int32_t) + compLen;
+  }
+
   actualLen += sizeof(SRetrieveTableRsp);
-  ASSERT(actualLen <= dataStrLen);
   taosArrayPush(pReq->dataLen, &actualLen);
   taosArrayPush(pReq->data, &buf);
 
@@ -493,6 +516,15 @@ int32_t streamDispatchAllBlocks(SStreamTask* pTask, const SStreamDataBlock* pDat
   return 0;
 }
 
+static int64_t streamDataBlockEncodeSize(const SStreamDataBlock* pData) {
+  int64_t size = 0;
+  int32_t blockNum = taosArrayGetSize(pData->blocks);
+  for (int32_t i = 0; i < blockNum; i++) {
+    size += sizeof(SRetrieveTableRsp) + blockGetEncodeSize(taosArrayGet(pData->blocks, i));
+  }
+  return size;
+}
+
 int32_t streamDispatch(SStreamTask* pTask) {
   ASSERT(pTask->outputType == TASK_OUTPUT__FIXED_DISPATCH || pTask->outputType == TASK_OUTPUT__SHUFFLE_DISPATCH);
 
@@ -510,7 +542,27 @@ int32_t streamDispatch(SStreamTask* pTask) {
   }
   ASSERT(pBlock->type == STREAM_INPUT__DATA_BLOCK);
 
-  qDebug("stream dispatching: task %d", pTask->taskId);
+  // coalesce the small results waiting in the output queue into one msg
+  int64_t size = streamDataBlockEncodeSize(pBlock);
+  int32_t itemNum = 1;
+  while (size < (int64_t)tsStreamDispatchBatchSize * 1024) {
+    SStreamDataBlock* pNext = streamQueueNextItem(pTask->outputQueue);
+    if (pNext == NULL) break;
+    if (pNext->srcVgId != pBlock->srcVgId) {
+      // keep it for the next msg
+      streamQueueProcessFail(pTask->outputQueue);
+      break;
+    }
+    size += streamDataBlockEncodeSize(pNext);
+    taosArrayAddAll(pBlock->blocks, pNext->blocks);
+    taosArrayDestroy(pNext->blocks);
+    taosFreeQitem(pNext);
+    itemNum++;
+  }
+
+  qDebug("stream dispatching: task %d, coalesced items: %d, size: %" PRId64, pTask->taskId, itemNum, size);
+
+  atomic_store_32(&pTask->roundCredit, INT32_MAX);
 
   int32_t code = 0;
   if (streamDispatchAllBlocks(pTask, pBlock) < 0) {
@@ -182,6 +182,21 @@ int32_t streamBatchExec(SStreamTask* pTask, int32_t batchLimit) {
 
 int32_t streamExecForAll(SStreamTask* pTask) {
   while (1) {
+    if (streamTaskOutputFull(pTask)) {
+      qDebug("stream task %d exec paused since output queue is full", pTask->taskId);
+      atomic_store_8(&pTask->execPaused, 1);
+      break;
+    }
+
+    // the submits are deferred while the replay is pending, so it comes after all the input queued before them
+    if (pTask->taskLevel == TASK_LEVEL__SOURCE && streamTaskReplayPending(pTask) &&
+        taosQueueEmpty(pTask->inputQueue->queue) && streamQueueCurItem(pTask->inputQueue) == NULL) {
+      if (streamSourceReplayFromCheckpoint(pTask) < 0) {
+        qError("task %d replay from checkpoint failed since %s", pTask->taskId, terrstr());
+      }
+      continue;
+    }
+
     int32_t batchCnt = 1;
     void*   input = NULL;
     while (1) {
@@ -226,6 +241,13 @@ int32_t streamExecForAll(SStreamTask* pTask) {
 
     SArray* pRes = taosArrayInit(0, sizeof(SSDataBlock));
 
+    // the operators may commit the state when done with the input, which then covers its version
+    if (((SStreamQueueItem*)input)->type == STREAM_INPUT__DATA_SUBMIT) {
+      streamStateSetCheckpointVer(pTask->pState, ((SStreamDataSubmit*)input)->ver);
+    } else if (((SStreamQueueItem*)input)->type == STREAM_INPUT__MERGED_SUBMIT) {
+      streamStateSetCheckpointVer(pTask->pState, ((SStreamMergedSubmit*)input)->ver);
+    }
+
     qDebug("stream task %d exec begin, msg batch: %d", pTask->taskId, batchCnt);
     streamTaskExecImpl(pTask, input, pRes);
     qDebug("stream task %d exec end", pTask->taskId);
@@ -260,6 +282,8 @@ int32_t streamExecForAll(SStreamTask* pTask) {
       taosArrayDestroy(pRes);
     }
     streamFreeQitem(input);
+
+    streamTaskDoCheckpoint(pTask);
   }
   return 0;
 }
@@ -275,7 +299,9 @@ int32_t streamTryExec(SStreamTask* pTask) {
     }
     atomic_store_8(&pTask->schedStatus, TASK_SCHED_STATUS__INACTIVE);
 
-    if (!taosQueueEmpty(pTask->inputQueue->queue)) {
+    bool pending = !taosQueueEmpty(pTask->inputQueue->queue) ||
+                   (pTask->taskLevel == TASK_LEVEL__SOURCE && streamTaskReplayPending(pTask));
+    if (pending && !atomic_load_8(&pTask->execPaused)) {
       streamSchedExec(pTask);
     }
   }
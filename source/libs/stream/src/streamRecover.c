@@ -14,6 +14,7 @@
  */
 
 #include "streamInc.h"
+#include "tglobal.h"
 
 int32_t streamTaskLaunchRecover(SStreamTask* pTask, int64_t version) {
   qDebug("task %d at node %d launch recover", pTask->taskId, pTask->nodeId);
@@ -204,6 +205,50 @@ int32_t streamSourceRecoverScanStep2(SStreamTask* pTask, int64_t ver) {
   return streamScanExec(pTask, 100);
 }
 
+// checkpoint
+int32_t streamTaskDoCheckpoint(SStreamTask* pTask) {
+  if (pTask->pState == NULL) {
+    return 0;
+  }
+
+  int64_t now = taosGetTimestampMs();
+  if (tsStreamCheckpointInterval <= 0 || now - pTask->lastCheckpointTs < tsStreamCheckpointInterval * 1000LL) {
+    return 0;
+  }
+  pTask->lastCheckpointTs = now;
+
+  // only the state pages dirtied since the last commit are written
+  if (streamStateCommit(pTask->pState) < 0) {
+    qError("task %d checkpoint failed since %s", pTask->taskId, terrstr());
+    return -1;
+  }
+
+  qDebug("task %d checkpoint at ver %" PRId64, pTask->taskId, streamStateGetCommittedVer(pTask->pState));
+  return 0;
+}
+
+int32_t streamSourceReplayFromCheckpoint(SStreamTask* pTask) {
+  ASSERT(pTask->taskLevel == TASK_LEVEL__SOURCE);
+  // the submits deferred from now on are replayed next time
+  int64_t endVer = atomic_load_64(&pTask->replayEndVer);
+  int64_t startVer = atomic_load_64(&pTask->replayStartVer);
+  atomic_store_64(&pTask->replayStartVer, endVer);
+
+  qInfo("task %d replay data of ver (%" PRId64 ", %" PRId64 "] from checkpoint", pTask->taskId, startVer, endVer);
+
+  // reuse the version ranged scan of recover step 2
+  void* exec = pTask->exec.executor;
+  if (qStreamSourceRecoverStep1(exec, startVer) < 0 || qStreamSourceRecoverStep2(exec, endVer) < 0) {
+    return -1;
+  }
+  if (streamScanExec(pTask, 100) < 0) {
+    return -1;
+  }
+
+  streamStateSetCheckpointVer(pTask->pState, endVer);
+  return 0;
+}
+
 int32_t streamDispatchRecoverFinishReq(SStreamTask* pTask) {
   SStreamRecoverFinishReq req = {
       .streamId = pTask->streamId,
@@ -17,6 +17,7 @@
 #include "streamInc.h"
 #include "tcommon.h"
 #include "tcompare.h"
+#include "tglobal.h"
 #include "ttimer.h"
 
 // todo refactor
@@ -25,6 +26,13 @@ typedef struct SStateKey {
   int64_t opNum;
 } SStateKey;
 
+// window state kept in the write-back cache, it is written into pStateDb only if dirty
+typedef struct SStateCacheEntry {
+  bool    dirty;
+  int32_t vLen;
+  char    data[];
+} SStateCacheEntry;
+
 typedef struct SStateSessionKey {
   SSessionKey key;
   int64_t     opNum;
@@ -106,6 +114,215 @@ static inline int stateKeyCmpr(const void* pKey1, int kLen1, const void* pKey2,
   return 0;
 }
 
+static void freeStateCacheEntry(void* param) { taosMemoryFree(*(SStateCacheEntry**)param); }
+
+static int32_t getStateCacheEntrySize(int32_t vLen) {
+  return sizeof(SStateKey) + sizeof(SStateCacheEntry) + POINTER_BYTES + vLen;
+}
+
+static int32_t streamStateCacheOpen(STdbState* pTdbState) {
+  if (tsStreamStateCacheSize <= 0) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  pTdbState->pStateCache = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
+  if (pTdbState->pStateCache == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  taosHashSetFreeFp(pTdbState->pStateCache, freeStateCacheEntry);
+  pTdbState->pDirtyKeys = taosArrayInit(64, sizeof(SStateKey));
+  if (pTdbState->pDirtyKeys == NULL) {
+    taosHashCleanup(pTdbState->pStateCache);
+    pTdbState->pStateCache = NULL;
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pTdbState->cacheSize = 0;
+  return TSDB_CODE_SUCCESS;
+}
+
+static void streamStateCacheClose(STdbState* pTdbState) {
+  taosHashCleanup(pTdbState->pStateCache);
+  pTdbState->pStateCache = NULL;
+  taosArrayDestroy(pTdbState->pDirtyKeys);
+  pTdbState->pDirtyKeys = NULL;
+  pTdbState->cacheSize = 0;
+}
+
+// write the dirty window states into pStateDb, the cached states are kept and become clean. Only the states updated
+// since the last flush are visited, so flushing before each cursor costs nothing if no state is updated in between.
+static int32_t streamStateCacheFlush(STdbState* pTdbState) {
+  if (pTdbState->pStateCache == NULL) {
+    return 0;
+  }
+
+  int32_t numOfKeys = (int32_t)taosArrayGetSize(pTdbState->pDirtyKeys);
+  for (int32_t i = 0; i < numOfKeys; ++i) {
+    SStateKey*         pKey = taosArrayGet(pTdbState->pDirtyKeys, i);
+    SStateCacheEntry** ppEntry = taosHashGet(pTdbState->pStateCache, pKey, sizeof(SStateKey));
+
+    // deleted, or already written since it is listed more than once
+    if (ppEntry == NULL || !(*ppEntry)->dirty) {
+      continue;
+    }
+
+    SStateCacheEntry* pEntry = *ppEntry;
+    if (tdbTbUpsert(pTdbState->pStateDb, pKey, sizeof(SStateKey), pEntry->data, pEntry->vLen, &pTdbState->txn) < 0) {
+      taosArrayPopFrontBatch(pTdbState->pDirtyKeys, i);
+      return -1;
+    }
+    pEntry->dirty = false;
+  }
+
+  taosArrayClear(pTdbState->pDirtyKeys);
+  return 0;
+}
+
+static void streamStateCacheClear(STdbState* pTdbState) {
+  if (pTdbState->pStateCache != NULL) {
+    taosHashClear(pTdbState->pStateCache);
+    taosArrayClear(pTdbState->pDirtyKeys);
+    pTdbState->cacheSize = 0;
+  }
+}
+
+// memory pressure, write the dirty states back and evict the clean ones until half of the budget is occupied. The
+// states are evicted in the iteration order of the hash, which is arbitrary: a recently updated state may go and is
+// then read from the db again on its next update.
+static int32_t streamStateCacheEvict(STdbState* pTdbState) {
+  if (streamStateCacheFlush(pTdbState) < 0) {
+    return -1;
+  }
+
+  int64_t limit = tsStreamStateCacheSize * 1048576LL / 2;
+  SArray* pKeys = taosArrayInit(64, sizeof(SStateKey));
+  if (pKeys == NULL) {
+    streamStateCacheClear(pTdbState);
+    return 0;
+  }
+
+  int64_t size = pTdbState->cacheSize;
+  void*   pIter = taosHashIterate(pTdbState->pStateCache, NULL);
+  while (pIter != NULL && size > limit) {
+    size_t keyLen = 0;
+    taosArrayPush(pKeys, taosHashGetKey(pIter, &keyLen));
+    size -= getStateCacheEntrySize((*(SStateCacheEntry**)pIter)->vLen);
+    pIter = taosHashIterate(pTdbState->pStateCache, pIter);
+  }
+  taosHashCancelIterate(pTdbState->pStateCache, pIter);
+
+  for (int32_t i = 0; i < taosArrayGetSize(pKeys); ++i) {
+    taosHashRemove(pTdbState->pStateCache, taosArrayGet(pKeys, i), sizeof(SStateKey));
+  }
+
+  pTdbState->cacheSize = size;
+  taosArrayDestroy(pKeys);
+  return 0;
+}
+
+static int32_t streamStateCachePut(STdbState* pTdbState, const SStateKey* pKey, const void* value, int32_t vLen,
+                                   bool dirty) {
+  SStateCacheEntry** ppEntry = taosHashGet(pTdbState->pStateCache, pKey, sizeof(SStateKey));
+  bool               wasDirty = (ppEntry != NULL && (*ppEntry)->dirty);
+
+  if (dirty && !wasDirty && taosArrayPush(pTdbState->pDirtyKeys, pKey) == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  // the window state is updated in place, which is the most common case
+  if (ppEntry != NULL && (*ppEntry)->vLen == vLen) {
+    if (vLen > 0) {
+      memcpy((*ppEntry)->data, value, vLen);
+    }
+    (*ppEntry)->dirty = wasDirty || dirty;
+    return 0;
+  }
+
+  SStateCacheEntry* pEntry = taosMemoryMalloc(sizeof(SStateCacheEntry) + vLen);
+  if (pEntry == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  pEntry->dirty = wasDirty || dirty;
+  pEntry->vLen = vLen;
+  if (vLen > 0) {
+    memcpy(pEntry->data, value, vLen);
+  }
+
+  if (ppEntry != NULL) {
+    pTdbState->cacheSize -= getStateCacheEntrySize((*ppEntry)->vLen);
+  }
+
+  if (taosHashPut(pTdbState->pStateCache, pKey, sizeof(SStateKey), &pEntry, POINTER_BYTES) != 0) {
+    taosMemoryFree(pEntry);
+    return -1;
+  }
+  pTdbState->cacheSize += getStateCacheEntrySize(vLen);
+
+  if (pTdbState->cacheSize > tsStreamStateCacheSize * 1048576LL) {
+    return streamStateCacheEvict(pTdbState);
+  }
+
+  return 0;
+}
+
+static int32_t streamStateCacheGet(STdbState* pTdbState, const SStateKey* pKey, void** pVal, int32_t* pVLen) {
+  SStateCacheEntry** ppEntry = taosHashGet(pTdbState->pStateCache, pKey, sizeof(SStateKey));
+  if (ppEntry == NULL) {
+    return -1;
+  }
+
+  // the value is released by streamFreeVal, the same as the one returned by tdbTbGet
+  SStateCacheEntry* pEntry = *ppEntry;
+  if (pVal != NULL) {
+    *pVal = NULL;
+    if (pEntry->vLen > 0) {
+      *pVal = tdbRealloc(NULL, pEntry->vLen);
+      if (*pVal == NULL) {
+        terrno = TSDB_CODE_OUT_OF_MEMORY;
+        return -1;
+      }
+      memcpy(*pVal, pEntry->data, pEntry->vLen);
+    }
+  }
+
+  if (pVLen != NULL) {
+    *pVLen = pEntry->vLen;
+  }
+  return 0;
+}
+
+#define STREAM_STATE_CHECKPOINT_KEY 0
+
+static int32_t streamStateCheckpointLoad(STdbState* pTdbState) {
+  int32_t key = STREAM_STATE_CHECKPOINT_KEY;
+  void*   pVal = NULL;
+  int32_t vLen = 0;
+
+  pTdbState->committedVer = -1;
+  if (tdbTbGet(pTdbState->pCheckpointDb, &key, sizeof(int32_t), &pVal, &vLen) == 0) {
+    if (vLen == sizeof(int64_t)) {
+      pTdbState->committedVer = *(int64_t*)pVal;
+    }
+    tdbFree(pVal);
+  }
+  pTdbState->checkpointVer = pTdbState->committedVer;
+  return 0;
+}
+
+// the processed version is written in the same txn as the window states, so both become durable at once
+static int32_t streamStateCheckpointPut(STdbState* pTdbState) {
+  if (pTdbState->checkpointVer == pTdbState->committedVer) {
+    return 0;
+  }
+  int32_t key = STREAM_STATE_CHECKPOINT_KEY;
+  return tdbTbUpsert(pTdbState->pCheckpointDb, &key, sizeof(int32_t), &pTdbState->checkpointVer, sizeof(int64_t),
+                     &pTdbState->txn);
+}
+
 SStreamState* streamStateOpen(char* path, SStreamTask* pTask, bool specPath, int32_t szPage, int32_t pages) {
   szPage = szPage < 0 ? 4096 : szPage;
   pages = pages < 0 ? 256 : pages;
@@ -159,10 +376,21 @@ SStreamState* streamStateOpen(char* path, SStreamTask* pTask, bool specPath, int
     goto _err;
   }
 
+  if (tdbTbOpen("checkpoint.state.db", sizeof(int32_t), sizeof(int64_t), NULL, pState->pTdbState->db,
+                &pState->pTdbState->pCheckpointDb, 0) < 0) {
+    goto _err;
+  }
+
+  streamStateCheckpointLoad(pState->pTdbState);
+
   if (streamStateBegin(pState) < 0) {
     goto _err;
   }
 
+  if (streamStateCacheOpen(pState->pTdbState) != TSDB_CODE_SUCCESS) {
+    goto _err;
+  }
+
   pState->pTdbState->pOwner = pTask;
 
   return pState;
@@ -173,12 +401,15 @@ _err:
   tdbTbClose(pState->pTdbState->pFillStateDb);
   tdbTbClose(pState->pTdbState->pSessionStateDb);
   tdbTbClose(pState->pTdbState->pParNameDb);
+  tdbTbClose(pState->pTdbState->pCheckpointDb);
   tdbClose(pState->pTdbState->db);
   streamStateDestroy(pState);
   return NULL;
 }
 
 void streamStateClose(SStreamState* pState) {
+  streamStateCacheFlush(pState->pTdbState);
+  streamStateCheckpointPut(pState->pTdbState);
   tdbCommit(pState->pTdbState->db, &pState->pTdbState->txn);
   tdbPostCommit(pState->pTdbState->db, &pState->pTdbState->txn);
   tdbTbClose(pState->pTdbState->pStateDb);
@@ -186,6 +417,7 @@ void streamStateClose(SStreamState* pState) {
   tdbTbClose(pState->pTdbState->pFillStateDb);
   tdbTbClose(pState->pTdbState->pSessionStateDb);
   tdbTbClose(pState->pTdbState->pParNameDb);
+  tdbTbClose(pState->pTdbState->pCheckpointDb);
   tdbClose(pState->pTdbState->db);
 
   streamStateDestroy(pState);
@@ -205,12 +437,20 @@ int32_t streamStateBegin(SStreamState* pState) {
 }
 
 int32_t streamStateCommit(SStreamState* pState) {
+  int64_t checkpointVer = pState->pTdbState->checkpointVer;
+  if (streamStateCacheFlush(pState->pTdbState) < 0) {
+    return -1;
+  }
+  if (streamStateCheckpointPut(pState->pTdbState) < 0) {
+    return -1;
+  }
   if (tdbCommit(pState->pTdbState->db, &pState->pTdbState->txn) < 0) {
     return -1;
   }
   if (tdbPostCommit(pState->pTdbState->db, &pState->pTdbState->txn) < 0) {
     return -1;
   }
+  pState->pTdbState->committedVer = checkpointVer;
   memset(&pState->pTdbState->txn, 0, sizeof(TXN));
   if (tdbTxnOpen(&pState->pTdbState->txn, 0, tdbDefaultMalloc, tdbDefaultFree, NULL,
                  TDB_TXN_WRITE | TDB_TXN_READ_UNCOMMITTED) < 0) {
@@ -223,6 +463,9 @@ int32_t streamStateCommit(SStreamState* pState) {
 }
 
 int32_t streamStateAbort(SStreamState* pState) {
+  // the uncommitted window states in cache are discarded along with the transaction
+  streamStateCacheClear(pState->pTdbState);
+  pState->pTdbState->checkpointVer = pState->pTdbState->committedVer;
   if (tdbAbort(pState->pTdbState->db, &pState->pTdbState->txn) < 0) {
     return -1;
   }
@@ -251,6 +494,9 @@ int32_t streamStateFuncDel(SStreamState* pState, const STupleKey* key) {
 // todo refactor
 int32_t streamStatePut(SStreamState* pState, const SWinKey* key, const void* value, int32_t vLen) {
   SStateKey sKey = {.key = *key, .opNum = pState->number};
+  if (pState->pTdbState->pStateCache != NULL) {
+    return streamStateCachePut(pState->pTdbState, &sKey, value, vLen, true);
+  }
   return tdbTbUpsert(pState->pTdbState->pStateDb, &sKey, sizeof(SStateKey), value, vLen, &pState->pTdbState->txn);
 }
 
@@ -261,8 +507,22 @@ int32_t streamStateFillPut(SStreamState* pState, const SWinKey* key, const void*
 
 // todo refactor
 int32_t streamStateGet(SStreamState* pState, const SWinKey* key, void** pVal, int32_t* pVLen) {
-  SStateKey sKey = {.key = *key, .opNum = pState->number};
-  return tdbTbGet(pState->pTdbState->pStateDb, &sKey, sizeof(SStateKey), pVal, pVLen);
+  SStateKey  sKey = {.key = *key, .opNum = pState->number};
+  STdbState* pTdbState = pState->pTdbState;
+  if (pTdbState->pStateCache == NULL) {
+    return tdbTbGet(pTdbState->pStateDb, &sKey, sizeof(SStateKey), pVal, pVLen);
+  }
+
+  if (streamStateCacheGet(pTdbState, &sKey, pVal, pVLen) == 0) {
+    return 0;
+  }
+
+  int32_t code = tdbTbGet(pTdbState->pStateDb, &sKey, sizeof(SStateKey), pVal, pVLen);
+  if (code == 0) {
+    // keep it in cache, since it is most likely to be updated soon
+    streamStateCachePut(pTdbState, &sKey, *pVal, *pVLen, false);
+  }
+  return code;
 }
 
 // todo refactor
@@ -272,8 +532,22 @@ int32_t streamStateFillGet(SStreamState* pState, const SWinKey* key, void** pVal
 
 // todo refactor
 int32_t streamStateDel(SStreamState* pState, const SWinKey* key) {
-  SStateKey sKey = {.key = *key, .opNum = pState->number};
-  return tdbTbDelete(pState->pTdbState->pStateDb, &sKey, sizeof(SStateKey), &pState->pTdbState->txn);
+  SStateKey  sKey = {.key = *key, .opNum = pState->number};
+  STdbState* pTdbState = pState->pTdbState;
+
+  bool cached = false;
+  if (pTdbState->pStateCache != NULL) {
+    SStateCacheEntry** ppEntry = taosHashGet(pTdbState->pStateCache, &sKey, sizeof(SStateKey));
+    if (ppEntry != NULL) {
+      pTdbState->cacheSize -= getStateCacheEntrySize((*ppEntry)->vLen);
+      taosHashRemove(pTdbState->pStateCache, &sKey, sizeof(SStateKey));
+      cached = true;
+    }
+  }
+
+  // the dirty state may have not been written into pStateDb yet
+  int32_t code = tdbTbDelete(pTdbState->pStateDb, &sKey, sizeof(SStateKey), &pTdbState->txn);
+  return cached ? 0 : code;
 }
 
 int32_t streamStateClear(SStreamState* pState) {
@@ -321,6 +595,11 @@ int32_t streamStateReleaseBuf(SStreamState* pState, const SWinKey* key, void* pV
 }
 
 SStreamStateCur* streamStateGetCur(SStreamState* pState, const SWinKey* key) {
+  // the cursor traverses pStateDb only
+  if (streamStateCacheFlush(pState->pTdbState) < 0) {
+    return NULL;
+  }
+
   SStreamStateCur* pCur = taosMemoryCalloc(1, sizeof(SStreamStateCur));
   if (pCur == NULL) return NULL;
   tdbTbcOpen(pState->pTdbState->pStateDb, &pCur->pCur, NULL);
@@ -427,6 +706,11 @@ int32_t streamStateSeekLast(SStreamState* pState, SStreamStateCur* pCur) {
 }
 
 SStreamStateCur* streamStateSeekKeyNext(SStreamState* pState, const SWinKey* key) {
+  // the cursor traverses pStateDb only
+  if (streamStateCacheFlush(pState->pTdbState) < 0) {
+    return NULL;
+  }
+
   SStreamStateCur* pCur = taosMemoryCalloc(1, sizeof(SStreamStateCur));
   if (pCur == NULL) {
     return NULL;
@@ -842,7 +1126,18 @@ int32_t streamStateGetParName(SStreamState* pState, int64_t groupId, void** pVal
   return tdbTbGet(pState->pTdbState->pParNameDb, &groupId, sizeof(int64_t), pVal, &len);
 }
 
+void streamStateSetCheckpointVer(SStreamState* pState, int64_t ver) {
+  if (ver > pState->pTdbState->checkpointVer) {
+    pState->pTdbState->checkpointVer = ver;
+  }
+}
+
+int64_t streamStateGetCommittedVer(SStreamState* pState) { return pState->pTdbState->committedVer; }
+
 void streamStateDestroy(SStreamState* pState) {
+  if (pState->pTdbState != NULL) {
+    streamStateCacheClose(pState->pTdbState);
+  }
   taosMemoryFreeClear(pState->pTdbState);
   taosMemoryFreeClear(pState);
 }
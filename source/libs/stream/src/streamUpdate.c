@@ -19,43 +19,14 @@
 #include "tstreamUpdate.h"
 #include "ttime.h"
 
-#define DEFAULT_FALSE_POSITIVE   0.01
-#define DEFAULT_BUCKET_SIZE      1310720
-#define DEFAULT_MAP_CAPACITY     1310720
-#define DEFAULT_MAP_SIZE         (DEFAULT_MAP_CAPACITY * 10)
-#define ROWS_PER_MILLISECOND     1
-#define MAX_NUM_SCALABLE_BF      100000
-#define MIN_NUM_SCALABLE_BF      10
-#define DEFAULT_PREADD_BUCKET    1
-#define MAX_INTERVAL             MILLISECOND_PER_MINUTE
-#define MIN_INTERVAL             (MILLISECOND_PER_SECOND * 10)
-#define DEFAULT_EXPECTED_ENTRIES 10000
-
-static int64_t adjustExpEntries(int64_t entries) { return TMIN(DEFAULT_EXPECTED_ENTRIES, entries); }
-
-static void windowSBfAdd(SUpdateInfo *pInfo, uint64_t count) {
-  if (pInfo->numSBFs < count) {
-    count = pInfo->numSBFs;
-  }
-  for (uint64_t i = 0; i < count; ++i) {
-    int64_t      rows = adjustExpEntries(pInfo->interval * ROWS_PER_MILLISECOND);
-    SScalableBf *tsSBF = tScalableBfInit(rows, DEFAULT_FALSE_POSITIVE);
-    taosArrayPush(pInfo->pTsSBFs, &tsSBF);
-  }
-}
+#define DEFAULT_MAP_CAPACITY       131072
+#define DEFAULT_RUN_CAPACITY       1
+#define MAX_NUM_WATERMARK_INTERVAL 100000
+#define MAX_INTERVAL               MILLISECOND_PER_MINUTE
+#define MIN_INTERVAL               (MILLISECOND_PER_SECOND * 10)
 
-static void windowSBfDelete(SUpdateInfo *pInfo, uint64_t count) {
-  if (count < pInfo->numSBFs) {
-    for (uint64_t i = 0; i < count; ++i) {
-      SScalableBf *pTsSBFs = taosArrayGetP(pInfo->pTsSBFs, 0);
-      tScalableBfDestroy(pTsSBFs);
-      taosArrayRemove(pInfo->pTsSBFs, 0);
-    }
-  } else {
-    taosArrayClearP(pInfo->pTsSBFs, (FDelete)tScalableBfDestroy);
-  }
-  pInfo->minTS += pInfo->interval * count;
-}
+// Each table keeps the exact keys within [maxTs - watermark, maxTs]. The keys are stored as runs of equally spaced
+// timestamps, so the rows of a table written at a fixed frequency take a single run no matter how many of them.
 
 static int64_t adjustInterval(int64_t interval, int32_t precision) {
   int64_t val = interval;
@@ -78,14 +49,19 @@ static int64_t adjustInterval(int64_t interval, int32_t precision) {
 static int64_t adjustWatermark(int64_t adjInterval, int64_t originInt, int64_t watermark) {
   if (watermark <= adjInterval) {
     watermark = TMAX(originInt / adjInterval, 1) * adjInterval;
-  } else if (watermark > MAX_NUM_SCALABLE_BF * adjInterval) {
-    watermark = MAX_NUM_SCALABLE_BF * adjInterval;
+  } else if (watermark > MAX_NUM_WATERMARK_INTERVAL * adjInterval) {
+    watermark = MAX_NUM_WATERMARK_INTERVAL * adjInterval;
   }/* else if (watermark < MIN_NUM_SCALABLE_BF * adjInterval) {
     watermark = MIN_NUM_SCALABLE_BF * adjInterval;
   }*/ // Todo(liuyao) save window info to tdb
   return watermark;
 }
 
+static void destroyTableUpdateInfo(void *param) {
+  STableUpdateInfo *pTbInfo = param;
+  taosArrayDestroy(pTbInfo->pRuns);
+}
+
 SUpdateInfo *updateInfoInitP(SInterval *pInterval, int64_t watermark) {
   return updateInfoInit(pInterval->interval, pInterval->precision, watermark);
 }
@@ -95,148 +71,198 @@ SUpdateInfo *updateInfoInit(int64_t interval, int32_t precision, int64_t waterma
   if (pInfo == NULL) {
     return NULL;
   }
-  pInfo->pTsBuckets = NULL;
-  pInfo->pTsSBFs = NULL;
-  pInfo->minTS = -1;
   pInfo->interval = adjustInterval(interval, precision);
   pInfo->watermark = adjustWatermark(pInfo->interval, interval, watermark);
+  pInfo->pCloseWinSet = NULL;
 
-  uint64_t bfSize = (uint64_t)(pInfo->watermark / pInfo->interval);
-
-  pInfo->pTsSBFs = taosArrayInit(bfSize, sizeof(void *));
-  if (pInfo->pTsSBFs == NULL) {
-    updateInfoDestroy(pInfo);
-    return NULL;
-  }
-  pInfo->numSBFs = bfSize;
-  windowSBfAdd(pInfo, bfSize);
-
-  pInfo->pTsBuckets = taosArrayInit(DEFAULT_BUCKET_SIZE, sizeof(TSKEY));
-  if (pInfo->pTsBuckets == NULL) {
+  _hash_fn_t hashFn = taosGetDefaultHashFunction(TSDB_DATA_TYPE_UBIGINT);
+  pInfo->pMap = taosHashInit(DEFAULT_MAP_CAPACITY, hashFn, true, HASH_NO_LOCK);
+  if (pInfo->pMap == NULL) {
     updateInfoDestroy(pInfo);
     return NULL;
   }
+  taosHashSetFreeFp(pInfo->pMap, destroyTableUpdateInfo);
 
-  TSKEY dumy = 0;
-  for (uint64_t i = 0; i < DEFAULT_BUCKET_SIZE; ++i) {
-    taosArrayPush(pInfo->pTsBuckets, &dumy);
-  }
-  pInfo->numBuckets = DEFAULT_BUCKET_SIZE;
-  pInfo->pCloseWinSBF = NULL;
-  _hash_fn_t hashFn = taosGetDefaultHashFunction(TSDB_DATA_TYPE_UBIGINT);
-  pInfo->pMap = taosHashInit(DEFAULT_MAP_CAPACITY, hashFn, true, HASH_NO_LOCK);
   pInfo->maxVersion = 0;
   pInfo->scanGroupId = 0;
   pInfo->scanWindow = (STimeWindow){.skey = INT64_MIN, .ekey = INT64_MAX};
   return pInfo;
 }
 
-static SScalableBf *getSBf(SUpdateInfo *pInfo, TSKEY ts) {
-  if (ts <= 0) {
-    return NULL;
+static inline TSKEY updateRunLastKey(const SUpdateRun *pRun) { return pRun->skey + pRun->step * (pRun->num - 1); }
+
+static inline bool updateRunContains(const SUpdateRun *pRun, TSKEY ts) {
+  if (ts < pRun->skey || ts > updateRunLastKey(pRun)) return false;
+  return pRun->num == 1 || (ts - pRun->skey) % pRun->step == 0;
+}
+
+// index of the last run starting no later than ts, or pTbInfo->start - 1 if there is none
+static int32_t updateRunSearch(const STableUpdateInfo *pTbInfo, TSKEY ts) {
+  int32_t low = pTbInfo->start;
+  int32_t high = (int32_t)taosArrayGetSize(pTbInfo->pRuns) - 1;
+  while (low <= high) {
+    int32_t     mid = low + (high - low) / 2;
+    SUpdateRun *pRun = taosArrayGet(pTbInfo->pRuns, mid);
+    if (pRun->skey <= ts) {
+      low = mid + 1;
+    } else {
+      high = mid - 1;
+    }
   }
-  if (pInfo->minTS < 0) {
-    pInfo->minTS = (TSKEY)(ts / pInfo->interval * pInfo->interval);
+  return high;
+}
+
+static STableUpdateInfo *getTableUpdateInfo(SUpdateInfo *pInfo, uint64_t tableId) {
+  STableUpdateInfo *pTbInfo = taosHashGet(pInfo->pMap, &tableId, sizeof(uint64_t));
+  if (pTbInfo != NULL) {
+    return pTbInfo;
   }
-  int64_t index = (int64_t)((ts - pInfo->minTS) / pInfo->interval);
-  if (index < 0) {
+
+  STableUpdateInfo tbInfo = {.maxTs = INT64_MIN, .start = 0};
+  tbInfo.pRuns = taosArrayInit(DEFAULT_RUN_CAPACITY, sizeof(SUpdateRun));
+  if (tbInfo.pRuns == NULL) {
     return NULL;
   }
-  if (index >= pInfo->numSBFs) {
-    uint64_t count = index + 1 - pInfo->numSBFs;
-    windowSBfDelete(pInfo, count);
-    windowSBfAdd(pInfo, count);
-    index = pInfo->numSBFs - 1;
+  if (taosHashPut(pInfo->pMap, &tableId, sizeof(uint64_t), &tbInfo, sizeof(STableUpdateInfo)) != 0) {
+    taosArrayDestroy(tbInfo.pRuns);
+    return NULL;
   }
-  SScalableBf *res = taosArrayGetP(pInfo->pTsSBFs, index);
-  if (res == NULL) {
-    int64_t rows = adjustExpEntries(pInfo->interval * ROWS_PER_MILLISECOND);
-    res = tScalableBfInit(rows, DEFAULT_FALSE_POSITIVE);
-    taosArrayPush(pInfo->pTsSBFs, &res);
+  return taosHashGet(pInfo->pMap, &tableId, sizeof(uint64_t));
+}
+
+// drop the keys below the watermark, the runs are removed lazily to avoid moving the array on every new key
+static void expireTableUpdateInfo(STableUpdateInfo *pTbInfo, int64_t watermark) {
+  TSKEY   bound = pTbInfo->maxTs - watermark;
+  int32_t size = taosArrayGetSize(pTbInfo->pRuns);
+  while (pTbInfo->start < size) {
+    SUpdateRun *pRun = taosArrayGet(pTbInfo->pRuns, pTbInfo->start);
+    if (updateRunLastKey(pRun) < bound) {
+      pTbInfo->start++;
+      continue;
+    }
+    if (pRun->skey < bound) {
+      int64_t num = (bound - pRun->skey + pRun->step - 1) / pRun->step;
+      pRun->skey += num * pRun->step;
+      pRun->num -= num;
+    }
+    break;
+  }
+
+  if (pTbInfo->start > 0 && pTbInfo->start * 2 >= size) {
+    taosArrayPopFrontBatch(pTbInfo->pRuns, pTbInfo->start);
+    pTbInfo->start = 0;
   }
-  return res;
 }
 
-bool updateInfoIsTableInserted(SUpdateInfo *pInfo, int64_t tbUid) {
-  void *pVal = taosHashGet(pInfo->pMap, &tbUid, sizeof(int64_t));
-  if (pVal || taosHashGetSize(pInfo->pMap) >= DEFAULT_MAP_SIZE) return true;
+// return true if the key has been seen
+static bool tableUpdateInfoPut(STableUpdateInfo *pTbInfo, TSKEY ts) {
+  int32_t index = updateRunSearch(pTbInfo, ts);
+  if (index < pTbInfo->start) {
+    SUpdateRun run = {.skey = ts, .step = 0, .num = 1};
+    taosArrayInsert(pTbInfo->pRuns, pTbInfo->start, &run);
+    return false;
+  }
+
+  SUpdateRun *pRun = taosArrayGet(pTbInfo->pRuns, index);
+  if (updateRunContains(pRun, ts)) {
+    return true;
+  }
+
+  TSKEY lastKey = updateRunLastKey(pRun);
+  if (ts > lastKey) {
+    // ts lies before the next run, extend the run if ts is the next one in it
+    if (pRun->num == 1) {
+      pRun->step = ts - pRun->skey;
+      pRun->num = 2;
+    } else if (ts - lastKey == pRun->step) {
+      pRun->num++;
+    } else {
+      SUpdateRun run = {.skey = ts, .step = 0, .num = 1};
+      taosArrayInsert(pTbInfo->pRuns, index + 1, &run);
+    }
+    return false;
+  }
+
+  // ts falls between two keys of the run, split it
+  int32_t    numLeft = (int32_t)((ts - pRun->skey) / pRun->step) + 1;
+  SUpdateRun right = {.skey = pRun->skey + pRun->step * numLeft, .step = pRun->step, .num = pRun->num - numLeft};
+  SUpdateRun mid = {.skey = ts, .step = 0, .num = 1};
+  pRun->num = numLeft;
+  if (right.num == 1) right.step = 0;
+  if (pRun->num == 1) pRun->step = 0;
+  taosArrayInsert(pTbInfo->pRuns, index + 1, &mid);
+  taosArrayInsert(pTbInfo->pRuns, index + 2, &right);
   return false;
 }
 
+static bool closeWindowSetPut(SUpdateInfo *pInfo, uint64_t tableId, TSKEY ts) {
+  SUpdateKey updateKey = {.tbUid = tableId, .ts = ts};
+  if (taosHashGet(pInfo->pCloseWinSet, &updateKey, sizeof(SUpdateKey)) != NULL) {
+    return true;
+  }
+  taosHashPut(pInfo->pCloseWinSet, &updateKey, sizeof(SUpdateKey), NULL, 0);
+  return false;
+}
+
+bool updateInfoIsTableInserted(SUpdateInfo *pInfo, int64_t tbUid) {
+  STableUpdateInfo *pTbInfo = taosHashGet(pInfo->pMap, &tbUid, sizeof(int64_t));
+  return pTbInfo != NULL && pTbInfo->maxTs != INT64_MIN;
+}
+
 TSKEY updateInfoFillBlockData(SUpdateInfo *pInfo, SSDataBlock *pBlock, int32_t primaryTsCol) {
   if (pBlock == NULL || pBlock->info.rows == 0) return INT64_MIN;
   TSKEY   maxTs = INT64_MIN;
   int64_t tbUid = pBlock->info.uid;
 
-  SColumnInfoData *pColDataInfo = taosArrayGet(pBlock->pDataBlock, primaryTsCol);
+  STableUpdateInfo *pTbInfo = getTableUpdateInfo(pInfo, tbUid);
+  if (pTbInfo == NULL) return INT64_MIN;
 
+  SColumnInfoData *pColDataInfo = taosArrayGet(pBlock->pDataBlock, primaryTsCol);
   for (int32_t i = 0; i < pBlock->info.rows; i++) {
     TSKEY ts = ((TSKEY *)pColDataInfo->pData)[i];
     maxTs = TMAX(maxTs, ts);
-    SScalableBf *pSBf = getSBf(pInfo, ts);
-    if (pSBf) {
-      SUpdateKey updateKey = {
-          .tbUid = tbUid,
-          .ts = ts,
-      };
-      tScalableBfPut(pSBf, &updateKey, sizeof(SUpdateKey));
+    if (pTbInfo->maxTs != INT64_MIN && ts < pTbInfo->maxTs - pInfo->watermark) {
+      continue;
+    }
+    tableUpdateInfoPut(pTbInfo, ts);
+    if (ts > pTbInfo->maxTs) {
+      pTbInfo->maxTs = ts;
+      expireTableUpdateInfo(pTbInfo, pInfo->watermark);
     }
-  }
-  TSKEY *pMaxTs = taosHashGet(pInfo->pMap, &tbUid, sizeof(int64_t));
-  if (pMaxTs == NULL || *pMaxTs > maxTs) {
-    taosHashPut(pInfo->pMap, &tbUid, sizeof(int64_t), &maxTs, sizeof(TSKEY));
   }
   return maxTs;
 }
 
 bool updateInfoIsUpdated(SUpdateInfo *pInfo, uint64_t tableId, TSKEY ts) {
-  int32_t res = TSDB_CODE_FAILED;
+  pInfo->stat.numOfChecked++;
 
-  SUpdateKey updateKey = {
-      .tbUid = tableId,
-      .ts = ts,
-  };
+  STableUpdateInfo *pTbInfo = getTableUpdateInfo(pInfo, tableId);
+  if (pTbInfo == NULL) {
+    // check from tsdb api
+    return true;
+  }
 
-  TSKEY   *pMapMaxTs = taosHashGet(pInfo->pMap, &tableId, sizeof(uint64_t));
-  uint64_t index = ((uint64_t)tableId) % pInfo->numBuckets;
-  TSKEY    maxTs = *(TSKEY *)taosArrayGet(pInfo->pTsBuckets, index);
-  if (ts < maxTs - pInfo->watermark) {
+  if (pTbInfo->maxTs != INT64_MIN && ts < pTbInfo->maxTs - pInfo->watermark) {
     // this window has been closed.
-    if (pInfo->pCloseWinSBF) {
-      res = tScalableBfPut(pInfo->pCloseWinSBF, &updateKey, sizeof(SUpdateKey));
-      if (res == TSDB_CODE_SUCCESS) {
-        return false;
-      } else {
-        return true;
-      }
+    if (pInfo->pCloseWinSet) {
+      bool seen = closeWindowSetPut(pInfo, tableId, ts);
+      if (seen) pInfo->stat.numOfUpdated++;
+      return seen;
     }
+    pInfo->stat.numOfExpired++;
     return true;
   }
 
-  SScalableBf *pSBf = getSBf(pInfo, ts);
-  // pSBf may be a null pointer
-  if (pSBf) {
-    res = tScalableBfPut(pSBf, &updateKey, sizeof(SUpdateKey));
-  }
-
-  int32_t size = taosHashGetSize(pInfo->pMap);
-  if ((!pMapMaxTs && size < DEFAULT_MAP_SIZE) || (pMapMaxTs && *pMapMaxTs < ts)) {
-    taosHashPut(pInfo->pMap, &tableId, sizeof(uint64_t), &ts, sizeof(TSKEY));
-    return false;
-  }
-
-  if (!pMapMaxTs && maxTs < ts) {
-    taosArraySet(pInfo->pTsBuckets, index, &ts);
-    return false;
+  if (tableUpdateInfoPut(pTbInfo, ts)) {
+    pInfo->stat.numOfUpdated++;
+    return true;
   }
 
-  if (ts < pInfo->minTS) {
-    return true;
-  } else if (res == TSDB_CODE_SUCCESS) {
-    return false;
+  if (ts > pTbInfo->maxTs) {
+    pTbInfo->maxTs = ts;
+    expireTableUpdateInfo(pTbInfo, pInfo->watermark);
   }
-  // check from tsdb api
-  return true;
+  return false;
 }
 
 void updateInfoSetScanRange(SUpdateInfo *pInfo, STimeWindow *pWin, uint64_t groupId, uint64_t version) {
@@ -266,33 +292,28 @@ void updateInfoDestroy(SUpdateInfo *pInfo) {
   if (pInfo == NULL) {
     return;
   }
-  taosArrayDestroy(pInfo->pTsBuckets);
-
-  uint64_t size = taosArrayGetSize(pInfo->pTsSBFs);
-  for (uint64_t i = 0; i < size; i++) {
-    SScalableBf *pSBF = taosArrayGetP(pInfo->pTsSBFs, i);
-    tScalableBfDestroy(pSBF);
-  }
+  qDebug("===stream===update info destroyed, rows checked:%" PRId64 ", updated:%" PRId64 ", below watermark:%" PRId64,
+         pInfo->stat.numOfChecked, pInfo->stat.numOfUpdated, pInfo->stat.numOfExpired);
 
-  taosArrayDestroy(pInfo->pTsSBFs);
+  taosHashCleanup(pInfo->pCloseWinSet);
   taosHashCleanup(pInfo->pMap);
   taosMemoryFree(pInfo);
 }
 
-void updateInfoAddCloseWindowSBF(SUpdateInfo *pInfo) {
-  if (pInfo->pCloseWinSBF) {
+void updateInfoAddCloseWindowSet(SUpdateInfo *pInfo) {
+  if (pInfo->pCloseWinSet) {
     return;
   }
-  int64_t rows = adjustExpEntries(pInfo->interval * ROWS_PER_MILLISECOND);
-  pInfo->pCloseWinSBF = tScalableBfInit(rows, DEFAULT_FALSE_POSITIVE);
+  pInfo->pCloseWinSet =
+      taosHashInit(DEFAULT_MAP_CAPACITY, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
 }
 
-void updateInfoDestoryColseWinSBF(SUpdateInfo *pInfo) {
-  if (!pInfo || !pInfo->pCloseWinSBF) {
+void updateInfoDestroyCloseWindowSet(SUpdateInfo *pInfo) {
+  if (!pInfo || !pInfo->pCloseWinSet) {
     return;
   }
-  tScalableBfDestroy(pInfo->pCloseWinSBF);
-  pInfo->pCloseWinSBF = NULL;
+  taosHashCleanup(pInfo->pCloseWinSet);
+  pInfo->pCloseWinSet = NULL;
 }
 
 int32_t updateInfoSerialize(void *buf, int32_t bufLen, const SUpdateInfo *pInfo) {
@@ -301,37 +322,35 @@ int32_t updateInfoSerialize(void *buf, int32_t bufLen, const SUpdateInfo *pInfo)
   tEncoderInit(&encoder, buf, bufLen);
   if (tStartEncode(&encoder) < 0) return -1;
 
-  int32_t size = taosArrayGetSize(pInfo->pTsBuckets);
-  if (tEncodeI32(&encoder, size) < 0) return -1;
-  for (int32_t i = 0; i < size; i++) {
-    TSKEY *pTs = (TSKEY *)taosArrayGet(pInfo->pTsBuckets, i);
-    if (tEncodeI64(&encoder, *pTs) < 0) return -1;
-  }
-
-  if (tEncodeU64(&encoder, pInfo->numBuckets) < 0) return -1;
-
-  int32_t sBfSize = taosArrayGetSize(pInfo->pTsSBFs);
-  if (tEncodeI32(&encoder, sBfSize) < 0) return -1;
-  for (int32_t i = 0; i < sBfSize; i++) {
-    SScalableBf *pSBf = taosArrayGetP(pInfo->pTsSBFs, i);
-    if (tScalableBfEncode(pSBf, &encoder) < 0) return -1;
-  }
-
-  if (tEncodeU64(&encoder, pInfo->numSBFs) < 0) return -1;
   if (tEncodeI64(&encoder, pInfo->interval) < 0) return -1;
   if (tEncodeI64(&encoder, pInfo->watermark) < 0) return -1;
-  if (tEncodeI64(&encoder, pInfo->minTS) < 0) return -1;
-
-  if (tScalableBfEncode(pInfo->pCloseWinSBF, &encoder) < 0) return -1;
 
   int32_t mapSize = taosHashGetSize(pInfo->pMap);
   if (tEncodeI32(&encoder, mapSize) < 0) return -1;
   void  *pIte = NULL;
   size_t keyLen = 0;
   while ((pIte = taosHashIterate(pInfo->pMap, pIte)) != NULL) {
-    void *key = taosHashGetKey(pIte, &keyLen);
+    void             *key = taosHashGetKey(pIte, &keyLen);
+    STableUpdateInfo *pTbInfo = pIte;
+    int32_t           size = taosArrayGetSize(pTbInfo->pRuns);
     if (tEncodeU64(&encoder, *(uint64_t *)key) < 0) return -1;
-    if (tEncodeI64(&encoder, *(TSKEY *)pIte) < 0) return -1;
+    if (tEncodeI64(&encoder, pTbInfo->maxTs) < 0) return -1;
+    if (tEncodeI32(&encoder, size - pTbInfo->start) < 0) return -1;
+    for (int32_t i = pTbInfo->start; i < size; i++) {
+      SUpdateRun *pRun = taosArrayGet(pTbInfo->pRuns, i);
+      if (tEncodeI64(&encoder, pRun->skey) < 0) return -1;
+      if (tEncodeI64(&encoder, pRun->step) < 0) return -1;
+      if (tEncodeI32(&encoder, pRun->num) < 0) return -1;
+    }
+  }
+
+  int32_t closeSize = pInfo->pCloseWinSet ? taosHashGetSize(pInfo->pCloseWinSet) : -1;
+  if (tEncodeI32(&encoder, closeSize) < 0) return -1;
+  pIte = NULL;
+  while (pInfo->pCloseWinSet && (pIte = taosHashIterate(pInfo->pCloseWinSet, pIte)) != NULL) {
+    SUpdateKey *pKey = taosHashGetKey(pIte, &keyLen);
+    if (tEncodeI64(&encoder, pKey->tbUid) < 0) return -1;
+    if (tEncodeI64(&encoder, pKey->ts) < 0) return -1;
   }
 
   if (tEncodeI64(&encoder, pInfo->scanWindow.skey) < 0) return -1;
@@ -352,45 +371,43 @@ int32_t updateInfoDeserialize(void *buf, int32_t bufLen, SUpdateInfo *pInfo) {
   tDecoderInit(&decoder, buf, bufLen);
   if (tStartDecode(&decoder) < 0) return -1;
 
-  int32_t size = 0;
-  if (tDecodeI32(&decoder, &size) < 0) return -1;
-  pInfo->pTsBuckets = taosArrayInit(size, sizeof(TSKEY));
-  TSKEY ts = INT64_MIN;
-  for (int32_t i = 0; i < size; i++) {
-    if (tDecodeI64(&decoder, &ts) < 0) return -1;
-    taosArrayPush(pInfo->pTsBuckets, &ts);
-  }
-
-  if (tDecodeU64(&decoder, &pInfo->numBuckets) < 0) return -1;
-
-  int32_t sBfSize = 0;
-  if (tDecodeI32(&decoder, &sBfSize) < 0) return -1;
-  pInfo->pTsSBFs = taosArrayInit(sBfSize, sizeof(void *));
-  for (int32_t i = 0; i < sBfSize; i++) {
-    SScalableBf *pSBf = tScalableBfDecode(&decoder);
-    if (!pSBf) return -1;
-    taosArrayPush(pInfo->pTsSBFs, &pSBf);
-  }
-
-  if (tDecodeU64(&decoder, &pInfo->numSBFs) < 0) return -1;
   if (tDecodeI64(&decoder, &pInfo->interval) < 0) return -1;
   if (tDecodeI64(&decoder, &pInfo->watermark) < 0) return -1;
-  if (tDecodeI64(&decoder, &pInfo->minTS) < 0) return -1;
-  pInfo->pCloseWinSBF = tScalableBfDecode(&decoder);
 
   int32_t mapSize = 0;
   if (tDecodeI32(&decoder, &mapSize) < 0) return -1;
-  _hash_fn_t hashFn = taosGetDefaultHashFunction(TSDB_DATA_TYPE_UBIGINT);
-  pInfo->pMap = taosHashInit(mapSize, hashFn, true, HASH_NO_LOCK);
-  uint64_t uid = 0;
-  ts = INT64_MIN;
+  taosHashClear(pInfo->pMap);
   for (int32_t i = 0; i < mapSize; i++) {
+    uint64_t uid = 0;
+    int32_t  size = 0;
     if (tDecodeU64(&decoder, &uid) < 0) return -1;
-    if (tDecodeI64(&decoder, &ts) < 0) return -1;
-    taosHashPut(pInfo->pMap, &uid, sizeof(uint64_t), &ts, sizeof(TSKEY));
+    STableUpdateInfo *pTbInfo = getTableUpdateInfo(pInfo, uid);
+    if (pTbInfo == NULL) return -1;
+    if (tDecodeI64(&decoder, &pTbInfo->maxTs) < 0) return -1;
+    if (tDecodeI32(&decoder, &size) < 0) return -1;
+    for (int32_t j = 0; j < size; j++) {
+      SUpdateRun run = {0};
+      if (tDecodeI64(&decoder, &run.skey) < 0) return -1;
+      if (tDecodeI64(&decoder, &run.step) < 0) return -1;
+      if (tDecodeI32(&decoder, &run.num) < 0) return -1;
+      taosArrayPush(pTbInfo->pRuns, &run);
+    }
   }
   ASSERT(mapSize == taosHashGetSize(pInfo->pMap));
 
+  int32_t closeSize = 0;
+  if (tDecodeI32(&decoder, &closeSize) < 0) return -1;
+  updateInfoDestroyCloseWindowSet(pInfo);
+  if (closeSize >= 0) {
+    updateInfoAddCloseWindowSet(pInfo);
+  }
+  for (int32_t i = 0; i < closeSize; i++) {
+    SUpdateKey key = {0};
+    if (tDecodeI64(&decoder, &key.tbUid) < 0) return -1;
+    if (tDecodeI64(&decoder, &key.ts) < 0) return -1;
+    taosHashPut(pInfo->pCloseWinSet, &key, sizeof(SUpdateKey), NULL, 0);
+  }
+
   if (tDecodeI64(&decoder, &pInfo->scanWindow.skey) < 0) return -1;
   if (tDecodeI64(&decoder, &pInfo->scanWindow.ekey) < 0) return -1;
   if (tDecodeU64(&decoder, &pInfo->scanGroupId) < 0) return -1;
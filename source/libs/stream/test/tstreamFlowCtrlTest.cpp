@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include "streamInc.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+
+namespace {
+
+void putOutputItems(SStreamQueue *pQueue, int32_t num) {
+  for (int32_t i = 0; i < num; ++i) {
+    SStreamDataBlock *pItem = (SStreamDataBlock *)taosAllocateQitem(sizeof(SStreamDataBlock), DEF_QITEM);
+    pItem->type = STREAM_INPUT__DATA_BLOCK;
+    pItem->blocks = taosArrayInit(0, sizeof(SSDataBlock));
+    taosWriteQitem(pQueue->queue, pItem);
+  }
+}
+
+}  // namespace
+
+TEST(TD_STREAM_FLOW_CTRL_TEST, dispatchCompressRoundTrip) {
+  int32_t rows = 1000;
+
+  SSDataBlock    *pBlock = createDataBlock();
+  SColumnInfoData col = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), 1);
+  blockDataAppendColInfo(pBlock, &col);
+  blockDataEnsureCapacity(pBlock, rows);
+  SColumnInfoData *pCol = (SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 0);
+  for (int32_t i = 0; i < rows; ++i) {
+    int64_t v = i % 10;
+    colDataAppendInt64(pCol, i, &v);
+  }
+  pBlock->info.rows = rows;
+
+  bool compress = tsStreamDispatchCompress;
+  tsStreamDispatchCompress = true;
+
+  SStreamDispatchReq req = {0};
+  req.dataLen = taosArrayInit(1, sizeof(int32_t));
+  req.data = taosArrayInit(1, POINTER_BYTES);
+  ASSERT_EQ(streamAddBlockToDispatchMsg(pBlock, &req), 0);
+  req.blockNum = 1;
+
+  // all the fields of the header are in network order
+  SRetrieveTableRsp *pRetrieve = (SRetrieveTableRsp *)taosArrayGetP(req.data, 0);
+  ASSERT_EQ(pRetrieve->compressed, 1);
+  int32_t rawLen = ntohl(*(int32_t *)pRetrieve->data);
+  int32_t compLen = ntohl(pRetrieve->compLen);
+  EXPECT_GT(rawLen, compLen);
+  EXPECT_EQ(*(int32_t *)taosArrayGet(req.dataLen, 0), (int32_t)(sizeof(SRetrieveTableRsp) + sizeof(int32_t)) + compLen);
+
+  SStreamDataBlock data = {0};
+  ASSERT_EQ(streamDispatchReqToData(&req, &data), 0);
+  ASSERT_EQ(taosArrayGetSize(data.blocks), 1);
+  SSDataBlock *pDecoded = (SSDataBlock *)taosArrayGet(data.blocks, 0);
+  ASSERT_EQ(pDecoded->info.rows, rows);
+  SColumnInfoData *pDecodedCol = (SColumnInfoData *)taosArrayGet(pDecoded->pDataBlock, 0);
+  for (int32_t i = 0; i < rows; ++i) {
+    EXPECT_EQ(*(int64_t *)colDataGetData(pDecodedCol, i), i % 10);
+  }
+
+  tsStreamDispatchCompress = compress;
+  taosArrayDestroyEx(data.blocks, (FDelete)blockDataFreeRes);
+  taosArrayDestroyP(req.data, taosMemoryFree);
+  taosArrayDestroy(req.dataLen);
+  blockDataDestroy(pBlock);
+}
+
+TEST(TD_STREAM_FLOW_CTRL_TEST, outputBoundedByCredit) {
+  SStreamTask task = {0};
+  task.outputType = TASK_OUTPUT__FIXED_DISPATCH;
+  task.inputQueue = streamQueueOpen();
+  task.outputQueue = streamQueueOpen();
+
+  task.dispatchCredit = STREAM_TASK_QUEUE_CAPACITY;
+  EXPECT_EQ(streamTaskGetCredit(&task), STREAM_TASK_QUEUE_CAPACITY);
+  EXPECT_FALSE(streamTaskOutputFull(&task));
+
+  putOutputItems(task.outputQueue, 4);
+  EXPECT_EQ(streamTaskGetCredit(&task), STREAM_TASK_QUEUE_CAPACITY - 4);
+  EXPECT_FALSE(streamTaskOutputFull(&task));
+
+  // the downstream grants fewer items than held
+  task.dispatchCredit = 4;
+  EXPECT_TRUE(streamTaskOutputFull(&task));
+  task.dispatchCredit = 5;
+  EXPECT_FALSE(streamTaskOutputFull(&task));
+
+  // a single result is still held for the probe of a downstream granting nothing
+  task.dispatchCredit = 0;
+  EXPECT_TRUE(streamTaskOutputFull(&task));
+
+  // never more than the capacity, whatever is granted
+  task.dispatchCredit = INT32_MAX;
+  putOutputItems(task.outputQueue, STREAM_TASK_QUEUE_CAPACITY - 4);
+  EXPECT_TRUE(streamTaskOutputFull(&task));
+  EXPECT_EQ(streamTaskGetCredit(&task), 0);
+
+  EXPECT_FALSE(streamTaskInputFull(&task));
+  putOutputItems(task.inputQueue, STREAM_TASK_QUEUE_CAPACITY);
+  EXPECT_TRUE(streamTaskInputFull(&task));
+
+  streamQueueClose(task.inputQueue);
+  streamQueueClose(task.outputQueue);
+}
+
+TEST(TD_STREAM_FLOW_CTRL_TEST, deferSubmitToReplay) {
+  SStreamTask task = {0};
+  EXPECT_FALSE(streamTaskReplayPending(&task));
+
+  streamTaskDeferSubmit(&task, 10);
+  EXPECT_TRUE(streamTaskReplayPending(&task));
+  EXPECT_EQ(task.replayStartVer, 9);
+  EXPECT_EQ(task.replayEndVer, 10);
+
+  // the range is extended while pending, versions of other msgs in between are skipped by the replay
+  streamTaskDeferSubmit(&task, 11);
+  streamTaskDeferSubmit(&task, 14);
+  EXPECT_EQ(task.replayStartVer, 9);
+  EXPECT_EQ(task.replayEndVer, 14);
+
+  // taken by the replay
+  task.replayStartVer = task.replayEndVer;
+  EXPECT_FALSE(streamTaskReplayPending(&task));
+
+  streamTaskDeferSubmit(&task, 20);
+  EXPECT_EQ(task.replayStartVer, 19);
+  EXPECT_EQ(task.replayEndVer, 20);
+}
+
+TEST(TD_STREAM_FLOW_CTRL_TEST, submitCoveredByCheckpoint) {
+  SStreamTask task = {0};
+  EXPECT_FALSE(streamTaskSubmitCovered(&task, 1));
+
+  // restored from a checkpoint newer than the vnode commit, nothing to replay
+  task.replayStartVer = task.replayEndVer = 100;
+  EXPECT_FALSE(streamTaskReplayPending(&task));
+  EXPECT_TRUE(streamTaskSubmitCovered(&task, 90));
+  EXPECT_TRUE(streamTaskSubmitCovered(&task, 100));
+  EXPECT_FALSE(streamTaskSubmitCovered(&task, 101));
+
+  // restored from a checkpoint older than the vnode commit, the wal entries applied again are deferred after it
+  task.replayStartVer = 50;
+  task.replayEndVer = 80;
+  EXPECT_TRUE(streamTaskReplayPending(&task));
+  EXPECT_TRUE(streamTaskSubmitCovered(&task, 50));
+  EXPECT_FALSE(streamTaskSubmitCovered(&task, 81));
+  streamTaskDeferSubmit(&task, 81);
+  EXPECT_EQ(task.replayStartVer, 50);
+  EXPECT_EQ(task.replayEndVer, 81);
+}
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include "streamState.h"
+#include "tglobal.h"
+
+namespace {
+
+const char *STATE_TEST_PATH = TD_TMP_DIR_PATH "streamStateTest";
+
+SStreamState *openTestState() {
+  taosRemoveDir(STATE_TEST_PATH);
+  taosMulMkDir(STATE_TEST_PATH);
+  return streamStateOpen((char *)STATE_TEST_PATH, NULL, true, -1, -1);
+}
+
+int64_t getStateValue(SStreamState *pState, int64_t ts) {
+  SWinKey key = {.groupId = 1, .ts = ts};
+  void   *pVal = NULL;
+  int32_t vLen = 0;
+  if (streamStateGet(pState, &key, &pVal, &vLen) != 0) {
+    return -1;
+  }
+
+  int64_t v = *(int64_t *)pVal;
+  streamFreeVal(pVal);
+  return v;
+}
+
+}  // namespace
+
+TEST(TD_STREAM_STATE_TEST, cachePutGetDel) {
+  SStreamState *pState = openTestState();
+  ASSERT_NE(pState, nullptr);
+  ASSERT_NE(pState->pTdbState->pStateCache, nullptr);
+
+  for (int64_t i = 0; i < 100; ++i) {
+    SWinKey key = {.groupId = 1, .ts = i};
+    GTEST_ASSERT_EQ(streamStatePut(pState, &key, &i, sizeof(int64_t)), 0);
+  }
+
+  // update in place
+  int64_t v = 1000;
+  SWinKey key = {.groupId = 1, .ts = 10};
+  GTEST_ASSERT_EQ(streamStatePut(pState, &key, &v, sizeof(int64_t)), 0);
+
+  GTEST_ASSERT_EQ(getStateValue(pState, 10), 1000);
+  GTEST_ASSERT_EQ(getStateValue(pState, 99), 99);
+  GTEST_ASSERT_EQ(getStateValue(pState, 100), -1);
+
+  // the dirty state has not been written into tdb yet
+  GTEST_ASSERT_EQ(streamStateDel(pState, &key), 0);
+  GTEST_ASSERT_EQ(getStateValue(pState, 10), -1);
+  GTEST_ASSERT_NE(streamStateDel(pState, &key), 0);
+
+  streamStateClose(pState);
+}
+
+TEST(TD_STREAM_STATE_TEST, cacheCursor) {
+  SStreamState *pState = openTestState();
+  ASSERT_NE(pState, nullptr);
+
+  for (int64_t i = 1; i <= 10; ++i) {
+    SWinKey key = {.groupId = 1, .ts = i * 10};
+    GTEST_ASSERT_EQ(streamStatePut(pState, &key, &i, sizeof(int64_t)), 0);
+  }
+
+  // the cursor sees the states still kept in cache
+  SWinKey          key = {.groupId = 1, .ts = 35};
+  SStreamStateCur *pCur = streamStateSeekKeyNext(pState, &key);
+  ASSERT_NE(pCur, nullptr);
+
+  SWinKey     resKey = {0};
+  const void *pVal = NULL;
+  int32_t     vLen = 0;
+  GTEST_ASSERT_EQ(streamStateGetKVByCur(pCur, &resKey, &pVal, &vLen), 0);
+  GTEST_ASSERT_EQ(resKey.ts, 40);
+  GTEST_ASSERT_EQ(*(int64_t *)pVal, 4);
+  streamStateFreeCur(pCur);
+
+  SWinKey first = {0};
+  GTEST_ASSERT_EQ(streamStateGetFirst(pState, &first), 0);
+  GTEST_ASSERT_EQ(first.ts, 10);
+
+  streamStateClose(pState);
+}
+
+TEST(TD_STREAM_STATE_TEST, cacheCursorAfterUpdate) {
+  SStreamState *pState = openTestState();
+  ASSERT_NE(pState, nullptr);
+
+  for (int64_t i = 1; i <= 1000; ++i) {
+    SWinKey key = {.groupId = 1, .ts = i};
+    GTEST_ASSERT_EQ(streamStatePut(pState, &key, &i, sizeof(int64_t)), 0);
+  }
+
+  // only the states updated since the previous cursor are written back before the next one
+  for (int64_t i = 1; i <= 1000; ++i) {
+    SWinKey key = {.groupId = 1, .ts = i};
+    int64_t v = i * 2;
+    GTEST_ASSERT_EQ(streamStatePut(pState, &key, &v, sizeof(int64_t)), 0);
+    GTEST_ASSERT_LE(taosArrayGetSize(pState->pTdbState->pDirtyKeys), 1);
+
+    SStreamStateCur *pCur = streamStateGetCur(pState, &key);
+    ASSERT_NE(pCur, nullptr);
+    GTEST_ASSERT_EQ(taosArrayGetSize(pState->pTdbState->pDirtyKeys), 0);
+
+    SWinKey     resKey = {0};
+    const void *pVal = NULL;
+    int32_t     vLen = 0;
+    GTEST_ASSERT_EQ(streamStateGetKVByCur(pCur, &resKey, &pVal, &vLen), 0);
+    GTEST_ASSERT_EQ(resKey.ts, i);
+    GTEST_ASSERT_EQ(*(int64_t *)pVal, v);
+    streamStateFreeCur(pCur);
+  }
+
+  // the deleted state is not written back by the next flush
+  SWinKey key = {.groupId = 1, .ts = 500};
+  int64_t v = 0;
+  GTEST_ASSERT_EQ(streamStatePut(pState, &key, &v, sizeof(int64_t)), 0);
+  GTEST_ASSERT_EQ(streamStateDel(pState, &key), 0);
+  SStreamStateCur *pCur = streamStateSeekKeyNext(pState, &key);
+  ASSERT_NE(pCur, nullptr);
+
+  SWinKey     resKey = {0};
+  const void *pVal = NULL;
+  int32_t     vLen = 0;
+  GTEST_ASSERT_EQ(streamStateGetKVByCur(pCur, &resKey, &pVal, &vLen), 0);
+  GTEST_ASSERT_EQ(resKey.ts, 501);
+  streamStateFreeCur(pCur);
+  GTEST_ASSERT_EQ(getStateValue(pState, 500), -1);
+
+  streamStateClose(pState);
+}
+
+TEST(TD_STREAM_STATE_TEST, cacheCommitAbort) {
+  SStreamState *pState = openTestState();
+  ASSERT_NE(pState, nullptr);
+
+  int64_t v = 1;
+  SWinKey key = {.groupId = 1, .ts = 1};
+  GTEST_ASSERT_EQ(streamStatePut(pState, &key, &v, sizeof(int64_t)), 0);
+  GTEST_ASSERT_EQ(streamStateCommit(pState), 0);
+
+  v = 2;
+  GTEST_ASSERT_EQ(streamStatePut(pState, &key, &v, sizeof(int64_t)), 0);
+  GTEST_ASSERT_EQ(getStateValue(pState, 1), 2);
+
+  // the uncommitted update in cache is discarded
+  GTEST_ASSERT_EQ(streamStateAbort(pState), 0);
+  GTEST_ASSERT_EQ(getStateValue(pState, 1), 1);
+
+  streamStateClose(pState);
+}
+
+TEST(TD_STREAM_STATE_TEST, cacheMemoryPressure) {
+  int32_t cacheSize = tsStreamStateCacheSize;
+  tsStreamStateCacheSize = 1;
+
+  SStreamState *pState = openTestState();
+  ASSERT_NE(pState, nullptr);
+
+  char buf[1024] = {0};
+  for (int64_t i = 0; i < 4096; ++i) {
+    SWinKey key = {.groupId = 1, .ts = i};
+    *(int64_t *)buf = i;
+    GTEST_ASSERT_EQ(streamStatePut(pState, &key, buf, sizeof(buf)), 0);
+    GTEST_ASSERT_LE(pState->pTdbState->cacheSize, 1048576);
+  }
+
+  // only a part of the states are evicted under memory pressure
+  GTEST_ASSERT_GT(pState->pTdbState->cacheSize, 0);
+
+  for (int64_t i = 0; i < 4096; i += 511) {
+    GTEST_ASSERT_EQ(getStateValue(pState, i), i);
+  }
+
+  streamStateClose(pState);
+  tsStreamStateCacheSize = cacheSize;
+}
+
+TEST(TD_STREAM_STATE_TEST, checkpointVer) {
+  SStreamState *pState = openTestState();
+  ASSERT_NE(pState, nullptr);
+  GTEST_ASSERT_EQ(streamStateGetCommittedVer(pState), -1);
+
+  int64_t v = 1;
+  SWinKey key = {.groupId = 1, .ts = 1};
+  GTEST_ASSERT_EQ(streamStatePut(pState, &key, &v, sizeof(int64_t)), 0);
+  streamStateSetCheckpointVer(pState, 100);
+  GTEST_ASSERT_EQ(streamStateCommit(pState), 0);
+  GTEST_ASSERT_EQ(streamStateGetCommittedVer(pState), 100);
+
+  // the version of the aborted input is not persisted
+  v = 2;
+  GTEST_ASSERT_EQ(streamStatePut(pState, &key, &v, sizeof(int64_t)), 0);
+  streamStateSetCheckpointVer(pState, 200);
+  GTEST_ASSERT_EQ(streamStateAbort(pState), 0);
+  GTEST_ASSERT_EQ(streamStateCommit(pState), 0);
+  GTEST_ASSERT_EQ(streamStateGetCommittedVer(pState), 100);
+
+  // both the state and its version are restored after reopen
+  streamStateClose(pState);
+
+  pState = streamStateOpen((char *)STATE_TEST_PATH, NULL, true, -1, -1);
+  ASSERT_NE(pState, nullptr);
+  GTEST_ASSERT_EQ(streamStateGetCommittedVer(pState), 100);
+  GTEST_ASSERT_EQ(getStateValue(pState, 1), 1);
+
+  streamStateClose(pState);
+}
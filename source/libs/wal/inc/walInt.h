@@ -21,6 +21,7 @@
 #include "tcoding.h"
 #include "tcommon.h"
 #include "tcompare.h"
+#include "tscalablebf.h"
 #include "wal.h"
 
 #ifdef __cplusplus
@@ -162,6 +163,39 @@ int64_t walChangeWrite(SWal* pWal, int64_t ver);
 int     walInitWriteFile(SWal* pWal);
 // seek section end
 
+// read cache section
+#define WAL_READ_CACHE_SLOTS     1024
+#define WAL_READ_CACHE_MAX_SIZE  (64 * 1024 * 1024)
+#define WAL_READ_CACHE_MAX_ENTRY (1024 * 1024)
+
+int32_t walReadCacheOpen(SWal* pWal);
+void    walReadCacheClose(SWal* pWal);
+int64_t walReadCacheGen(SWal* pWal);
+void    walReadCachePut(SWal* pWal, const SWalCkHead* pHead, int64_t gen);
+int32_t walReadCacheGet(SWal* pWal, int64_t ver, SWalCkHead** ppHead, int64_t* pCapacity);
+void    walReadCacheRemoveFrom(SWal* pWal, int64_t ver);
+// read cache section end
+
+// segment index section
+#define WAL_SEG_IDX_EXPECTED_UIDS 4096
+#define WAL_SEG_IDX_ERROR_RATE    0.01
+
+typedef struct {
+  int64_t      firstVer;
+  int64_t      lastVer;  // last version indexed
+  int8_t       hasMeta;
+  SScalableBf* pUidBf;  // uids of the submit blocks
+} SWalSegIdx;
+
+int32_t walSegIdxOpen(SWal* pWal);
+void    walSegIdxClose(SWal* pWal);
+void    walSegIdxRoll(SWal* pWal, int64_t firstVer);
+void    walSegIdxAppend(SWal* pWal, int64_t ver, tmsg_t msgType, const void* body, int32_t bodyLen);
+void    walSegIdxRemoveBefore(SWal* pWal, int64_t firstVer);
+void    walSegIdxRemoveFrom(SWal* pWal, int64_t ver);
+bool    walSegIdxCanSkip(SWal* pWal, int64_t ver, SHashObj* pUids, bool scanMeta, int64_t* pSegLastVer);
+// segment index section end
+
 int64_t walGetSeq();
 int     walSeekWriteVer(SWal* pWal, int64_t ver);
 int32_t walRollImpl(SWal* pWal);
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "taoserror.h"
+#include "walInt.h"
+
+// The cache is a ring indexed by version, an entry is evicted once a newer version lands in the same slot. Entries
+// are copied in and out, thus a reader never holds a reference to the cached memory. A reader gets the generation of
+// the cache before it reads an entry from file, and the entry is not cached if any versions are removed in between,
+// since the bytes read may belong to the versions rolled back.
+
+static FORCE_INLINE int64_t walGetEntrySize(const SWalCkHead *pHead) {
+  return sizeof(SWalCkHead) + pHead->head.bodyLen;
+}
+
+static void walReadCacheFreeSlot(SWalReadCache *pCache, SWalCacheSlot *pSlot) {
+  if (pSlot->pEntry != NULL) {
+    pCache->size -= walGetEntrySize(pSlot->pEntry);
+    taosMemoryFreeClear(pSlot->pEntry);
+  }
+  atomic_store_64(&pSlot->ver, -1);
+}
+
+int32_t walReadCacheOpen(SWal *pWal) {
+  SWalReadCache *pCache = &pWal->readCache;
+
+  pCache->size = 0;
+  pCache->gen = 0;
+  pCache->pSlots = taosMemoryCalloc(WAL_READ_CACHE_SLOTS, sizeof(SWalCacheSlot));
+  if (pCache->pSlots == NULL) {
+    terrno = TSDB_CODE_WAL_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  for (int32_t i = 0; i < WAL_READ_CACHE_SLOTS; ++i) {
+    pCache->pSlots[i].ver = -1;
+  }
+
+  taosThreadRwlockInit(&pCache->lock, NULL);
+  return 0;
+}
+
+void walReadCacheClose(SWal *pWal) {
+  SWalReadCache *pCache = &pWal->readCache;
+  if (pCache->pSlots == NULL) {
+    return;
+  }
+
+  for (int32_t i = 0; i < WAL_READ_CACHE_SLOTS; ++i) {
+    walReadCacheFreeSlot(pCache, &pCache->pSlots[i]);
+  }
+
+  taosMemoryFreeClear(pCache->pSlots);
+  taosThreadRwlockDestroy(&pCache->lock);
+}
+
+int64_t walReadCacheGen(SWal *pWal) { return atomic_load_64(&pWal->readCache.gen); }
+
+void walReadCachePut(SWal *pWal, const SWalCkHead *pHead, int64_t gen) {
+  SWalReadCache *pCache = &pWal->readCache;
+  int64_t        ver = pHead->head.version;
+  int64_t        size = walGetEntrySize(pHead);
+
+  if (pCache->pSlots == NULL || size > WAL_READ_CACHE_MAX_ENTRY) {
+    return;
+  }
+
+  SWalCacheSlot *pSlot = &pCache->pSlots[ver % WAL_READ_CACHE_SLOTS];
+
+  taosThreadRwlockWrlock(&pCache->lock);
+  if (pSlot->ver == ver || pCache->gen != gen) {
+    taosThreadRwlockUnlock(&pCache->lock);
+    return;
+  }
+
+  walReadCacheFreeSlot(pCache, pSlot);
+  if (pCache->size + size <= WAL_READ_CACHE_MAX_SIZE) {
+    pSlot->pEntry = taosMemoryMalloc(size);
+    if (pSlot->pEntry != NULL) {
+      memcpy(pSlot->pEntry, pHead, size);
+      atomic_store_64(&pSlot->ver, ver);
+      pCache->size += size;
+    }
+  }
+  taosThreadRwlockUnlock(&pCache->lock);
+}
+
+int32_t walReadCacheGet(SWal *pWal, int64_t ver, SWalCkHead **ppHead, int64_t *pCapacity) {
+  SWalReadCache *pCache = &pWal->readCache;
+  if (pCache->pSlots == NULL) {
+    return -1;
+  }
+
+  SWalCacheSlot *pSlot = &pCache->pSlots[ver % WAL_READ_CACHE_SLOTS];
+  int32_t        code = -1;
+
+  // no lock is taken on a miss, the version is checked again with the lock held
+  if (atomic_load_64(&pSlot->ver) != ver) {
+    return -1;
+  }
+
+  taosThreadRwlockRdlock(&pCache->lock);
+  if (pSlot->ver == ver) {
+    SWalCkHead *pEntry = pSlot->pEntry;
+    if (*pCapacity < pEntry->head.bodyLen) {
+      SWalCkHead *ptr = (SWalCkHead *)taosMemoryRealloc(*ppHead, sizeof(SWalCkHead) + pEntry->head.bodyLen);
+      if (ptr != NULL) {
+        *ppHead = ptr;
+        *pCapacity = pEntry->head.bodyLen;
+      }
+    }
+
+    if (*pCapacity >= pEntry->head.bodyLen) {
+      memcpy(*ppHead, pEntry, walGetEntrySize(pEntry));
+      code = 0;
+    }
+  }
+  taosThreadRwlockUnlock(&pCache->lock);
+
+  return code;
+}
+
+void walReadCacheRemoveFrom(SWal *pWal, int64_t ver) {
+  SWalReadCache *pCache = &pWal->readCache;
+  if (pCache->pSlots == NULL) {
+    return;
+  }
+
+  taosThreadRwlockWrlock(&pCache->lock);
+  atomic_add_fetch_64(&pCache->gen, 1);
+  for (int32_t i = 0; i < WAL_READ_CACHE_SLOTS; ++i) {
+    SWalCacheSlot *pSlot = &pCache->pSlots[i];
+    if (pSlot->ver >= ver) {
+      walReadCacheFreeSlot(pCache, pSlot);
+    }
+  }
+  taosThreadRwlockUnlock(&pCache->lock);
+}
@@ -114,6 +114,18 @@ SWal *walOpen(const char *path, SWalCfg *pCfg) {
     goto _err;
   }
 
+  // init read cache
+  if (walReadCacheOpen(pWal) < 0) {
+    wError("vgId:%d, failed to init read cache since %s", pWal->cfg.vgId, tstrerror(terrno));
+    goto _err;
+  }
+
+  // init segment index
+  if (walSegIdxOpen(pWal) < 0) {
+    wError("vgId:%d, failed to init segment index since %s", pWal->cfg.vgId, tstrerror(terrno));
+    goto _err;
+  }
+
   // open meta
   walResetVer(&pWal->vers);
   pWal->pLogFile = NULL;
@@ -161,6 +173,8 @@ SWal *walOpen(const char *path, SWalCfg *pCfg) {
 _err:
   taosArrayDestroy(pWal->fileInfoSet);
   taosHashCleanup(pWal->pRefHash);
+  walReadCacheClose(pWal);
+  walSegIdxClose(pWal);
   taosThreadMutexDestroy(&pWal->mutex);
   taosMemoryFree(pWal);
   pWal = NULL;
@@ -203,6 +217,7 @@ void walClose(SWal *pWal) {
   pWal->pIdxFile = NULL;
   taosArrayDestroy(pWal->fileInfoSet);
   pWal->fileInfoSet = NULL;
+  walSegIdxClose(pWal);
 
   void *pIter = NULL;
   while (1) {
@@ -221,6 +236,7 @@ static void walFreeObj(void *wal) {
   SWal *pWal = wal;
   wDebug("vgId:%d, wal:%p is freed", pWal->cfg.vgId, pWal);
 
+  walReadCacheClose(pWal);
   taosThreadMutexDestroy(&pWal->mutex);
   taosMemoryFreeClear(pWal);
 }
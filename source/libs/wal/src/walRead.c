@@ -35,6 +35,8 @@ SWalReader *walOpenReader(SWal *pWal, SWalFilterCond *cond) {
   pReader->curFileFirstVer = -1;
   pReader->curInvalid = 1;
   pReader->capacity = 0;
+  pReader->pUidFilter = NULL;
+  pReader->segCheckedVer = -1;
   if (cond) {
     pReader->cond = *cond;
   } else {
@@ -83,6 +85,34 @@ int32_t walNextValidMsg(SWalReader *pReader) {
          pReader->pWal->cfg.vgId, fetchVer, lastVer, committedVer, appliedVer, endVer);
   pReader->curStopped = 0;
   while (fetchVer <= endVer) {
+    if (pReader->pUidFilter != NULL && fetchVer > pReader->segCheckedVer) {
+      int64_t segLastVer = -1;
+      bool    canSkip =
+          walSegIdxCanSkip(pReader->pWal, fetchVer, pReader->pUidFilter, pReader->cond.scanMeta, &segLastVer);
+      // the versions not yet applied may still be rolled back, never skip beyond them
+      pReader->segCheckedVer = TMIN(segLastVer, endVer);
+      if (canSkip) {
+        wDebug("vgId:%d, wal skip index from %" PRId64 " to %" PRId64 ", no table of the reader found",
+               pReader->pWal->cfg.vgId, fetchVer, pReader->segCheckedVer);
+        fetchVer = pReader->segCheckedVer + 1;
+        pReader->curVersion = fetchVer;
+        pReader->curInvalid = 1;
+        continue;
+      }
+    }
+
+    if (walReadCacheGet(pReader->pWal, fetchVer, &pReader->pHead, &pReader->capacity) == 0) {
+      // the file cursor is left behind, the next read from file has to seek
+      pReader->curVersion = fetchVer + 1;
+      pReader->curInvalid = 1;
+      if (pReader->pHead->head.msgType == TDMT_VND_SUBMIT ||
+          (IS_META_MSG(pReader->pHead->head.msgType) && pReader->cond.scanMeta)) {
+        return 0;
+      }
+      fetchVer++;
+      continue;
+    }
+
     if (walFetchHeadNew(pReader, fetchVer) < 0) {
       return -1;
     }
@@ -91,6 +121,7 @@ int32_t walNextValidMsg(SWalReader *pReader) {
       if (walFetchBodyNew(pReader) < 0) {
         return -1;
       }
+      walReadCachePut(pReader->pWal, pReader->pHead, pReader->cacheGen);
       return 0;
     } else {
       if (walSkipFetchBodyNew(pReader) < 0) {
@@ -104,6 +135,11 @@ int32_t walNextValidMsg(SWalReader *pReader) {
   return -1;
 }
 
+void walReaderSetUidFilter(SWalReader *pReader, SHashObj *pUids) {
+  pReader->pUidFilter = pUids;
+  pReader->segCheckedVer = -1;
+}
+
 static int64_t walReadSeekFilePos(SWalReader *pReader, int64_t fileFirstVer, int64_t ver) {
   int64_t ret = 0;
 
@@ -238,6 +274,7 @@ static int32_t walFetchHeadNew(SWalReader *pRead, int64_t fetchVer) {
   bool    seeked = false;
 
   wDebug("vgId:%d, wal starts to fetch head, index:%" PRId64, pRead->pWal->cfg.vgId, fetchVer);
+  pRead->cacheGen = walReadCacheGen(pRead->pWal);
 
   if (pRead->curInvalid || pRead->curVersion != fetchVer) {
     if (walReadSeekVer(pRead, fetchVer) < 0) {
@@ -360,6 +397,8 @@ int32_t walFetchHead(SWalReader *pRead, int64_t ver, SWalCkHead *pHead) {
     return -1;
   }
 
+  pRead->cacheGen = walReadCacheGen(pRead->pWal);
+
   if (pRead->curInvalid || pRead->curVersion != ver) {
     code = walReadSeekVer(pRead, ver);
     if (code < 0) {
@@ -434,6 +473,12 @@ int32_t walFetchBody(SWalReader *pRead, SWalCkHead **ppHead) {
          pRead->pWal->cfg.vgId, ver, pRead->pWal->vers.firstVer, pRead->pWal->vers.commitVer, pRead->pWal->vers.lastVer,
          pRead->pWal->vers.appliedVer);
 
+  if (walReadCacheGet(pRead->pWal, ver, ppHead, &pRead->capacity) == 0) {
+    pRead->curVersion = ver + 1;
+    pRead->curInvalid = 1;
+    return 0;
+  }
+
   if (pRead->capacity < pReadHead->bodyLen) {
     SWalCkHead *ptr = (SWalCkHead *)taosMemoryRealloc(*ppHead, sizeof(SWalCkHead) + pReadHead->bodyLen);
     if (ptr == NULL) {
@@ -479,6 +524,7 @@ int32_t walFetchBody(SWalReader *pRead, SWalCkHead **ppHead) {
     return -1;
   }
 
+  walReadCachePut(pRead->pWal, *ppHead, pRead->cacheGen);
   pRead->curVersion = ver + 1;
   return 0;
 }
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "taoserror.h"
+#include "walInt.h"
+
+// Each file created since open keeps a bloom filter of the table uids written into it, built while appending. A
+// reader filtering on a set of tables skips a whole file when none of them may be in it. The index lives in memory
+// only, the files without an index, e.g. the ones found at open, are always read. All the functions are called with
+// the wal mutex held, except walSegIdxCanSkip which takes it.
+
+static int32_t walSegIdxCompare(const void *pLeft, const void *pRight) {
+  return compareInt64Val(&((const SWalSegIdx *)pLeft)->firstVer, &((const SWalSegIdx *)pRight)->firstVer);
+}
+
+static void walSegIdxPopBack(SWal *pWal) {
+  SWalSegIdx *pIdx = taosArrayPop(pWal->pSegIdxs);
+  if (pIdx != NULL) {
+    tScalableBfDestroy(pIdx->pUidBf);
+  }
+}
+
+// the body is not trusted, the block lengths are checked before they are followed
+static int32_t walSegIdxPutSubmit(SWalSegIdx *pIdx, const void *body, int32_t bodyLen) {
+  if (bodyLen < (int32_t)sizeof(SSubmitReq)) {
+    return -1;
+  }
+
+  int64_t totalLen = (int32_t)htonl(((const SSubmitReq *)body)->length);
+  if (totalLen < (int64_t)sizeof(SSubmitReq) || totalLen > bodyLen) {
+    return -1;
+  }
+
+  int64_t len = sizeof(SSubmitReq);
+  while (len < totalLen) {
+    if (totalLen - len < (int64_t)sizeof(SSubmitBlk)) {
+      return -1;
+    }
+    const SSubmitBlk *pBlock = POINTER_SHIFT(body, len);
+    int32_t           dataLen = htonl(pBlock->dataLen);
+    int32_t           schemaLen = htonl(pBlock->schemaLen);
+    if (dataLen < 0 || schemaLen < 0) {
+      return -1;
+    }
+    int64_t uid = htobe64(pBlock->uid);
+    tScalableBfPut(pIdx->pUidBf, &uid, sizeof(int64_t));
+    len += sizeof(SSubmitBlk) + (int64_t)dataLen + schemaLen;
+  }
+  return 0;
+}
+
+int32_t walSegIdxOpen(SWal *pWal) {
+  pWal->pSegIdxs = taosArrayInit(8, sizeof(SWalSegIdx));
+  if (pWal->pSegIdxs == NULL) {
+    terrno = TSDB_CODE_WAL_OUT_OF_MEMORY;
+    return -1;
+  }
+  return 0;
+}
+
+void walSegIdxClose(SWal *pWal) {
+  if (pWal->pSegIdxs == NULL) {
+    return;
+  }
+
+  while (taosArrayGetSize(pWal->pSegIdxs) > 0) {
+    walSegIdxPopBack(pWal);
+  }
+  taosArrayDestroy(pWal->pSegIdxs);
+  pWal->pSegIdxs = NULL;
+}
+
+void walSegIdxRoll(SWal *pWal, int64_t firstVer) {
+  if (pWal->pSegIdxs == NULL) {
+    return;
+  }
+
+  // the files rolled back are created again with the same first version
+  walSegIdxRemoveFrom(pWal, firstVer);
+
+  SWalSegIdx idx = {.firstVer = firstVer, .lastVer = firstVer - 1, .hasMeta = 0};
+  idx.pUidBf = tScalableBfInit(WAL_SEG_IDX_EXPECTED_UIDS, WAL_SEG_IDX_ERROR_RATE);
+  if (idx.pUidBf == NULL) {
+    wWarn("vgId:%d, wal file %" PRId64 " is not indexed since out of memory", pWal->cfg.vgId, firstVer);
+    return;
+  }
+
+  if (taosArrayPush(pWal->pSegIdxs, &idx) == NULL) {
+    tScalableBfDestroy(idx.pUidBf);
+  }
+}
+
+void walSegIdxAppend(SWal *pWal, int64_t ver, tmsg_t msgType, const void *body, int32_t bodyLen) {
+  if (pWal->pSegIdxs == NULL || taosArrayGetSize(pWal->pSegIdxs) == 0) {
+    return;
+  }
+
+  SWalSegIdx *pIdx = taosArrayGetLast(pWal->pSegIdxs);
+  if (pIdx->firstVer != walGetCurFileFirstVer(pWal)) {
+    return;
+  }
+
+  // a file with a hole in its index can not be skipped any more
+  if (ver != pIdx->lastVer + 1) {
+    wDebug("vgId:%d, wal file %" PRId64 " index dropped, ver:%" PRId64 " last indexed:%" PRId64, pWal->cfg.vgId,
+           pIdx->firstVer, ver, pIdx->lastVer);
+    walSegIdxPopBack(pWal);
+    return;
+  }
+
+  if (msgType == TDMT_VND_SUBMIT) {
+    if (walSegIdxPutSubmit(pIdx, body, bodyLen) < 0) {
+      wDebug("vgId:%d, wal file %" PRId64 " index dropped, ver:%" PRId64 " malformed submit", pWal->cfg.vgId,
+             pIdx->firstVer, ver);
+      walSegIdxPopBack(pWal);
+      return;
+    }
+  } else if (IS_META_MSG(msgType)) {
+    pIdx->hasMeta = 1;
+  }
+
+  pIdx->lastVer = ver;
+}
+
+void walSegIdxRemoveBefore(SWal *pWal, int64_t firstVer) {
+  if (pWal->pSegIdxs == NULL) {
+    return;
+  }
+
+  int32_t size = taosArrayGetSize(pWal->pSegIdxs);
+  int32_t num = 0;
+  for (; num < size; num++) {
+    SWalSegIdx *pIdx = taosArrayGet(pWal->pSegIdxs, num);
+    if (firstVer >= 0 && pIdx->firstVer >= firstVer) break;
+    tScalableBfDestroy(pIdx->pUidBf);
+  }
+  taosArrayPopFrontBatch(pWal->pSegIdxs, num);
+}
+
+void walSegIdxRemoveFrom(SWal *pWal, int64_t ver) {
+  if (pWal->pSegIdxs == NULL) {
+    return;
+  }
+
+  while (taosArrayGetSize(pWal->pSegIdxs) > 0) {
+    SWalSegIdx *pIdx = taosArrayGetLast(pWal->pSegIdxs);
+    if (pIdx->firstVer < ver && pIdx->lastVer < ver) break;
+    walSegIdxPopBack(pWal);
+  }
+}
+
+bool walSegIdxCanSkip(SWal *pWal, int64_t ver, SHashObj *pUids, bool scanMeta, int64_t *pSegLastVer) {
+  bool canSkip = false;
+  *pSegLastVer = INT64_MAX;
+
+  taosThreadMutexLock(&pWal->mutex);
+  if (pWal->pSegIdxs == NULL) {
+    goto _end;
+  }
+
+  SWalSegIdx  tmp = {.firstVer = ver};
+  SWalSegIdx *pIdx = taosArraySearch(pWal->pSegIdxs, &tmp, walSegIdxCompare, TD_LE);
+  if (pIdx == NULL || ver > pIdx->lastVer) {
+    // not indexed, read up to the next indexed file
+    SWalSegIdx *pNext = taosArraySearch(pWal->pSegIdxs, &tmp, walSegIdxCompare, TD_GT);
+    if (pNext != NULL) {
+      *pSegLastVer = pNext->firstVer - 1;
+    }
+    goto _end;
+  }
+
+  *pSegLastVer = pIdx->lastVer;
+  if (scanMeta && pIdx->hasMeta) {
+    goto _end;
+  }
+
+  canSkip = true;
+  void *pIter = NULL;
+  while ((pIter = taosHashIterate(pUids, pIter)) != NULL) {
+    int64_t *pUid = taosHashGetKey(pIter, NULL);
+    if (tScalableBfNoContain(pIdx->pUidBf, pUid, sizeof(int64_t)) != TSDB_CODE_SUCCESS) {
+      taosHashCancelIterate(pUids, pIter);
+      canSkip = false;
+      break;
+    }
+  }
+
+_end:
+  taosThreadMutexUnlock(&pWal->mutex);
+  return canSkip;
+}
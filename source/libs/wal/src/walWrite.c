@@ -38,6 +38,7 @@ int32_t walRestoreFromSnapshot(SWal *pWal, int64_t ver) {
 
   taosCloseFile(&pWal->pLogFile);
   taosCloseFile(&pWal->pIdxFile);
+  walReadCacheRemoveFrom(pWal, -1);
 
   if (pWal->vers.firstVer != -1) {
     int32_t fileSetSize = taosArrayGetSize(pWal->fileInfoSet);
@@ -64,12 +65,15 @@ int32_t walRestoreFromSnapshot(SWal *pWal, int64_t ver) {
     }
   }
   walRemoveMeta(pWal);
+  // the readers may have read the removed files since the cache was cleared above
+  walReadCacheRemoveFrom(pWal, -1);
 
   pWal->writeCur = -1;
   pWal->totSize = 0;
   pWal->lastRollSeq = -1;
 
   taosArrayClear(pWal->fileInfoSet);
+  walSegIdxRemoveBefore(pWal, -1);
   pWal->vers.firstVer = -1;
   pWal->vers.lastVer = ver;
   pWal->vers.commitVer = ver;
@@ -111,6 +115,10 @@ int32_t walRollback(SWal *pWal, int64_t ver) {
     return -1;
   }
 
+  // the versions rolled back may be written again with different content
+  walReadCacheRemoveFrom(pWal, ver);
+  walSegIdxRemoveFrom(pWal, ver);
+
   // find correct file
   if (ver < walGetLastFileFirstVer(pWal)) {
     // change current files
@@ -221,6 +229,8 @@ int32_t walRollback(SWal *pWal, int64_t ver) {
   }
   ((SWalFileInfo *)taosArrayGetLast(pWal->fileInfoSet))->lastVer = ver - 1;
   ((SWalFileInfo *)taosArrayGetLast(pWal->fileInfoSet))->fileSize = entry.offset;
+  // the readers may have read the truncated entries since the cache was cleared above
+  walReadCacheRemoveFrom(pWal, ver);
   if (((SWalFileInfo *)taosArrayGetLast(pWal->fileInfoSet))->lastVer < ver - 1) {
     ASSERT(((SWalFileInfo *)taosArrayGetLast(pWal->fileInfoSet))->fileSize == 0);
     ((SWalFileInfo *)taosArrayGetLast(pWal->fileInfoSet))->firstVer = -1;
@@ -381,6 +391,7 @@ int32_t walEndSnapshot(SWal *pWal) {
     } else {
       pWal->vers.firstVer = ((SWalFileInfo *)taosArrayGet(pWal->fileInfoSet, 0))->firstVer;
     }
+    walSegIdxRemoveBefore(pWal, pWal->vers.firstVer);
   }
   pWal->writeCur = taosArrayGetSize(pWal->fileInfoSet) - 1;
   pWal->totSize = newTotSize;
@@ -437,6 +448,7 @@ int32_t walRollImpl(SWal *pWal) {
   if (code != 0) {
     goto END;
   }
+  walSegIdxRoll(pWal, newFileFirstVer);
 
   // switch file
   pWal->pIdxFile = pIdxFile;
@@ -532,6 +544,7 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
   pWal->totSize += sizeof(SWalCkHead) + bodyLen;
   pFileInfo->lastVer = index;
   pFileInfo->fileSize += sizeof(SWalCkHead) + bodyLen;
+  walSegIdxAppend(pWal, index, msgType, body, bodyLen);
 
   return 0;
 
@@ -361,6 +361,158 @@ TEST_F(WalKeepEnv, readHandleRead) {
   walCloseReader(pRead);
 }
 
+TEST_F(WalKeepEnv, readCacheShared) {
+  walResetEnv();
+  int code;
+
+  int i;
+  for (i = 0; i < 100; i++) {
+    char newStr[100];
+    sprintf(newStr, "%s-%d", ranStr, i);
+    int len = strlen(newStr);
+    code = walWrite(pWal, i, TDMT_VND_SUBMIT, newStr, len);
+    ASSERT_EQ(code, 0);
+  }
+  walApplyVer(pWal, 99);
+
+  SWalFilterCond cond = {0};
+  cond.scanUncommited = 1;
+
+  // the first reader reads from file and fills the cache, the second one is served from the cache
+  for (int r = 0; r < 2; r++) {
+    SWalReader* pRead = walOpenReader(pWal, &cond);
+    ASSERT(pRead != NULL);
+    code = walReadSeekVer(pRead, 0);
+    ASSERT_EQ(code, 0);
+
+    for (i = 0; i < 100; i++) {
+      code = walNextValidMsg(pRead);
+      ASSERT_EQ(code, 0);
+      ASSERT_EQ(pRead->pHead->head.version, i);
+      ASSERT_EQ(pRead->curVersion, i + 1);
+      ASSERT_EQ(pRead->curInvalid, r);
+
+      char newStr[100];
+      sprintf(newStr, "%s-%d", ranStr, i);
+      int len = strlen(newStr);
+      ASSERT_EQ(pRead->pHead->head.bodyLen, len);
+      ASSERT_EQ(memcmp(newStr, pRead->pHead->head.body, len), 0);
+    }
+    code = walNextValidMsg(pRead);
+    ASSERT_EQ(code, -1);
+    walCloseReader(pRead);
+  }
+  ASSERT_GT(pWal->readCache.size, 0);
+
+  // rollback drops the cached versions
+  code = walRollback(pWal, 50);
+  ASSERT_EQ(code, 0);
+  for (i = 0; i < WAL_READ_CACHE_SLOTS; i++) {
+    ASSERT_LT(pWal->readCache.pSlots[i].ver, 50);
+  }
+
+  // an entry read from file before the rollback is not cached after it
+  SWalReader* pRead = walOpenReader(pWal, &cond);
+  ASSERT(pRead != NULL);
+  code = walReadSeekVer(pRead, 10);
+  ASSERT_EQ(code, 0);
+  code = walFetchHead(pRead, 10, pRead->pHead);
+  ASSERT_EQ(code, 0);
+
+  int64_t staleGen = pRead->cacheGen;
+  code = walRollback(pWal, 20);
+  ASSERT_EQ(code, 0);
+  ASSERT_GT(walReadCacheGen(pWal), staleGen);
+
+  SWalCkHead* pStale = (SWalCkHead*)taosMemoryCalloc(1, sizeof(SWalCkHead) + 8);
+  pStale->head.version = 30;
+  pStale->head.bodyLen = 8;
+  walReadCachePut(pWal, pStale, staleGen);
+  ASSERT_NE(pWal->readCache.pSlots[30].ver, 30);
+
+  walReadCachePut(pWal, pStale, walReadCacheGen(pWal));
+  ASSERT_EQ(pWal->readCache.pSlots[30].ver, 30);
+
+  int64_t     capacity = 0;
+  SWalCkHead* pHead = NULL;
+  ASSERT_EQ(walReadCacheGet(pWal, 31, &pHead, &capacity), -1);
+  ASSERT_EQ(walReadCacheGet(pWal, 30, &pHead, &capacity), 0);
+  ASSERT_EQ(pHead->head.bodyLen, 8);
+
+  taosMemoryFree(pHead);
+  taosMemoryFree(pStale);
+  walCloseReader(pRead);
+}
+
+static int32_t walBuildSubmit(char* buf, int64_t uid) {
+  int32_t     len = sizeof(SSubmitReq) + sizeof(SSubmitBlk);
+  SSubmitReq* pReq = (SSubmitReq*)buf;
+  memset(buf, 0, len);
+  pReq->length = htonl(len);
+  pReq->numOfBlocks = htonl(1);
+  ((SSubmitBlk*)pReq->blocks)->uid = htobe64(uid);
+  return len;
+}
+
+TEST_F(WalCleanEnv, segIdxSkip) {
+  int  code;
+  char buf[128];
+
+  // three files, each written with a table of its own
+  for (int s = 0; s < 3; s++) {
+    code = walRollImpl(pWal);
+    ASSERT_EQ(code, 0);
+    for (int i = 0; i < 10; i++) {
+      code = walWrite(pWal, s * 10 + i, TDMT_VND_SUBMIT, buf, walBuildSubmit(buf, 100 + s));
+      ASSERT_EQ(code, 0);
+    }
+  }
+  walApplyVer(pWal, 29);
+  ASSERT_EQ(taosArrayGetSize(pWal->pSegIdxs), 3);
+
+  SWalFilterCond cond = {0};
+  cond.scanUncommited = 1;
+  SHashObj* pUids = taosHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), true, HASH_NO_LOCK);
+  int64_t   uid = 102;
+  taosHashPut(pUids, &uid, sizeof(int64_t), NULL, 0);
+
+  // the first two files are skipped
+  SWalReader* pRead = walOpenReader(pWal, &cond);
+  ASSERT(pRead != NULL);
+  walReaderSetUidFilter(pRead, pUids);
+  code = walReadSeekVer(pRead, 0);
+  ASSERT_EQ(code, 0);
+  for (int i = 20; i < 30; i++) {
+    code = walNextValidMsg(pRead);
+    ASSERT_EQ(code, 0);
+    ASSERT_EQ(pRead->pHead->head.version, i);
+  }
+  code = walNextValidMsg(pRead);
+  ASSERT_EQ(code, -1);
+  walCloseReader(pRead);
+
+  // no file holds the table
+  taosHashClear(pUids);
+  uid = 999;
+  taosHashPut(pUids, &uid, sizeof(int64_t), NULL, 0);
+  pRead = walOpenReader(pWal, &cond);
+  ASSERT(pRead != NULL);
+  walReaderSetUidFilter(pRead, pUids);
+  code = walReadSeekVer(pRead, 0);
+  ASSERT_EQ(code, 0);
+  code = walNextValidMsg(pRead);
+  ASSERT_EQ(code, -1);
+  ASSERT_EQ(pRead->curVersion, 30);
+  walCloseReader(pRead);
+
+  // the rolled back versions are not indexed any more
+  code = walRollback(pWal, 15);
+  ASSERT_EQ(code, 0);
+  ASSERT_EQ(taosArrayGetSize(pWal->pSegIdxs), 1);
+
+  taosHashCleanup(pUids);
+}
+
 TEST_F(WalRetentionEnv, repairMeta1) {
   walResetEnv();
   int code;
@@ -116,62 +116,92 @@ TdUcs4 *tasoUcs4Copy(TdUcs4 *target_ucs4, TdUcs4 *source_ucs4, int32_t len_ucs4)
   return memcpy(target_ucs4, source_ucs4, len_ucs4 * sizeof(TdUcs4));
 }
 
-int32_t taosUcs4ToMbs(TdUcs4 *ucs4, int32_t ucs4_max_len, char *mbs) {
-#ifdef DISALLOW_NCHAR_WITHOUT_ICONV
-  printf("Nchar cannot be read and written without iconv, please install iconv library and recompile TDengine.\n");
-  return -1;
-#else
-  iconv_t cd = iconv_open(tsCharset, DEFAULT_UNICODE_ENCODEC);
-  size_t  ucs4_input_len = ucs4_max_len;
-  size_t  outLen = ucs4_max_len;
-  if (iconv(cd, (char **)&ucs4, &ucs4_input_len, &mbs, &outLen) == -1) {
-    iconv_close(cd);
-    return -1;
-  }
-
-  iconv_close(cd);
-  return (int32_t)(ucs4_max_len - outLen);
-#endif
-}
+typedef enum { M2C = 0, C2M, CM_NUM } ConvType;
 
 typedef struct {
   iconv_t conv;
   int8_t  inUse;
 } SConv;
 
-SConv  *gConv = NULL;
-int32_t convUsed = 0;
-int32_t gConvMaxNum = 0;
+SConv  *gConv[CM_NUM] = {NULL, NULL};
+int32_t convUsed[CM_NUM] = {0, 0};
+int32_t gConvMaxNum[CM_NUM] = {0, 0};
+bool    gConvAscii = false;  // the ascii chars are the same bytes in tsCharset, converted without iconv
+bool    gConvUtf8 = false;   // tsCharset is UTF-8, all the chars are converted without iconv
+
+static iconv_t taosOpenConv(ConvType type) {
+  if (type == M2C) {
+    return iconv_open(DEFAULT_UNICODE_ENCODEC, tsCharset);
+  }
+  return iconv_open(tsCharset, DEFAULT_UNICODE_ENCODEC);
+}
+
+// checked with iconv itself, the charsets like UTF-16 or EBCDIC do not keep the ascii bytes
+static bool taosCharsetKeepsAscii() {
+  if (!IS_LITTLE_ENDIAN()) {
+    return false;
+  }
+
+  TdUcs4 ucs4[128];
+  char   mbs[128];
+  for (int32_t i = 0; i < 128; ++i) {
+    ucs4[i] = i;
+  }
+
+  iconv_t conv = taosOpenConv(C2M);
+  if ((iconv_t)-1 == conv) {
+    return false;
+  }
+  char  *in = (char *)ucs4;
+  char  *out = mbs;
+  size_t inLen = sizeof(ucs4);
+  size_t outLen = sizeof(mbs);
+  bool   keep = iconv(conv, &in, &inLen, &out, &outLen) != -1 && outLen == 0;
+  iconv_close(conv);
+
+  for (int32_t i = 0; keep && i < 128; ++i) {
+    keep = (mbs[i] == (char)i);
+  }
+  return keep;
+}
 
 void taosConvInit(void) {
-  gConvMaxNum = 512;
-  gConv = taosMemoryCalloc(gConvMaxNum, sizeof(SConv));
-  for (int32_t i = 0; i < gConvMaxNum; ++i) {
-    gConv[i].conv = iconv_open(DEFAULT_UNICODE_ENCODEC, tsCharset);
-    if ((iconv_t)-1 == gConv[i].conv || (iconv_t)0 == gConv[i].conv) {
-      ASSERT(0);
+  for (int32_t type = M2C; type < CM_NUM; ++type) {
+    gConvMaxNum[type] = 512;
+    gConv[type] = taosMemoryCalloc(gConvMaxNum[type], sizeof(SConv));
+    for (int32_t i = 0; i < gConvMaxNum[type]; ++i) {
+      gConv[type][i].conv = taosOpenConv(type);
+      if ((iconv_t)-1 == gConv[type][i].conv || (iconv_t)0 == gConv[type][i].conv) {
+        ASSERT(0);
+      }
     }
   }
+  gConvAscii = taosCharsetKeepsAscii();
+  gConvUtf8 = gConvAscii && (strcasecmp(tsCharset, "UTF-8") == 0 || strcasecmp(tsCharset, "UTF8") == 0);
 }
 
 void taosConvDestroy() {
-  for (int32_t i = 0; i < gConvMaxNum; ++i) {
-    iconv_close(gConv[i].conv);
+  for (int32_t type = M2C; type < CM_NUM; ++type) {
+    for (int32_t i = 0; i < gConvMaxNum[type]; ++i) {
+      iconv_close(gConv[type][i].conv);
+    }
+    taosMemoryFreeClear(gConv[type]);
+    gConvMaxNum[type] = -1;
   }
-  taosMemoryFreeClear(gConv);
-  gConvMaxNum = -1;
+  gConvAscii = false;
+  gConvUtf8 = false;
 }
 
-iconv_t taosAcquireConv(int32_t *idx) {
-  if (gConvMaxNum <= 0) {
+iconv_t taosAcquireConv(int32_t *idx, ConvType type) {
+  if (gConvMaxNum[type] <= 0) {
     *idx = -1;
-    return iconv_open(DEFAULT_UNICODE_ENCODEC, tsCharset);
+    return taosOpenConv(type);
   }
 
   while (true) {
-    int32_t used = atomic_add_fetch_32(&convUsed, 1);
-    if (used > gConvMaxNum) {
-      used = atomic_sub_fetch_32(&convUsed, 1);
+    int32_t used = atomic_add_fetch_32(&convUsed[type], 1);
+    if (used > gConvMaxNum[type]) {
+      used = atomic_sub_fetch_32(&convUsed[type], 1);
       sched_yield();
       continue;
     }
@@ -179,31 +209,161 @@ iconv_t taosAcquireConv(int32_t *idx) {
     break;
   }
 
-  int32_t startId = taosGetSelfPthreadId() % gConvMaxNum;
+  int32_t startId = taosGetSelfPthreadId() % gConvMaxNum[type];
   while (true) {
-    if (gConv[startId].inUse) {
-      startId = (startId + 1) % gConvMaxNum;
+    if (gConv[type][startId].inUse) {
+      startId = (startId + 1) % gConvMaxNum[type];
       continue;
     }
 
-    int8_t old = atomic_val_compare_exchange_8(&gConv[startId].inUse, 0, 1);
+    int8_t old = atomic_val_compare_exchange_8(&gConv[type][startId].inUse, 0, 1);
     if (0 == old) {
       break;
     }
   }
 
   *idx = startId;
-  return gConv[startId].conv;
+  return gConv[type][startId].conv;
 }
 
-void taosReleaseConv(int32_t idx, iconv_t conv) {
+void taosReleaseConv(int32_t idx, iconv_t conv, ConvType type) {
   if (idx < 0) {
     iconv_close(conv);
     return;
   }
 
-  atomic_store_8(&gConv[idx].inUse, 0);
-  atomic_sub_fetch_32(&convUsed, 1);
+  atomic_store_8(&gConv[type][idx].inUse, 0);
+  atomic_sub_fetch_32(&convUsed[type], 1);
+}
+
+static int32_t taosUcs4ToUtf8(const TdUcs4 *ucs4, int32_t ucs4_max_len, char *mbs) {
+  if (ucs4_max_len % sizeof(TdUcs4) != 0) {
+    return -1;
+  }
+
+  // no more than 4 bytes for each char, the output never exceeds the input
+  uint8_t *out = (uint8_t *)mbs;
+  int32_t  total = ucs4_max_len / sizeof(TdUcs4);
+  for (int32_t i = 0; i < total; ++i) {
+    uint32_t c = (uint32_t)ucs4[i];
+    if (c < 0x80) {
+      *out++ = (uint8_t)c;
+    } else if (c < 0x800) {
+      *out++ = (uint8_t)(0xC0 | (c >> 6));
+      *out++ = (uint8_t)(0x80 | (c & 0x3F));
+    } else if (c < 0x10000) {
+      if (c >= 0xD800 && c <= 0xDFFF) {
+        return -1;
+      }
+      *out++ = (uint8_t)(0xE0 | (c >> 12));
+      *out++ = (uint8_t)(0x80 | ((c >> 6) & 0x3F));
+      *out++ = (uint8_t)(0x80 | (c & 0x3F));
+    } else if (c <= 0x10FFFF) {
+      *out++ = (uint8_t)(0xF0 | (c >> 18));
+      *out++ = (uint8_t)(0x80 | ((c >> 12) & 0x3F));
+      *out++ = (uint8_t)(0x80 | ((c >> 6) & 0x3F));
+      *out++ = (uint8_t)(0x80 | (c & 0x3F));
+    } else {
+      return -1;
+    }
+  }
+
+  return (int32_t)(out - (uint8_t *)mbs);
+}
+
+// the overlong forms, the surrogates and the truncated chars are rejected as iconv does
+static bool taosUtf8ToUcs4(const char *mbs, size_t mbsLength, TdUcs4 *ucs4, int32_t ucs4_max_len, int32_t *len) {
+  const uint8_t *in = (const uint8_t *)mbs;
+  int32_t        total = ucs4_max_len / sizeof(TdUcs4);
+  int32_t        num = 0;
+  size_t         i = 0;
+  while (i < mbsLength) {
+    if (num >= total) {
+      return false;
+    }
+
+    uint32_t c = in[i];
+    int32_t  n = 0;
+    uint32_t min = 0;
+    if (c < 0x80) {
+      ucs4[num++] = (TdUcs4)c;
+      i++;
+      continue;
+    } else if ((c & 0xE0) == 0xC0) {
+      c &= 0x1F;
+      n = 1;
+      min = 0x80;
+    } else if ((c & 0xF0) == 0xE0) {
+      c &= 0x0F;
+      n = 2;
+      min = 0x800;
+    } else if ((c & 0xF8) == 0xF0) {
+      c &= 0x07;
+      n = 3;
+      min = 0x10000;
+    } else {
+      return false;
+    }
+
+    if (mbsLength - i <= n) {
+      return false;
+    }
+    for (int32_t k = 1; k <= n; ++k) {
+      if ((in[i + k] & 0xC0) != 0x80) {
+        return false;
+      }
+      c = (c << 6) | (in[i + k] & 0x3F);
+    }
+    if (c < min || c > 0x10FFFF || (c >= 0xD800 && c <= 0xDFFF)) {
+      return false;
+    }
+
+    ucs4[num++] = (TdUcs4)c;
+    i += n + 1;
+  }
+
+  if (len != NULL) {
+    *len = num * sizeof(TdUcs4);
+  }
+  return true;
+}
+
+int32_t taosUcs4ToMbs(TdUcs4 *ucs4, int32_t ucs4_max_len, char *mbs) {
+#ifdef DISALLOW_NCHAR_WITHOUT_ICONV
+  printf("Nchar cannot be read and written without iconv, please install iconv library and recompile TDengine.\n");
+  return -1;
+#else
+  if (gConvUtf8) {
+    return taosUcs4ToUtf8(ucs4, ucs4_max_len, mbs);
+  }
+
+  // the leading ascii chars are narrowed directly, iconv only takes the rest from the first other char
+  int32_t num = 0;
+  if (gConvAscii) {
+    int32_t total = ucs4_max_len / sizeof(TdUcs4);
+    while (num < total && (uint32_t)ucs4[num] < 0x80) {
+      mbs[num] = (char)ucs4[num];
+      num++;
+    }
+    if (num * (int32_t)sizeof(TdUcs4) == ucs4_max_len) {
+      return num;
+    }
+  }
+
+  int32_t idx = -1;
+  iconv_t conv = taosAcquireConv(&idx, C2M);
+  char   *in = (char *)(ucs4 + num);
+  char   *out = mbs + num;
+  size_t  ucs4_input_len = ucs4_max_len - num * sizeof(TdUcs4);
+  size_t  outLen = ucs4_max_len - num;
+  if (iconv(conv, &in, &ucs4_input_len, &out, &outLen) == -1) {
+    taosReleaseConv(idx, conv, C2M);
+    return -1;
+  }
+
+  taosReleaseConv(idx, conv, C2M);
+  return (int32_t)(ucs4_max_len - outLen);
+#endif
 }
 
 bool taosMbsToUcs4(const char *mbs, size_t mbsLength, TdUcs4 *ucs4, int32_t ucs4_max_len, int32_t *len) {
@@ -212,17 +372,34 @@ bool taosMbsToUcs4(const char *mbs, size_t mbsLength, TdUcs4 *ucs4, int32_t ucs4
   return -1;
 #else
   memset(ucs4, 0, ucs4_max_len);
+  if (gConvUtf8) {
+    return taosUtf8ToUcs4(mbs, mbsLength, ucs4, ucs4_max_len, len);
+  }
 
-  int32_t idx = -1;
-  iconv_t conv = taosAcquireConv(&idx);
-  size_t  ucs4_input_len = mbsLength;
-  size_t  outLeft = ucs4_max_len;
-  if (iconv(conv, (char **)&mbs, &ucs4_input_len, (char **)&ucs4, &outLeft) == -1) {
-    taosReleaseConv(idx, conv);
-    return false;
+  size_t num = 0;
+  if (gConvAscii) {
+    size_t total = TMIN(mbsLength, ucs4_max_len / sizeof(TdUcs4));
+    while (num < total && (uint8_t)mbs[num] < 0x80) {
+      ucs4[num] = (uint8_t)mbs[num];
+      num++;
+    }
+  }
+
+  size_t outLeft = ucs4_max_len - num * sizeof(TdUcs4);
+  if (num < mbsLength) {
+    int32_t idx = -1;
+    iconv_t conv = taosAcquireConv(&idx, M2C);
+    char   *in = (char *)(mbs + num);
+    char   *out = (char *)(ucs4 + num);
+    size_t  ucs4_input_len = mbsLength - num;
+    if (iconv(conv, &in, &ucs4_input_len, &out, &outLeft) == -1) {
+      taosReleaseConv(idx, conv, M2C);
+      return false;
+    }
+
+    taosReleaseConv(idx, conv, M2C);
   }
 
-  taosReleaseConv(idx, conv);
   if (len != NULL) {
     *len = (int32_t)(ucs4_max_len - outLeft);
     if (*len < 0) {
@@ -266,6 +443,28 @@ int32_t taosUcs4len(TdUcs4 *ucs4) {
   return n;
 }
 
+// a char of UTF-8 starts at the first byte or at any byte not of the form 10xxxxxx
+#define UTF8_CONTINUATION(c) (((uint8_t)(c)&0xC0) == 0x80)
+
+int32_t taosUtf8StrLen(const char *str, int32_t bytes) {
+  int32_t num = (bytes > 0) ? 1 : 0;
+  for (int32_t i = 1; i < bytes; ++i) {
+    num += !UTF8_CONTINUATION(str[i]);
+  }
+  return num;
+}
+
+int32_t taosUtf8Offset(const char *str, int32_t bytes, int32_t chars) {
+  int32_t pos = 0;
+  while (chars-- > 0 && pos < bytes) {
+    pos++;
+    while (pos < bytes && UTF8_CONTINUATION(str[pos])) {
+      pos++;
+    }
+  }
+  return pos;
+}
+
 // dst buffer size should be at least 2*len + 1
 int32_t taosHexEncode(const unsigned char *src, char *dst, int32_t len) {
   if (!dst) {
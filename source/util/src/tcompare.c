@@ -1004,7 +1004,7 @@ int32_t compareJsonValDesc(const void *pLeft, const void *pRight) { return compa
  *    TSDB_NOWILDCARDMATCH:  No match in spite of having * or % wildcards.
  * Like matching rules:
  *      '%': Matches zero or more characters
- *      '_': Matches one character
+ *      '_': Matches one character, all the bytes of a char of UTF-8 if pInfo->utf8 is set
  *
  */
 int32_t patternMatch(const char *patterStr, const char *str, size_t size, const SPatternCompareInfo *pInfo) {
@@ -1020,11 +1020,13 @@ int32_t patternMatch(const char *patterStr, const char *str, size_t size, const
 
       while ((c = patterStr[i++]) == pInfo->matchAll || c == pInfo->matchOne) {
         if (c == pInfo->matchOne) {
-          if (j > size || str[j++] == 0) {
+          if (j >= size || str[j] == 0) {
             // empty string, return not match
             return TSDB_PATTERN_NOWILDCARDMATCH;
           } else {
-            ++o;
+            int32_t n = pInfo->utf8 ? taosUtf8Offset(str + j, size - j, 1) : 1;
+            j += n;
+            o += n;
           }
         }
       }
@@ -1060,7 +1062,15 @@ int32_t patternMatch(const char *patterStr, const char *str, size_t size, const
         i++;
         continue;
       }
-      if (c == c1 || tolower(c) == tolower(c1) || (c == pInfo->matchOne && c1 != 0)) {
+      if (c == pInfo->matchOne && c1 != 0) {
+        if (pInfo->utf8) {
+          int32_t n = taosUtf8Offset(str + j - 1, size - j + 1, 1) - 1;
+          j += n;
+          o += n;
+        }
+        continue;
+      }
+      if (c == c1 || tolower(c) == tolower(c1)) {
         continue;
       }
     }
@@ -1173,9 +1183,7 @@ int32_t taosArrayCompareString(const void *a, const void *b) {
   return compareLenPrefixedStr(x, y);
 }
 
-int32_t compareStrPatternMatch(const void *pLeft, const void *pRight) {
-  SPatternCompareInfo pInfo = {'%', '_'};
-
+static int32_t doCompareStrPatternMatch(const void *pLeft, const void *pRight, const SPatternCompareInfo *pInfo) {
   assert(varDataLen(pRight) <= TSDB_MAX_FIELD_LEN);
   char *pattern = taosMemoryCalloc(varDataLen(pRight) + 1, sizeof(char));
   memcpy(pattern, varDataVal(pRight), varDataLen(pRight));
@@ -1185,16 +1193,30 @@ int32_t compareStrPatternMatch(const void *pLeft, const void *pRight) {
   memcpy(buf, varDataVal(pLeft), sz);
   buf[sz] = 0;
 
-  int32_t ret = patternMatch(pattern, buf, sz, &pInfo);
+  int32_t ret = patternMatch(pattern, buf, sz, pInfo);
   taosMemoryFree(buf);
   taosMemoryFree(pattern);
   return (ret == TSDB_PATTERN_MATCH) ? 0 : 1;
 }
 
+int32_t compareStrPatternMatch(const void *pLeft, const void *pRight) {
+  SPatternCompareInfo pInfo = {'%', '_'};
+  return doCompareStrPatternMatch(pLeft, pRight, &pInfo);
+}
+
 int32_t compareStrPatternNotMatch(const void *pLeft, const void *pRight) {
   return compareStrPatternMatch(pLeft, pRight) ? 0 : 1;
 }
 
+int32_t compareUtf8PatternMatch(const void *pLeft, const void *pRight) {
+  SPatternCompareInfo pInfo = {'%', '_', true};
+  return doCompareStrPatternMatch(pLeft, pRight, &pInfo);
+}
+
+int32_t compareUtf8PatternNotMatch(const void *pLeft, const void *pRight) {
+  return compareUtf8PatternMatch(pLeft, pRight) ? 0 : 1;
+}
+
 int32_t compareWStrPatternMatch(const void *pLeft, const void *pRight) {
   SPatternCompareInfo pInfo = {'%', '_'};
 
@@ -0,0 +1,6 @@
+char version[64] = "3.0.1.8";
+char compatible_version[12] = "3.0.0.0";
+char gitinfo[48] = "a4cbdc90c702a5699158a1f2018935ce5acb234c";
+char buildinfo[64] = "Built at 2026-10-19 14:41:55";
+
+void libtaos_3_0_1_8_Linux_x64_stable() {};
@@ -4,6 +4,7 @@
 #include <iostream>
 
 #include "taos.h"
+#include "tcompare.h"
 #include "tutil.h"
 
 TEST(testCase, string_dequote_test) {
@@ -177,4 +178,73 @@ TEST(testCase, string_strnchr_test) {
 
 //   char a16[] = "'-'.";
 //   EXPECT_TRUE(strnchr(a16, '.', strlen(a16), true) != NULL);
-// }
\ No newline at end of file
+// }
+TEST(testCase, ucs4_convert_test) {
+  char charset[TD_CHARSET_LEN] = {0};
+  memcpy(charset, tsCharset, TD_CHARSET_LEN);
+  strcpy(tsCharset, "UTF-8");
+  taosConvInit();
+
+  const char *strs[] = {"", "abc", "abcdefghijklmnopqrstuvwxyz0123456789", "abc\xe4\xb8\xad\xe6\x96\x87" "def",
+                        "\xe4\xb8\xad\xe6\x96\x87", "\xc3\xa9\xf0\x9f\x98\x80"};
+  const int32_t chars[] = {0, 3, 36, 8, 2, 2};
+  for (int32_t i = 0; i < sizeof(strs) / sizeof(strs[0]); ++i) {
+    TdUcs4  ucs4[64] = {0};
+    char    mbs[256] = {0};
+    int32_t len = 0;
+    ASSERT_TRUE(taosMbsToUcs4(strs[i], strlen(strs[i]), ucs4, sizeof(ucs4), &len));
+    ASSERT_EQ(len, chars[i] * TSDB_NCHAR_SIZE);
+    ASSERT_EQ(taosUcs4ToMbs(ucs4, len, mbs), strlen(strs[i]));
+    ASSERT_STREQ(mbs, strs[i]);
+  }
+
+  // the buffer is too small
+  TdUcs4 ucs4[2] = {0};
+  ASSERT_FALSE(taosMbsToUcs4("abc", 3, ucs4, sizeof(ucs4), NULL));
+  ASSERT_FALSE(taosMbsToUcs4("a\xe4\xb8\xad\xe6\x96\x87", 7, ucs4, sizeof(ucs4), NULL));
+
+  // a truncated char, a stray continuation byte, an overlong form and a surrogate
+  ASSERT_FALSE(taosMbsToUcs4("\xe4\xb8", 2, ucs4, sizeof(ucs4), NULL));
+  ASSERT_FALSE(taosMbsToUcs4("\xb8", 1, ucs4, sizeof(ucs4), NULL));
+  ASSERT_FALSE(taosMbsToUcs4("\xc0\xaf", 2, ucs4, sizeof(ucs4), NULL));
+  ASSERT_FALSE(taosMbsToUcs4("\xed\xa0\x80", 3, ucs4, sizeof(ucs4), NULL));
+  char mbs[8] = {0};
+  ucs4[0] = 0xD800;
+  ASSERT_EQ(taosUcs4ToMbs(ucs4, sizeof(TdUcs4), mbs), -1);
+  ucs4[0] = 0x110000;
+  ASSERT_EQ(taosUcs4ToMbs(ucs4, sizeof(TdUcs4), mbs), -1);
+
+  taosConvDestroy();
+  memcpy(tsCharset, charset, TD_CHARSET_LEN);
+}
+
+TEST(testCase, utf8_length_test) {
+  const char *str = "a\xe4\xb8\xad\xc3\xa9\xf0\x9f\x98\x80z";
+  int32_t     bytes = strlen(str);
+  ASSERT_EQ(taosUtf8StrLen(str, 0), 0);
+  ASSERT_EQ(taosUtf8StrLen(str, bytes), 5);
+  ASSERT_EQ(taosUtf8StrLen("abc", 3), 3);
+
+  const int32_t offsets[] = {0, 1, 4, 6, 10, 11, 11};
+  for (int32_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); ++i) {
+    ASSERT_EQ(taosUtf8Offset(str, bytes, i), offsets[i]);
+  }
+
+  // the char cut at the end of the value is counted, and the offset stops at the end
+  ASSERT_EQ(taosUtf8StrLen(str, 3), 2);
+  ASSERT_EQ(taosUtf8Offset(str, 3, 2), 3);
+}
+
+TEST(testCase, utf8_pattern_match_test) {
+  const char         *str = "a\xe4\xb8\xad" "b";
+  size_t              len = strlen(str);
+  SPatternCompareInfo bytes = PATTERN_COMPARE_INFO_INITIALIZER;
+  SPatternCompareInfo chars = {'%', '_', true};
+
+  // '_' is a byte of a VARCHAR, and a char of the UTF-8 of an nchar
+  ASSERT_EQ(patternMatch("a___b", str, len, &bytes), TSDB_PATTERN_MATCH);
+  ASSERT_EQ(patternMatch("a_b", str, len, &bytes), TSDB_PATTERN_NOMATCH);
+  ASSERT_EQ(patternMatch("a_b", str, len, &chars), TSDB_PATTERN_MATCH);
+  ASSERT_EQ(patternMatch("a___b", str, len, &chars), TSDB_PATTERN_NOMATCH);
+  ASSERT_EQ(patternMatch("%_b", str, len, &chars), TSDB_PATTERN_MATCH);
+}
@@ -0,0 +1,68 @@
+import os
+
+from util.log import *
+from util.cases import *
+from util.sql import *
+from util.types import TDSmlProtocolType, TDSmlTimestampType
+from util.common import tdCom
+
+class TDTestCase:
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor(), False)
+        self._conn = conn
+
+        self.tb_nums = 10
+        self.ts = 1626006833639000000
+
+    def createDb(self, name):
+        tdSql.execute(f"drop database if exists {name}")
+        tdSql.execute(f"create database {name} vgroups 2 schemaless 1")
+        tdSql.execute(f"use {name}")
+
+    def execInOtherProcess(self, sql):
+        # the meta cached by the client of this process is not told about it
+        buildPath = tdCom.getBuildPath()
+        cfgPath = tdCom.getClientCfgPath()
+        cmdStr = '%s/build/bin/taos -c %s -s "%s"' % (buildPath, cfgPath, sql)
+        tdLog.info(cmdStr)
+        if os.system(cmdStr) != 0:
+            tdLog.exit(f"failed to execute {sql}")
+
+    def buildLines(self, round):
+        lines = []
+        for i in range(self.tb_nums):
+            lines.append(f"stb,t1=tb{i} c1={round}i64,c2=\"v{round}\" {self.ts + round * 1000000000}")
+        return lines
+
+    def insertAndCheck(self, round, rows):
+        # the batch submitted with the stale meta is sent again with the meta of the mnode
+        self._conn.schemaless_insert(self.buildLines(round), TDSmlProtocolType.LINE.value,
+                                     TDSmlTimestampType.NANO_SECOND.value)
+        tdSql.query("select count(*) from stb")
+        tdSql.checkData(0, 0, rows)
+        tdSql.query(f"select count(*) from stb where c1 = {round}")
+        tdSql.checkData(0, 0, self.tb_nums)
+
+    def run(self):
+        dbname = "sml_db"
+        self.createDb(dbname)
+
+        # cache the meta of the stable and the vgroups of the child tables
+        self.insertAndCheck(0, self.tb_nums)
+        self.insertAndCheck(1, self.tb_nums * 2)
+
+        # the stable is created again with another uid
+        self.execInOtherProcess(f"drop table {dbname}.stb; create stable {dbname}.stb "
+                                f"(_ts timestamp, c1 bigint, c2 binary(16)) tags (t1 binary(16))")
+        self.insertAndCheck(2, self.tb_nums)
+        self.insertAndCheck(3, self.tb_nums * 2)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
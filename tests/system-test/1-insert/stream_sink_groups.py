@@ -0,0 +1,81 @@
+import time
+
+from util.log import *
+from util.sql import *
+from util.cases import *
+
+class TDTestCase:
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+        self.tb_nums = 4
+        # more windows of a group than the rows of a result block, so the sink gets several blocks of each new table
+        self.row_nums = 6000
+        self.ts = 1648791210000
+
+    def prepare_datas(self, dbname):
+        tdSql.execute(f"drop database if exists {dbname}")
+        tdSql.execute(f"create database {dbname} vgroups 1")
+        tdSql.execute(f"create stable {dbname}.stb (ts timestamp, c1 int) tags (t1 int)")
+        for i in range(self.tb_nums):
+            # two tables of each tag
+            tdSql.execute(f"create table {dbname}.ct_{i} using {dbname}.stb tags ({i // 2})")
+
+    def insert_datas(self, dbname):
+        # the rows of all tables in one submit, so the results of all groups come in one sink batch
+        sql = "insert into"
+        for i in range(self.tb_nums):
+            sql += f" {dbname}.ct_{i} values"
+            for row in range(self.row_nums):
+                sql += f" ({self.ts + row * 1000}, {row % 10})"
+        tdSql.execute(sql)
+
+    def wait_rows(self, sql, rows):
+        for _ in range(60):
+            tdSql.query(sql)
+            if tdSql.queryResult[0][0] == rows:
+                return
+            time.sleep(1)
+        tdLog.exit(f"[{sql}] returns {tdSql.queryResult[0][0]}, {rows} expected")
+
+    def check_sink(self, dbname, stream, groups):
+        rows = groups * self.row_nums
+        self.wait_rows(f"select count(*) from {dbname}.{stream}", rows)
+
+        # each group is written into a single table created once
+        tdSql.query(f"select distinct tbname from {dbname}.{stream}")
+        tdSql.checkRows(groups)
+        tdSql.query(f"select tbname, count(*), sum(s) from {dbname}.{stream} partition by tbname")
+        tdSql.checkRows(groups)
+        for row in tdSql.queryResult:
+            if row[1] != self.row_nums:
+                tdLog.exit(f"table {row[0]} has {row[1]} rows, {self.row_nums} expected")
+
+        tdSql.query(f"select sum(s) from {dbname}.{stream}")
+        tdSql.checkData(0, 0, self.tb_nums * sum(row % 10 for row in range(self.row_nums)))
+
+    def run(self):
+        dbname = "db"
+        self.prepare_datas(dbname)
+        tdSql.execute(f"create stream s_tb trigger at_once into {dbname}.st_tb as "
+                      f"select _wstart, count(*) c, sum(c1) s from {dbname}.stb partition by tbname interval(1s)")
+        tdSql.execute(f"create stream s_tag trigger at_once into {dbname}.st_tag as "
+                      f"select _wstart, count(*) c, sum(c1) s from {dbname}.stb partition by t1 interval(1s)")
+        time.sleep(2)
+
+        self.insert_datas(dbname)
+        self.check_sink(dbname, "st_tb", self.tb_nums)
+        self.check_sink(dbname, "st_tag", self.tb_nums // 2)
+
+        tdSql.execute("drop stream s_tb")
+        tdSql.execute("drop stream s_tag")
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,90 @@
+from util.log import *
+from util.sql import *
+from util.cases import *
+
+class TDTestCase:
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+        # more tables than a morsel of the parallel group by, so that the workers are started
+        self.tb_nums = 3100
+        self.row_nums = 3
+        self.tag_nums = 10
+        self.ts = 1537146000000
+
+    def prepare_datas(self, dbname="db"):
+        tdSql.execute(f"drop database if exists {dbname}")
+        tdSql.execute(f"create database {dbname} vgroups 1")
+        tdSql.execute(f"create stable {dbname}.stb (ts timestamp, c1 int, c2 bigint) tags (t1 int)")
+
+        for start in range(0, self.tb_nums, 100):
+            sql = "create table"
+            for i in range(start, min(start + 100, self.tb_nums)):
+                sql += f" {dbname}.ct_{i} using {dbname}.stb tags ({i % self.tag_nums})"
+            tdSql.execute(sql)
+
+        for start in range(0, self.tb_nums, 100):
+            sql = "insert into"
+            for i in range(start, min(start + 100, self.tb_nums)):
+                sql += f" {dbname}.ct_{i} values"
+                for row in range(self.row_nums):
+                    sql += f" ({self.ts + row * 1000}, {i + row}, {i * row})"
+            tdSql.execute(sql)
+
+    def expected_by_tag(self):
+        res = {}
+        for i in range(self.tb_nums):
+            for row in range(self.row_nums):
+                t1 = i % self.tag_nums
+                cnt, total, mi, ma = res.get(t1, (0, 0, None, None))
+                v = i + row
+                res[t1] = (cnt + 1, total + v, v if mi is None else min(mi, v), v if ma is None else max(ma, v))
+        return res
+
+    def check_same(self, sql1, sql2):
+        tdSql.query(sql1)
+        res1 = tdSql.queryResult
+        tdSql.query(sql2)
+        res2 = tdSql.queryResult
+        if res1 != res2:
+            tdLog.exit(f"results differ, [{sql1}]: {res1[:5]}... [{sql2}]: {res2[:5]}...")
+
+    def group_by_tag(self, dbname="db"):
+        tdSql.query(f"select t1, count(*), sum(c1), min(c1), max(c1) from {dbname}.stb group by t1 order by t1")
+        tdSql.checkRows(self.tag_nums)
+        expected = self.expected_by_tag()
+        for t1 in range(self.tag_nums):
+            cnt, total, mi, ma = expected[t1]
+            tdSql.checkData(t1, 0, t1)
+            tdSql.checkData(t1, 1, cnt)
+            tdSql.checkData(t1, 2, total)
+            tdSql.checkData(t1, 3, mi)
+            tdSql.checkData(t1, 4, ma)
+
+        # the group by on a subquery is never run in parallel
+        self.check_same(f"select t1, count(*), sum(c1), min(c1), max(c1), avg(c2) from {dbname}.stb group by t1 order by t1",
+                        f"select t1, count(*), sum(c1), min(c1), max(c1), avg(c2) from (select t1, c1, c2 from {dbname}.stb) group by t1 order by t1")
+
+    def group_by_column(self, dbname="db"):
+        self.check_same(f"select c1, count(*), sum(c2), max(t1) from {dbname}.stb group by c1 order by c1",
+                        f"select c1, count(*), sum(c2), max(t1) from (select c1, c2, t1 from {dbname}.stb) group by c1 order by c1")
+        self.check_same(f"select t1, count(*) from {dbname}.stb where c1 > 1000 group by t1 order by t1",
+                        f"select t1, count(*) from (select t1, c1 from {dbname}.stb) where c1 > 1000 group by t1 order by t1")
+
+    def run(self):
+        self.prepare_datas()
+        self.group_by_tag()
+        self.group_by_column()
+
+        tdSql.query("select count(*) from (select c1 from db.stb group by c1)")
+        tdSql.checkData(0, 0, self.tb_nums + self.row_nums - 1)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,76 @@
+from util.log import *
+from util.sql import *
+from util.cases import *
+
+class TDTestCase:
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+        # several file blocks of each table fall into one day, so only their SMA is loaded by interval(1d)
+        self.row_nums = 50000
+        self.tb_nums = 2
+        self.ts = 1537146000000
+
+    def prepare_datas(self, dbname, precision):
+        unit = 1000 if precision == "ms" else 1000000
+        tdSql.execute(f"drop database if exists {dbname}")
+        tdSql.execute(f"create database {dbname} vgroups 1 precision '{precision}'")
+        tdSql.execute(f"create stable {dbname}.stb (ts timestamp, c1 int, c2 double) tags (t1 int)")
+
+        for i in range(self.tb_nums):
+            tdSql.execute(f"create table {dbname}.ct_{i} using {dbname}.stb tags ({i})")
+            for start in range(0, self.row_nums, 2000):
+                sql = f"insert into {dbname}.ct_{i} values"
+                for row in range(start, start + 2000):
+                    sql += f" ({(self.ts + row * 2000) * unit // 1000}, {row % 100}, {row * 0.5})"
+                tdSql.execute(sql)
+
+        # the SMA only exists in the data files
+        tdSql.execute(f"flush database {dbname}")
+
+    def check_same(self, sql1, sql2):
+        tdSql.query(sql1)
+        res1 = tdSql.queryResult
+        tdSql.query(sql2)
+        res2 = tdSql.queryResult
+        if res1 != res2:
+            tdLog.exit(f"results differ, [{sql1}]: {res1[:3]}... [{sql2}]: {res2[:3]}...")
+        return res1
+
+    def check_interval(self, dbname):
+        funcs = "_wstart, _wend, count(*), count(c1), sum(c1), min(c1), max(c1), sum(c2)"
+        for window in ["1d", "1h", "10m"]:
+            # the interval on a subquery always loads the data
+            res = self.check_same(f"select {funcs} from {dbname}.ct_0 interval({window})",
+                                  f"select {funcs} from (select ts, c1, c2 from {dbname}.ct_0) interval({window})")
+            total = sum(row[2] for row in res)
+            if total != self.row_nums:
+                tdLog.exit(f"interval({window}) counts {total} rows, {self.row_nums} expected")
+
+            self.check_same(f"select * from (select tbname, {funcs} from {dbname}.stb partition by tbname interval({window})) order by 1, 2",
+                            f"select * from (select tbname, {funcs} from (select tbname, ts, c1, c2 from {dbname}.stb) partition by tbname interval({window})) order by 1, 2")
+
+        # sliding windows always load the data
+        self.check_same(f"select {funcs} from {dbname}.ct_1 interval(1d) sliding(12h)",
+                        f"select {funcs} from (select ts, c1, c2 from {dbname}.ct_1) interval(1d) sliding(12h)")
+
+        # the aggregation on the result of interval is not affected by the blocks of which only SMA is loaded
+        self.check_same(f"select count(*), sum(s) from (select _wstart, sum(c1) s from {dbname}.ct_0 interval(1d))",
+                        f"select count(*), sum(s) from (select _wstart, sum(c1) s from (select ts, c1 from {dbname}.ct_0) interval(1d))")
+
+    def run(self):
+        self.prepare_datas("db", "ms")
+        self.check_interval("db")
+
+        self.prepare_datas("db_us", "us")
+        self.check_interval("db_us")
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,77 @@
+from util.log import *
+from util.sql import *
+from util.cases import *
+
+class TDTestCase:
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+        self.tb_nums = 4
+        # far more windows than the rows of a result block, so a result block is emitted before all windows are closed
+        self.row_nums = 20000
+        self.ts = 1537146000000
+
+    def prepare_datas(self, dbname="db"):
+        tdSql.execute(f"drop database if exists {dbname}")
+        tdSql.execute(f"create database {dbname} vgroups 2")
+        tdSql.execute(f"create stable {dbname}.stb (ts timestamp, c1 int) tags (t1 int)")
+
+        for i in range(self.tb_nums):
+            tdSql.execute(f"create table {dbname}.ct_{i} using {dbname}.stb tags ({i})")
+            for start in range(0, self.row_nums, 1000):
+                sql = f"insert into {dbname}.ct_{i} values"
+                for row in range(start, start + 1000):
+                    sql += f" ({self.ts + row * 1000}, {row % 7 + i})"
+                tdSql.execute(sql)
+
+    def check_same(self, sql1, sql2):
+        tdSql.query(sql1)
+        res1 = tdSql.queryResult
+        tdSql.query(sql2)
+        res2 = tdSql.queryResult
+        if res1 != res2:
+            tdLog.exit(f"results differ, [{sql1}]: {len(res1)} rows, [{sql2}]: {len(res2)} rows")
+        return res1
+
+    def child_table_interval(self, dbname="db"):
+        # the interval on a subquery never runs in the streaming mode
+        res = self.check_same(f"select _wstart, count(*), sum(c1) from {dbname}.ct_1 interval(3s)",
+                              f"select _wstart, count(*), sum(c1) from (select ts, c1 from {dbname}.ct_1) interval(3s)")
+        if len(res) != (self.row_nums + 2) // 3 + 1 and len(res) != (self.row_nums + 2) // 3:
+            tdLog.exit(f"unexpected windows: {len(res)}")
+
+        # each emitted window is filtered exactly once
+        res = self.check_same(f"select _wstart, sum(c1) from {dbname}.ct_1 interval(3s) having sum(c1) % 2 = 0",
+                              f"select _wstart, sum(c1) from (select ts, c1 from {dbname}.ct_1) interval(3s) having sum(c1) % 2 = 0")
+        for row in res:
+            if row[1] % 2 != 0:
+                tdLog.exit(f"row not filtered: {row}")
+
+        # all windows of some result blocks are removed by the filter
+        self.check_same(f"select _wstart, max(c1) from {dbname}.ct_1 interval(1s) having _wstart > '2018-09-17 09:30:00.000'",
+                        f"select _wstart, max(c1) from (select ts, c1 from {dbname}.ct_1) interval(1s) having _wstart > '2018-09-17 09:30:00.000'")
+
+    def partition_interval(self, dbname="db"):
+        self.check_same(f"select * from (select tbname, _wstart, count(*), min(c1), max(c1) from {dbname}.stb partition by tbname interval(7s) having count(*) > 6) order by 1, 2",
+                        f"select * from (select tbname, _wstart, count(*), min(c1), max(c1) from (select tbname, ts, c1 from {dbname}.stb) partition by tbname interval(7s) having count(*) > 6) order by 1, 2")
+        self.check_same(f"select count(*) from (select tbname, _wstart, sum(c1) from {dbname}.stb partition by tbname interval(2s) having sum(c1) > 10)",
+                        f"select count(*) from (select tbname, _wstart, sum(c1) from (select tbname, ts, c1 from {dbname}.stb) partition by tbname interval(2s) having sum(c1) > 10)")
+
+    def run(self):
+        self.prepare_datas()
+        self.child_table_interval()
+        self.partition_interval()
+
+        tdSql.execute("flush database db")
+        self.child_table_interval()
+        self.partition_interval()
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
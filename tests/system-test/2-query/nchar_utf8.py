@@ -0,0 +1,106 @@
+from util.log import *
+from util.sql import *
+from util.cases import *
+
+class TDTestCase:
+    # the nchar columns of the databases created by the dnode keep UTF-8
+    updatecfgDict = {'ncharUtf8': 1}
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+        self.ts = 1537146000000
+        self.values = ["abc", "中文字符", "aé😀b", "😀" * 8]
+
+    def prepare_datas(self, dbname):
+        tdSql.execute(f"drop database if exists {dbname}")
+        tdSql.execute(f"create database {dbname} vgroups 1")
+        tdSql.execute(f"create stable {dbname}.stb (ts timestamp, c1 nchar(8), c2 binary(32)) tags (t1 nchar(4))")
+        tdSql.execute(f"create table {dbname}.ct_0 using {dbname}.stb tags ('标签')")
+        for i, value in enumerate(self.values):
+            tdSql.execute(f"insert into {dbname}.ct_0 values ({self.ts + i}, '{value}', '{value}')")
+        tdSql.execute(f"insert into {dbname}.ct_0 values ({self.ts + len(self.values)}, null, null)")
+
+    def check_schema(self, dbname):
+        # 4 bytes for each char
+        tdSql.query(f"describe {dbname}.stb")
+        tdSql.checkData(1, 1, "VARCHAR")
+        tdSql.checkData(1, 2, 32)
+        tdSql.checkData(3, 1, "VARCHAR")
+        tdSql.checkData(3, 2, 16)
+
+        tdSql.execute(f"alter stable {dbname}.stb add column c3 nchar(4)")
+        tdSql.query(f"describe {dbname}.stb")
+        tdSql.checkData(3, 1, "VARCHAR")
+        tdSql.checkData(3, 2, 16)
+        # the chars of the column added are counted as well
+        tdSql.execute(f"create table {dbname}.ct_1 using {dbname}.stb tags ('标签')")
+        tdSql.execute(f"insert into {dbname}.ct_1 (ts, c3) values ({self.ts}, '中文')")
+        tdSql.query(f"select char_length(c3) from {dbname}.ct_1")
+        tdSql.checkData(0, 0, 2)
+        tdSql.execute(f"drop table {dbname}.ct_1")
+        tdSql.execute(f"alter stable {dbname}.stb drop column c3")
+
+    def check_values(self, dbname):
+        tdSql.query(f"select c1, t1 from {dbname}.ct_0 order by ts")
+        tdSql.checkRows(len(self.values) + 1)
+        for i, value in enumerate(self.values):
+            tdSql.checkData(i, 0, value)
+            tdSql.checkData(i, 1, "标签")
+        tdSql.checkData(len(self.values), 0, None)
+
+        # the chars are counted and cut on the UTF-8 kept
+        tdSql.query(f"select char_length(c1), length(c1), substr(c1, 2, 2), substr(c1, -2) from {dbname}.ct_0 order by ts")
+        for i, value in enumerate(self.values):
+            tdSql.checkData(i, 0, len(value))
+            tdSql.checkData(i, 1, len(value.encode()))
+            tdSql.checkData(i, 2, value[1:3])
+            tdSql.checkData(i, 3, value[-2:])
+        tdSql.checkData(len(self.values), 0, None)
+
+        # the binary columns of the database still count the bytes
+        tdSql.query(f"select char_length(c2), length(c2), substr(c2, 2, 2) from {dbname}.ct_0 where c2 = 'abc'")
+        tdSql.checkData(0, 0, 3)
+        tdSql.checkData(0, 1, 3)
+        tdSql.checkData(0, 2, "bc")
+        tdSql.query(f"select char_length(c2) from {dbname}.ct_0 order by ts")
+        for i, value in enumerate(self.values):
+            tdSql.checkData(i, 0, len(value.encode()))
+        tdSql.query(f"select c2 from {dbname}.ct_0 where c2 like 'a__b'")
+        tdSql.checkRows(0)
+        tdSql.query(f"select c2 from {dbname}.ct_0 where c2 like 'a______b'")
+        tdSql.checkRows(1)
+        tdSql.checkData(0, 0, "aé😀b")
+
+        # '_' matches a char of any bytes
+        tdSql.query(f"select c1 from {dbname}.ct_0 where c1 like '中_字%'")
+        tdSql.checkRows(1)
+        tdSql.checkData(0, 0, "中文字符")
+        tdSql.query(f"select c1 from {dbname}.ct_0 where c1 like 'a__b'")
+        tdSql.checkRows(1)
+        tdSql.checkData(0, 0, "aé😀b")
+        tdSql.query(f"select c1 from {dbname}.ct_0 where c1 like '________'")
+        tdSql.checkRows(1)
+        tdSql.checkData(0, 0, "😀" * 8)
+
+    def run(self):
+        dbname = "db"
+        self.prepare_datas(dbname)
+        self.check_schema(dbname)
+        self.check_values(dbname)
+
+        tdSql.execute(f"flush database {dbname}")
+        self.check_values(dbname)
+
+        # the values longer than the chars of the column in bytes are rejected
+        tdSql.error(f"insert into {dbname}.ct_0 values ({self.ts + 100}, '{'😀' * 9}')")
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,83 @@
+
+import taos
+import sys
+import time
+import socket
+import os
+import threading
+
+from util.log import *
+from util.sql import *
+from util.cases import *
+from util.dnodes import *
+from util.common import *
+sys.path.append("./7-tmq")
+from tmqCommon import *
+
+class TDTestCase:
+    def __init__(self):
+        self.vgroups    = 1
+        self.ctbNum     = 10
+        self.rowsPerTbl = 1000
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug(f"start to excute {__file__}")
+        tdSql.init(conn.cursor(), False)
+
+    def prepareTestEnv(self, dbName):
+        tmqCom.initConsumerTable()
+        tdCom.create_database(tdSql, dbName, 1, vgroups=self.vgroups, replica=1)
+        tmqCom.create_stable(tdSql, dbName=dbName, stbName='stb')
+        tmqCom.create_ctable(tdSql, dbName=dbName, stbName='stb', ctbPrefix='ctb', ctbNum=self.ctbNum, ctbStartIdx=0)
+
+    # the consumer polls before any data is written, so its polls are parked on the vnode and answered by the push
+    def consumeRealtime(self, caseName, keyList):
+        tdLog.printNoPrefix(f"======== {caseName}, consumer config: {keyList}")
+        dbName = 'dbt'
+        topicName = 'topic_batch'
+        self.prepareTestEnv(dbName)
+
+        queryString = "select ts, c1, c2 from %s.stb"%(dbName)
+        tdSql.execute("create topic %s as %s"%(topicName, queryString))
+
+        consumerId   = 0
+        expectrowcnt = self.rowsPerTbl * self.ctbNum
+        tmqCom.insertConsumerInfo(consumerId, expectrowcnt, topicName, keyList, 0, 0)
+
+        # the parked poll of a batch not reaching its rows is answered on expiry, so the consumer waits longer than it
+        tmqCom.startTmqSimProcess(pollDelay=30, dbName=dbName, showMsg=1, showRow=1, snapshot=0)
+        time.sleep(3)
+
+        tmqCom.insert_data_interlaceByMultiTbl(tsql=tdSql, dbName=dbName, ctbPrefix='ctb', ctbNum=self.ctbNum,
+                                               rowsPerTbl=self.rowsPerTbl, batchNum=10, startTs=1640966400000, ctbStartIdx=0)
+
+        resultList = tmqCom.selectConsumeResult(1)
+        if resultList[0] != expectrowcnt:
+            tdLog.exit("%s, expect consume rows: %d, act consume rows: %d"%(caseName, expectrowcnt, resultList[0]))
+
+        time.sleep(5)
+        tdSql.query("drop topic %s"%topicName)
+        tdLog.printNoPrefix(f"======== {caseName} end ...... ")
+
+    def run(self):
+        baseKeys = 'group.id:cgrp1, enable.auto.commit:true, auto.commit.interval.ms:1000, auto.offset.reset:earliest'
+
+        # answered on the first block
+        self.consumeRealtime("answer at once", baseKeys)
+
+        # answered once the rows are collected, no delay bound
+        self.consumeRealtime("batch by rows", baseKeys + ', msg.batch.rows:500')
+
+        # the delay bounds the wait of a batch never reaching its rows
+        self.consumeRealtime("batch by delay", baseKeys + ', msg.batch.rows:1000000, msg.batch.delay.ms:200')
+
+        # the batch never reaches its rows and has no delay bound, the rows collected are answered on expiry
+        self.consumeRealtime("batch by expiry", baseKeys + ', msg.batch.rows:1000000')
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success(f"{__file__} successfully executed")
+
+tdCases.addLinux(__file__, TDTestCase())
+tdCases.addWindows(__file__, TDTestCase())
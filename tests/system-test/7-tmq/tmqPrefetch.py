@@ -0,0 +1,100 @@
+import taos
+import sys
+import time
+import socket
+import os
+import threading
+import math
+
+from util.log import *
+from util.sql import *
+from util.cases import *
+from util.dnodes import *
+from util.common import *
+sys.path.append("./7-tmq")
+from tmqCommon import *
+
+class TDTestCase:
+    def __init__(self):
+        self.vgroups    = 4
+        self.ctbNum     = 10
+        self.rowsPerTbl = 10000
+        self.dbName     = 'dbt'
+        self.pollDelay  = 20
+        # several rsp of a vgroup are buffered ahead of the app
+        self.keyList    = 'group.id:cgrp1, enable.auto.commit:false, auto.offset.reset:earliest, msg.prefetch.depth:4'
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug(f"start to excute {__file__}")
+        tdSql.init(conn.cursor(), False)
+
+    def prepareTestEnv(self):
+        tdCom.create_database(tdSql, self.dbName, 1, vgroups=self.vgroups, replica=1)
+        tmqCom.create_stable(tdSql, dbName=self.dbName, stbName='stb')
+        tmqCom.create_ctable(tdSql, dbName=self.dbName, stbName='stb', ctbPrefix='ctb', ctbNum=self.ctbNum, ctbStartIdx=0)
+        tmqCom.insert_data_interlaceByMultiTbl(tsql=tdSql, dbName=self.dbName, ctbPrefix='ctb', ctbNum=self.ctbNum,
+                                               rowsPerTbl=self.rowsPerTbl, batchNum=100, startTs=1640966400000, ctbStartIdx=0)
+
+    def startConsumer(self, consumerId, topicName, expectrowcnt):
+        tmqCom.insertConsumerInfo(consumerId, expectrowcnt, topicName, self.keyList, 0, 1)
+        tmqCom.startTmqSimProcess(pollDelay=self.pollDelay, dbName=self.dbName, showMsg=1, showRow=1, snapshot=0)
+
+    # the consumer stops in the middle with rsp still buffered, only the rows handed to it are committed, so the next
+    # consumer of the group gets exactly the rest
+    def commitWithPrefetch(self):
+        tdLog.printNoPrefix("======== commit with prefetch")
+        topicName = 'topic_prefetch_commit'
+        tdSql.execute("create topic %s as select ts, c1, c2 from %s.stb"%(topicName, self.dbName))
+        totalRows = self.rowsPerTbl * self.ctbNum
+
+        tmqCom.initConsumerTable()
+        self.startConsumer(0, topicName, math.ceil(totalRows / 3))
+        firstRows = tmqCom.selectConsumeResult(1)[0]
+
+        tmqCom.initConsumerTable()
+        self.startConsumer(1, topicName, totalRows)
+        secondRows = tmqCom.selectConsumeResult(1)[0]
+
+        if firstRows <= 0 or firstRows >= totalRows or firstRows + secondRows != totalRows:
+            tdLog.exit("consume rows %d + %d, expect %d in all"%(firstRows, secondRows, totalRows))
+
+        time.sleep(5)
+        tdSql.query("drop topic %s"%topicName)
+        tdLog.printNoPrefix("======== commit with prefetch end ...... ")
+
+    # a consumer joins the group while the first one has polls in flight, the rsp prefetched for the vgroups moved to
+    # it are dropped and no row is lost
+    def rebalanceWithPrefetch(self):
+        tdLog.printNoPrefix("======== rebalance with prefetch")
+        topicName = 'topic_prefetch_rebalance'
+        tdSql.execute("create topic %s as select ts, c1, c2 from %s.stb"%(topicName, self.dbName))
+        totalRows = self.rowsPerTbl * self.ctbNum
+
+        tmqCom.initConsumerTable()
+        self.startConsumer(0, topicName, totalRows)
+        tmqCom.getStartConsumeNotifyFromTmqsim()
+
+        tmqCom.initConsumerInfoTable()
+        self.startConsumer(1, topicName, totalRows)
+
+        resultList = tmqCom.selectConsumeResult(2)
+        # rows consumed and not committed before the rebalance are consumed again by the new owner of their vgroup
+        if resultList[0] + resultList[1] < totalRows:
+            tdLog.exit("consume rows %d + %d, expect at least %d"%(resultList[0], resultList[1], totalRows))
+
+        time.sleep(5)
+        tdSql.query("drop topic %s"%topicName)
+        tdLog.printNoPrefix("======== rebalance with prefetch end ...... ")
+
+    def run(self):
+        self.prepareTestEnv()
+        self.commitWithPrefetch()
+        self.rebalanceWithPrefetch()
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success(f"{__file__} successfully executed")
+
+tdCases.addLinux(__file__, TDTestCase())
+tdCases.addWindows(__file__, TDTestCase())